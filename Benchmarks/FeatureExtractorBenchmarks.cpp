@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "GA/FeatureExtractor.h"
+#include "GA/WorkerPool.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr int numMelBands = 26;
+    
+    // The per-frame DCT as it was: one std::cos per coefficient and band
+    void dctWithCos(const std::vector<float>& melEnergies, std::array<float, 10>& mfccs)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            mfccs[static_cast<size_t>(i)] = 0.0f;
+            for (int j = 0; j < numMelBands; ++j)
+                mfccs[static_cast<size_t>(i)] += melEnergies[static_cast<size_t>(j)]
+                    * std::cos(juce::MathConstants<float>::pi * i * (j + 0.5f) / numMelBands);
+        }
+    }
+    
+    // FeatureExtractor's form: basis built once, matrix-vector product per frame
+    void dctWithBasis(const std::vector<float>& basis, const std::vector<float>& melEnergies, std::array<float, 10>& mfccs)
+    {
+        const float* row = basis.data();
+        for (int i = 0; i < 10; ++i, row += numMelBands)
+        {
+            float sum = 0.0f;
+            for (int j = 0; j < numMelBands; ++j)
+                sum += melEnergies[static_cast<size_t>(j)] * row[j];
+            mfccs[static_cast<size_t>(i)] = sum;
+        }
+    }
+}
+
+TEST_CASE("MFCC DCT speed", "[benchmark][features]")
+{
+    std::vector<float> melEnergies(numMelBands);
+    for (int j = 0; j < numMelBands; ++j)
+        melEnergies[static_cast<size_t>(j)] = std::log(1.0f + 0.37f * j);
+    
+    std::vector<float> basis(static_cast<size_t>(10 * numMelBands));
+    for (int i = 0; i < 10; ++i)
+        for (int j = 0; j < numMelBands; ++j)
+            basis[static_cast<size_t>(i * numMelBands + j)] = std::cos(juce::MathConstants<float>::pi * i * (j + 0.5f) / numMelBands);
+    
+    std::array<float, 10> cosMfccs {}, basisMfccs {};
+    dctWithCos(melEnergies, cosMfccs);
+    dctWithBasis(basis, melEnergies, basisMfccs);
+    REQUIRE(cosMfccs == basisMfccs);
+    
+    BENCHMARK("DCT, std::cos per term")
+    {
+        dctWithCos(melEnergies, cosMfccs);
+        return cosMfccs[3];
+    };
+    
+    BENCHMARK("DCT, precomputed basis")
+    {
+        dctWithBasis(basis, melEnergies, basisMfccs);
+        return basisMfccs[3];
+    };
+}
+
+TEST_CASE("Feature extraction speed", "[benchmark][features]")
+{
+    // Fitness profile: 1 s at 22.05 kHz, 1024-point frames, hop 256
+    FeatureExtractor extractor(22050.0, 1024, 256);
+    
+    std::vector<float> audio(22050);
+    for (size_t i = 0; i < audio.size(); ++i)
+        audio[i] = 0.4f * std::sin(0.06f * static_cast<float>(i)) * std::exp(-static_cast<float>(i) / 22050.0f);
+    
+    BENCHMARK("extractFeatures, 1 s fitness render")
+    {
+        return extractor.extractFeatures(audio.data(), static_cast<int>(audio.size())).mfccMean[0];
+    };
+}
+
+TEST_CASE("Frame-parallel feature extraction speed", "[benchmark][features]")
+{
+    // A long full-fidelity analysis: 8 s at 44.1 kHz, 2048-point frames, hop 512
+    FeatureExtractor extractor(44100.0, 2048, 512);
+    WorkerPool pool(4);
+    
+    std::vector<float> audio(8 * 44100);
+    for (size_t i = 0; i < audio.size(); ++i)
+        audio[i] = 0.4f * std::sin(0.03f * static_cast<float>(i)) * std::exp(-static_cast<float>(i) / 176400.0f);
+    
+    const int numSamples = static_cast<int>(audio.size());
+    
+    BENCHMARK("extractFeatures, 8 s, sequential")
+    {
+        return extractor.extractFeatures(audio.data(), numSamples).mfccMean[0];
+    };
+    
+    BENCHMARK("extractFeatures, 8 s, 4 pool slots")
+    {
+        return extractor.extractFeatures(audio.data(), numSamples, pool).mfccMean[0];
+    };
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "GA/AudioFeatureCache.h"
+#include "GA/GeneticAlgorithm.h"
+#include "GA/MLPPreferenceModel.h"
+#include "GA/NoveltyIndex.h"
+#include "GA/ParameterBridge.h"
+#include "GA/Population.h"
+#include "GA/SelectionOperators.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int genomeSize = 17;
+
+    std::vector<float> makeGenome(int seed)
+    {
+        juce::Random random(seed);
+        std::vector<float> genome(genomeSize);
+        for (auto& value : genome)
+            value = random.nextFloat();
+        return genome;
+    }
+
+    std::vector<juce::String> getParamNames()
+    {
+        std::vector<juce::String> names;
+        for (int i = 0; i < genomeSize; ++i)
+            names.push_back("p" + juce::String(i));
+        return names;
+    }
+
+    juce::File getModelDir(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("GABenchmarks").getChildFile(name);
+        dir.deleteRecursively();
+        dir.createDirectory();
+        return dir;
+    }
+}
+
+TEST_CASE("AudioFeatureCache speed", "[benchmark][features]")
+{
+    AudioFeatureCache cache(44100.0);
+    const auto cached = makeGenome(1);
+    cache.getFeatures(cached);
+
+    std::vector<float> features(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    int next = 2;
+
+    BENCHMARK("getFeatures, hit")
+    {
+        return cache.getFeatures(cached)[0];
+    };
+
+    // A genome never seen before: render and analysis of the fitness phrase
+    BENCHMARK_ADVANCED("getFeatures, miss")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<std::vector<float>> genomes;
+        for (int i = 0; i < meter.runs(); ++i)
+            genomes.push_back(makeGenome(next++));
+
+        meter.measure([&](int run) { return cache.getFeatures(genomes[static_cast<size_t>(run)])[0]; });
+    };
+
+    BENCHMARK("computeFeatures, uncached")
+    {
+        cache.computeFeatures(cached, features.data());
+        return features[0];
+    };
+}
+
+TEST_CASE("Novelty speed", "[benchmark][ga]")
+{
+    // The GA's population and default neighbourhood
+    Population population(50, genomeSize);
+    population.initializeRandom();
+    for (int i = 0; i < population.size(); ++i)
+        population.setFitness(i, 0.5f);
+
+    NoveltyIndex index(genomeSize);
+    index.rebuild(population);
+    const auto candidate = makeGenome(7);
+
+    BENCHMARK("NoveltyIndex rebuild, 50 members")
+    {
+        index.rebuild(population);
+        return index.size();
+    };
+
+    BENCHMARK("memberNovelty, k = 5")
+    {
+        return index.memberNovelty(population, 3, 5);
+    };
+
+    BENCHMARK("candidateNovelty, k = 5")
+    {
+        return index.candidateNovelty(population, candidate.data(), 5);
+    };
+}
+
+TEST_CASE("Selection speed", "[benchmark][ga]")
+{
+    // A generation's parents at the largest offspring count (40), for a small and a large population
+    constexpr int numParents = 80;
+    
+    for (int size : { 50, 2000 })
+    {
+        Population population(size, genomeSize);
+        population.initializeRandom();
+        juce::Random random(size);
+        for (int i = 0; i < population.size(); ++i)
+            population.setFitness(i, random.nextFloat());
+        
+        RandomStream rng(1);
+        int parents[numParents];
+        const std::string members = ", " + std::to_string(size) + " members";
+        
+        BENCHMARK("Tournament, k = 3" + members)
+        {
+            TournamentSelection()(population, rng, parents, numParents);
+            return parents[0];
+        };
+        
+        RankSelection rank;
+        BENCHMARK("Rank, prepare and draw" + members)
+        {
+            rank.prepare(population);
+            rank(rng, parents, numParents);
+            return parents[0];
+        };
+        
+        BENCHMARK("Stochastic universal sampling" + members)
+        {
+            StochasticUniversalSampling()(population, rng, parents, numParents);
+            return parents[0];
+        };
+    }
+}
+
+TEST_CASE("GA generation speed", "[benchmark][ga]")
+{
+    for (auto mode : { GAConfig::MLPInputMode::Genome, GAConfig::MLPInputMode::Audio })
+    {
+        const bool audio = mode == GAConfig::MLPInputMode::Audio;
+        const auto dir = getModelDir(audio ? "audio" : "genome");
+
+        {
+            MLPPreferenceModel model(getParamNames(), dir);
+            REQUIRE(model.waitUntilReady());
+            model.setInputMode(mode);
+
+            GAConfig config;
+            config.mlpInputMode = mode;
+            config.numEvaluationThreads = 1;
+
+            GeneticAlgorithm ga(model);
+            ga.setConfig(config);
+            ga.stepGeneration();  // Initialises the population outside the measurement
+
+            std::vector<float> params;
+            float fitness;
+
+            BENCHMARK(std::string("stepGeneration, ") + (audio ? "Audio" : "Genome") + " mode, 1 thread")
+            {
+                ga.stepGeneration();
+                ga.getParameterBridge()->pop(params, fitness);  // Keep the bridge draining like the plugin
+                return fitness;
+            };
+        }
+
+        dir.deleteRecursively();
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "GA/MLP.h"
+#include "GA/FixedMLP.h"
+#include "GA/QuantizedMLP.h"
+#include <vector>
+
+namespace
+{
+    constexpr int batchSize = 64;    // A generation's worth of candidates
+    constexpr int replaySize = 8;    // MLPPreferenceModel replay batch
+    
+    std::vector<float> makeInputs(int inputSize, int numSamples)
+    {
+        std::vector<float> inputs(static_cast<size_t>(inputSize) * numSamples);
+        for (size_t i = 0; i < inputs.size(); ++i)
+            inputs[i] = static_cast<float>((i * 37) % 101) / 100.0f;
+        return inputs;
+    }
+    
+    // Runtime-sized MLP against the fixed-size and quantized ones of the same shape
+    template <typename FixedType, typename QuantizedType>
+    void benchmarkShape(const char* name)
+    {
+        constexpr int inputSize = FixedType::getInputSize();
+        MLP runtime(inputSize, FixedType::getHiddenSize());
+        FixedType fixed;
+        fixed.setWeights(runtime.getWeights());
+        
+        const auto inputs = makeInputs(inputSize, batchSize);
+        const std::vector<float> single(inputs.begin(), inputs.begin() + inputSize);
+        std::vector<float> outputs(batchSize);
+        
+        std::vector<float> targets(replaySize), weights(replaySize, 1.0f);
+        for (int n = 0; n < replaySize; ++n)
+            targets[n] = static_cast<float>(n % 2);
+        
+        BENCHMARK(std::string(name) + ", MLP predict")
+        {
+            return runtime.predict(single);
+        };
+        
+        BENCHMARK(std::string(name) + ", FixedMLP predict")
+        {
+            return fixed.predict(single);
+        };
+        
+        BENCHMARK(std::string(name) + ", MLP predictBatch x64")
+        {
+            runtime.predictBatch(inputs.data(), batchSize, outputs.data());
+            return outputs[0];
+        };
+        
+        BENCHMARK(std::string(name) + ", FixedMLP predictBatch x64")
+        {
+            fixed.predictBatch(inputs.data(), batchSize, outputs.data());
+            return outputs[0];
+        };
+        
+        const QuantizedType quantized(fixed);
+        
+        BENCHMARK(std::string(name) + ", QuantizedMLP predictBatch x64")
+        {
+            quantized.predictBatch(inputs.data(), batchSize, outputs.data());
+            return outputs[0];
+        };
+        
+        BENCHMARK(std::string(name) + ", MLP trainBatch x8")
+        {
+            runtime.trainBatch(inputs.data(), replaySize, targets.data(), weights.data(), 0.05f);
+        };
+        
+        BENCHMARK(std::string(name) + ", FixedMLP trainBatch x8")
+        {
+            fixed.trainBatch(inputs.data(), replaySize, targets.data(), weights.data(), 0.05f);
+        };
+    }
+}
+
+TEST_CASE("MLP speed, genome shape", "[benchmark][mlp]")
+{
+    benchmarkShape<GenomeMLP, QuantizedGenomeMLP>("17x32");
+}
+
+TEST_CASE("MLP speed, audio shape", "[benchmark][mlp]")
+{
+    benchmarkShape<AudioMLP, QuantizedAudioMLP>("24x32");
+}
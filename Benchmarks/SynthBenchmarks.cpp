@@ -0,0 +1,33 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "GA/HeadlessSynth.h"
+#include <vector>
+
+namespace
+{
+    constexpr int blockSize = 512;
+}
+
+TEST_CASE("HeadlessSynth render speed", "[benchmark][synth]")
+{
+    // Three-note phrase, released halfway, at each rate the plugin commonly runs
+    for (double rate : { 44100.0, 96000.0 })
+    {
+        const int numSamples = static_cast<int>(rate);
+        const std::vector<MidiEvent> events
+        {
+            { 0, 0x90, 48, 100 }, { 0, 0x90, 55, 100 }, { 0, 0x90, 60, 100 },
+            { numSamples / 2, 0x80, 48, 0 }, { numSamples / 2, 0x80, 55, 0 }, { numSamples / 2, 0x80, 60, 0 }
+        };
+        
+        HeadlessSynth synth(rate, blockSize);
+        synth.setParameters(std::vector<float>(HeadlessParam::COUNT, 0.5f));
+        juce::AudioBuffer<float> buffer(1, numSamples);
+        
+        BENCHMARK("renderSequence, 1 s phrase at " + std::to_string(static_cast<int>(rate)) + " Hz")
+        {
+            synth.renderSequence(events, buffer);
+            return buffer.getSample(0, numSamples / 4);
+        };
+    }
+}
@@ -7,78 +7,1115 @@
 */
 
 #include "AudioFeatureCache.h"
+#include "Trace.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 
-AudioFeatureCache::AudioFeatureCache(double sampleRate_)
+// Renders queued genomes through getFeaturesBatch, one lockstep sweep at a time
+class AudioFeatureCache::PrefetchThread : public juce::Thread
+{
+public:
+    explicit PrefetchThread(AudioFeatureCache& owner)
+        : juce::Thread("FeaturePrefetch")
+        , cache(owner)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+    
+    ~PrefetchThread() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        
+        queueChanged.notify_all();
+        stopThread(2000);
+    }
+    
+    void enqueue(const float* genome)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            
+            for (const auto& queued : queue)
+                if (std::equal(queued.begin(), queued.end(), genome))
+                    return;
+            
+            // The oldest hints are the likeliest to be stale
+            if (queue.size() >= maxPrefetchQueue)
+                queue.pop_front();
+            
+            queue.emplace_back();
+            std::copy(genome, genome + HeadlessParam::COUNT, queue.back().begin());
+        }
+        
+        queueChanged.notify_all();
+    }
+    
+    bool waitUntilIdle(int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        return queueChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                     [this] { return queue.empty() && !busy; });
+    }
+    
+    void run() override
+    {
+        std::vector<float> genomes;
+        std::vector<float> features;
+        
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                busy = false;
+                queueChanged.notify_all();
+                queueChanged.wait(lock, [this] { return stopping || !queue.empty(); });
+                
+                if (stopping)
+                    return;
+                
+                genomes.clear();
+                while (!queue.empty() && genomes.size() < static_cast<size_t>(HeadlessSynthBatch::MAX_WIDTH) * HeadlessParam::COUNT)
+                {
+                    genomes.insert(genomes.end(), queue.front().begin(), queue.front().end());
+                    queue.pop_front();
+                }
+                
+                busy = true;
+            }
+            
+            // Drop what was looked up (and so cached) while it sat in the queue
+            size_t numPending = 0;
+            for (size_t row = 0; row < genomes.size(); row += HeadlessParam::COUNT)
+            {
+                if (!cache.isCached(genomes.data() + row))
+                {
+                    std::copy(genomes.begin() + static_cast<std::ptrdiff_t>(row),
+                              genomes.begin() + static_cast<std::ptrdiff_t>(row + HeadlessParam::COUNT),
+                              genomes.begin() + static_cast<std::ptrdiff_t>(numPending * HeadlessParam::COUNT));
+                    ++numPending;
+                }
+            }
+            
+            if (numPending == 0)
+                continue;
+            
+            features.resize(numPending * AUDIO_FEATURE_COUNT);
+            cache.getFeaturesBatch(genomes.data(), static_cast<int>(numPending), HeadlessParam::COUNT, features.data());
+            cache.prefetchedCount += numPending;
+        }
+    }
+    
+private:
+    AudioFeatureCache& cache;
+    std::deque<std::array<float, HeadlessParam::COUNT>> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    bool stopping = false;
+    bool busy = false;  // A sweep taken from the queue is still rendering
+};
+
+// Runs reconfigure() for requestSampleRate(), coalescing requests made while it builds
+class AudioFeatureCache::ReconfigureThread : public juce::Thread
+{
+public:
+    explicit ReconfigureThread(AudioFeatureCache& owner)
+        : juce::Thread("FeatureReconfigure")
+        , cache(owner)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+    
+    ~ReconfigureThread() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        
+        changed.notify_all();
+        stopThread(5000);
+    }
+    
+    void request()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = true;
+        }
+        
+        changed.notify_all();
+    }
+    
+    bool waitUntilIdle(int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return !pending && !busy; });
+    }
+    
+    void run() override
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                busy = false;
+                changed.notify_all();
+                changed.wait(lock, [this] { return stopping || pending; });
+                
+                if (stopping)
+                    return;
+                
+                pending = false;
+                busy = true;
+            }
+            
+            // Reads the latest request, so several made meanwhile cost one rebuild
+            cache.reconfigure();
+        }
+    }
+    
+private:
+    AudioFeatureCache& cache;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool pending = false;
+    bool busy = false;
+    bool stopping = false;
+};
+
+AudioFeatureCache::AudioFeatureCache(double sampleRate_, RenderProfile profile_)
     : sampleRate(sampleRate_)
+    , profile(profile_)
+    , requestedSampleRate(sampleRate_)
+    , requestedProfile(profile_)
+{
+    idleContexts.push_back(std::make_unique<RenderContext>(renderRateFor(sampleRate), profile, configVersion));
+}
+
+AudioFeatureCache::~AudioFeatureCache()
+{
+    // Stop background work before the state it uses goes away
+    reconfigureThread.reset();
+    prefetchThread.reset();
+}
+
+void AudioFeatureCache::prefetch(const float* genomes, int numGenomes, int genomeSize)
+{
+    if (genomeSize != HeadlessParam::COUNT || numGenomes <= 0)
+        return;
+    
+    PrefetchThread* thread;
+    
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        if (prefetchThread == nullptr)
+            prefetchThread = std::make_unique<PrefetchThread>(*this);
+        thread = prefetchThread.get();
+    }
+    
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        const float* genome = genomes + static_cast<size_t>(i) * genomeSize;
+        if (!isCached(genome))
+            thread->enqueue(genome);
+    }
+}
+
+bool AudioFeatureCache::waitForPrefetches(int timeoutMs)
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex);
+    return prefetchThread == nullptr || prefetchThread->waitUntilIdle(timeoutMs);
+}
+
+AudioFeatureCache::RenderContext::RenderContext(double rate, const RenderProfile& profile, uint32_t version)
+    : sampleRate(rate)
+    , configVersion(version)
+    , synth(rate)
+    , extractor(rate, profile.fftSize, profile.hopSize)
+{
+    int totalSamples = static_cast<int>(rate * profile.durationMs / 1000.0);
+    int noteDuration = totalSamples / 4;
+    
+    // Create a phrase: C4-E4-G4-C5 with varied velocities
+    phrase = {
+        {0, 0x90, 60, 110},
+        {noteDuration - 100, 0x80, 60, 0},
+        {noteDuration, 0x90, 64, 80},
+        {noteDuration * 2 - 100, 0x80, 64, 0},
+        {noteDuration * 2, 0x90, 67, 50},
+        {noteDuration * 3 - 100, 0x80, 67, 0},
+        {noteDuration * 3, 0x90, 72, 100},
+        {totalSamples - 200, 0x80, 72, 0}
+    };
+    
+    phraseSamples = totalSamples;
+    prefixSamples = noteDuration;
+    streamBlock.resize(static_cast<size_t>(profile.hopSize > 0 ? profile.hopSize : profile.fftSize / 4));
+}
+
+void AudioFeatureCache::RenderContext::ensureBatch()
+{
+    if (batch != nullptr)
+        return;
+    
+    batch = std::make_unique<HeadlessSynthBatch>(sampleRate);
+    batchAudio.setSize(HeadlessSynthBatch::MAX_WIDTH, phraseSamples);
+}
+
+std::vector<float> AudioFeatureCache::getFeatures(const std::vector<float>& genome, bool persistent)
+{
+    PPG_TRACE_ZONE("Feature cache get");
+    
+    const uint32_t renderGeneration = generation.load();
+    const float tolerance = keyTolerance.load();
+    if (tolerance <= 0.0f || genome.size() != static_cast<size_t>(HeadlessParam::COUNT))
+    {
+        std::vector<float> features = getExactFeatures(genome);
+        if (persistent)
+            persist(genome.data(), 1, static_cast<int>(genome.size()), features.data(), renderGeneration);
+        return features;
+    }
+    
+    // Genomes in the same cell share the features of the cell's centre
+    std::vector<float> key(genome.size());
+    quantizeGenome(genome.data(), tolerance, key.data());
+    
+    std::vector<float> features = getExactFeatures(key);
+    if (persistent)
+        persist(key.data(), 1, HeadlessParam::COUNT, features.data(), renderGeneration);
+    if (key != genome)
+        noteApproximation(genome.data(), features.data());
+    
+    return features;
+}
+
+void AudioFeatureCache::getFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut,
+                                         bool persistent)
+{
+    PPG_TRACE_ZONE("Feature cache get batch");
+    
+    // Hits are persisted too: a rated genome was usually cached when the GA evaluated it
+    const uint32_t renderGeneration = generation.load();
+    const float tolerance = keyTolerance.load();
+    if (tolerance <= 0.0f || genomeSize != HeadlessParam::COUNT)
+    {
+        getExactFeaturesBatch(genomes, numGenomes, genomeSize, featuresOut);
+        if (persistent)
+            persist(genomes, numGenomes, genomeSize, featuresOut, renderGeneration);
+        return;
+    }
+    
+    std::vector<float> keys(static_cast<size_t>(numGenomes) * genomeSize);
+    for (int i = 0; i < numGenomes; ++i)
+        quantizeGenome(genomes + static_cast<size_t>(i) * genomeSize, tolerance, keys.data() + static_cast<size_t>(i) * genomeSize);
+    
+    getExactFeaturesBatch(keys.data(), numGenomes, genomeSize, featuresOut);
+    if (persistent)
+        persist(keys.data(), numGenomes, genomeSize, featuresOut, renderGeneration);
+    
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        const float* genome = genomes + static_cast<size_t>(i) * genomeSize;
+        if (!std::equal(genome, genome + genomeSize, keys.begin() + static_cast<std::ptrdiff_t>(i) * genomeSize))
+            noteApproximation(genome, featuresOut + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT);
+    }
+}
+
+void AudioFeatureCache::setKeyTolerance(float tolerance, int auditInterval)
+{
+    keyTolerance.store(std::max(0.0f, tolerance));
+    driftAuditInterval.store(std::max(0, auditInterval));
+    
+    std::lock_guard<std::mutex> lock(driftMutex);
+    drift = {};
+}
+
+AudioFeatureCache::DriftStats AudioFeatureCache::getDriftStats() const
+{
+    std::lock_guard<std::mutex> lock(driftMutex);
+    return drift;
+}
+
+void AudioFeatureCache::quantizeGenome(const float* genome, float tolerance, float* keyOut)
+{
+    // Cells 2 * tolerance wide, so every gene is within tolerance of its cell's centre
+    const float step = 2.0f * tolerance;
+    
+    for (int i = 0; i < HeadlessParam::COUNT; ++i)
+        keyOut[i] = juce::jlimit(0.0f, 1.0f, std::round(genome[i] / step) * step);
+}
+
+void AudioFeatureCache::noteApproximation(const float* genome, const float* approximateFeatures)
 {
-    synth = std::make_unique<HeadlessSynth>(sampleRate);
-    extractor = std::make_unique<FeatureExtractor>(sampleRate);
+    const int interval = driftAuditInterval.load();
+    bool audit;
+    
+    {
+        std::lock_guard<std::mutex> lock(driftMutex);
+        ++drift.approximateLookups;
+        audit = interval > 0 && (drift.approximateLookups - 1) % static_cast<size_t>(interval) == 0;  // First, then every interval
+    }
+    
+    if (!audit)
+        return;
+    
+    // Render the genome itself (uncached) to see what the approximation cost
+    std::array<float, AUDIO_FEATURE_COUNT> exact;
+    computeFeatures(std::vector<float>(genome, genome + HeadlessParam::COUNT), exact.data());
+    
+    float sumError = 0.0f;
+    float maxError = 0.0f;
+    for (int f = 0; f < AUDIO_FEATURE_COUNT; ++f)
+    {
+        const float error = std::abs(exact[static_cast<size_t>(f)] - approximateFeatures[f]);
+        sumError += error;
+        maxError = std::max(maxError, error);
+    }
+    
+    std::lock_guard<std::mutex> lock(driftMutex);
+    
+    // Running mean of each audit's mean absolute error
+    ++drift.audits;
+    drift.meanAbsError += (sumError / AUDIO_FEATURE_COUNT - drift.meanAbsError) / static_cast<float>(drift.audits);
+    drift.maxAbsError = std::max(drift.maxAbsError, maxError);
 }
 
-std::vector<float> AudioFeatureCache::getFeatures(const std::vector<float>& genome)
+std::vector<float> AudioFeatureCache::getExactFeatures(const std::vector<float>& genome)
 {
-    size_t hash = hashGenome(genome);
+    const int genomeSize = static_cast<int>(genome.size());
+    uint32_t renderGeneration = generation.load();
+    std::vector<float> features(AUDIO_FEATURE_COUNT);
+    
+    std::shared_ptr<InFlightRender> claim;
+    switch (findOrClaim(genome.data(), genomeSize, features.data(), claim))
+    {
+        case Lookup::hit:
+            ++cacheHits;
+            return features;
+            
+        case Lookup::joined:
+            // Another caller is rendering this genome; wait for its result
+            ++cacheHits;
+            ++inFlightJoins;
+            claim->wait(features.data());
+            return features;
+            
+        case Lookup::claimed:
+            break;
+    }
     
-    auto it = cache.find(hash);
-    if (it != cache.end())
+    // Computed in an earlier session
+    if (findStored(genome.data(), genomeSize, features.data()))
     {
-        // Cache hit - move to front of LRU
         ++cacheHits;
-        lruOrder.erase(lruMap[hash]);
-        lruOrder.push_front(hash);
-        lruMap[hash] = lruOrder.begin();
-        return it->second;
+        insert(genome.data(), genomeSize, features.data(), renderGeneration, claim);
+        return features;
     }
     
-    // Cache miss - extract features
+    // Cache miss - extract features without holding the cache lock
     ++cacheMisses;
-    std::vector<float> features = extractFeatures(genome);
+    const auto renderStart = juce::Time::getHighResolutionTicks();
+    computeFeatures(genome, features.data());
+    recordRenderTime(renderStart, 1);
+    insert(genome.data(), genomeSize, features.data(), renderGeneration, claim);
+    
+    return features;
+}
+
+void AudioFeatureCache::getExactFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut)
+{
+    // Only allocate once something misses
+    std::vector<int> misses;
+    std::vector<std::shared_ptr<InFlightRender>> claims;  // Parallel to misses
+    std::vector<std::pair<int, std::shared_ptr<InFlightRender>>> joined;
+    uint32_t renderGeneration = generation.load();
     
-    // Evict if necessary
-    if (cache.size() >= maxCacheSize)
-        evictLRU();
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        std::shared_ptr<InFlightRender> claim;
+        switch (findOrClaim(genomes + static_cast<size_t>(i) * genomeSize, genomeSize,
+                            featuresOut + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT, claim))
+        {
+            case Lookup::hit:
+                ++cacheHits;
+                break;
+                
+            case Lookup::joined:
+                joined.emplace_back(i, std::move(claim));
+                break;
+                
+            case Lookup::claimed:
+                misses.push_back(i);
+                claims.push_back(std::move(claim));
+                break;
+        }
+    }
     
-    // Add to cache
-    cache[hash] = features;
-    lruOrder.push_front(hash);
-    lruMap[hash] = lruOrder.begin();
+    if (!misses.empty())
+    {
+        // Misses found in the persistent store need no render
+        size_t numUnstored = 0;
+        for (size_t m = 0; m < misses.size(); ++m)
+        {
+            const int i = misses[m];
+            const float* genome = genomes + static_cast<size_t>(i) * genomeSize;
+            float* features = featuresOut + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT;
+            
+            if (findStored(genome, genomeSize, features))
+            {
+                ++cacheHits;
+                insert(genome, genomeSize, features, renderGeneration, claims[m]);
+            }
+            else
+            {
+                misses[numUnstored] = i;
+                claims[numUnstored] = std::move(claims[m]);
+                ++numUnstored;
+            }
+        }
+        misses.resize(numUnstored);
+        claims.resize(numUnstored);
+    }
     
-    return features;
+    if (!misses.empty())
+    {
+        // Render all misses together without holding any cache lock
+        cacheMisses += misses.size();
+        
+        const int numMisses = static_cast<int>(misses.size());
+        std::vector<float> missGenomes(static_cast<size_t>(numMisses) * genomeSize);
+        std::vector<float> missFeatures(static_cast<size_t>(numMisses) * AUDIO_FEATURE_COUNT);
+        
+        for (int m = 0; m < numMisses; ++m)
+        {
+            const float* row = genomes + static_cast<size_t>(misses[m]) * genomeSize;
+            std::copy(row, row + genomeSize, missGenomes.begin() + static_cast<size_t>(m) * genomeSize);
+        }
+        
+        const auto renderStart = juce::Time::getHighResolutionTicks();
+        computeFeaturesBatch(missGenomes.data(), numMisses, genomeSize, missFeatures.data());
+        recordRenderTime(renderStart, numMisses);
+        
+        for (int m = 0; m < numMisses; ++m)
+        {
+            const float* first = missFeatures.data() + static_cast<size_t>(m) * AUDIO_FEATURE_COUNT;
+            std::copy(first, first + AUDIO_FEATURE_COUNT, featuresOut + static_cast<size_t>(misses[m]) * AUDIO_FEATURE_COUNT);
+            insert(missGenomes.data() + static_cast<size_t>(m) * genomeSize, genomeSize, first, renderGeneration,
+                   claims[static_cast<size_t>(m)]);
+        }
+    }
+    
+    // Only wait on other callers' renders once ours are published, so two
+    // batches claiming each other's genomes can't block one another
+    for (auto& [i, claim] : joined)
+    {
+        ++cacheHits;
+        ++inFlightJoins;
+        claim->wait(featuresOut + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT);
+    }
+}
+
+void AudioFeatureCache::InFlightRender::publish(const float* result)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::copy(result, result + AUDIO_FEATURE_COUNT, features.begin());
+        ready = true;
+    }
+    
+    done.notify_all();
+}
+
+void AudioFeatureCache::InFlightRender::wait(float* featuresOut)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return ready; });
+    std::copy(features.begin(), features.end(), featuresOut);
+}
+
+void AudioFeatureCache::computeFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut)
+{
+    // HeadlessSynth ignores malformed genomes; keep that behaviour on the scalar path
+    if (genomeSize != HeadlessParam::COUNT)
+    {
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            const float* row = genomes + static_cast<size_t>(i) * genomeSize;
+            computeFeatures(std::vector<float>(row, row + genomeSize), featuresOut + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT);
+        }
+        return;
+    }
+    
+    auto context = acquireContext();
+    
+    context->ensureBatch();
+    
+    for (int first = 0; first < numGenomes; first += HeadlessSynthBatch::MAX_WIDTH)
+    {
+        const int width = std::min(HeadlessSynthBatch::MAX_WIDTH, numGenomes - first);
+        
+        for (int l = 0; l < width; ++l)
+            context->batch->setParameters(l, genomes + static_cast<size_t>(first + l) * genomeSize);
+        
+        {
+            PPG_TRACE_ZONE("Render batch");
+            context->batch->renderSequence(context->phrase, context->batchAudio, width);
+        }
+        
+        PPG_TRACE_ZONE("Extract features");
+        
+        for (int l = 0; l < width; ++l)
+        {
+            FeatureVector fv = context->extractor.extractFeatures(context->batchAudio.getReadPointer(l),
+                                                                  context->batchAudio.getNumSamples());
+            flattenFeatures(fv, featuresOut + static_cast<size_t>(first + l) * AUDIO_FEATURE_COUNT);
+        }
+    }
+    
+    releaseContext(std::move(context));
+}
+
+bool AudioFeatureCache::computePrefixFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut)
+{
+    if (genomeSize != HeadlessParam::COUNT)
+        return false;
+    
+    auto context = acquireContext();
+    
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        context->synth.setParameters(genomes + static_cast<size_t>(i) * genomeSize);
+        streamFeatures(*context, context->prefixSamples, featuresOut + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT);
+    }
+    
+    releaseContext(std::move(context));
+    return true;
+}
+
+size_t AudioFeatureCache::shardIndex(size_t hash)
+{
+    // Top bits of a Fibonacci mix, independent of the low bits the table probes with
+    return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> (64 - shardBits));
+}
+
+AudioFeatureCache::Lookup AudioFeatureCache::findOrClaim(const float* genome, int genomeSize, float* featuresOut,
+                                                         std::shared_ptr<InFlightRender>& claimOut)
+{
+    // Never cached, so there's nothing to share: the caller just renders
+    if (genomeSize != HeadlessParam::COUNT)
+        return Lookup::claimed;
+    
+    const size_t hash = hashGenome(genome, genomeSize);
+    Shard& shard = shards[shardIndex(hash)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    // Hit sets the entry's CLOCK bit; nothing moves
+    if (const float* cached = shard.table.find(genome, hash))
+    {
+        std::copy(cached, cached + AUDIO_FEATURE_COUNT, featuresOut);
+        return Lookup::hit;
+    }
+    
+    // Few renders are ever in flight at once, so a scan is cheapest
+    for (const auto& render : shard.inFlight)
+    {
+        if (std::memcmp(render->genome.data(), genome, sizeof(float) * HeadlessParam::COUNT) == 0)
+        {
+            claimOut = render;
+            return Lookup::joined;
+        }
+    }
+    
+    claimOut = std::make_shared<InFlightRender>();
+    std::copy(genome, genome + HeadlessParam::COUNT, claimOut->genome.begin());
+    shard.inFlight.push_back(claimOut);
+    return Lookup::claimed;
+}
+
+void AudioFeatureCache::insert(const float* genome, int genomeSize, const float* features, uint32_t renderGeneration,
+                               const std::shared_ptr<InFlightRender>& claim)
+{
+    if (genomeSize != HeadlessParam::COUNT)
+        return;
+    
+    const size_t hash = hashGenome(genome, genomeSize);
+    Shard& shard = shards[shardIndex(hash)];
+    
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        
+        // Cached before the claim is dropped, so no one can miss in between
+        shard.inFlight.erase(std::remove(shard.inFlight.begin(), shard.inFlight.end(), claim), shard.inFlight.end());
+        
+        // Skip insertion if the cache was reset since the render started; clear()
+        // bumps the generation before emptying shards, so checking under the lock is enough
+        if (renderGeneration == generation.load() && shard.table.insert(genome, hash, features))
+            ++cacheEvictions;
+    }
+    
+    // Waiters get the result even if it was too late to cache
+    if (claim != nullptr)
+        claim->publish(features);
+}
+
+void AudioFeatureCache::recordRenderTime(juce::int64 startTicks, int numRendered)
+{
+    if (numRendered <= 0)
+        return;
+    
+    const double elapsedMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    
+    // A lockstep batch shares its time evenly between the genomes it rendered
+    const double perGenomeMs = elapsedMs / numRendered;
+    totalRenderMicros += static_cast<uint64_t>(elapsedMs * 1000.0);
+    
+    int bin = 0;
+    while (bin < RENDER_HISTOGRAM_BINS - 1 && perGenomeMs >= getRenderHistogramUpperMs(bin))
+        ++bin;
+    
+    renderHistogram[static_cast<size_t>(bin)] += static_cast<size_t>(numRendered);
+}
+
+void AudioFeatureCache::setMemoryBudget(size_t bytes)
+{
+    if (bytes == 0)
+        bytes = defaultMemoryBudget;
+    
+    memoryBudget.store(bytes);
+    const int perShard = Table::capacityFor(bytes / numShards);
+    
+    for (auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.table.capacity() != perShard)
+            shard.table = Table(perShard);
+    }
+}
+
+AudioFeatureCache::Stats AudioFeatureCache::getStats() const
+{
+    Stats stats;
+    stats.hits = cacheHits.load();
+    stats.misses = cacheMisses.load();
+    stats.evictions = cacheEvictions.load();
+    stats.joins = inFlightJoins.load();
+    stats.totalRenderMs = static_cast<double>(totalRenderMicros.load()) / 1000.0;
+    
+    for (size_t bin = 0; bin < renderHistogram.size(); ++bin)
+        stats.renderHistogram[bin] = renderHistogram[bin].load();
+    
+    for (const auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += static_cast<size_t>(shard.table.size());
+        stats.capacity += static_cast<size_t>(shard.table.capacity());
+        stats.memoryBytes += Table::bytesFor(shard.table.capacity());
+    }
+    
+    return stats;
+}
+
+size_t AudioFeatureCache::getCacheCapacity() const
+{
+    size_t capacity = 0;
+    for (const auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        capacity += static_cast<size_t>(shard.table.capacity());
+    }
+    return capacity;
+}
+
+void AudioFeatureCache::computeFeatures(const std::vector<float>& genome, float* featuresOut)
+{
+    auto context = acquireContext();
+    extractFeatures(genome, *context, featuresOut);
+    releaseContext(std::move(context));
 }
 
 bool AudioFeatureCache::hasCached(const std::vector<float>& genome) const
 {
-    size_t hash = hashGenome(genome);
-    return cache.find(hash) != cache.end();
+    return genome.size() == static_cast<size_t>(HeadlessParam::COUNT) && isCached(genome.data());
+}
+
+bool AudioFeatureCache::isCached(const float* genome) const
+{
+    std::array<float, HeadlessParam::COUNT> key;
+    std::copy(genome, genome + HeadlessParam::COUNT, key.begin());
+    
+    if (const float tolerance = keyTolerance.load(); tolerance > 0.0f)
+        quantizeGenome(genome, tolerance, key.data());
+    
+    size_t hash = hashGenome(key.data(), HeadlessParam::COUNT);
+    
+    {
+        const Shard& shard = shards[shardIndex(hash)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.table.contains(key.data(), hash))
+            return true;
+    }
+    
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return store != nullptr && store->find(key.data(), hash) != nullptr;
+}
+
+size_t AudioFeatureCache::getCacheSize() const
+{
+    size_t size = 0;
+    for (const auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += static_cast<size_t>(shard.table.size());
+    }
+    return size;
 }
 
 void AudioFeatureCache::setSampleRate(double newSampleRate)
 {
-    if (std::abs(newSampleRate - sampleRate) < 1.0)
-        return;  // No significant change
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        
+        if (std::abs(newSampleRate - requestedSampleRate) < 1.0)
+            return;  // No significant change
+        
+        requestedSampleRate = newSampleRate;
+    }
+    
+    reconfigure();
+}
+
+void AudioFeatureCache::requestSampleRate(double newSampleRate)
+{
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        
+        if (std::abs(newSampleRate - requestedSampleRate) < 1.0)
+            return;
+        
+        requestedSampleRate = newSampleRate;
+        
+        // Nothing to rebuild under a fixed-rate profile, so no thread either
+        if (profile.sampleRate > 0.0 && requestedProfile == profile)
+        {
+            sampleRate = newSampleRate;
+            return;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(reconfigureMutex);
+    if (reconfigureThread == nullptr)
+        reconfigureThread = std::make_unique<ReconfigureThread>(*this);
+    
+    reconfigureThread->request();
+}
+
+bool AudioFeatureCache::waitForReconfiguration(int timeoutMs)
+{
+    std::lock_guard<std::mutex> lock(reconfigureMutex);
+    return reconfigureThread == nullptr || reconfigureThread->waitUntilIdle(timeoutMs);
+}
+
+void AudioFeatureCache::setRenderProfile(const RenderProfile& newProfile)
+{
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        requestedProfile = newProfile;
+    }
+    
+    reconfigure();
+}
+
+void AudioFeatureCache::reconfigure()
+{
+    double newSampleRate;
+    RenderProfile newProfile;
+    double renderRate;
+    uint32_t ticket;
+    int count;
+    
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        newSampleRate = requestedSampleRate;
+        newProfile = requestedProfile;
+        ticket = ++reconfigureTicket;
+        
+        const double oldRenderRate = renderRateFor(sampleRate);
+        renderRate = newProfile.sampleRate > 0.0 ? newProfile.sampleRate : newSampleRate;
+        
+        // A fixed-rate profile renders the same audio at any host rate
+        if (newProfile == profile && renderRate == oldRenderRate)
+        {
+            sampleRate = newSampleRate;
+            return;
+        }
+        
+        count = std::max({ 1, reservedContexts, peakContextsInUse });
+    }
+    
+    // Building allocates (FFT tables, voices, buffers), so lookups keep the
+    // old contexts until the new set is complete
+    std::vector<std::unique_ptr<RenderContext>> built;
+    for (int i = 0; i < count; ++i)
+    {
+        built.push_back(std::make_unique<RenderContext>(renderRate, newProfile, 0));  // Version set on swap
+        built.back()->ensureBatch();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        if (ticket != reconfigureTicket)
+            return;  // Superseded; the newer request rebuilds
+        
+        sampleRate = newSampleRate;
+        profile = newProfile;
+        ++configVersion;
+        
+        for (auto& context : built)
+            context->configVersion = configVersion;
+        
+        idleContexts = std::move(built);
+        contextsInUse = 0;  // Contexts still out are dropped on release
+    }
     
-    sampleRate = newSampleRate;
-    synth = std::make_unique<HeadlessSynth>(sampleRate);
-    extractor = std::make_unique<FeatureExtractor>(sampleRate);
     clear();
+    openStore();
+}
+
+void AudioFeatureCache::setPersistentDirectory(const juce::File& directory)
+{
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        storeDirectory = directory;
+    }
+    
+    openStore();
+}
+
+size_t AudioFeatureCache::getStoredCount() const
+{
+    std::lock_guard<std::mutex> lock(storeMutex);
+    return store != nullptr ? static_cast<size_t>(store->size()) : 0;
+}
+
+void AudioFeatureCache::openStore()
+{
+    FeatureStore::Tag tag;
+    tag.renderVersion = RENDER_VERSION;
+    tag.keySize = HeadlessParam::COUNT;
+    tag.valueSize = AUDIO_FEATURE_COUNT;
+    
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        tag.sampleRate = renderRateFor(sampleRate);
+        tag.durationMs = profile.durationMs;
+        tag.fftSize = profile.fftSize;
+        tag.hopSize = profile.hopSize;
+    }
+    
+    std::lock_guard<std::mutex> writeLock(storeWriteMutex);
+    std::lock_guard<std::mutex> lock(storeMutex);
+    store.reset();  // Flushes the previous configuration's file
+    
+    if (!storeDirectory.isDirectory())
+        return;
+    
+    // One file per configuration, so switching back and forth keeps both
+    juce::String name = "audio_features_" + juce::String(juce::roundToInt(tag.sampleRate))
+                      + "_" + juce::String(tag.durationMs) + "_" + juce::String(tag.fftSize)
+                      + "_" + juce::String(tag.hopSize) + ".bin";
+    
+    store = std::make_unique<FeatureStore>(storeDirectory.getChildFile(name), tag, &hashGenome, maxStoredFeatures);
+    if (!store->isOpen())
+        store.reset();
+}
+
+bool AudioFeatureCache::findStored(const float* genome, int genomeSize, float* featuresOut) const
+{
+    if (genomeSize != HeadlessParam::COUNT)
+        return false;
+    
+    const size_t hash = hashGenome(genome, genomeSize);
+    std::lock_guard<std::mutex> lock(storeMutex);
+    
+    const float* features = store != nullptr ? store->find(genome, hash) : nullptr;
+    if (features == nullptr)
+        return false;
+    
+    std::copy(features, features + AUDIO_FEATURE_COUNT, featuresOut);
+    return true;
+}
+
+void AudioFeatureCache::persist(const float* genomes, int numGenomes, int genomeSize,
+                                const float* features, uint32_t renderGeneration)
+{
+    if (genomeSize != HeadlessParam::COUNT)
+        return;
+    
+    std::lock_guard<std::mutex> writeLock(storeWriteMutex);
+    std::lock_guard<std::mutex> lock(storeMutex);
+    
+    // A config change bumps the generation before switching file, so this
+    // can't write a stale render into the new configuration's store
+    if (store == nullptr || renderGeneration != generation.load())
+        return;
+    
+    // Buffered by the store's stream; flushStore() writes them out
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        const float* genome = genomes + static_cast<size_t>(i) * genomeSize;
+        store->append(genome, hashGenome(genome, genomeSize), features + static_cast<size_t>(i) * AUDIO_FEATURE_COUNT);
+    }
+}
+
+void AudioFeatureCache::flushStore()
+{
+    // Appends and the store's replacement wait, but not lookups: find() never
+    // touches the stream a flush writes
+    std::lock_guard<std::mutex> writeLock(storeWriteMutex);
+    
+    FeatureStore* current = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(storeMutex);
+        current = store.get();
+    }
+    
+    if (current != nullptr)
+        current->flush();
+}
+
+void AudioFeatureCache::reserveContexts(int count)
+{
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        reservedContexts = std::max(reservedContexts, count);
+    }
+    
+    rebuildContexts();
+}
+
+int AudioFeatureCache::getNumIdleContexts() const
+{
+    std::lock_guard<std::mutex> lock(contextMutex);
+    return static_cast<int>(idleContexts.size());
+}
+
+void AudioFeatureCache::rebuildContexts()
+{
+    double rate;
+    RenderProfile buildProfile;
+    uint32_t version;
+    int count;
+    
+    {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        rate = renderRateFor(sampleRate);
+        buildProfile = profile;
+        version = configVersion;
+        
+        const int target = std::max({ 1, reservedContexts, peakContextsInUse });
+        count = target - static_cast<int>(idleContexts.size()) - contextsInUse;
+    }
+    
+    if (count <= 0)
+        return;
+    
+    // Building allocates (FFT tables, voices, buffers), so keep the lock free meanwhile
+    std::vector<std::unique_ptr<RenderContext>> built;
+    for (int i = 0; i < count; ++i)
+    {
+        built.push_back(std::make_unique<RenderContext>(rate, buildProfile, version));
+        built.back()->ensureBatch();
+    }
+    
+    std::lock_guard<std::mutex> lock(contextMutex);
+    if (version != configVersion)
+        return;  // Superseded; the newer change rebuilds
+    
+    for (auto& context : built)
+        idleContexts.push_back(std::move(context));
+}
+
+AudioFeatureCache::RenderProfile AudioFeatureCache::getRenderProfile() const
+{
+    std::lock_guard<std::mutex> lock(contextMutex);
+    return profile;
+}
+
+double AudioFeatureCache::getRenderSampleRate() const
+{
+    std::lock_guard<std::mutex> lock(contextMutex);
+    return renderRateFor(sampleRate);
+}
+
+double AudioFeatureCache::renderRateFor(double hostRate) const
+{
+    return profile.sampleRate > 0.0 ? profile.sampleRate : hostRate;
 }
 
 void AudioFeatureCache::clear()
 {
-    cache.clear();
-    lruOrder.clear();
-    lruMap.clear();
+    ++generation;  // First, so renders that started earlier stop inserting
+    
+    // In-flight renders are forgotten too, so later misses don't join a stale
+    // config's render; their owners still publish to whoever already waits
+    for (auto& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.table.clear();
+        shard.inFlight.clear();
+    }
+    
     cacheHits = 0;
     cacheMisses = 0;
+    cacheEvictions = 0;
+    inFlightJoins = 0;
+    totalRenderMicros = 0;
+    for (auto& bin : renderHistogram)
+        bin = 0;
+}
+
+std::unique_ptr<AudioFeatureCache::RenderContext> AudioFeatureCache::acquireContext()
+{
+    std::lock_guard<std::mutex> lock(contextMutex);
+    
+    ++contextsInUse;
+    peakContextsInUse = std::max(peakContextsInUse, contextsInUse);
+    
+    if (idleContexts.empty())
+        return std::make_unique<RenderContext>(renderRateFor(sampleRate), profile, configVersion);
+    
+    auto context = std::move(idleContexts.back());
+    idleContexts.pop_back();
+    return context;
+}
+
+void AudioFeatureCache::releaseContext(std::unique_ptr<RenderContext> context)
+{
+    std::lock_guard<std::mutex> lock(contextMutex);
+    
+    // Drop contexts built for a previous sample rate or profile
+    if (context->configVersion == configVersion)
+    {
+        --contextsInUse;
+        idleContexts.push_back(std::move(context));
+    }
 }
 
-size_t AudioFeatureCache::hashGenome(const std::vector<float>& genome) const
+size_t AudioFeatureCache::hashGenome(const float* genome, int genomeSize)
 {
     // Hash float bits directly for collision-free hashing
     size_t hash = 0;
-    for (float val : genome)
+    for (int i = 0; i < genomeSize; ++i)
     {
+        float val = genome[i];
         uint32_t bits;
         std::memcpy(&bits, &val, sizeof(bits));
         hash ^= std::hash<uint32_t>{}(bits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
@@ -86,51 +1123,60 @@ size_t AudioFeatureCache::hashGenome(const std::vector<float>& genome) const
     return hash;
 }
 
-std::vector<float> AudioFeatureCache::extractFeatures(const std::vector<float>& genome)
+void AudioFeatureCache::extractFeatures(const std::vector<float>& genome, RenderContext& context, float* featuresOut)
 {
-    synth->setParameters(genome);
+    PPG_TRACE_ZONE("Render and extract features");
     
-    // Render using current sample rate
-    int totalSamples = static_cast<int>(sampleRate * totalDurationMs / 1000.0);
-    int noteDuration = totalSamples / 4;
+    context.synth.setParameters(genome);
     
-    // Create a phrase: C4-E4-G4-C5 with varied velocities
-    std::vector<MidiEvent> events = {
-        {0, 0x90, 60, 110},
-        {noteDuration - 100, 0x80, 60, 0},
-        {noteDuration, 0x90, 64, 80},
-        {noteDuration * 2 - 100, 0x80, 64, 0},
-        {noteDuration * 2, 0x90, 67, 50},
-        {noteDuration * 3 - 100, 0x80, 67, 0},
-        {noteDuration * 3, 0x90, 72, 100},
-        {totalSamples - 200, 0x80, 72, 0}
-    };
-    
-    juce::AudioBuffer<float> audio = synth->renderSequence(events, totalSamples);
-    FeatureVector fv = extractor->extractFeatures(audio);
+    if (auto* pool = analysisPool.load())
+    {
+        // Frame-parallel analysis needs the whole render at once
+        if (context.audio.getNumSamples() != context.phraseSamples)
+            context.audio.setSize(1, context.phraseSamples);
+        
+        context.synth.renderSequence(context.phrase, context.audio);
+        FeatureVector fv = context.extractor.extractFeatures(context.audio.getReadPointer(0), context.phraseSamples, *pool);
+        flattenFeatures(fv, featuresOut);
+        return;
+    }
     
-    // Flatten to vector
-    std::vector<float> features;
-    features.reserve(AUDIO_FEATURE_COUNT);
+    streamFeatures(context, context.phraseSamples, featuresOut);
+}
+
+void AudioFeatureCache::streamFeatures(RenderContext& context, int numSamples, float* featuresOut)
+{
+    context.extractor.beginStream();
+    context.synth.streamSequence(context.phrase, numSamples,
+                                 context.streamBlock.data(), static_cast<int>(context.streamBlock.size()),
+                                 [&context](const float* block, int blockSamples)
+                                 {
+                                     context.extractor.pushSamples(block, blockSamples);
+                                 });
+    FeatureVector fv = context.extractor.finishStream();
+    flattenFeatures(fv, featuresOut);
+}
+
+void AudioFeatureCache::flattenFeatures(const FeatureVector& fv, float* featuresOut)
+{
+    float* out = featuresOut;
     
     for (int i = 0; i < 10; ++i)
-        features.push_back(fv.mfccMean[i]);
+        *out++ = fv.mfccMean[i];
     
     for (int i = 0; i < 10; ++i)
-        features.push_back(fv.mfccStd[i]);
+        *out++ = fv.mfccStd[i];
     
-    features.push_back(fv.spectralCentroidMean);
-    features.push_back(fv.spectralCentroidStd);
-    features.push_back(fv.attackTime);
-    features.push_back(fv.rmsEnergy);
+    *out++ = fv.spectralCentroidMean;
+    *out++ = fv.spectralCentroidStd;
+    *out++ = fv.attackTime;
+    *out++ = fv.rmsEnergy;
     
     // Normalize all features to [0, 1]
-    normalizeFeatures(features);
-    
-    return features;
+    normalizeFeatures(featuresOut);
 }
 
-void AudioFeatureCache::normalizeFeatures(std::vector<float>& features)
+void AudioFeatureCache::normalizeFeatures(float* features)
 {
     // MFCCs mean (indices 0-9)
     for (int i = 0; i < 10; ++i)
@@ -158,14 +1204,4 @@ float AudioFeatureCache::normalizeValue(float value, float min, float max)
     return std::max(0.0f, std::min(1.0f, normalized));
 }
 
-void AudioFeatureCache::evictLRU()
-{
-    if (lruOrder.empty())
-        return;
-    
-    size_t lruHash = lruOrder.back();
-    lruOrder.pop_back();
-    lruMap.erase(lruHash);
-    cache.erase(lruHash);
-}
 
@@ -5,19 +5,45 @@
     Author:  Daniel Lister
 
     Caches audio features for genomes to avoid redundant rendering.
-    Uses LRU eviction when cache is full.
+    Entries live in flat FeatureTables keyed by the full genome, with
+    CLOCK (approximate LRU) eviction when a table is full.
     Features are normalized to [0, 1] for MLP input.
+    Thread-safe: the cache is split into shards by genome hash, each with
+    its own lock, so lookups on different threads rarely contend. Misses
+    render outside any lock, each on its own synth/extractor context, so
+    several evaluators can render at once; a miss on a genome another
+    caller is already rendering waits for that render instead.
+    A RenderProfile sets the render rate, phrase length and analysis
+    resolution; a fixed-rate profile makes features host-rate independent.
+    Rate and profile changes build the new render contexts before swapping
+    them in, so lookups keep rendering on the old ones meanwhile;
+    requestSampleRate() does the building on a background thread.
+    With a persistent directory set, the features of genomes looked up as
+    persistent (rated ones) are also appended to a FeatureStore per render
+    configuration, and found there by later sessions before anything is
+    rendered.
+    An optional key tolerance snaps genomes to a grid first, so near
+    duplicates share one entry; sampled audits measure the feature drift.
+    prefetch() hands genomes to a low-priority thread that renders them
+    ahead of the lookup that will need them.
   ==============================================================================
 */
 
 #pragma once
 
 #include "HeadlessSynth.h"
+#include "HeadlessSynthBatch.h"
 #include "FeatureExtractor.h"
+#include "FeatureTable.h"
+#include "FeatureStore.h"
+#include <array>
 #include <vector>
-#include <unordered_map>
-#include <list>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+class WorkerPool;
 
 class AudioFeatureCache
 {
@@ -25,42 +51,333 @@ public:
     // Audio feature count: 10 MFCCs mean + 10 std + centroid mean/std + attack + RMS
     static constexpr int AUDIO_FEATURE_COUNT = 24;
     
-    explicit AudioFeatureCache(double sampleRate = 44100.0);
+    // Bump whenever a synth or extractor change alters the features of a genome,
+    // so persisted features from older builds are discarded
+    static constexpr uint32_t RENDER_VERSION = 1;
+    
+    /** How a genome is rendered and analysed on a cache miss. */
+    struct RenderProfile
+    {
+        double sampleRate = 0.0;  // Internal render rate; 0 renders at the host rate
+        int durationMs = 2000;    // Length of the C4-E4-G4-C5 phrase
+        int fftSize = 2048;
+        int hopSize = 512;
+        
+        // Host rate, 2 s phrase, 2048-point FFT (the original analysis)
+        static RenderProfile fullFidelity() { return {}; }
+        
+        // Fixed 22.05 kHz, 1 s phrase; same FFT window length in seconds
+        static RenderProfile fitness() { return { 22050.0, 1000, 1024, 256 }; }
+        
+        // Same render rate and analysis settings
+        bool operator==(const RenderProfile& other) const
+        {
+            return sampleRate == other.sampleRate && durationMs == other.durationMs
+                && fftSize == other.fftSize && hopSize == other.hopSize;
+        }
+    };
+    
+    explicit AudioFeatureCache(double sampleRate = 44100.0,
+                               RenderProfile profile = RenderProfile::fullFidelity());
+    ~AudioFeatureCache();
+    
+    // Get normalized features for a genome, rendering audio if not cached.
+    // Persistent also keeps them in the persistent store
+    std::vector<float> getFeatures(const std::vector<float>& genome, bool persistent = false);
+    
+    /**
+     * Renders and analyses a genome without consulting or filling the cache,
+     * writing AUDIO_FEATURE_COUNT normalized features. Once a render context
+     * has warmed up this performs no heap allocation.
+     */
+    void computeFeatures(const std::vector<float>& genome, float* featuresOut);
+    
+    // A FeatureVector as the AUDIO_FEATURE_COUNT normalized features lookups return
+    static void flattenFeatures(const FeatureVector& fv, float* featuresOut);
+    
+    /**
+     * Features for a contiguous genome matrix (numGenomes rows of genomeSize),
+     * written as numGenomes rows of AUDIO_FEATURE_COUNT. Hits come from the
+     * cache; misses render together in lockstep sweeps and are cached.
+     * Persistent also keeps every row's features in the persistent store.
+     */
+    void getFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut,
+                          bool persistent = false);
+    
+    // Uncached batch render, HeadlessSynthBatch::MAX_WIDTH genomes per sweep
+    void computeFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut);
+    
+    /**
+     * Uncached features of only the phrase's first note (a quarter of the
+     * render), as a cheap preview of computeFeaturesBatch. Rows must be
+     * HeadlessParam::COUNT values; returns false otherwise.
+     */
+    bool computePrefixFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut);
+    
+    /** Accuracy of tolerance-snapped lookups, measured by occasional exact renders. */
+    struct DriftStats
+    {
+        size_t approximateLookups = 0;  // Lookups whose genome differed from its key
+        size_t audits = 0;              // Of those, how many were also rendered exactly
+        float meanAbsError = 0.0f;      // Mean |exact - approximate| per normalized feature
+        float maxAbsError = 0.0f;       // Largest single-feature error seen
+    };
+    
+    /**
+     * Treats genomes within tolerance of each other per gene as the same
+     * genome: lookups snap every gene to a grid of cells 2 * tolerance wide
+     * and return the features of the cell's centre, rendering it on a miss.
+     * Every auditInterval-th snapped lookup also renders the genome itself
+     * and adds the difference to getDriftStats() (0 = no audits). A
+     * tolerance of 0 (the default) caches exact genomes only. Resets drift.
+     */
+    void setKeyTolerance(float tolerance, int auditInterval = 64);
+    float getKeyTolerance() const { return keyTolerance.load(); }
+    DriftStats getDriftStats() const;
+    
+    /**
+     * Queues genomes for a low-priority background thread to render and
+     * cache, so a later lookup hits. Genomes already cached, stored or
+     * queued are skipped, and a full queue drops its oldest requests, so
+     * this never waits on a render. Rows must be HeadlessParam::COUNT values.
+     */
+    void prefetch(const float* genomes, int numGenomes, int genomeSize);
+    
+    // Blocks until every queued prefetch has been rendered; false on timeout
+    bool waitForPrefetches(int timeoutMs);
     
-    // Get normalized features for a genome, rendering audio if not cached
-    std::vector<float> getFeatures(const std::vector<float>& genome);
+    // Genomes rendered by the prefetch thread since construction
+    size_t getPrefetchedCount() const { return prefetchedCount.load(); }
     
-    // Check if genome is cached without triggering render
+    // Check if genome is cached without triggering render (only HeadlessParam::COUNT genomes are cached)
     bool hasCached(const std::vector<float>& genome) const;
     
-    // Update sample rate (clears cache, reinitializes synth/extractor)
+    /**
+     * Splits the analysis frames of single-genome misses (getFeatures,
+     * computeFeatures) across pool, cutting the latency of one long render.
+     * Those renders are then buffered rather than streamed. nullptr (the
+     * default) restores streaming; the pool must outlive its use here.
+     */
+    void setAnalysisPool(WorkerPool* pool) { analysisPool.store(pool); }
+    
+    /**
+     * Persists features in directory, one file per render configuration
+     * (rate, phrase length, FFT and hop size, RENDER_VERSION). Misses look
+     * there before rendering, and persistent lookups are appended, up to
+     * maxStoredFeatures records. Config changes switch file; clear() leaves
+     * stored features alone. An invalid directory turns persistence off.
+     */
+    void setPersistentDirectory(const juce::File& directory);
+    
+    // Pushes appended features to disk; lookups carry on meanwhile
+    void flushStore();
+    
+    // Records in the current persistent store (0 without one)
+    size_t getStoredCount() const;
+    
+    // Update host sample rate (clears cache unless the profile fixes the render rate).
+    // Blocks while new contexts are built; other threads keep rendering meanwhile.
     void setSampleRate(double newSampleRate);
     
+    /**
+     * setSampleRate without blocking: a background thread builds the new
+     * render contexts and swaps them in, and lookups are served by the old
+     * configuration until then. Only the latest request is applied.
+     */
+    void requestSampleRate(double newSampleRate);
+    
+    // Blocks until requested rate changes have been applied; false on timeout
+    bool waitForReconfiguration(int timeoutMs);
+    
+    // Change how misses are rendered (clears cache, reinitializes synth/extractor)
+    void setRenderProfile(const RenderProfile& newProfile);
+    RenderProfile getRenderProfile() const;
+    
+    // Rate genomes are actually rendered at
+    double getRenderSampleRate() const;
+    
+    /**
+     * Pre-builds render contexts (synth, extractor, batch renderer and
+     * buffers) so that count threads can miss at once without building one
+     * mid-evaluation. The pool then holds at least this many. A sample rate
+     * or profile change rebuilds every context at once, as many as were
+     * ever in use together.
+     */
+    void reserveContexts(int count);
+    
+    // Contexts ready to check out (idle and current)
+    int getNumIdleContexts() const;
+    
     // Clear cache
     void clear();
     
+    /**
+     * Sets the memory the in-memory cache may use, rounded down to whole
+     * entries per shard (at least one each). Shards whose capacity changes
+     * are emptied. 0 restores the default, which holds 128 entries.
+     */
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return memoryBudget.load(); }
+    
+    static constexpr int RENDER_HISTOGRAM_BINS = 12;
+    
+    // Render time bucket upper bound: bin 0 is under 0.25 ms, each doubles, the last is open
+    static double getRenderHistogramUpperMs(int bin) { return 0.25 * static_cast<double>(1 << bin); }
+    
+    /** Snapshot of cache use since the last clear(), for sizing the budget. */
+    struct Stats
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t joins = 0;              // Misses served by waiting on another caller's render (counted as hits)
+        size_t entries = 0;
+        size_t capacity = 0;
+        size_t memoryBytes = 0;        // Heap held by the tables
+        double totalRenderMs = 0.0;    // Summed over misses
+        std::array<size_t, RENDER_HISTOGRAM_BINS> renderHistogram {};  // Misses per render time bucket
+        
+        float getHitRate() const { return hits + misses > 0 ? static_cast<float>(hits) / static_cast<float>(hits + misses) : 0.0f; }
+        double getAverageMissMs() const { return misses > 0 ? totalRenderMs / static_cast<double>(misses) : 0.0; }
+    };
+    
+    Stats getStats() const;
+    
     // Cache stats for debugging
-    size_t getCacheSize() const { return cache.size(); }
-    size_t getCacheHits() const { return cacheHits; }
-    size_t getCacheMisses() const { return cacheMisses; }
+    size_t getCacheSize() const;
+    size_t getCacheCapacity() const;
+    size_t getCacheHits() const { return cacheHits.load(); }
+    size_t getCacheMisses() const { return cacheMisses.load(); }
 
 private:
-    std::unique_ptr<HeadlessSynth> synth;
-    std::unique_ptr<FeatureExtractor> extractor;
+    // Render state owned by one caller for the duration of a miss
+    struct RenderContext
+    {
+        RenderContext(double rate, const RenderProfile& profile, uint32_t version);
+        
+        double sampleRate;
+        uint32_t configVersion;
+        HeadlessSynth synth;
+        FeatureExtractor extractor;
+        
+        // Phrase and its length, built once for this rate and profile
+        std::vector<MidiEvent> phrase;
+        int phraseSamples;
+        int prefixSamples;   // First note, up to the second note-on
+        
+        // Single renders stream hop-sized blocks straight into the extractor
+        std::vector<float> streamBlock;
+        
+        // Whole render for pooled analysis, sized on first use
+        juce::AudioBuffer<float> audio;
+        
+        // Lockstep renderer and its per-lane buffer, created on first batch use
+        std::unique_ptr<HeadlessSynthBatch> batch;
+        juce::AudioBuffer<float> batchAudio;
+        
+        void ensureBatch();
+    };
+    
+    // Idle contexts, created on demand or up front (one per concurrent renderer)
+    std::vector<std::unique_ptr<RenderContext>> idleContexts;
+    mutable std::mutex contextMutex;
     double sampleRate;
+    RenderProfile profile;
+    uint32_t configVersion = 0;  // Bumped whenever contexts must be rebuilt (guarded by contextMutex)
+    std::atomic<WorkerPool*> analysisPool { nullptr };
+    
+    // Context counts for rebuilding (guarded by contextMutex)
+    int reservedContexts = 0;
+    int contextsInUse = 0;
+    int peakContextsInUse = 0;
+    
+    // Builds contexts for the current config outside contextMutex, then adds
+    // them unless the config changed meanwhile
+    void rebuildContexts();
+    
+    // Latest requested config (guarded by contextMutex); reconfigure() applies it
+    double requestedSampleRate;
+    RenderProfile requestedProfile;
+    uint32_t reconfigureTicket = 0;  // Bumped per reconfigure(), so a superseded build is dropped
+    
+    // Builds contexts for the requested config, then swaps them in and clears
+    // the cache if the render config changed; the old contexts serve until then
+    void reconfigure();
+    
+    // Applies requestSampleRate() off the caller's thread (guarded by reconfigureMutex)
+    class ReconfigureThread;
+    std::unique_ptr<ReconfigureThread> reconfigureThread;
+    std::mutex reconfigureMutex;
+    
+    double renderRateFor(double hostRate) const;
+    
+    std::unique_ptr<RenderContext> acquireContext();
+    void releaseContext(std::unique_ptr<RenderContext> context);
+    
+    using Table = FeatureTable<HeadlessParam::COUNT, AUDIO_FEATURE_COUNT>;
     
-    static constexpr size_t maxCacheSize = 128;
+    static constexpr int shardBits = 3;
+    static constexpr int numShards = 1 << shardBits;
+    static constexpr size_t defaultMemoryBudget = numShards * Table::bytesFor(16);  // 128 entries
+    static constexpr int maxStoredFeatures = 1 << 16;  // ~11 MB per configuration, of rated genomes
     
-    // LRU cache: genome hash -> feature vector
-    std::unordered_map<size_t, std::vector<float>> cache;
-    std::list<size_t> lruOrder;  // Most recently used at front
-    std::unordered_map<size_t, std::list<size_t>::iterator> lruMap;
+    // A miss being rendered by one caller; others missing on the same genome wait for it
+    struct InFlightRender
+    {
+        std::array<float, HeadlessParam::COUNT> genome;
+        std::array<float, AUDIO_FEATURE_COUNT> features;
+        bool ready = false;
+        std::mutex mutex;
+        std::condition_variable done;
+        
+        void publish(const float* result);
+        void wait(float* featuresOut);
+    };
     
-    size_t cacheHits = 0;
-    size_t cacheMisses = 0;
+    // Genome -> normalized features, preallocated; each shard has an equal share of the budget
+    struct Shard
+    {
+        Table table { Table::capacityFor(defaultMemoryBudget / numShards) };
+        std::vector<std::shared_ptr<InFlightRender>> inFlight;  // Renders claimed but not yet cached
+        mutable std::mutex mutex;
+    };
     
-    // Phrase duration for multi-note rendering
-    static constexpr int totalDurationMs = 2000;
+    std::array<Shard, numShards> shards;
+    std::atomic<size_t> memoryBudget { defaultMemoryBudget };
+    
+    // Features kept across sessions (guarded by storeMutex; null when not persisting).
+    // Appends and flushes also hold storeWriteMutex, taken first, so a flush
+    // needn't hold storeMutex, which every miss takes
+    std::unique_ptr<FeatureStore> store;
+    juce::File storeDirectory;
+    mutable std::mutex storeMutex;
+    std::mutex storeWriteMutex;
+    
+    // Bumped by clear()/setSampleRate() so renders started earlier aren't inserted
+    std::atomic<uint32_t> generation{0};
+    
+    // Near-duplicate lookups (see setKeyTolerance)
+    std::atomic<float> keyTolerance{0.0f};
+    std::atomic<int> driftAuditInterval{64};
+    DriftStats drift;  // Guarded by driftMutex
+    mutable std::mutex driftMutex;
+    
+    // Background renders for prefetch(), started on first use (guarded by prefetchMutex)
+    class PrefetchThread;
+    static constexpr size_t maxPrefetchQueue = 256;
+    std::unique_ptr<PrefetchThread> prefetchThread;
+    std::mutex prefetchMutex;
+    std::atomic<size_t> prefetchedCount{0};
+    
+    std::atomic<size_t> cacheHits{0};
+    std::atomic<size_t> cacheMisses{0};
+    std::atomic<size_t> cacheEvictions{0};
+    std::atomic<size_t> inFlightJoins{0};
+    
+    // Miss cost, in microseconds so it fits an atomic integer
+    std::atomic<uint64_t> totalRenderMicros{0};
+    std::array<std::atomic<size_t>, RENDER_HISTOGRAM_BINS> renderHistogram {};
+    void recordRenderTime(juce::int64 startTicks, int numRendered);
     
     // Normalization ranges (empirically derived)
     static constexpr float mfccMin = -50.0f;
@@ -72,10 +389,38 @@ private:
     static constexpr float rmsMin = 0.0f;
     static constexpr float rmsMax = 0.3f;
     
-    size_t hashGenome(const std::vector<float>& genome) const;
-    std::vector<float> extractFeatures(const std::vector<float>& genome);
-    void normalizeFeatures(std::vector<float>& features);
-    void evictLRU();
+    static size_t hashGenome(const float* genome, int genomeSize);
+    
+    // hasCached for a HeadlessParam::COUNT genome
+    bool isCached(const float* genome) const;
+    
+    // Cached lookups on exactly these genomes (getFeatures* after any snapping)
+    std::vector<float> getExactFeatures(const std::vector<float>& genome);
+    void getExactFeaturesBatch(const float* genomes, int numGenomes, int genomeSize, float* featuresOut);
+    
+    // Snaps a HeadlessParam::COUNT genome to its tolerance cell's centre
+    static void quantizeGenome(const float* genome, float tolerance, float* keyOut);
+    // Counts a snapped lookup and, every audit interval, measures its error
+    void noteApproximation(const float* genome, const float* approximateFeatures);
+    void extractFeatures(const std::vector<float>& genome, RenderContext& context, float* featuresOut);
+    // Streams the first numSamples of the phrase through the extractor (parameters already set)
+    void streamFeatures(RenderContext& context, int numSamples, float* featuresOut);
+    
+    // Cache bookkeeping (locks the genome's shard); other genome sizes are never cached
+    static size_t shardIndex(size_t hash);
+    
+    // A miss either joins the render already in flight or claims the genome,
+    // and the claimant must then insert() it (with its claim) exactly once
+    enum class Lookup { hit, joined, claimed };
+    Lookup findOrClaim(const float* genome, int genomeSize, float* featuresOut, std::shared_ptr<InFlightRender>& claimOut);
+    void insert(const float* genome, int genomeSize, const float* features, uint32_t renderGeneration,
+                const std::shared_ptr<InFlightRender>& claim);
+    static void normalizeFeatures(float* features);
+    
+    // Persistent store: reopened for the current config; lookup and write-through
+    void openStore();
+    bool findStored(const float* genome, int genomeSize, float* featuresOut) const;
+    void persist(const float* genomes, int numGenomes, int genomeSize, const float* features, uint32_t renderGeneration);
     
     static float normalizeValue(float value, float min, float max);
 };
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+    CpuBudget.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "CpuBudget.h"
+#include <algorithm>
+#include <cmath>
+
+float CpuBudget::getBackoffFactor() const
+{
+    const float load = audioLoad.load();
+    if (load <= backoffLoad)
+        return 1.0f;
+
+    // Linear from the full budget at backoffLoad to minimumShare at the deadline
+    const float t = std::min((load - backoffLoad) / (1.0f - backoffLoad), 1.0f);
+    return minimumShare + (1.0f - t) * (1.0f - minimumShare);
+}
+
+int CpuBudget::capThreads(int maxThreads) const
+{
+    const float cores = budgetCores.load();
+    if (cores <= 0.0f)
+        return maxThreads;
+
+    return std::clamp(static_cast<int>(std::ceil(cores)), 1, std::max(1, maxThreads));
+}
+
+double CpuBudget::getPauseSeconds(double busySeconds, int numThreads) const
+{
+    if (busySeconds <= 0.0 || numThreads < 1)
+        return 0.0;
+
+    // Unlimited counts as every thread running flat out
+    const float cores = budgetCores.load();
+    const double allowed = (cores > 0.0f ? cores : static_cast<float>(numThreads)) * getBackoffFactor();
+
+    if (allowed >= numThreads)
+        return 0.0;
+
+    // busy * threads core-seconds spread over busy + pause seconds averages allowed cores
+    return std::min(busySeconds * (numThreads / allowed - 1.0), maxPauseSeconds);
+}
+
+void CpuBudget::pause(juce::Thread& thread, double pauseSeconds)
+{
+    const int ms = static_cast<int>(pauseSeconds * 1000.0);
+    if (ms > 0 && !thread.threadShouldExit())
+        thread.wait(ms);
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+    CpuBudget.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Duty-cycle limit for background work. A budget is an average number of
+    cores, summed over the threads doing the work: 0.5 lets the GA use half
+    of one core, 2 lets it use two. After each unit of work the thread
+    idles for long enough to bring its average down to the budget. The
+    budget also shrinks while the audio thread is close to its deadline,
+    so GA and training work yields to audio even when no budget is set.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+class CpuBudget
+{
+public:
+    static constexpr float backoffLoad = 0.5f;      // Audio deadline load where background work starts yielding
+    static constexpr float minimumShare = 0.05f;    // Share of the budget left at full audio load
+    static constexpr double maxPauseSeconds = 1.0;  // Longest single pause, so work never stalls outright
+
+    // Average cores the work may use; 0 = unlimited (audio backoff still applies)
+    void setCores(float cores) { budgetCores.store(cores > 0.0f ? cores : 0.0f); }
+    float getCores() const { return budgetCores.load(); }
+
+    // Audio thread load as a fraction of its deadline (AudioLoadMeter's average)
+    void setAudioLoad(float load) { audioLoad.store(load); }
+    float getAudioLoad() const { return audioLoad.load(); }
+
+    // Share of the budget left after backing off for audio load, in [minimumShare, 1]
+    float getBackoffFactor() const;
+
+    // maxThreads capped to the whole cores the budget covers (at least one)
+    int capThreads(int maxThreads) const;
+
+    // Idle time that keeps busySeconds of work on numThreads threads within budget
+    double getPauseSeconds(double busySeconds, int numThreads) const;
+
+    // Waits pauseSeconds on thread's event, so notify() or stopThread() ends it early
+    static void pause(juce::Thread& thread, double pauseSeconds);
+
+private:
+    std::atomic<float> budgetCores { 0.0f };
+    std::atomic<float> audioLoad { 0.0f };
+};
@@ -10,24 +10,32 @@
 
 #include "CrossoverOperators.h"
 
-Individual UniformCrossover::operator()(const Individual& parent1, 
-                                       const Individual& parent2, 
-                                       juce::Random& rng) const
+Individual UniformCrossover::operator()(const IndividualView& parent1, 
+                                       const IndividualView& parent2, 
+                                       RandomStream& rng) const
 {
     const int paramCount = parent1.getParameterCount();
     
     // Create offspring with same parameter count
     Individual offspring(paramCount);
+    (*this)(parent1, parent2, offspring.getParameters().data(), rng);
+    
+    // Offspring starts with invalidated fitness (needs evaluation)
+    return offspring;
+}
+
+void UniformCrossover::operator()(const IndividualView& parent1,
+                                  const IndividualView& parent2,
+                                  float* offspringOut,
+                                  RandomStream& rng) const
+{
+    const int paramCount = parent1.getParameterCount();
     
     // Uniform crossover: randomly pick each parameter from either parent
     for (int i = 0; i < paramCount; ++i)
     {
-        float value = (rng.nextBool()) ? parent1.getParameter(i) 
-                                       : parent2.getParameter(i);
-        offspring.setParameter(i, value);
+        offspringOut[i] = (rng.nextBool()) ? parent1.getParameter(i)
+                                           : parent2.getParameter(i);
     }
-    
-    // Offspring starts with invalidated fitness (needs evaluation)
-    return offspring;
 }
 
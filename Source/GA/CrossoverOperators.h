@@ -12,6 +12,7 @@
 
 #include <juce_core/juce_core.h>
 #include "Individual.h"
+#include "RandomStream.h"
 
 //==============================================================================
 /**
@@ -20,8 +21,14 @@
 */
 struct UniformCrossover
 {
-    Individual operator()(const Individual& parent1, 
-                         const Individual& parent2, 
-                         juce::Random& rng) const;
+    Individual operator()(const IndividualView& parent1, 
+                         const IndividualView& parent2, 
+                         RandomStream& rng) const;
+    
+    // In-place variant: writes parent1.getParameterCount() values to offspringOut
+    void operator()(const IndividualView& parent1,
+                    const IndividualView& parent2,
+                    float* offspringOut,
+                    RandomStream& rng) const;
 };
 
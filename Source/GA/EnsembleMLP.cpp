@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+    EnsembleMLP.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "EnsembleMLP.h"
+#include <algorithm>
+
+template <int InputSize, int HiddenSize, int NumHeads>
+EnsembleMLP<InputSize, HiddenSize, NumHeads>::EnsembleMLP(uint64_t seed)
+    : bootstrapRng(seed, bootstrapStream)
+{
+    // Xavier initialization per head for input->hidden; every head's output
+    // layer starts at zero, so the ensemble starts at exactly 0.5 with no spread
+    RandomStream gen(seed, weightStream);
+    const float scaleIH = std::sqrt(2.0f / (InputSize + HiddenSize));
+    std::uniform_real_distribution<float> distIH(-scaleIH, scaleIH);
+
+    for (int i = 0; i < weightsIHSize; ++i)
+        parameters[i] = distIH(gen);
+}
+
+template <int InputSize, int HiddenSize, int NumHeads>
+void EnsembleMLP<InputSize, HiddenSize, NumHeads>::hiddenLayer(const float* input, float* hidden) const
+{
+    std::copy(parameters.begin() + biasHOffset, parameters.begin() + weightsHOOffset, hidden);
+
+    // Every head's units in one broadcast multiply-add per input
+    for (int i = 0; i < InputSize; ++i)
+    {
+        const float x = input[i];
+        const float* w = parameters.data() + i * width;
+
+        for (int j = 0; j < width; ++j)
+            hidden[j] += x * w[j];
+    }
+}
+
+template <int InputSize, int HiddenSize, int NumHeads>
+void EnsembleMLP<InputSize, HiddenSize, NumHeads>::headOutputs(const float* hidden, float* outputs) const
+{
+    const float* weightsHO = parameters.data() + weightsHOOffset;
+
+    for (int k = 0; k < NumHeads; ++k)
+    {
+        float sum = parameters[biasOOffset + k];
+        for (int j = k * HiddenSize; j < (k + 1) * HiddenSize; ++j)
+            sum += (hidden[j] > 0.0f ? hidden[j] : 0.0f) * weightsHO[j];
+
+        outputs[k] = sigmoid(sum);
+    }
+}
+
+template <int InputSize, int HiddenSize, int NumHeads>
+void EnsembleMLP<InputSize, HiddenSize, NumHeads>::predictBatch(const float* inputs, int numSamples,
+                                                                float* meanOut, float* varianceOut) const
+{
+    std::array<float, width> hidden;
+    std::array<float, NumHeads> outputs;
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        hiddenLayer(inputs + static_cast<size_t>(n) * InputSize, hidden.data());
+        headOutputs(hidden.data(), outputs.data());
+
+        float mean = 0.0f;
+        for (float output : outputs)
+            mean += output;
+        mean /= NumHeads;
+
+        float variance = 0.0f;
+        for (float output : outputs)
+            variance += (output - mean) * (output - mean);
+
+        meanOut[n] = mean;
+        varianceOut[n] = variance / NumHeads;
+    }
+}
+
+template <int InputSize, int HiddenSize, int NumHeads>
+void EnsembleMLP<InputSize, HiddenSize, NumHeads>::trainBatch(const float* inputs, int numSamples, const float* targets,
+                                                              const float* sampleWeights, float learningRate)
+{
+    if (numSamples <= 0)
+        return;
+
+    gradients.fill(0.0f);
+    float* gradIH = gradients.data();
+    float* gradBiasH = gradients.data() + biasHOffset;
+    float* gradHO = gradients.data() + weightsHOOffset;
+    float* gradBiasO = gradients.data() + biasOOffset;
+    const float* weightsHO = parameters.data() + weightsHOOffset;
+
+    std::poisson_distribution<int> bootstrap(1.0);
+    std::array<float, tileSize * width> tile;
+    std::array<float, NumHeads> outputs;
+
+    for (int start = 0; start < numSamples; start += tileSize)
+    {
+        const int count = std::min(tileSize, numSamples - start);
+
+        for (int n = 0; n < count; ++n)
+            hiddenLayer(inputs + static_cast<size_t>(start + n) * InputSize, tile.data() + n * width);
+
+        for (int n = 0; n < count; ++n)
+        {
+            const float* input = inputs + static_cast<size_t>(start + n) * InputSize;
+            float* h = tile.data() + n * width;
+            headOutputs(h, outputs.data());
+
+            for (int k = 0; k < NumHeads; ++k)
+            {
+                const float resampled = static_cast<float>(bootstrap(bootstrapRng));
+                float dOutput = (outputs[k] - targets[start + n]) * sampleWeights[start + n] * resampled;
+                dOutput = std::clamp(dOutput, -gradClipThreshold, gradClipThreshold);
+
+                gradBiasO[k] += dOutput;
+
+                // Hidden deltas overwrite the pre-activations, which aren't needed after this
+                for (int j = k * HiddenSize; j < (k + 1) * HiddenSize; ++j)
+                {
+                    const bool active = h[j] > 0.0f;
+                    gradHO[j] += dOutput * (active ? h[j] : 0.0f);
+                    h[j] = active ? dOutput * weightsHO[j] : 0.0f;
+                }
+            }
+
+            for (int j = 0; j < width; ++j)
+                gradBiasH[j] += h[j];
+
+            for (int i = 0; i < InputSize; ++i)
+            {
+                const float x = input[i];
+                float* g = gradIH + i * width;
+
+                for (int j = 0; j < width; ++j)
+                    g[j] += x * h[j];
+            }
+        }
+    }
+
+    // One Adam step on the mean gradient
+    ++timestep;
+    const float bc1 = 1.0f - std::pow(beta1, timestep);
+    const float bc2 = 1.0f - std::pow(beta2, timestep);
+    const float scale = 1.0f / static_cast<float>(numSamples);
+
+    auto adamSteps = [&](int begin, int end, float decay)
+    {
+        for (int p = begin; p < end; ++p)
+        {
+            const float grad = gradients[p] * scale;
+            m[p] = beta1 * m[p] + (1.0f - beta1) * grad;
+            v[p] = beta2 * v[p] + (1.0f - beta2) * grad * grad;
+            const float mHat = m[p] / bc1;
+            const float vHat = v[p] / bc2;
+            parameters[p] -= learningRate * (mHat / (std::sqrt(vHat) + epsilon) + decay * parameters[p]);
+        }
+    };
+
+    // Weights decay; biases don't
+    adamSteps(0, biasHOffset, weightDecay);
+    adamSteps(biasHOffset, weightsHOOffset, 0.0f);
+    adamSteps(weightsHOOffset, biasOOffset, weightDecay);
+    adamSteps(biasOOffset, parameterCount, 0.0f);
+}
+
+template <int InputSize, int HiddenSize, int NumHeads>
+std::vector<float> EnsembleMLP<InputSize, HiddenSize, NumHeads>::getWeights() const
+{
+    std::vector<float> weights;
+    weights.reserve(getWeightCount());
+
+    weights.insert(weights.end(), parameters.begin(), parameters.end());
+    weights.insert(weights.end(), m.begin(), m.end());
+    weights.insert(weights.end(), v.begin(), v.end());
+    weights.push_back(static_cast<float>(timestep));
+
+    return weights;
+}
+
+template <int InputSize, int HiddenSize, int NumHeads>
+bool EnsembleMLP<InputSize, HiddenSize, NumHeads>::setWeights(const std::vector<float>& weights)
+{
+    if (static_cast<int>(weights.size()) != getWeightCount())
+        return false;
+
+    auto next = weights.begin();
+    for (Parameters* block : { &parameters, &m, &v })
+    {
+        std::copy(next, next + parameterCount, block->begin());
+        next += parameterCount;
+    }
+
+    timestep = static_cast<int>(*next);
+
+    return true;
+}
+
+template class EnsembleMLP<17, 16, 4>;
+template class EnsembleMLP<24, 16, 4>;
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+    EnsembleMLP.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    NumHeads small MLPs sharing one fused forward pass, for uncertainty
+    estimates. The heads' hidden layers are stacked side by side into a
+    single InputSize x (NumHeads * HiddenSize) weight matrix, so scoring K
+    heads costs one wider matrix pass rather than K separate ones. Each head
+    trains on its own online bootstrap of every batch (Poisson(1) sample
+    weights), so the heads disagree where the data doesn't pin them down and
+    the spread of their predictions measures the model's uncertainty.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RandomStream.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template <int InputSize, int HiddenSize, int NumHeads>
+class EnsembleMLP
+{
+public:
+    // Weights and bootstraps are both drawn from the seed
+    explicit EnsembleMLP(uint64_t seed = 0);
+
+    static constexpr int getInputSize() { return InputSize; }
+    static constexpr int getNumHeads() { return NumHeads; }
+
+    /**
+     * Fused forward pass over a row-major numSamples x InputSize matrix,
+     * writing the mean and variance of the heads' predictions per row.
+     * Writes no state, so it is safe to call concurrently.
+     */
+    void predictBatch(const float* inputs, int numSamples, float* meanOut, float* varianceOut) const;
+
+    /**
+     * One Adam step per head on its bootstrap of the batch. Heads see each
+     * sample a Poisson(1) number of times on top of its sample weight, and
+     * output gradients are clipped as in MLP.
+     */
+    void trainBatch(const float* inputs, int numSamples, const float* targets,
+                    const float* sampleWeights, float learningRate = 0.05f);
+
+    // Flat parameters then Adam moments then timestep, like MLP
+    std::vector<float> getWeights() const;
+
+    // Returns true if size matches, false otherwise
+    bool setWeights(const std::vector<float>& weights);
+
+    static constexpr int getWeightCount() { return 3 * parameterCount + 1; }
+
+private:
+    static constexpr int width = NumHeads * HiddenSize;  // Stacked hidden units
+    static constexpr int weightsIHSize = InputSize * width;
+    static constexpr int parameterCount = weightsIHSize + width + width + NumHeads;
+
+    // Samples whose hidden layer is held at once; longer batches run in tiles
+    static constexpr int tileSize = width <= 256 ? 1024 / width : 1;
+
+    // All parameters in one block (weightsIH, biasH, weightsHO, biasO), so the
+    // Adam update is one flat loop; weightsIH is input-major over stacked units
+    using Parameters = std::array<float, parameterCount>;
+    Parameters parameters {};
+    Parameters m {}, v {};
+    Parameters gradients {};  // Summed mini-batch gradients (reused)
+    int timestep = 0;
+
+    RandomStream bootstrapRng;
+    static constexpr uint64_t weightStream = 0, bootstrapStream = 1;  // Split from the seed
+
+    static constexpr int biasHOffset = weightsIHSize;
+    static constexpr int weightsHOOffset = biasHOffset + width;
+    static constexpr int biasOOffset = weightsHOOffset + width;
+
+    // Adam hyperparameters (as MLP)
+    static constexpr float beta1 = 0.9f;
+    static constexpr float beta2 = 0.999f;
+    static constexpr float epsilon = 1e-8f;
+    static constexpr float weightDecay = 1e-4f;
+    static constexpr float gradClipThreshold = 1.0f;
+
+    void hiddenLayer(const float* input, float* hidden) const;
+    void headOutputs(const float* hidden, float* outputs) const;
+
+    static float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+};
+
+extern template class EnsembleMLP<17, 16, 4>;
+extern template class EnsembleMLP<24, 16, 4>;
+
+using GenomeEnsemble = EnsembleMLP<17, 16, 4>;  // Genome parameters in
+using AudioEnsemble = EnsembleMLP<24, 16, 4>;   // Audio features in
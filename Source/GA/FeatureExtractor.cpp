@@ -7,142 +7,328 @@
 */
 
 #include "FeatureExtractor.h"
+#include "WorkerPool.h"
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 
-FeatureExtractor::FeatureExtractor(double sampleRate, int fftSize)
+namespace
+{
+    // Spectral kernels keep one accumulator per lane so the compiler can
+    // vectorise them; lanes are summed at the end
+    constexpr int kernelLanes = 8;
+    
+    float dotProduct(const float* a, const float* b, int n)
+    {
+        alignas(32) float lanes[kernelLanes] = {};
+        
+        int i = 0;
+        for (; i + kernelLanes <= n; i += kernelLanes)
+            for (int j = 0; j < kernelLanes; ++j)
+                lanes[j] += a[i + j] * b[i + j];
+        
+        float sum = 0.0f;
+        for (int j = 0; j < kernelLanes; ++j)
+            sum += lanes[j];
+        for (; i < n; ++i)
+            sum += a[i] * b[i];
+        
+        return sum;
+    }
+}
+
+FeatureExtractor::FeatureExtractor(double sampleRate, int fftSize, int hopSize)
     : sampleRate(sampleRate)
     , fftSize(fftSize)
-    , hopSize(fftSize / 4)  // 75% overlap for good temporal resolution
+    , hopSize(hopSize > 0 ? hopSize : fftSize / 4)  // 75% overlap for good temporal resolution
     , numMelBands(26)
-    , fft(static_cast<int>(std::log2(fftSize)))
+    , scratch(fftSize, numMelBands)
 {
     // Pre-allocate all buffers
-    fftData.resize(fftSize * 2, 0.0f);
     window.resize(fftSize);
-    magnitude.resize(fftSize / 2 + 1);
-    melEnergies.resize(numMelBands);
-    
-    // Note: mfccFrames and centroidFrames are reserved dynamically in extractFeatures
-    // based on actual audio buffer size
+    ring.resize(fftSize, 0.0f);
+    attackFloor.reserve(fftSize);  // Only rising ramps longer than this grow it
     
     // Hann window
     for (int i = 0; i < fftSize; ++i)
         window[i] = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (fftSize - 1)));
     
     initializeMelFilterbank();
+    initializeDCTBasis();
+}
+
+FeatureExtractor::FrameScratch::FrameScratch(int fftSize, int numMelBands)
+    : fft(static_cast<int>(std::log2(fftSize)))
+    , fftData(static_cast<size_t>(fftSize * 2), 0.0f)
+    , magnitude(static_cast<size_t>(fftSize / 2 + 1))
+    , melEnergies(static_cast<size_t>(numMelBands))
+{
 }
 
 FeatureVector FeatureExtractor::extractFeatures(const juce::AudioBuffer<float>& audio)
 {
+    return extractFeatures(audio.getReadPointer(0), audio.getNumSamples());
+}
+
+FeatureVector FeatureExtractor::extractFeatures(const float* audioData, int numSamples)
+{
+    beginStream();
+    pushSamples(audioData, numSamples);
+    return finishStream();
+}
+
+void FeatureExtractor::beginStream()
+{
+    ringPos = 0;
+    streamedSamples = 0;
+    nextFrameEnd = fftSize;
+    sumSquares = 0.0f;
+    peakAmp = 0.0f;
+    peakIndex = 0;
+    attackStart = 0;
+    attackFloor.clear();
+    frameStats = {};
+}
+
+void FeatureExtractor::pushSamples(const float* samples, int numSamples)
+{
+    while (numSamples > 0)
+    {
+        // Stop at each frame boundary so the ring holds exactly that frame
+        const int chunk = std::min(numSamples, nextFrameEnd - streamedSamples);
+        trackSamples(samples, chunk);
+        
+        for (int i = 0; i < chunk; ++i)
+        {
+            ring[static_cast<size_t>(ringPos)] = samples[i];
+            if (++ringPos == fftSize)
+                ringPos = 0;
+        }
+        
+        samples += chunk;
+        numSamples -= chunk;
+        
+        if (streamedSamples == nextFrameEnd)
+        {
+            // Oldest sample sits at ringPos: unwrap into two runs
+            analyseFrame(scratch, ring.data() + ringPos, fftSize - ringPos, ring.data(), ringPos, frameStats);
+            nextFrameEnd += hopSize;
+        }
+    }
+}
+
+FeatureVector FeatureExtractor::finishStream()
+{
+    // Shorter than one frame: analyse what we have, zero padded
+    if (frameStats.centroid.count == 0)
+        analyseFrame(scratch, ring.data(), streamedSamples, nullptr, 0, frameStats);
+    
     FeatureVector features;
     
-    // Extract temporal features (computed over entire audio)
-    features.rmsEnergy = computeRMSEnergy(audio);
-    features.attackTime = computeAttackTime(audio);
+    // Temporal features (over the whole signal)
+    features.rmsEnergy = streamedSamples > 0 ? std::sqrt(sumSquares / streamedSamples) : 0.0f;
+    features.attackTime = peakAmp < 0.001f ? 0.0f : (peakIndex - attackStart) / (float)sampleRate;
     
-    // Extract spectral features over multiple frames
-    extractMultiFrameFeatures(audio, features);
+    // Spectral features: mean and standard deviation across frames
+    for (int i = 0; i < 10; ++i)
+    {
+        features.mfccMean[i] = frameStats.mfcc[i].getMean();
+        features.mfccStd[i] = frameStats.mfcc[i].getStd();
+    }
+    features.spectralCentroidMean = frameStats.centroid.getMean();
+    features.spectralCentroidStd = frameStats.centroid.getStd();
     
     return features;
 }
 
-void FeatureExtractor::computeFFT(const float* audioData, int startSample, int numSamples)
+FeatureVector FeatureExtractor::extractFeatures(const float* audioData, int numSamples, WorkerPool& pool)
 {
-    // Clear FFT data
-    std::fill(fftData.begin(), fftData.end(), 0.0f);
+    const int numFrames = numSamples >= fftSize ? (numSamples - fftSize) / hopSize + 1 : 0;
+    const int numTasks = std::min(pool.getNumSlots(), numFrames);
     
-    // Copy windowed audio to FFT buffer
-    int samplesToUse = std::min(fftSize, numSamples - startSample);
-    samplesToUse = std::max(0, samplesToUse);
+    // Nothing to split: the sequential analysis is the same work
+    if (numTasks <= 1)
+        return extractFeatures(audioData, numSamples);
     
-    for (int i = 0; i < samplesToUse; ++i)
-        fftData[i] = audioData[startSample + i] * window[i];
+    while (static_cast<int>(slotScratch.size()) < pool.getNumSlots() - 1)
+        slotScratch.push_back(std::make_unique<FrameScratch>(fftSize, numMelBands));
+    taskStats.resize(static_cast<size_t>(numTasks));
     
-    // Perform FFT
-    fft.performRealOnlyForwardTransform(fftData.data());
+    // Temporal features need every sample in order, so they run as one extra
+    // task beside the contiguous runs of frames
+    beginStream();
     
-    // Compute magnitude spectrum
-    for (int i = 0; i < (int)magnitude.size(); ++i)
+    pool.parallelFor(numTasks + 1, [&](int task, int slot)
     {
-        float real = fftData[i * 2];
-        float imag = fftData[i * 2 + 1];
-        magnitude[i] = std::sqrt(real * real + imag * imag);
-    }
-}
-
-float FeatureExtractor::computeSpectralCentroid()
-{
-    float weightedSum = 0.0f;
-    float sum = 0.0f;
-    const float freqPerBin = sampleRate / fftSize;
+        if (task == numTasks)
+        {
+            trackSamples(audioData, numSamples);
+            return;
+        }
+        
+        FrameScratch& frame = slot == 0 ? scratch : *slotScratch[static_cast<size_t>(slot - 1)];
+        FrameStats& stats = taskStats[static_cast<size_t>(task)];
+        stats = {};
+        
+        const int endFrame = numFrames * (task + 1) / numTasks;
+        for (int f = numFrames * task / numTasks; f < endFrame; ++f)
+            analyseFrame(frame, audioData + static_cast<size_t>(f) * hopSize, fftSize, nullptr, 0, stats);
+    });
     
-    // Compute weighted centroid (frequency * magnitude)
-    for (int i = 0; i < (int)magnitude.size(); ++i)
-    {
-        float mag = magnitude[i];
-        weightedSum += (i * freqPerBin) * mag;
-        sum += mag;
-    }
+    for (const auto& stats : taskStats)
+        frameStats.merge(stats);
     
-    return sum > 1e-10f ? weightedSum / sum : 0.0f;
+    return finishStream();
 }
 
-float FeatureExtractor::computeAttackTime(const juce::AudioBuffer<float>& audio)
+void FeatureExtractor::trackSamples(const float* samples, int numSamples)
 {
-    const int numSamples = audio.getNumSamples();
-    const float* audioData = audio.getReadPointer(0);
-    
-    // Single-pass algorithm: find peak and track where amplitude exceeds threshold
-    float peakAmp = 0.0f;
-    int peakIndex = 0;
-    
     for (int i = 0; i < numSamples; ++i)
     {
-        float amp = std::abs(audioData[i]);
+        const float x = samples[i];
+        const float amp = std::abs(x);
+        const int index = streamedSamples + i;
+        
+        sumSquares += x * x;
+        
+        // A new peak fixes its attack start now: the latest earlier sample at
+        // or below 5% of it (or the signal start), as a backwards search would find
         if (amp > peakAmp)
         {
             peakAmp = amp;
-            peakIndex = i;
+            peakIndex = index;
+            attackStart = latestSampleAtOrBelow(peakAmp * 0.05f);
         }
+        
+        // Samples no quieter than this one can never be the latest below a level again
+        while (!attackFloor.empty() && attackFloor.back().amplitude >= amp)
+            attackFloor.pop_back();
+        attackFloor.push_back({ index, amp });
     }
     
-    if (peakAmp < 0.001f)
-        return 0.0f;
+    streamedSamples += numSamples;
+}
+
+int FeatureExtractor::latestSampleAtOrBelow(float level) const
+{
+    // Amplitudes rise strictly along attackFloor, so the candidates at or
+    // below level form a prefix; its last entry is the latest such sample
+    auto it = std::upper_bound(attackFloor.begin(), attackFloor.end(), level,
+                               [](float l, const AttackCandidate& c) { return l < c.amplitude; });
+    return it == attackFloor.begin() ? 0 : std::prev(it)->index;
+}
+
+void FeatureExtractor::analyseFrame(FrameScratch& frame, const float* first, int firstCount,
+                                    const float* second, int secondCount, FrameStats& stats) const
+{
+    // Clear FFT data, then copy windowed audio into it
+    std::fill(frame.fftData.begin(), frame.fftData.end(), 0.0f);
+    
+    for (int i = 0; i < firstCount; ++i)
+        frame.fftData[i] = first[i] * window[i];
+    for (int i = 0; i < secondCount; ++i)
+        frame.fftData[firstCount + i] = second[i] * window[firstCount + i];
     
-    // Search backwards from peak to find start of attack
-    float threshold = peakAmp * 0.05f;
-    int startIndex = 0;
+    float frameCentroid = computeSpectrum(frame);
     
-    for (int i = peakIndex; i >= 0; --i)
+    std::array<float, 10> frameMFCCs;
+    computeMFCCs(frame, frameMFCCs);
+    
+    for (int i = 0; i < 10; ++i)
+        stats.mfcc[i].add(frameMFCCs[i]);
+    stats.centroid.add(frameCentroid);
+}
+
+void FeatureExtractor::RunningStats::add(float value)
+{
+    ++count;
+    sum += value;
+    
+    const double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+void FeatureExtractor::RunningStats::merge(const RunningStats& later)
+{
+    if (later.count == 0)
+        return;
+    
+    if (count == 0)
     {
-        if (std::abs(audioData[i]) <= threshold)
-        {
-            startIndex = i;
-            break;
-        }
+        *this = later;
+        return;
     }
     
-    // Attack time in seconds
-    return (peakIndex - startIndex) / (float)sampleRate;
+    // Chan et al. pairwise combination of the two runs' moments
+    const int total = count + later.count;
+    const double delta = later.mean - mean;
+    mean += delta * later.count / total;
+    m2 += later.m2 + delta * delta * (static_cast<double>(count) * later.count / total);
+    sum += later.sum;
+    count = total;
 }
 
-float FeatureExtractor::computeRMSEnergy(const juce::AudioBuffer<float>& audio)
+void FeatureExtractor::FrameStats::merge(const FrameStats& later)
 {
-    const int numSamples = audio.getNumSamples();
-    const float* audioData = audio.getReadPointer(0);
+    for (int i = 0; i < 10; ++i)
+        mfcc[i].merge(later.mfcc[i]);
+    centroid.merge(later.centroid);
+}
+
+float FeatureExtractor::RunningStats::getStd() const
+{
+    return count > 1 ? static_cast<float>(std::sqrt(m2 / (count - 1))) : 0.0f;
+}
+
+float FeatureExtractor::computeSpectrum(FrameScratch& frame) const
+{
+    // Perform FFT
+    frame.fft.performRealOnlyForwardTransform(frame.fftData.data());
+    
+    // Magnitude spectrum. Kept as its own loop: the strided real/imag loads
+    // only vectorise without a reduction in the same loop.
+    const int numBins = static_cast<int>(frame.magnitude.size());
+    const float* bins = frame.fftData.data();
+    float* mags = frame.magnitude.data();
+    
+    for (int i = 0; i < numBins; ++i)
+    {
+        float real = bins[i * 2];
+        float imag = bins[i * 2 + 1];
+        mags[i] = std::sqrt(real * real + imag * imag);
+    }
+    
+    // Centroid sums (frequency * magnitude) over the spectrum, still in cache
+    const float freqPerBin = static_cast<float>(sampleRate / fftSize);
+    alignas(32) float weightedLanes[kernelLanes] = {};
+    alignas(32) float sumLanes[kernelLanes] = {};
     
-    if (numSamples == 0)
-        return 0.0f;
+    int i = 0;
+    for (; i + kernelLanes <= numBins; i += kernelLanes)
+    {
+        for (int j = 0; j < kernelLanes; ++j)
+        {
+            weightedLanes[j] += static_cast<float>(i + j) * freqPerBin * mags[i + j];
+            sumLanes[j] += mags[i + j];
+        }
+    }
     
-    // Compute sum of squares
+    float weightedSum = 0.0f;
     float sum = 0.0f;
-    for (int i = 0; i < numSamples; ++i)
+    for (int j = 0; j < kernelLanes; ++j)
     {
-        float sample = audioData[i];
-        sum += sample * sample;
+        weightedSum += weightedLanes[j];
+        sum += sumLanes[j];
     }
     
-    return std::sqrt(sum / numSamples);
+    for (; i < numBins; ++i)
+    {
+        weightedSum += static_cast<float>(i) * freqPerBin * mags[i];
+        sum += mags[i];
+    }
+    
+    return sum > 1e-10f ? weightedSum / sum : 0.0f;
 }
 
 void FeatureExtractor::initializeMelFilterbank()
@@ -152,9 +338,10 @@ void FeatureExtractor::initializeMelFilterbank()
     float minMel = hzToMel(0.0f);
     float maxMel = hzToMel(sampleRate / 2.0f);
     
-    melFilters.resize(numMelBands);
+    melBands.resize(numMelBands);
     
     const float minWeight = 1e-6f;  // Ignore near-zero weights
+    const int numBins = fftSize / 2 + 1;
     
     // Create filter bank with proper boundary handling
     for (int i = 0; i < numMelBands; ++i)
@@ -174,15 +361,19 @@ void FeatureExtractor::initializeMelFilterbank()
         int rightBin = static_cast<int>(rightHz * fftSize / sampleRate);
         
         // Clamp to valid range
-        leftBin = std::max(0, std::min(leftBin, (int)magnitude.size() - 1));
-        centerBin = std::max(0, std::min(centerBin, (int)magnitude.size() - 1));
-        rightBin = std::max(0, std::min(rightBin, (int)magnitude.size() - 1));
+        leftBin = std::max(0, std::min(leftBin, numBins - 1));
+        centerBin = std::max(0, std::min(centerBin, numBins - 1));
+        rightBin = std::max(0, std::min(rightBin, numBins - 1));
         
-        // Reserve approximate space (triangular filter typically spans 50-150 bins)
-        melFilters[i].indices.reserve(rightBin - leftBin + 1);
-        melFilters[i].weights.reserve(rightBin - leftBin + 1);
+        // Build triangular filter over [leftBin, rightBin], then trim to the
+        // span of non-negligible weights
+        auto& band = melBands[i];
+        band.startBin = leftBin;
+        band.weights.assign(rightBin - leftBin + 1, 0.0f);
+        
+        int firstBin = rightBin + 1;
+        int lastBin = leftBin - 1;
         
-        // Build triangular filter, storing only non-zero values
         for (int j = leftBin; j <= rightBin; ++j)
         {
             float freq = j * sampleRate / fftSize;
@@ -199,172 +390,68 @@ void FeatureExtractor::initializeMelFilterbank()
                 weight = (denom > 0.0f) ? (rightHz - freq) / denom : 0.0f;
             }
             
-            // Only store non-negligible weights
+            // Negligible weights stay zero inside the run
             if (weight > minWeight)
             {
-                melFilters[i].indices.push_back(j);
-                melFilters[i].weights.push_back(weight);
+                band.weights[j - leftBin] = weight;
+                firstBin = std::min(firstBin, j);
+                lastBin = std::max(lastBin, j);
             }
         }
+        
+        if (lastBin < firstBin)
+        {
+            band.weights.clear();  // Empty band (collapsed at low frequencies)
+            continue;
+        }
+        
+        band.weights.erase(band.weights.begin() + (lastBin - leftBin + 1), band.weights.end());
+        band.weights.erase(band.weights.begin(), band.weights.begin() + (firstBin - leftBin));
+        band.startBin = firstBin;
     }
 }
 
-void FeatureExtractor::applyMelFilterbank(std::vector<float>& melEnergies)
+void FeatureExtractor::applyMelFilterbank(FrameScratch& frame) const
 {
     // No allocation - assumes melEnergies is already sized correctly
-    // Use sparse representation: only process non-zero filter coefficients
     for (int i = 0; i < numMelBands; ++i)
     {
-        float energy = 0.0f;
-        const auto& filter = melFilters[i];
-        
-        // Iterate only over non-zero filter coefficients (typically ~50-150 vs ~1024)
-        for (size_t k = 0; k < filter.indices.size(); ++k)
-            energy += magnitude[filter.indices[k]] * filter.weights[k];
+        // Dense run over the band's own bins (typically ~50-150 vs ~1024)
+        const auto& band = melBands[i];
+        float energy = dotProduct(frame.magnitude.data() + band.startBin, band.weights.data(),
+                                  static_cast<int>(band.weights.size()));
         
         // Log compression
-        melEnergies[i] = std::log(energy + 1e-10f);
+        frame.melEnergies[i] = std::log(energy + 1e-10f);
     }
 }
 
-void FeatureExtractor::applyDCT(const std::vector<float>& melEnergies, std::array<float, 10>& mfccs)
+void FeatureExtractor::initializeDCTBasis()
 {
-    // Discrete Cosine Transform to get MFCCs
+    // Same float expression the per-frame DCT used, so MFCCs are unchanged
+    dctBasis.resize(static_cast<size_t>(10 * numMelBands));
     for (int i = 0; i < 10; ++i)
-    {
-        mfccs[i] = 0.0f;
         for (int j = 0; j < numMelBands; ++j)
-        {
-            mfccs[i] += melEnergies[j] * std::cos(juce::MathConstants<float>::pi * i * (j + 0.5f) / numMelBands);
-        }
-    }
-}
-
-void FeatureExtractor::computeMFCCs(std::array<float, 10>& mfccs)
-{
-    // Use pre-allocated member variable for zero-allocation runtime
-    applyMelFilterbank(melEnergies);
-    applyDCT(melEnergies, mfccs);
-}
-
-void FeatureExtractor::extractMultiFrameFeatures(const juce::AudioBuffer<float>& audio, FeatureVector& features)
-{
-    const int numSamples = audio.getNumSamples();
-    const float* audioData = audio.getReadPointer(0);
-    
-    // Calculate exactly how many frames we need for this audio buffer
-    int numFrames = (numSamples / hopSize) + 1;
-    
-    // Reserve space if needed (only reallocates if buffer grew)
-    if (numFrames > (int)mfccFrames.capacity())
-    {
-        mfccFrames.reserve(numFrames);
-        centroidFrames.reserve(numFrames);
-    }
-    
-    // Clear frame storage (reuse allocated memory)
-    mfccFrames.clear();
-    centroidFrames.clear();
-    
-    // Process overlapping frames across the entire audio
-    for (int startSample = 0; startSample + fftSize <= numSamples; startSample += hopSize)
-    {
-        // Compute FFT for this frame
-        computeFFT(audioData, startSample, numSamples);
-        
-        // Extract features from this frame
-        std::array<float, 10> frameMFCCs;
-        computeMFCCs(frameMFCCs);
-        mfccFrames.push_back(frameMFCCs);
-        
-        float frameCentroid = computeSpectralCentroid();
-        centroidFrames.push_back(frameCentroid);
-    }
-    
-    // If we didn't get any frames, handle edge case
-    if (mfccFrames.empty())
-    {
-        // Fall back to single frame from center of audio
-        int startSample = std::max(0, (numSamples - fftSize) / 2);
-        computeFFT(audioData, startSample, numSamples);
-        
-        std::array<float, 10> frameMFCCs;
-        computeMFCCs(frameMFCCs);
-        mfccFrames.push_back(frameMFCCs);
-        
-        float frameCentroid = computeSpectralCentroid();
-        centroidFrames.push_back(frameCentroid);
-    }
-    
-    // Compute mean and standard deviation across all frames
-    computeMeanAndStd(mfccFrames, features.mfccMean, features.mfccStd);
-    computeMeanAndStd(centroidFrames, features.spectralCentroidMean, features.spectralCentroidStd);
+            dctBasis[static_cast<size_t>(i * numMelBands + j)] =
+                std::cos(juce::MathConstants<float>::pi * i * (j + 0.5f) / numMelBands);
 }
 
-void FeatureExtractor::computeMeanAndStd(const std::vector<std::array<float, 10>>& frames,
-                                         std::array<float, 10>& mean, std::array<float, 10>& std)
+void FeatureExtractor::applyDCT(const std::vector<float>& melEnergies, std::array<float, 10>& mfccs) const
 {
-    const int numFrames = static_cast<int>(frames.size());
-    if (numFrames == 0)
-    {
-        mean.fill(0.0f);
-        std.fill(0.0f);
-        return;
-    }
-    
-    // Compute mean for each coefficient
-    mean.fill(0.0f);
-    for (const auto& frame : frames)
+    // Discrete Cosine Transform to get MFCCs: basis matrix times log mel energies
+    const float* row = dctBasis.data();
+    for (int i = 0; i < 10; ++i, row += numMelBands)
     {
-        for (int i = 0; i < 10; ++i)
-            mean[i] += frame[i];
-    }
-    for (int i = 0; i < 10; ++i)
-        mean[i] /= numFrames;
-    
-    // Compute standard deviation for each coefficient
-    std.fill(0.0f);
-    if (numFrames > 1)
-    {
-        for (const auto& frame : frames)
-        {
-            for (int i = 0; i < 10; ++i)
-            {
-                float diff = frame[i] - mean[i];
-                std[i] += diff * diff;
-            }
-        }
-        for (int i = 0; i < 10; ++i)
-            std[i] = std::sqrt(std[i] / (numFrames - 1));
+        float sum = 0.0f;
+        for (int j = 0; j < numMelBands; ++j)
+            sum += melEnergies[j] * row[j];
+        mfccs[i] = sum;
     }
 }
 
-void FeatureExtractor::computeMeanAndStd(const std::vector<float>& values, float& mean, float& std)
+void FeatureExtractor::computeMFCCs(FrameScratch& frame, std::array<float, 10>& mfccs) const
 {
-    const int numValues = static_cast<int>(values.size());
-    if (numValues == 0)
-    {
-        mean = 0.0f;
-        std = 0.0f;
-        return;
-    }
-    
-    // Compute mean
-    mean = 0.0f;
-    for (float value : values)
-        mean += value;
-    mean /= numValues;
-    
-    // Compute standard deviation
-    std = 0.0f;
-    if (numValues > 1)
-    {
-        for (float value : values)
-        {
-            float diff = value - mean;
-            std += diff * diff;
-        }
-        std = std::sqrt(std / (numValues - 1));
-    }
+    // Use the frame's pre-allocated buffers for zero-allocation runtime
+    applyMelFilterbank(frame);
+    applyDCT(frame.melEnergies, mfccs);
 }
-
@@ -6,6 +6,9 @@
 
     Efficient audio feature extraction for GA fitness evaluation.
     Pre-allocates all buffers for zero-allocation runtime performance.
+    Audio can be pushed in blocks as it is rendered; frames are analysed
+    as they complete, so memory is O(fftSize) rather than O(signal).
+    A whole buffer can instead have its frames split across a WorkerPool.
   ==============================================================================
 */
 
@@ -13,6 +16,9 @@
 
 #include <juce_dsp/juce_dsp.h>
 #include <array>
+#include <memory>
+
+class WorkerPool;
 
 // Lightweight feature vector for audio comparison
 // Captures both average characteristics and temporal variation
@@ -39,53 +45,131 @@ struct FeatureVector
 class FeatureExtractor
 {
 public:
-    FeatureExtractor(double sampleRate, int fftSize = 2048);
+    // hopSize 0 uses fftSize / 4 (75% overlap)
+    FeatureExtractor(double sampleRate, int fftSize = 2048, int hopSize = 0);
     
     // Extract all features from audio buffer (single-pass, pre-allocated)
     FeatureVector extractFeatures(const juce::AudioBuffer<float>& audio);
     
+    // Same analysis over a raw mono signal
+    FeatureVector extractFeatures(const float* audioData, int numSamples);
+    
+    /**
+     * Streaming form of extractFeatures: beginStream(), then pushSamples()
+     * with consecutive blocks of any size, then finishStream(). The result
+     * matches extractFeatures over the concatenated blocks.
+     */
+    void beginStream();
+    void pushSamples(const float* samples, int numSamples);
+    FeatureVector finishStream();
+    
+    /**
+     * extractFeatures with the frames split into contiguous runs across the
+     * pool's slots, each slot analysing with its own FFT and scratch. Run
+     * statistics are merged in order, so results don't depend on scheduling;
+     * they match the sequential analysis to float rounding of the merge.
+     */
+    FeatureVector extractFeatures(const float* audioData, int numSamples, WorkerPool& pool);
+    
 private:
     double sampleRate;
     int fftSize;
     int hopSize;
     int numMelBands;
     
-    // Sparse mel filter representation for efficiency
-    struct SparseFilter
+    // Mel filter as one contiguous run of bins with dense weights, so each
+    // band is a straight dot product over the spectrum (no index gathers)
+    struct MelBand
     {
-        std::vector<int> indices;     // Non-zero bin indices
-        std::vector<float> weights;   // Corresponding weights
+        int startBin = 0;
+        std::vector<float> weights;   // weights[k] applies to bin startBin + k
     };
     
-    // Pre-allocated buffers (reused for every extraction)
-    juce::dsp::FFT fft;
-    std::vector<float> fftData;
+    // FFT and buffers one frame is analysed in (one per concurrent analysis)
+    struct FrameScratch
+    {
+        FrameScratch(int fftSize, int numMelBands);
+        
+        juce::dsp::FFT fft;
+        std::vector<float> fftData;
+        std::vector<float> magnitude;
+        std::vector<float> melEnergies;
+    };
+    
+    // Read-only analysis tables, shared by every scratch
     std::vector<float> window;
-    std::vector<float> magnitude;
-    std::vector<float> melEnergies;  // Pre-allocated for zero-allocation runtime
-    std::vector<SparseFilter> melFilters;  // Sparse representation (only non-zero values)
+    std::vector<MelBand> melBands;   // Trimmed to each filter's non-zero span
+    std::vector<float> dctBasis;     // DCT-II rows: dctBasis[i * numMelBands + j]
     
-    // Multi-frame storage (pre-allocated)
-    std::vector<std::array<float, 10>> mfccFrames;  // MFCC per frame
-    std::vector<float> centroidFrames;              // Centroid per frame
+    // Pre-allocated buffers (reused for every extraction)
+    FrameScratch scratch;
+    std::vector<std::unique_ptr<FrameScratch>> slotScratch;  // Pool slots 1.. (slot 0 uses scratch)
+    
+    // Per-frame statistic accumulated as frames complete. The running sum
+    // gives the same mean as summing stored frames; Welford's update gives
+    // the variance without keeping them.
+    struct RunningStats
+    {
+        int count = 0;
+        float sum = 0.0f;
+        double mean = 0.0;
+        double m2 = 0.0;
+        
+        void add(float value);
+        void merge(const RunningStats& later);
+        float getMean() const { return count > 0 ? sum / count : 0.0f; }
+        float getStd() const;
+    };
+    
+    struct FrameStats
+    {
+        std::array<RunningStats, 10> mfcc;
+        RunningStats centroid;
+        
+        void merge(const FrameStats& later);
+    };
+    
+    // Sample seen by the attack search: index and |x|
+    struct AttackCandidate
+    {
+        int index;
+        float amplitude;
+    };
+    
+    // Stream state (reset by beginStream)
+    std::vector<float> ring;          // Last fftSize samples, oldest at ringPos once full
+    int ringPos = 0;
+    int streamedSamples = 0;
+    int nextFrameEnd = 0;             // Sample count at which the next frame completes
+    float sumSquares = 0.0f;
+    float peakAmp = 0.0f;
+    int peakIndex = 0;
+    int attackStart = 0;              // Attack start for the current peak
+    std::vector<AttackCandidate> attackFloor;  // Strictly rising amplitudes: latest sample at or below any level
+    FrameStats frameStats;
+    
+    // Per-task statistics for the pooled analysis (reused)
+    std::vector<FrameStats> taskStats;
     
     // Feature computation (single frame)
-    void computeFFT(const float* audioData, int startSample, int numSamples);
-    float computeSpectralCentroid();
-    float computeAttackTime(const juce::AudioBuffer<float>& audio);
-    float computeRMSEnergy(const juce::AudioBuffer<float>& audio);
-    void computeMFCCs(std::array<float, 10>& mfccs);
-    
-    // Multi-frame analysis
-    void extractMultiFrameFeatures(const juce::AudioBuffer<float>& audio, FeatureVector& features);
-    void computeMeanAndStd(const std::vector<std::array<float, 10>>& frames, 
-                          std::array<float, 10>& mean, std::array<float, 10>& std);
-    void computeMeanAndStd(const std::vector<float>& values, float& mean, float& std);
+    // Windows a frame given as up to two runs (the ring unwraps into two),
+    // zero padded, and adds its MFCCs and centroid to stats
+    void analyseFrame(FrameScratch& frame, const float* first, int firstCount,
+                      const float* second, int secondCount, FrameStats& stats) const;
+    // FFT of the windowed frame, its magnitudes and the spectral centroid
+    // (returned) while the spectrum is still in cache
+    float computeSpectrum(FrameScratch& frame) const;
+    void computeMFCCs(FrameScratch& frame, std::array<float, 10>& mfccs) const;
+    
+    // Temporal features, over every sample in order
+    void trackSamples(const float* samples, int numSamples);
+    int latestSampleAtOrBelow(float level) const;
     
     // MFCC helpers
     void initializeMelFilterbank();
-    void applyMelFilterbank(std::vector<float>& melEnergies);
-    void applyDCT(const std::vector<float>& melEnergies, std::array<float, 10>& mfccs);
+    void initializeDCTBasis();
+    void applyMelFilterbank(FrameScratch& frame) const;
+    void applyDCT(const std::vector<float>& melEnergies, std::array<float, 10>& mfccs) const;
     
     // Mel scale conversion
     static float hzToMel(float hz) { return 2595.0f * std::log10(1.0f + hz / 700.0f); }
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+    FeatureStore.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "FeatureStore.h"
+#include <algorithm>
+#include <cstring>
+
+bool FeatureStore::Tag::operator==(const Tag& other) const
+{
+    return renderVersion == other.renderVersion
+        && keySize == other.keySize
+        && valueSize == other.valueSize
+        && durationMs == other.durationMs
+        && fftSize == other.fftSize
+        && hopSize == other.hopSize
+        && sampleRate == other.sampleRate;
+}
+
+FeatureStore::FeatureStore(const juce::File& file, const Tag& tag_, HashFunction hash, int maxRecords_)
+    : tag(tag_)
+    , recordSize(tag_.keySize + tag_.valueSize)
+    , maxRecords(std::max(0, maxRecords_))
+    , index(16, -1)
+    , mask(15)
+{
+    FileHeader header;
+    std::memset(static_cast<void*>(&header), 0, sizeof(header));  // Padding is written too, so keep it deterministic
+    std::memcpy(header.magic, "PPGF", 4);
+    header.formatVersion = formatVersion;
+    header.tag = tag;
+
+    const size_t recordBytes = sizeof(float) * static_cast<size_t>(recordSize);
+    int64_t storedRecords = -1;  // -1 = file must be started afresh
+
+    if (file.existsAsFile() && file.getSize() >= static_cast<juce::int64>(sizeof(FileHeader)))
+    {
+        FileHeader existing;
+        juce::FileInputStream stream(file);
+
+        if (stream.openedOk()
+            && stream.read(&existing, sizeof(existing)) == static_cast<int>(sizeof(existing))
+            && std::memcmp(existing.magic, header.magic, 4) == 0
+            && existing.formatVersion == formatVersion
+            && existing.tag == tag)
+        {
+            storedRecords = (file.getSize() - static_cast<juce::int64>(sizeof(FileHeader)))
+                          / static_cast<juce::int64>(recordBytes);
+        }
+    }
+
+    if (storedRecords < 0)
+    {
+        if (!file.getParentDirectory().createDirectory() || !file.replaceWithData(&header, sizeof(header)))
+            return;
+
+        storedRecords = 0;
+    }
+
+    // Drop a record torn by a crash mid-append so new records stay aligned
+    const juce::int64 validBytes = static_cast<juce::int64>(sizeof(FileHeader))
+                                 + storedRecords * static_cast<juce::int64>(recordBytes);
+    output = std::make_unique<juce::FileOutputStream>(file);
+    if (!output->openedOk())
+    {
+        output.reset();
+        return;
+    }
+
+    if (file.getSize() != validBytes)
+    {
+        output->setPosition(validBytes);
+        output->truncate();
+    }
+
+    if (storedRecords > 0)
+    {
+        mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+        if (mapping->getData() != nullptr && mapping->getSize() >= static_cast<size_t>(validBytes))
+        {
+            mappedRecords = reinterpret_cast<const float*>(static_cast<const char*>(mapping->getData()) + sizeof(FileHeader));
+            numMapped = static_cast<int>(storedRecords);
+        }
+        else
+        {
+            // Unmappable: start over rather than append after records we can't read
+            mapping.reset();
+            output->setPosition(static_cast<juce::int64>(sizeof(FileHeader)));
+            output->truncate();
+        }
+    }
+
+    output->setPosition(static_cast<juce::int64>(sizeof(FileHeader)) + numMapped * static_cast<juce::int64>(recordBytes));
+
+    // One pass over the mapping builds the index; the records themselves stay on disk
+    recordHashes.reserve(static_cast<size_t>(numMapped));
+
+    for (int r = 0; r < numMapped; ++r)
+        addToIndex(r, hash(record(r), tag.keySize));
+}
+
+FeatureStore::~FeatureStore()
+{
+    flush();
+}
+
+const float* FeatureStore::find(const float* key, size_t hash) const
+{
+    const int number = lookup(key, hash);
+    return number >= 0 ? record(number) + tag.keySize : nullptr;
+}
+
+void FeatureStore::append(const float* key, size_t hash, const float* value)
+{
+    if (output == nullptr || size() >= maxRecords || lookup(key, hash) >= 0)
+        return;
+
+    const size_t keyBytes = sizeof(float) * static_cast<size_t>(tag.keySize);
+    const size_t valueBytes = sizeof(float) * static_cast<size_t>(tag.valueSize);
+
+    if (!output->write(key, keyBytes) || !output->write(value, valueBytes))
+    {
+        DBG("FeatureStore: write failed, persisting stopped");
+        output.reset();
+        return;
+    }
+
+    appended.insert(appended.end(), key, key + tag.keySize);
+    appended.insert(appended.end(), value, value + tag.valueSize);
+    addToIndex(size(), hash);
+}
+
+void FeatureStore::flush()
+{
+    if (output != nullptr)
+        output->flush();
+}
+
+const float* FeatureStore::record(int number) const
+{
+    if (number < numMapped)
+        return mappedRecords + static_cast<size_t>(number) * recordSize;
+
+    return appended.data() + static_cast<size_t>(number - numMapped) * recordSize;
+}
+
+int FeatureStore::lookup(const float* key, size_t hash) const
+{
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const int number = index[i];
+        if (number < 0)
+            return -1;
+
+        // Bitwise key match, like the hash
+        if (recordHashes[static_cast<size_t>(number)] == hash
+            && std::memcmp(record(number), key, sizeof(float) * static_cast<size_t>(tag.keySize)) == 0)
+            return number;
+    }
+}
+
+void FeatureStore::addToIndex(int number, size_t hash)
+{
+    recordHashes.push_back(hash);
+
+    if (recordHashes.size() * 2 > index.size())
+    {
+        growIndex();  // Reindexes every record, including this one
+        return;
+    }
+
+    size_t i = hash & mask;
+    while (index[i] >= 0)
+        i = (i + 1) & mask;
+    index[i] = number;
+}
+
+void FeatureStore::growIndex()
+{
+    index.assign(index.size() * 2, -1);
+    mask = index.size() - 1;
+
+    for (size_t r = 0; r < recordHashes.size(); ++r)
+    {
+        size_t i = recordHashes[r] & mask;
+        while (index[i] >= 0)
+            i = (i + 1) & mask;
+        index[i] = static_cast<int32_t>(r);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+    FeatureStore.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Append-only on-disk table of key -> value float records, so features
+    computed in one session are available in the next. The file is memory
+    mapped when opened and indexed once; records appended afterwards are
+    written through to the file and also kept in memory. A header tag names
+    the render and analysis settings the values came from, and a file with
+    a different tag is started afresh. Not thread-safe.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class FeatureStore
+{
+public:
+    using HashFunction = size_t (*)(const float* key, int keySize);
+
+    // What the stored values were computed with; any difference invalidates the file
+    struct Tag
+    {
+        uint32_t renderVersion = 0;
+        int32_t keySize = 0;
+        int32_t valueSize = 0;
+        int32_t durationMs = 0;
+        int32_t fftSize = 0;
+        int32_t hopSize = 0;
+        double sampleRate = 0.0;
+
+        bool operator==(const Tag& other) const;
+    };
+
+    /**
+     * Opens (or creates) file for tag. Records are hashed with hash, which
+     * must match the hash callers pass to find() and append(). Appends stop
+     * once maxRecords are stored.
+     */
+    FeatureStore(const juce::File& file, const Tag& tag, HashFunction hash, int maxRecords);
+    ~FeatureStore();
+
+    // False if the file couldn't be created; lookups then always miss
+    bool isOpen() const { return output != nullptr; }
+
+    int size() const { return static_cast<int>(recordHashes.size()); }
+
+    // Stored value for key, or nullptr; valid until the next append
+    const float* find(const float* key, size_t hash) const;
+
+    // Adds key -> value unless key is stored or the store is full
+    void append(const float* key, size_t hash, const float* value);
+
+    // Pushes appended records to disk. Only touches the file stream, so it
+    // may run alongside find(), though not alongside append()
+    void flush();
+
+private:
+    // On-disk header; records of keySize + valueSize floats follow it
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t formatVersion;
+        Tag tag;
+    };
+
+    static constexpr uint32_t formatVersion = 1;
+
+    Tag tag;
+    int recordSize;  // Floats per record
+    int maxRecords;
+
+    // Records present when opened, read straight from the mapping
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    const float* mappedRecords = nullptr;
+    int numMapped = 0;
+
+    // Records appended since, in memory as well as on disk
+    std::vector<float> appended;
+    std::unique_ptr<juce::FileOutputStream> output;
+
+    // Open-addressing index of record numbers (linear probing, at most half full)
+    std::vector<int32_t> index;
+    std::vector<size_t> recordHashes;
+    size_t mask = 0;
+
+    const float* record(int number) const;
+    int lookup(const float* key, size_t hash) const;
+    void addToIndex(int number, size_t hash);
+    void growIndex();
+};
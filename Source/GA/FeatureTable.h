@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+    FeatureTable.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Fixed-capacity genome -> feature table in flat, preallocated storage.
+    An open-addressing index (linear probing, at most half full) maps hashes
+    to entries; each entry keeps its full key inline beside the value and
+    the key is compared on every lookup, so a hash collision can never
+    return another genome's features. CLOCK eviction approximates LRU
+    without touching any list on a hit. Not thread-safe.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+template <int KeySize, int ValueSize>
+class FeatureTable
+{
+public:
+    explicit FeatureTable(int capacity)
+        : entries(static_cast<size_t>(std::max(1, capacity)))
+    {
+        const size_t indexSize = indexSizeFor(capacity);
+        index.assign(indexSize, IndexSlot {});
+        mask = indexSize - 1;
+    }
+
+    int size() const { return count; }
+    int capacity() const { return static_cast<int>(entries.size()); }
+
+    // Heap footprint of a table of this capacity (entries plus index)
+    static constexpr size_t bytesFor(int capacity)
+    {
+        return sizeof(Entry) * static_cast<size_t>(std::max(1, capacity)) + sizeof(IndexSlot) * indexSizeFor(capacity);
+    }
+
+    // Largest capacity whose footprint fits in bytes (at least 1)
+    static int capacityFor(size_t bytes)
+    {
+        int low = 1, high = static_cast<int>(std::min<size_t>(bytes / sizeof(Entry) + 1, 1 << 30));
+        while (low < high)
+        {
+            const int mid = low + (high - low + 1) / 2;
+            if (bytesFor(mid) <= bytes)
+                low = mid;
+            else
+                high = mid - 1;
+        }
+        return low;
+    }
+
+    // Value stored for key, or nullptr; marks the entry recently used
+    const float* find(const float* key, size_t hash)
+    {
+        int entry = lookup(key, hash);
+        if (entry < 0)
+            return nullptr;
+
+        entries[static_cast<size_t>(entry)].referenced = true;
+        return entries[static_cast<size_t>(entry)].value.data();
+    }
+
+    bool contains(const float* key, size_t hash) const { return lookup(key, hash) >= 0; }
+
+    // Stores key -> value unless key is already present, evicting when full;
+    // returns true if an entry was evicted to make room
+    bool insert(const float* key, size_t hash, const float* value)
+    {
+        if (lookup(key, hash) >= 0)
+            return false;
+
+        const bool full = count == capacity();
+        const int entry = full ? evict() : count++;
+
+        auto& slot = entries[static_cast<size_t>(entry)];
+        slot.hash = hash;
+        std::copy(key, key + KeySize, slot.key.begin());
+        std::copy(value, value + ValueSize, slot.value.begin());
+        slot.referenced = true;
+
+        size_t i = hash & mask;
+        while (index[i].entry >= 0)
+            i = (i + 1) & mask;
+        index[i] = { entry, tagOf(hash) };
+        return full;
+    }
+
+    void clear()
+    {
+        count = 0;
+        hand = 0;
+        std::fill(index.begin(), index.end(), IndexSlot {});
+    }
+
+private:
+    struct Entry
+    {
+        size_t hash = 0;
+        std::array<float, KeySize> key {};
+        std::array<float, ValueSize> value {};
+        bool referenced = false;  // CLOCK bit, set on every hit
+    };
+
+    // Small index records, so a probe sequence stays within a cache line or two
+    struct IndexSlot
+    {
+        int32_t entry = -1;  // -1 = empty
+        uint32_t tag = 0;    // Hash bits, checked before the key is compared
+    };
+
+    std::vector<Entry> entries;
+    std::vector<IndexSlot> index;
+    size_t mask = 0;
+    int count = 0;
+    int hand = 0;  // CLOCK position in entries
+
+    static constexpr size_t indexSizeFor(int capacity)
+    {
+        size_t indexSize = 1;
+        while (indexSize < static_cast<size_t>(std::max(1, capacity)) * 2)
+            indexSize <<= 1;
+        return indexSize;
+    }
+
+    static uint32_t tagOf(size_t hash) { return static_cast<uint32_t>(hash ^ (static_cast<uint64_t>(hash) >> 32)); }
+
+    int lookup(const float* key, size_t hash) const
+    {
+        const uint32_t tag = tagOf(hash);
+
+        for (size_t i = hash & mask;; i = (i + 1) & mask)
+        {
+            const auto& slot = index[i];
+            if (slot.entry < 0)
+                return -1;
+
+            // Bitwise key match, like the hash (so -0.0f and NaN keys behave consistently)
+            if (slot.tag == tag && std::memcmp(entries[static_cast<size_t>(slot.entry)].key.data(), key,
+                                               sizeof(float) * KeySize) == 0)
+                return slot.entry;
+        }
+    }
+
+    // Frees the first entry the hand finds unreferenced since its last pass
+    int evict()
+    {
+        for (;;)
+        {
+            const int victim = hand;
+            hand = (hand + 1) % capacity();
+
+            auto& entry = entries[static_cast<size_t>(victim)];
+            if (entry.referenced)
+            {
+                entry.referenced = false;
+                continue;
+            }
+
+            unlink(victim);
+            return victim;
+        }
+    }
+
+    // Removes entry's index slot, shifting later probes back over the hole
+    void unlink(int entry)
+    {
+        size_t hole = entries[static_cast<size_t>(entry)].hash & mask;
+        while (index[hole].entry != entry)
+            hole = (hole + 1) & mask;
+
+        index[hole] = IndexSlot {};
+
+        for (size_t next = (hole + 1) & mask; index[next].entry >= 0; next = (next + 1) & mask)
+        {
+            const size_t home = entries[static_cast<size_t>(index[next].entry)].hash & mask;
+
+            // Leave slots whose home lies cyclically in (hole, next]
+            const bool staysPut = hole <= next ? (home > hole && home <= next)
+                                               : (home > hole || home <= next);
+            if (staysPut)
+                continue;
+
+            index[hole] = index[next];
+            index[next] = IndexSlot {};
+            hole = next;
+        }
+    }
+};
@@ -0,0 +1,367 @@
+/*
+  ==============================================================================
+    FeedbackLog.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "FeedbackLog.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t formatVersion = 1;
+
+    // On-disk header; namesBytes of comma-joined UTF-8 parameter names follow it
+    struct LogHeader
+    {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t genomeSize;
+        uint32_t recordBytes;
+        uint32_t namesBytes;
+    };
+
+    juce::String joinNames(const std::vector<juce::String>& names)
+    {
+        juce::String joined;
+        for (size_t i = 0; i < names.size(); ++i)
+            joined += (i == 0 ? "" : ",") + names[i];
+        return joined;
+    }
+
+    // Parses the header at data, returning the offset of the first record or 0
+    size_t parseHeader(const char* data, size_t size, LogHeader& header, juce::String& names)
+    {
+        if (data == nullptr || size < sizeof(LogHeader))
+            return 0;
+
+        std::memcpy(&header, data, sizeof(header));
+
+        if (std::memcmp(header.magic, "PPGF", 4) != 0 || header.formatVersion != formatVersion
+            || header.recordBytes != sizeof(FeedbackLog::Record) + sizeof(float) * header.genomeSize
+            || size - sizeof(LogHeader) < header.namesBytes)
+            return 0;
+
+        names = juce::String(std::string(data + sizeof(LogHeader), header.namesBytes));
+        return sizeof(LogHeader) + header.namesBytes;
+    }
+}
+
+void FeedbackLog::Record::setConfigFlags(const juce::String& flags)
+{
+    const char* text = flags.toRawUTF8();
+    const size_t length = std::min(std::strlen(text), static_cast<size_t>(configFlagsSize - 1));
+    std::memcpy(configFlags, text, length);
+    configFlags[length] = '\0';
+}
+
+FeedbackLog::FeedbackLog(const juce::File& file, const std::vector<juce::String>& parameterNames)
+    : juce::Thread("FeedbackLog")
+    , genomeSize(static_cast<int>(parameterNames.size()))
+    , recordBytes(sizeof(Record) + sizeof(float) * parameterNames.size())
+    , csvHeader(getCSVHeader(parameterNames))
+{
+    const juce::String names = joinNames(parameterNames);
+    size_t recordsStart = 0;
+
+    if (file.existsAsFile())
+    {
+        // Only the header is needed here; records are never read back while logging
+        juce::FileInputStream input(file);
+        std::vector<char> head(sizeof(LogHeader) + std::strlen(names.toRawUTF8()));
+        const int headBytes = input.openedOk() ? input.read(head.data(), static_cast<int>(head.size())) : 0;
+
+        LogHeader header;
+        juce::String existingNames;
+        recordsStart = parseHeader(head.data(), static_cast<size_t>(std::max(headBytes, 0)), header, existingNames);
+
+        if (recordsStart == 0 || existingNames != names)
+        {
+            recordsStart = 0;
+            const juce::String timestamp = juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S");
+            const juce::File backupFile = file.getSiblingFile(file.getFileNameWithoutExtension() + "_backup_"
+                                                              + timestamp + file.getFileExtension());
+            file.moveFileTo(backupFile);
+            DBG("Schema changed. Rotated old feedback log to " << backupFile.getFileName());
+        }
+    }
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+    {
+        stream.reset();
+        return;
+    }
+
+    if (recordsStart > 0)
+    {
+        // Drop a record torn by a crash mid-write, so appends stay aligned
+        const auto records = static_cast<juce::int64>(recordsStart)
+                           + (file.getSize() - static_cast<juce::int64>(recordsStart)) / static_cast<juce::int64>(recordBytes)
+                                 * static_cast<juce::int64>(recordBytes);
+        stream->setPosition(records);
+        stream->truncate();
+    }
+    else
+    {
+        LogHeader header;
+        std::memcpy(header.magic, "PPGF", 4);
+        header.formatVersion = formatVersion;
+        header.genomeSize = static_cast<uint32_t>(genomeSize);
+        header.recordBytes = static_cast<uint32_t>(recordBytes);
+        header.namesBytes = static_cast<uint32_t>(std::strlen(names.toRawUTF8()));
+
+        stream->setPosition(0);
+        stream->truncate();
+        stream->write(&header, sizeof(header));
+        stream->write(names.toRawUTF8(), header.namesBytes);
+        stream->flush();
+    }
+
+    // Headroom for the records appended while a write is in progress
+    buffered.reserve(flushThresholdBytes * 2);
+    writing.reserve(flushThresholdBytes * 2);
+
+    startThread(juce::Thread::Priority::low);
+}
+
+FeedbackLog::~FeedbackLog()
+{
+    if (stream == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    changed.notify_all();
+    stopThread(5000);
+}
+
+void FeedbackLog::append(const float* genome, const Record& record)
+{
+    if (stream == nullptr)
+        return;
+
+    bool full = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto* recordData = reinterpret_cast<const char*>(&record);
+        const auto* genomeData = reinterpret_cast<const char*>(genome);
+        buffered.insert(buffered.end(), recordData, recordData + sizeof(Record));
+        buffered.insert(buffered.end(), genomeData, genomeData + sizeof(float) * static_cast<size_t>(genomeSize));
+        ++appendedRecords;
+        full = buffered.size() >= flushThresholdBytes;
+    }
+
+    if (full)
+        changed.notify_all();
+}
+
+bool FeedbackLog::flush(int timeoutMs)
+{
+    if (stream == nullptr)
+        return false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    const uint64_t target = appendedRecords;
+    flushRequested = true;
+    changed.notify_all();
+
+    return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, target] { return writtenRecords >= target; });
+}
+
+void FeedbackLog::run()
+{
+    for (;;)
+    {
+        uint64_t records = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait_for(lock, std::chrono::milliseconds(flushIntervalMs), [this]
+            {
+                return stopping || flushRequested || buffered.size() >= flushThresholdBytes;
+            });
+
+            flushRequested = false;
+
+            // Stop only once everything appended is on disk
+            if (buffered.empty())
+            {
+                if (stopping)
+                    return;
+
+                continue;
+            }
+
+            std::swap(buffered, writing);
+            records = appendedRecords;
+        }
+
+        if (!stream->write(writing.data(), writing.size()))
+            DBG("FeedbackLog: write failed");
+
+        stream->flush();
+        writing.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writtenRecords = records;
+        }
+
+        changed.notify_all();
+    }
+}
+
+juce::String FeedbackLog::getCSVHeader(const std::vector<juce::String>& parameterNames)
+{
+    juce::String header;
+    for (const auto& name : parameterNames)
+        header += name + ",";
+    header += "rating,playTimeSeconds,sampleIndex,mlpGenomePrediction,mlpAudioPrediction,configFlags,timestamp,sampleWeight";
+    return header;
+}
+
+bool FeedbackLog::exportCSV(const juce::File& logFile, const juce::File& csvFile)
+{
+    if (!logFile.existsAsFile())
+        return false;
+
+    juce::MemoryMappedFile mapping(logFile, juce::MemoryMappedFile::readOnly);
+    const auto* data = static_cast<const char*>(mapping.getData());
+    const size_t size = mapping.getSize();
+
+    LogHeader header;
+    juce::String names;
+    const size_t recordsStart = parseHeader(data, size, header, names);
+    if (recordsStart == 0)
+        return false;
+
+    std::vector<juce::String> parameterNames;
+    if (header.genomeSize > 0)
+    {
+        juce::StringArray tokens;
+        tokens.addTokens(names, ",", "");
+        for (const auto& token : tokens)
+            parameterNames.push_back(token);
+    }
+
+    juce::FileOutputStream csv(csvFile);
+    if (!csv.openedOk())
+        return false;
+
+    csv.setPosition(0);
+    csv.truncate();
+    csv << getCSVHeader(parameterNames) << "\n";
+
+    // A torn trailing record is skipped
+    const size_t numRecords = (size - recordsStart) / header.recordBytes;
+    std::vector<float> genome(header.genomeSize);
+
+    for (size_t r = 0; r < numRecords; ++r)
+    {
+        const char* recordData = data + recordsStart + r * header.recordBytes;
+        Record record;
+        std::memcpy(&record, recordData, sizeof(Record));
+        std::memcpy(genome.data(), recordData + sizeof(Record), sizeof(float) * genome.size());
+        record.configFlags[configFlagsSize - 1] = '\0';
+
+        juce::String line;
+        for (float param : genome)
+            line += juce::String(param, 6) + ",";
+
+        line += juce::String(record.rating, 1) + ",";
+        line += juce::String(record.playTimeSeconds, 2) + ",";
+        line += juce::String(static_cast<juce::int64>(record.sampleIndex)) + ",";
+        line += juce::String(record.genomePrediction, 6) + ",";
+        line += juce::String(record.audioPrediction, 6) + ",";
+        line += juce::String(record.configFlags) + ",";
+        line += juce::Time(record.timestampMs).toISO8601(true) + ",";
+        line += juce::String(record.sampleWeight, 2);
+
+        csv << line << "\n";
+    }
+
+    csv.flush();
+    return true;
+}
+
+int FeedbackLog::importCSV(const juce::File& csvFile)
+{
+    if (stream == nullptr || !csvFile.existsAsFile())
+        return -1;
+
+    juce::StringArray lines;
+    csvFile.readLines(lines);
+    if (lines.isEmpty() || lines[0].trim() != csvHeader)
+        return -1;
+
+    // The parameters, then rating, play time, index, both predictions, flags, time and weight
+    const int numColumns = genomeSize + 8;
+    std::vector<float> genome(static_cast<size_t>(genomeSize));
+    int imported = 0;
+
+    for (int i = 1; i < lines.size(); ++i)
+    {
+        juce::StringArray columns;
+        columns.addTokens(lines[i].trim(), ",", "");
+        if (columns.size() != numColumns)
+            continue;
+
+        for (int p = 0; p < genomeSize; ++p)
+            genome[static_cast<size_t>(p)] = columns[p].getFloatValue();
+
+        Record record;
+        record.rating = columns[genomeSize].getFloatValue();
+        record.playTimeSeconds = columns[genomeSize + 1].getFloatValue();
+        record.sampleIndex = static_cast<uint64_t>(std::max<juce::int64>(0, columns[genomeSize + 2].getLargeIntValue()));
+        record.genomePrediction = columns[genomeSize + 3].getFloatValue();
+        record.audioPrediction = columns[genomeSize + 4].getFloatValue();
+        record.setConfigFlags(columns[genomeSize + 5]);
+        record.timestampMs = juce::Time::fromISO8601(columns[genomeSize + 6]).toMilliseconds();
+        record.sampleWeight = columns[genomeSize + 7].getFloatValue();
+
+        append(genome.data(), record);
+        ++imported;
+    }
+
+    return imported;
+}
+
+bool FeedbackLog::readRecords(const juce::File& logFile, int genomeSize,
+                              const std::function<void(const Record&, const float* genome)>& visit)
+{
+    if (!logFile.existsAsFile())
+        return false;
+
+    juce::MemoryMappedFile mapping(logFile, juce::MemoryMappedFile::readOnly);
+    const auto* data = static_cast<const char*>(mapping.getData());
+    const size_t size = mapping.getSize();
+
+    LogHeader header;
+    juce::String names;
+    const size_t recordsStart = parseHeader(data, size, header, names);
+    if (recordsStart == 0 || static_cast<int>(header.genomeSize) != genomeSize)
+        return false;
+
+    // Records aren't float-aligned in the file, so each is copied out
+    const size_t numRecords = (size - recordsStart) / header.recordBytes;
+    std::vector<float> genome(header.genomeSize);
+    Record record;
+
+    for (size_t r = 0; r < numRecords; ++r)
+    {
+        const char* recordData = data + recordsStart + r * header.recordBytes;
+        std::memcpy(&record, recordData, sizeof(Record));
+        std::memcpy(genome.data(), recordData + sizeof(Record), sizeof(float) * genome.size());
+        visit(record, genome.data());
+    }
+
+    return true;
+}
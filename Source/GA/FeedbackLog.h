@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+    FeedbackLog.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Append-only binary log of rated samples. The file starts with a schema
+    header (the parameter names), followed by fixed-size records: a Record,
+    then one float per parameter. append() only copies the record into a
+    memory buffer. A background thread writes the buffer through one stream
+    that stays open, once a second or when enough records have built up, so
+    logging costs the caller no file I/O. exportCSV() converts a log into
+    the CSV that analysis/compute_metrics.py reads, and importCSV() brings
+    such a CSV back in.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class FeedbackLog : private juce::Thread
+{
+public:
+    static constexpr int configFlagsSize = 64;
+
+    // Fixed part of a record; the genome follows it on disk
+    struct Record
+    {
+        int64_t timestampMs = 0;  // Milliseconds since the epoch
+        uint64_t sampleIndex = 0;
+        float rating = 0.0f;
+        float playTimeSeconds = 0.0f;
+        float genomePrediction = 0.0f;
+        float audioPrediction = 0.0f;
+        float sampleWeight = 1.0f;
+        char configFlags[configFlagsSize] {};  // Null-terminated, truncated to fit
+
+        void setConfigFlags(const juce::String& flags);
+    };
+
+    /**
+     * Opens file for appending. A log written with other parameter names is
+     * moved aside to a timestamped backup and a new log started, as the CSV
+     * dataset was; a record torn by a crash is dropped.
+     */
+    FeedbackLog(const juce::File& file, const std::vector<juce::String>& parameterNames);
+
+    // Writes anything still buffered
+    ~FeedbackLog() override;
+
+    bool isOpen() const { return stream != nullptr; }
+
+    // Non-blocking; genome holds one value per parameter
+    void append(const float* genome, const Record& record);
+
+    // Blocks until every appended record has been written; false on timeout
+    bool flush(int timeoutMs = 5000);
+
+    /**
+     * Streams a log's records in order through a memory mapping, calling
+     * visit(record, genome) for each. False if logFile isn't a valid log of
+     * genomeSize parameters. Records still buffered by a writer are not seen.
+     */
+    static bool readRecords(const juce::File& logFile, int genomeSize,
+                            const std::function<void(const Record&, const float* genome)>& visit);
+
+    // Writes the CSV compute_metrics.py reads; false if logFile isn't a valid log
+    static bool exportCSV(const juce::File& logFile, const juce::File& csvFile);
+
+    /**
+     * Appends the rows of a CSV in that schema (as exportCSV() and the CSV
+     * dataset before the log wrote it), returning how many; -1 if the file
+     * can't be read or its columns aren't this log's. Rows that don't parse
+     * are skipped.
+     */
+    int importCSV(const juce::File& csvFile);
+
+    static juce::String getCSVHeader(const std::vector<juce::String>& parameterNames);
+
+    static constexpr int flushIntervalMs = 1000;
+    static constexpr size_t flushThresholdBytes = 64 * 1024;
+
+private:
+    void run() override;
+
+    const int genomeSize;
+    const size_t recordBytes;
+    const juce::String csvHeader;
+    std::unique_ptr<juce::FileOutputStream> stream;  // Only the writer thread touches it after construction
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<char> buffered;  // Appended, not yet written
+    std::vector<char> writing;   // Being written by the writer thread (reused)
+    uint64_t appendedRecords = 0;
+    uint64_t writtenRecords = 0;
+    bool flushRequested = false;
+    bool stopping = false;
+};
@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+    FixedMLP.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "FixedMLP.h"
+#include "RandomStream.h"
+#include <algorithm>
+#include <random>
+
+template <int InputSize, int HiddenSize>
+FixedMLP<InputSize, HiddenSize>::FixedMLP(uint64_t seed)
+{
+    initializeWeights(seed);
+}
+
+template <int InputSize, int HiddenSize>
+void FixedMLP<InputSize, HiddenSize>::initializeWeights(uint64_t seed)
+{
+    RandomStream gen(seed);
+
+    // Xavier initialization for input->hidden; the output layer and biases
+    // start at zero so initial predictions are exactly 0.5, as in MLP
+    const float scaleIH = std::sqrt(2.0f / (InputSize + HiddenSize));
+    std::uniform_real_distribution<float> distIH(-scaleIH, scaleIH);
+    for (float& w : weightsIH)
+        w = distIH(gen);
+}
+
+template <int InputSize, int HiddenSize>
+void FixedMLP<InputSize, HiddenSize>::hiddenLayer(const float* input, float* hidden) const
+{
+    std::copy(biasH.begin(), biasH.end(), hidden);
+
+    for (int i = 0; i < InputSize; ++i)
+    {
+        const float x = input[i];
+        const float* w = weightsIH.data() + i * HiddenSize;
+
+        for (int j = 0; j < HiddenSize; ++j)
+            hidden[j] += x * w[j];
+    }
+}
+
+template <int InputSize, int HiddenSize>
+float FixedMLP<InputSize, HiddenSize>::outputLayer(const float* hidden) const
+{
+    float sum = biasO;
+    for (int j = 0; j < HiddenSize; ++j)
+        sum += relu(hidden[j]) * weightsHO[j];
+
+    return sigmoid(sum);
+}
+
+template <int InputSize, int HiddenSize>
+float FixedMLP<InputSize, HiddenSize>::predict(const std::vector<float>& input) const
+{
+    HiddenVector hidden;
+    hiddenLayer(input.data(), hidden.data());
+    return outputLayer(hidden.data());
+}
+
+template <int InputSize, int HiddenSize>
+void FixedMLP<InputSize, HiddenSize>::predictBatch(const float* inputs, int numSamples, float* outputs) const
+{
+    HiddenVector hidden;
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        hiddenLayer(inputs + static_cast<size_t>(n) * InputSize, hidden.data());
+        outputs[n] = outputLayer(hidden.data());
+    }
+}
+
+template <int InputSize, int HiddenSize>
+void FixedMLP<InputSize, HiddenSize>::train(const std::vector<float>& input, float target,
+                                            float learningRate, float sampleWeight)
+{
+    trainBatch(input.data(), 1, &target, &sampleWeight, learningRate);
+}
+
+template <int InputSize, int HiddenSize>
+void FixedMLP<InputSize, HiddenSize>::trainBatch(const float* inputs, int numSamples, const float* targets,
+                                                 const float* sampleWeights, float learningRate)
+{
+    if (numSamples <= 0)
+        return;
+
+    // Accumulate gradients tile by tile; hidden deltas use weightsHO from before the update
+    gradIH.fill(0.0f);
+    gradBiasH.fill(0.0f);
+    gradHO.fill(0.0f);
+    float gradBiasO = 0.0f;
+
+    std::array<float, tileSize * HiddenSize> tile;
+
+    for (int start = 0; start < numSamples; start += tileSize)
+    {
+        const int count = std::min(tileSize, numSamples - start);
+
+        for (int n = 0; n < count; ++n)
+            hiddenLayer(inputs + static_cast<size_t>(start + n) * InputSize, tile.data() + n * HiddenSize);
+
+        for (int n = 0; n < count; ++n)
+        {
+            const float* input = inputs + static_cast<size_t>(start + n) * InputSize;
+            float* h = tile.data() + n * HiddenSize;
+
+            // Gradient clipping
+            float dOutput = (outputLayer(h) - targets[start + n]) * sampleWeights[start + n];
+            dOutput = std::clamp(dOutput, -gradClipThreshold, gradClipThreshold);
+
+            gradBiasO += dOutput;
+
+            // Hidden deltas overwrite the pre-activations, which aren't needed after this
+            for (int j = 0; j < HiddenSize; ++j)
+            {
+                const bool active = h[j] > 0.0f;
+                gradHO[j] += dOutput * (active ? h[j] : 0.0f);
+                h[j] = active ? dOutput * weightsHO[j] : 0.0f;
+            }
+
+            for (int j = 0; j < HiddenSize; ++j)
+                gradBiasH[j] += h[j];
+
+            for (int i = 0; i < InputSize; ++i)
+            {
+                const float x = input[i];
+                float* g = gradIH.data() + i * HiddenSize;
+
+                for (int j = 0; j < HiddenSize; ++j)
+                    g[j] += x * h[j];
+            }
+        }
+    }
+
+    // One Adam step on the mean gradient
+    ++timestep;
+    const float bc1 = 1.0f - std::pow(beta1, timestep);
+    const float bc2 = 1.0f - std::pow(beta2, timestep);
+    const float scale = 1.0f / static_cast<float>(numSamples);
+
+    auto adamStep = [&](float& weight, float& m, float& v, float grad, float decay)
+    {
+        grad *= scale;
+        m = beta1 * m + (1.0f - beta1) * grad;
+        v = beta2 * v + (1.0f - beta2) * grad * grad;
+        const float mHat = m / bc1;
+        const float vHat = v / bc2;
+        weight -= learningRate * (mHat / (std::sqrt(vHat) + epsilon) + decay * weight);
+    };
+
+    // Weights decay; biases don't
+    for (int idx = 0; idx < weightsIHSize; ++idx)
+        adamStep(weightsIH[idx], mIH[idx], vIH[idx], gradIH[idx], weightDecay);
+
+    for (int j = 0; j < HiddenSize; ++j)
+    {
+        adamStep(weightsHO[j], mHO[j], vHO[j], gradHO[j], weightDecay);
+        adamStep(biasH[j], mBiasH[j], vBiasH[j], gradBiasH[j], 0.0f);
+    }
+
+    adamStep(biasO, mBiasO, vBiasO, gradBiasO, 0.0f);
+}
+
+template <int InputSize, int HiddenSize>
+std::vector<float> FixedMLP<InputSize, HiddenSize>::getWeights() const
+{
+    std::vector<float> weights;
+    weights.reserve(getWeightCount());
+
+    weights.insert(weights.end(), weightsIH.begin(), weightsIH.end());
+    weights.insert(weights.end(), biasH.begin(), biasH.end());
+    weights.insert(weights.end(), weightsHO.begin(), weightsHO.end());
+    weights.push_back(biasO);
+
+    // Adam first moments
+    weights.insert(weights.end(), mIH.begin(), mIH.end());
+    weights.insert(weights.end(), mBiasH.begin(), mBiasH.end());
+    weights.insert(weights.end(), mHO.begin(), mHO.end());
+    weights.push_back(mBiasO);
+
+    // Adam second moments
+    weights.insert(weights.end(), vIH.begin(), vIH.end());
+    weights.insert(weights.end(), vBiasH.begin(), vBiasH.end());
+    weights.insert(weights.end(), vHO.begin(), vHO.end());
+    weights.push_back(vBiasO);
+
+    weights.push_back(static_cast<float>(timestep));
+
+    return weights;
+}
+
+template <int InputSize, int HiddenSize>
+bool FixedMLP<InputSize, HiddenSize>::setWeights(const std::vector<float>& weights)
+{
+    if (static_cast<int>(weights.size()) != getWeightCount())
+        return false;
+
+    auto next = weights.begin();
+    auto read = [&next](auto& values)
+    {
+        std::copy(next, next + static_cast<std::ptrdiff_t>(values.size()), values.begin());
+        next += static_cast<std::ptrdiff_t>(values.size());
+    };
+
+    read(weightsIH);
+    read(biasH);
+    read(weightsHO);
+    biasO = *next++;
+
+    // Adam first moments
+    read(mIH);
+    read(mBiasH);
+    read(mHO);
+    mBiasO = *next++;
+
+    // Adam second moments
+    read(vIH);
+    read(vBiasH);
+    read(vHO);
+    vBiasO = *next++;
+
+    timestep = static_cast<int>(*next++);
+
+    return true;
+}
+
+template class FixedMLP<17, 32>;
+template class FixedMLP<24, 32>;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+    FixedMLP.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Compile-time sized counterpart of MLP for the shapes the preference model
+    uses. Weights, Adam moments and scratch live in std::array members, so
+    nothing touches the heap after construction, and every loop has a
+    constant trip count the compiler can unroll and vectorise. Same maths,
+    same API and the same weight serialization as MLP, which stays available
+    for experimenting with other shapes.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+template <int InputSize, int HiddenSize>
+class FixedMLP
+{
+public:
+    // The same seed always gives the same initial weights
+    explicit FixedMLP(uint64_t seed = 0);
+
+    static constexpr int getInputSize() { return InputSize; }
+    static constexpr int getHiddenSize() { return HiddenSize; }
+
+    /**
+     * Forward pass: predict preference score [0, 1].
+     * Writes no state, so it is safe to call concurrently.
+     */
+    float predict(const std::vector<float>& input) const;
+
+    /**
+     * Batched forward pass over a row-major numSamples x InputSize matrix.
+     * Safe to call concurrently. Results match predict() exactly.
+     */
+    void predictBatch(const float* inputs, int numSamples, float* outputs) const;
+
+    // Single-sample training, as MLP::train
+    void train(const std::vector<float>& input, float target,
+               float learningRate = 0.05f, float sampleWeight = 1.0f);
+
+    // One Adam step on the weighted mean gradient of a mini-batch, as MLP::trainBatch
+    void trainBatch(const float* inputs, int numSamples, const float* targets,
+                    const float* sampleWeights, float learningRate = 0.05f);
+
+    // Same layout as MLP::getWeights, so saved weights load into either
+    std::vector<float> getWeights() const;
+
+    // Returns true if size matches, false otherwise
+    bool setWeights(const std::vector<float>& weights);
+
+    static constexpr int getWeightCount()
+    {
+        // Weights + biases, their Adam moments (m and v for each), + timestep
+        return 3 * (InputSize * HiddenSize + HiddenSize + HiddenSize + 1) + 1;
+    }
+
+private:
+    template <int, int> friend class QuantizedMLP;  // Reads the weights it quantizes
+
+    static constexpr int weightsIHSize = InputSize * HiddenSize;
+
+    // Samples whose hidden layer is held at once; longer batches run in tiles
+    static constexpr int tileSize = HiddenSize <= 256 ? 1024 / HiddenSize : 1;
+
+    using HiddenVector = std::array<float, HiddenSize>;
+
+    // Weights and biases; weightsIH is input-major as in MLP
+    std::array<float, weightsIHSize> weightsIH {};
+    HiddenVector biasH {};
+    HiddenVector weightsHO {};
+    float biasO = 0.0f;
+
+    // Adam optimizer state (first and second moment estimates)
+    std::array<float, weightsIHSize> mIH {}, vIH {};
+    HiddenVector mBiasH {}, vBiasH {};
+    HiddenVector mHO {}, vHO {};
+    float mBiasO = 0.0f, vBiasO = 0.0f;
+    int timestep = 0;
+
+    // Summed mini-batch gradients (reused)
+    std::array<float, weightsIHSize> gradIH {};
+    HiddenVector gradBiasH {}, gradHO {};
+
+    // Adam hyperparameters
+    static constexpr float beta1 = 0.9f;
+    static constexpr float beta2 = 0.999f;
+    static constexpr float epsilon = 1e-8f;
+    static constexpr float weightDecay = 1e-4f;
+    static constexpr float gradClipThreshold = 1.0f;
+
+    void initializeWeights(uint64_t seed);
+    void hiddenLayer(const float* input, float* hidden) const;
+    float outputLayer(const float* hidden) const;
+
+    static float relu(float x) { return x > 0.0f ? x : 0.0f; }
+    static float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+};
+
+extern template class FixedMLP<17, 32>;
+extern template class FixedMLP<24, 32>;
+
+using GenomeMLP = FixedMLP<17, 32>;  // Genome parameters in
+using AudioMLP = FixedMLP<24, 32>;   // Audio features in
@@ -19,10 +19,18 @@ struct GAConfig
     float epsilonMax = 0.5f;
     float epsilonMin = 0.05f;
     float epsilonDecay = 0.99f;
+    
+    // Uncertainty exploration: the bridge candidate is the offspring with the
+    // highest fitness + uncertaintyBonus * stddev (UCB over the model's
+    // ensemble) instead of an epsilon-greedy pick; needs a model with an
+    // uncertainty estimate, otherwise epsilon-greedy is kept
+    bool uncertaintyExploration = false;
+    float uncertaintyBonus = 1.0f;
 
     // Novelty bonus: reward individuals different from current population
     bool noveltyBonus = false;
     int noveltyK = 5;  // Number of nearest neighbors for novelty calculation
+    int noveltyArchiveSize = 0;  // Past elites kept as extra novelty neighbours (0 = off)
 
     // Multi-objective: combine MLP fitness with novelty
     bool multiObjective = false;
@@ -31,6 +39,81 @@ struct GAConfig
     // MLP input mode: genome parameters or audio features
     enum class MLPInputMode { Genome, Audio };
     MLPInputMode mlpInputMode = MLPInputMode::Genome;
+
+    // Individuals per island (at least one generation's offspring)
+    int populationSize = 50;
+    
+    // Threads used to evaluate offspring in parallel (0 = one per CPU core)
+    int numEvaluationThreads = 0;
+    
+    // Island model: independent sub-populations evolved in parallel, exchanging
+    // their best individual every migrationInterval generations (1 = off)
+    int numIslands = 1;
+    int migrationInterval = 10;
+    bool randomMigration = false;  // false = ring topology (island i -> i + 1)
+    
+    // Progressive evaluation: offspring get a cheap prefix score first, and
+    // those scoring below the population's worst by more than the margin are
+    // dropped without a full evaluation. Offspring then only replace members
+    // they beat. A share of rejections is fully evaluated anyway to measure
+    // how often early rejection is wrong.
+    bool progressiveEvaluation = false;
+    float earlyRejectMargin = 0.05f;
+    float rejectionAuditRate = 0.1f;
+    
+    // Surrogate filtering: offspring are ranked by the model's cheap
+    // surrogate (the genome MLP in audio mode) and only the top
+    // surrogateKeepFraction get a full evaluation; of the rest, the audit
+    // rate's share is fully evaluated anyway to measure how well the stages
+    // agree. Offspring then only replace members they beat. Takes precedence
+    // over progressive evaluation; needs a model with a surrogate
+    bool surrogateFiltering = false;
+    float surrogateKeepFraction = 0.3f;
+    
+    // Oversampled breeding: each generation breeds this many candidates,
+    // scores them all in one surrogate pass and keeps the best offspring
+    // (one generation's worth) to evaluate and insert. Off at or below a
+    // generation's offspring count, and when the model has no surrogate
+    int proposalBatchSize = 0;
+    static constexpr int offspringPerGeneration = 10;  // At a fixed budget
+    bool breedsProposals() const { return proposalBatchSize > offspringPerGeneration; }
+    
+    // Silence rejection: bred candidates whose predicted phrase level
+    // (GenomeConstraints::estimateLevelDb) is below inaudibleLevelDb are
+    // bred again, up to a few times each, before anything evaluates or
+    // renders them. Costs about a microsecond per candidate
+    bool silenceRejection = false;
+    float inaudibleLevelDb = -30.0f;
+    
+    // Generation budget (GenerationBudget): Fixed breeds the same offspring
+    // count every generation. Latency sizes generations from their measured
+    // cost so each takes targetLatencyMs, and a fetched preset is replaced
+    // within about that long; CpuTime gives each targetCpuMsPerSecond over
+    // the evaluation threads and idles out the rest of the second. Under
+    // either, proposalBatchSize scales with the offspring count
+    enum class BudgetMode { Fixed, Latency, CpuTime };
+    BudgetMode budgetMode = BudgetMode::Fixed;
+    float targetLatencyMs = 150.0f;
+    float targetCpuMsPerSecond = 250.0f;
+    
+    // Parent selection (SelectionOperators.h): Tournament takes the best of
+    // tournamentSize random members; Rank draws by linear rank, the best
+    // rankPressure (1 to 2) times as often as the average; Stochastic
+    // universal sampling is fitness proportional with evenly spaced draws.
+    // Every generation's parents are drawn in one pass
+    enum class SelectionMode { Tournament, Rank, StochasticUniversal };
+    SelectionMode selectionMode = SelectionMode::Tournament;
+    int tournamentSize = 3;
+    float rankPressure = 1.5f;
+    
+    // Replacement: WorstN has each offspring take a worst member's place
+    // (only members they beat under progressive or surrogate evaluation);
+    // Crowding has each replace the nearest of crowdingSize random members
+    // if fitter, keeping distinct niches; ElitistSteadyState always keeps
+    // the best of population and offspring
+    enum class ReplacementMode { WorstN, Crowding, ElitistSteadyState };
+    ReplacementMode replacementMode = ReplacementMode::WorstN;
+    int crowdingSize = 3;
     
     juce::String toString() const
     {
@@ -38,7 +121,10 @@ struct GAConfig
         
         if (mlpInputMode == MLPInputMode::Audio)
             result = "audio";
-        else if (!adaptiveExploration && !noveltyBonus && !multiObjective)
+        else if (!adaptiveExploration && !noveltyBonus && !multiObjective && numIslands <= 1
+                 && !progressiveEvaluation && !uncertaintyExploration && !surrogateFiltering
+                 && !breedsProposals() && !silenceRejection && budgetMode == BudgetMode::Fixed
+                 && selectionMode == SelectionMode::Tournament && replacementMode == ReplacementMode::WorstN)
             return "baseline";
         
         if (adaptiveExploration)
@@ -47,6 +133,30 @@ struct GAConfig
             result += (result.isEmpty() ? "" : "+") + juce::String("novelty");
         if (multiObjective)
             result += (result.isEmpty() ? "" : "+") + juce::String("multiobjective");
+        if (numIslands > 1)
+            result += (result.isEmpty() ? "" : "+") + juce::String("islands") + juce::String(numIslands);
+        if (progressiveEvaluation)
+            result += (result.isEmpty() ? "" : "+") + juce::String("progressive");
+        if (uncertaintyExploration)
+            result += (result.isEmpty() ? "" : "+") + juce::String("ucb");
+        if (surrogateFiltering)
+            result += (result.isEmpty() ? "" : "+") + juce::String("surrogate");
+        if (breedsProposals())
+            result += (result.isEmpty() ? "" : "+") + juce::String("proposals") + juce::String(proposalBatchSize);
+        if (silenceRejection)
+            result += (result.isEmpty() ? "" : "+") + juce::String("silence");
+        if (budgetMode == BudgetMode::Latency)
+            result += (result.isEmpty() ? "" : "+") + juce::String("latency") + juce::String(juce::roundToInt(targetLatencyMs));
+        if (budgetMode == BudgetMode::CpuTime)
+            result += (result.isEmpty() ? "" : "+") + juce::String("cpu") + juce::String(juce::roundToInt(targetCpuMsPerSecond));
+        if (selectionMode == SelectionMode::Rank)
+            result += (result.isEmpty() ? "" : "+") + juce::String("rank");
+        if (selectionMode == SelectionMode::StochasticUniversal)
+            result += (result.isEmpty() ? "" : "+") + juce::String("sus");
+        if (replacementMode == ReplacementMode::Crowding)
+            result += (result.isEmpty() ? "" : "+") + juce::String("crowding");
+        if (replacementMode == ReplacementMode::ElitistSteadyState)
+            result += (result.isEmpty() ? "" : "+") + juce::String("elitist");
         
         if (result.isEmpty())
             result = "baseline";
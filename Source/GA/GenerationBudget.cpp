@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+    GenerationBudget.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "GenerationBudget.h"
+#include <algorithm>
+#include <cmath>
+
+void GenerationBudget::setTarget(Mode newMode, float latencyMs, float cpuMs)
+{
+    latencyTargetMs.store(std::max(1.0f, latencyMs));
+    cpuTargetMsPerSecond.store(std::clamp(cpuMs, 1.0f, 1000.0f));
+    mode.store(newMode);
+}
+
+double GenerationBudget::getTargetSeconds(int numSlots) const
+{
+    switch (mode.load())
+    {
+        case Mode::Latency:
+            return latencyTargetMs.load() / 1000.0;
+
+        // The slots share the CPU time, one generation's worth per second
+        case Mode::CpuTime:
+            return cpuTargetMsPerSecond.load() / 1000.0 / std::max(1, numSlots);
+
+        case Mode::Fixed:
+            break;
+    }
+
+    return 0.0;
+}
+
+int GenerationBudget::getOffspringCount(int fixedOffspring, int maxOffspring, int numSlots)
+{
+    const double targetSeconds = getTargetSeconds(numSlots);
+    const float perOffspring = msPerOffspring.load();
+    int count = fixedOffspring;
+
+    if (targetSeconds > 0.0 && perOffspring > 0.0f)
+    {
+        const int last = std::max(minOffspring, lastOffspring.load());
+        const double fitting = std::floor(targetSeconds * 1000.0 / perOffspring);
+        const double grown = std::ceil(last * static_cast<double>(maxGrowth));
+
+        count = static_cast<int>(std::clamp(std::min(fitting, grown), static_cast<double>(minOffspring),
+                                            static_cast<double>(std::max(minOffspring, maxOffspring))));
+    }
+
+    lastOffspring.store(count);
+    lastSlots.store(numSlots);
+    return count;
+}
+
+void GenerationBudget::recordGeneration(int numOffspring, double seconds)
+{
+    if (numOffspring <= 0 || seconds <= 0.0)
+        return;
+
+    const float ms = static_cast<float>(seconds * 1000.0);
+    smooth(generationMs, ms);
+    smooth(msPerOffspring, ms / static_cast<float>(numOffspring));
+}
+
+void GenerationBudget::recordFetchLatency(double seconds)
+{
+    smooth(fetchLatencyMs, static_cast<float>(seconds * 1000.0));
+}
+
+void GenerationBudget::recordCycle(double busySeconds, int numSlots, double cycleSeconds)
+{
+    if (cycleSeconds > 0.0)
+        smooth(cpuMsPerSecond, static_cast<float>(busySeconds * std::max(1, numSlots) * 1000.0 / cycleSeconds));
+}
+
+double GenerationBudget::getPauseSeconds(double busySeconds, int numSlots) const
+{
+    if (mode.load() != Mode::CpuTime || busySeconds <= 0.0)
+        return 0.0;
+
+    // busy * slots core-seconds spread over busy + pause seconds averages the target
+    const double allowed = cpuTargetMsPerSecond.load() / 1000.0;
+    return std::clamp(busySeconds * (std::max(1, numSlots) / allowed - 1.0), 0.0, maxPauseSeconds);
+}
+
+GenerationBudget::Stats GenerationBudget::getStats() const
+{
+    Stats stats;
+    stats.mode = mode.load();
+    stats.offspringPerGeneration = lastOffspring.load();
+    stats.targetMs = static_cast<float>(getTargetSeconds(lastSlots.load()) * 1000.0);
+    stats.generationMs = generationMs.load();
+    stats.msPerOffspring = msPerOffspring.load();
+    stats.fetchLatencyMs = fetchLatencyMs.load();
+    stats.cpuMsPerSecond = cpuMsPerSecond.load();
+    return stats;
+}
+
+void GenerationBudget::smooth(std::atomic<float>& average, float value)
+{
+    // The first measurement seeds the average; written by one thread only
+    const float previous = average.load();
+    average.store(previous > 0.0f ? previous + smoothing * (value - previous) : value);
+}
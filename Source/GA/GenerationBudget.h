@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+    GenerationBudget.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Sizes GA generations to a time target instead of a fixed offspring
+    count. A generation's time is some overhead plus a cost per offspring
+    (breeding, surrogate passes, evaluations and, in audio mode, renders).
+    After each generation the measured time per offspring updates a
+    smoothed estimate, and the next generation gets as many offspring as
+    fit the target. As the overhead is folded into that estimate, the size
+    settles where the whole generation takes the target time. A latency
+    target is a generation's wall time, so a fetched preset's replacement
+    is ready within about that long. A CPU target is an average of so
+    many milliseconds per second, counted over the evaluation threads:
+    each generation gets that much and the thread idles out the rest.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "GAConfig.h"
+#include <atomic>
+
+class GenerationBudget
+{
+public:
+    using Mode = GAConfig::BudgetMode;
+
+    static constexpr int minOffspring = 2;       // Fewest offspring a generation is cut to
+    static constexpr float smoothing = 0.3f;     // Weight of the newest measurement
+    static constexpr float maxGrowth = 2.0f;     // Largest step up from one generation to the next
+    static constexpr double maxPauseSeconds = 1.0;  // Longest single pause, as CpuBudget's
+
+    void setTarget(Mode mode, float latencyMs, float cpuMsPerSecond);
+    Mode getMode() const { return mode.load(); }
+
+    // Wall time a generation on numSlots threads should take; 0 for a fixed size
+    double getTargetSeconds(int numSlots) const;
+
+    /**
+     * Offspring for the next generation: fixedOffspring for a fixed size or
+     * until a generation has been measured, else as many as the target
+     * allows, in [minOffspring, maxOffspring].
+     */
+    int getOffspringCount(int fixedOffspring, int maxOffspring, int numSlots);
+
+    // A generation that bred numOffspring (per island) took seconds; skip ones that re-scored
+    void recordGeneration(int numOffspring, double seconds);
+
+    // Seconds from a fetch to the next candidate being queued
+    void recordFetchLatency(double seconds);
+
+    // A generation was busy for busySeconds on numSlots threads, out of cycleSeconds of wall time
+    void recordCycle(double busySeconds, int numSlots, double cycleSeconds);
+
+    // Idle after busySeconds on numSlots threads that keeps a CPU target's average; 0 otherwise
+    double getPauseSeconds(double busySeconds, int numSlots) const;
+
+    struct Stats
+    {
+        Mode mode = Mode::Fixed;
+        int offspringPerGeneration = 0;  // Chosen for the latest generation
+        float targetMs = 0.0f;           // Generation time aimed at; 0 for a fixed size
+        float generationMs = 0.0f;       // Measured generation time (smoothed)
+        float msPerOffspring = 0.0f;     // Measured time per offspring, overhead included (smoothed)
+        float fetchLatencyMs = 0.0f;     // Fetch to the next queued candidate (smoothed; 0 = none yet)
+        float cpuMsPerSecond = 0.0f;     // Busy time x threads per second of wall time (smoothed)
+    };
+
+    Stats getStats() const;  // Any thread
+
+private:
+    std::atomic<Mode> mode { Mode::Fixed };
+    std::atomic<float> latencyTargetMs { 150.0f };
+    std::atomic<float> cpuTargetMsPerSecond { 250.0f };
+
+    std::atomic<int> lastOffspring { 0 };
+    std::atomic<int> lastSlots { 1 };
+    std::atomic<float> generationMs { 0.0f };
+    std::atomic<float> msPerOffspring { 0.0f };
+    std::atomic<float> fetchLatencyMs { 0.0f };
+    std::atomic<float> cpuMsPerSecond { 0.0f };
+
+    static void smooth(std::atomic<float>& average, float value);
+};
@@ -16,15 +16,81 @@
 #include "CrossoverOperators.h"
 #include "MutationOperators.h"
 #include "IFitnessModel.h"
+#include "WorkerPool.h"
+#include "NoveltyIndex.h"
+#include "GenomeConstraints.h"
+#include "Trace.h"
 #include <algorithm>
+#include <numeric>
 #include <vector>
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include <random>
 
+namespace
+{
+    constexpr uint32_t snapshotVersion = 2;
+
+    // Snapshot header; per island, its two streams, genome matrix and fitness follow it
+    struct SnapshotHeader
+    {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t parameterCount;
+        uint32_t numIslands;
+        uint32_t populationSize;
+        int32_t generationCount;
+        RandomStream::State rngState;  // The stream run keys are drawn from
+        float epsilon;
+        uint32_t reserved;
+        uint64_t checksum;  // FNV-1a over the payload
+    };
+
+    size_t getIslandSnapshotBytes(size_t populationSize, size_t parameterCount)
+    {
+        return 2 * sizeof(RandomStream::State) + populationSize * (parameterCount + 1) * sizeof(float);
+    }
+
+    // Child streams of an island's stream, one per call site
+    enum IslandStream : uint64_t { initStream = 1, breedingStream, choiceStream };
+
+    uint64_t checksum(const void* data, size_t bytes)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        const auto* p = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            hash ^= p[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    bool isValidSnapshot(const void* data, size_t size, int parameterCount)
+    {
+        if (data == nullptr || size < sizeof(SnapshotHeader))
+            return false;
+
+        SnapshotHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        return std::memcmp(header.magic, "PPGS", 4) == 0 && header.formatVersion == snapshotVersion
+            && header.parameterCount == static_cast<uint32_t>(parameterCount)
+            && header.numIslands > 0 && header.populationSize > 0
+            && size == sizeof(SnapshotHeader) + header.numIslands * getIslandSnapshotBytes(header.populationSize, header.parameterCount)
+            && checksum(static_cast<const char*>(data) + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader)) == header.checksum;
+    }
+}
+
 GeneticAlgorithm::GeneticAlgorithm(IFitnessModel& model) 
-    : juce::Thread("GeneticAlgorithm"), fitnessModel(model)
+    : juce::Thread("GeneticAlgorithm"),
+      rng(static_cast<uint64_t>(juce::Random::getSystemRandom().nextInt64())),  // Unseeded runs differ
+      fitnessModel(model)
 {
-    parameterBridge = std::make_unique<ParameterBridge>();
+    parameterBridge = std::make_unique<ParameterBridge>(CANDIDATE_QUEUE_CAPACITY, PARAMETER_COUNT);
 }
 
 GeneticAlgorithm::~GeneticAlgorithm()
@@ -39,6 +105,13 @@ void GeneticAlgorithm::startGA()
     
     paused.store(false);
     pauseEvent.signal();
+    
+    // Restoring is only a copy, so a resumed population's first candidates
+    // are queued before the thread starts; run() re-scores it
+    if (!populationInitialized && restoreSnapshot())
+        offerIslandBests();
+    
+    juce::Thread::setAffinityMask(affinityMask.load());  // 0 = any core
     startThread(juce::Thread::Priority::normal);
 }
 
@@ -47,8 +120,9 @@ void GeneticAlgorithm::stopGA()
     // Signal the thread to stop
     signalThreadShouldExit();
     
-    // Wake up the thread if it's paused
+    // Wake up the thread if it's paused or waiting for the mailbox
     pauseEvent.signal();
+    parameterBridge->wakeProducer();
     
     // Wait for the thread to finish (with timeout for safety)
     stopThread(2000); // 2 second timeout
@@ -56,7 +130,10 @@ void GeneticAlgorithm::stopGA()
     // Reset pause state
     paused.store(false);
     
-    // Reset population initialization flag so it will re-initialize on next start
+    // Keep the population so the next start resumes from it
+    if (populationInitialized && !isThreadRunning())
+        publishSnapshot();
+    
     populationInitialized = false;
 }
 
@@ -66,6 +143,7 @@ void GeneticAlgorithm::pauseGA()
     {
         paused.store(true);
         pauseEvent.reset(); // Clear the event so thread will wait
+        parameterBridge->wakeProducer(); // Move from the mailbox wait to the pause wait
     }
 }
 
@@ -78,98 +156,338 @@ void GeneticAlgorithm::resumeGA()
     }
 }
 
+void GeneticAlgorithm::setEvaluationPool(std::shared_ptr<WorkerPool> pool)
+{
+    std::lock_guard<std::mutex> lock(sharedPoolMutex);
+    sharedPool = std::move(pool);
+}
+
+void GeneticAlgorithm::ensureEvaluationPool()
+{
+    std::shared_ptr<WorkerPool> shared;
+    {
+        std::lock_guard<std::mutex> lock(sharedPoolMutex);
+        shared = sharedPool;
+    }
+    
+    if (shared != nullptr)
+    {
+        if (evaluationPool != shared)
+        {
+            evaluationPool = std::move(shared);
+            usingSharedPool = true;
+            fitnessModel.prepareForConcurrency(evaluationPool->getNumSlots());
+        }
+        return;
+    }
+    
+    int requested = config.numEvaluationThreads > 0 ? config.numEvaluationThreads
+                                                    : juce::SystemStats::getNumCpus();
+    requested = cpuBudget.capThreads(requested);
+    const uint32_t mask = affinityMask.load();
+    
+    if (evaluationPool == nullptr || evaluationPool->getNumSlots() != requested || poolAffinityMask != mask
+        || usingSharedPool)
+    {
+        evaluationPool = std::make_shared<WorkerPool>(requested, juce::Thread::Priority::normal, mask);
+        poolAffinityMask = mask;
+        usingSharedPool = false;
+        fitnessModel.prepareForConcurrency(evaluationPool->getNumSlots());
+    }
+}
+
 void GeneticAlgorithm::initializePopulation(bool checkExitSignal)
 {
-    // Create population with configured size and parameter count
-    population = std::make_unique<Population>(POPULATION_SIZE, PARAMETER_COUNT);
+    if (restoreSnapshot())
+    {
+        rescorePopulation(checkExitSignal);
+        return;
+    }
+    
+    const int numIslands = std::max(1, config.numIslands);
+    const int populationSize = std::max(OFFSPRING_PER_GENERATION, config.populationSize);
+    const uint64_t modelVersion = fitnessModel.getModelVersion();
+    
+    islands.clear();
+    islands.resize(static_cast<size_t>(numIslands));
+    generationCount = 0;
     
-    // Initialize with random parameters
-    population->initializeRandom();
+    ensureEvaluationPool();
     
-    // Evaluate initial population
-    for (int i = 0; i < population->size(); ++i)
+    auto& fitness = populationFitness;
+    fitness.resize(static_cast<size_t>(populationSize));
+    
+    // A fresh run key per initialisation; every island gets its own streams
+    // from it, so parallel islands never share state
+    const uint64_t runKey = rng.next64();
+    
+    for (size_t index = 0; index < islands.size(); ++index)
     {
+        auto& island = islands[index];
+        const RandomStream islandStream(runKey, index);
+        island.rng = islandStream.split(breedingStream);
+        island.choiceRng = islandStream.split(choiceStream);
+        
+        // Create population with configured size and parameter count
+        island.population = std::make_unique<Population>(populationSize, PARAMETER_COUNT);
+        
+        // Initialize with random parameters
+        RandomStream initRng = islandStream.split(initStream);
+        island.population->initializeRandom(initRng);
+        
+        island.noveltyIndex = std::make_unique<NoveltyIndex>(PARAMETER_COUNT, config.noveltyArchiveSize);
+        island.noveltyIndexValid = false;
+        island.parents.resize(2 * MAX_OFFSPRING_PER_GENERATION);
+        
+        // Evaluate initial population as one batch, straight from the genome matrix
+        evaluateGenomes(island, island.population->getGenomeMatrix(), populationSize, fitness.data(), true);
+        
         if (checkExitSignal && threadShouldExit())
             return;
-            
-        Individual& individual = const_cast<Individual&>((*population)[i]);
-        float fitness = evaluateIndividual(individual);
-        individual.setFitness(fitness);
+        
+        for (int i = 0; i < populationSize; ++i)
+            island.population->setFitness(i, fitness[i]);
     }
     
-    // Update statistics to find best individual
-    population->markDirty();
-    
     populationInitialized = true;
+    rescorePending = false;
+    scoredModelVersion = modelVersion;
+    publishSnapshot();
 }
 
-float GeneticAlgorithm::evaluateIndividual(const Individual& individual)
+void GeneticAlgorithm::rescorePopulation(bool checkExitSignal)
 {
-    float mlpFitness = fitnessModel.evaluate(individual.getParameters());
+    PPG_TRACE_ZONE("GA rescore");
     
-    if (config.multiObjective && config.noveltyBonus && population)
+    // Read first: an update landing mid-pass gets another pass
+    const uint64_t modelVersion = fitnessModel.getModelVersion();
+    ensureEvaluationPool();
+    
+    const int populationSize = islands.front().population->size();
+    auto& fitness = populationFitness;
+    fitness.resize(static_cast<size_t>(populationSize));
+    
+    for (auto& island : islands)
     {
-        float novelty = computeNovelty(individual);
-        return computeCombinedFitness(mlpFitness, novelty);
+        evaluateGenomes(island, island.population->getGenomeMatrix(), populationSize, fitness.data(), true);
+        
+        if (checkExitSignal && threadShouldExit())
+            return;
+        
+        for (int i = 0; i < populationSize; ++i)
+            island.population->setFitness(i, fitness[static_cast<size_t>(i)]);
     }
     
-    return mlpFitness;
+    rescorePending = false;
+    scoredModelVersion = modelVersion;
+    ++rescoreCount;
+    publishSnapshot();
 }
 
-void GeneticAlgorithm::setConfig(const GAConfig& cfg)
+void GeneticAlgorithm::offerIslandBests()
 {
-    config = cfg;
-    if (config.adaptiveExploration)
+    for (auto& island : islands)
     {
-        currentEpsilon = config.epsilonMax;
+        if (island.population && island.population->hasBest())
+        {
+            IndividualView best = island.population->getBest();
+            parameterBridge->push(best.data(), best.getParameterCount(), best.getFitness());
+        }
     }
-    else
+}
+
+bool GeneticAlgorithm::getPopulationSnapshot(juce::MemoryBlock& destData) const
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    
+    if (snapshot.getSize() == 0)
+        return false;
+    
+    destData = snapshot;
+    return true;
+}
+
+bool GeneticAlgorithm::setPopulationSnapshot(const void* data, size_t sizeInBytes)
+{
+    if (!isValidSnapshot(data, sizeInBytes, PARAMETER_COUNT))
+        return false;
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    snapshot = juce::MemoryBlock(data, sizeInBytes);
+    return true;
+}
+
+void GeneticAlgorithm::clearPopulationSnapshot()
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    snapshot.reset();
+}
+
+void GeneticAlgorithm::publishSnapshot()
+{
+    PPG_TRACE_ZONE("GA snapshot");
+    
+    const auto numIslands = islands.size();
+    const auto populationSize = static_cast<size_t>(islands.front().population->size());
+    const size_t genomeBytes = populationSize * PARAMETER_COUNT * sizeof(float);
+    const size_t bytes = sizeof(SnapshotHeader) + numIslands * getIslandSnapshotBytes(populationSize, PARAMETER_COUNT);
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    
+    // Same size every generation, so only the first publish allocates
+    snapshot.setSize(bytes);
+    auto* data = static_cast<char*>(snapshot.getData());
+    char* write = data + sizeof(SnapshotHeader);
+    
+    for (const auto& island : islands)
     {
-        currentEpsilon = DEFAULT_EXPLORATION_RATE;
+        const RandomStream::State streams[] = { island.rng.getState(), island.choiceRng.getState() };
+        std::memcpy(write, streams, sizeof(streams));
+        write += sizeof(streams);
+        
+        std::memcpy(write, island.population->getGenomeMatrix(), genomeBytes);
+        write += genomeBytes;
+        
+        std::memcpy(write, island.population->getFitnessArray(), populationSize * sizeof(float));
+        write += populationSize * sizeof(float);
     }
+    
+    SnapshotHeader header {};
+    std::memcpy(header.magic, "PPGS", 4);
+    header.formatVersion = snapshotVersion;
+    header.parameterCount = PARAMETER_COUNT;
+    header.numIslands = static_cast<uint32_t>(numIslands);
+    header.populationSize = static_cast<uint32_t>(populationSize);
+    header.generationCount = generationCount;
+    header.rngState = rng.getState();
+    header.epsilon = currentEpsilon;
+    header.checksum = checksum(data + sizeof(SnapshotHeader), bytes - sizeof(SnapshotHeader));
+    std::memcpy(data, &header, sizeof(header));
 }
 
-float GeneticAlgorithm::computeNovelty(const Individual& individual)
+bool GeneticAlgorithm::restoreSnapshot()
 {
-    if (!population || population->size() < 2)
-        return 0.0f;
+    const int numIslands = std::max(1, config.numIslands);
+    const int populationSize = std::max(OFFSPRING_PER_GENERATION, config.populationSize);
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    
+    if (snapshot.getSize() == 0)
+        return false;
     
-    const auto& params = individual.getParameters();
-    std::vector<float> distances;
-    distances.reserve(population->size());
+    // Validated when it was set or published, so only its shape can be wrong
+    const auto* data = static_cast<const char*>(snapshot.getData());
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
     
-    for (int i = 0; i < population->size(); ++i)
+    if (header.numIslands != static_cast<uint32_t>(numIslands) || header.populationSize != static_cast<uint32_t>(populationSize))
+        return false;
+    
+    islands.clear();
+    islands.resize(static_cast<size_t>(numIslands));
+    generationCount = header.generationCount;
+    rng.setState(header.rngState);
+    
+    if (config.adaptiveExploration)
+        currentEpsilon = juce::jlimit(config.epsilonMin, config.epsilonMax, header.epsilon);
+    
+    const char* read = data + sizeof(SnapshotHeader);
+    
+    for (auto& island : islands)
     {
-        const auto& otherParams = (*population)[i].getParameters();
-        if (&otherParams == &params)
-            continue;
+        RandomStream::State streams[2];
+        std::memcpy(streams, read, sizeof(streams));
+        read += sizeof(streams);
+        island.rng.setState(streams[0]);
+        island.choiceRng.setState(streams[1]);
+        
+        island.population = std::make_unique<Population>(populationSize, PARAMETER_COUNT);
+        island.noveltyIndex = std::make_unique<NoveltyIndex>(PARAMETER_COUNT, config.noveltyArchiveSize);
+        island.noveltyIndexValid = false;
         
-        float sumSq = 0.0f;
-        for (size_t j = 0; j < params.size(); ++j)
+        const char* fitness = read + static_cast<size_t>(populationSize) * PARAMETER_COUNT * sizeof(float);
+        Genome<PARAMETER_COUNT> genome;
+        
+        for (int i = 0; i < populationSize; ++i)
         {
-            float diff = params[j] - otherParams[j];
-            sumSq += diff * diff;
+            float value;
+            std::memcpy(genome.data(), read, sizeof(genome));
+            std::memcpy(&value, fitness + static_cast<size_t>(i) * sizeof(float), sizeof(value));
+            read += sizeof(genome);
+            island.population->replace(i, genome.data(), value);
         }
-        distances.push_back(std::sqrt(sumSq));
+        
+        read = fitness + static_cast<size_t>(populationSize) * sizeof(float);
     }
     
-    if (distances.empty())
-        return 0.0f;
+    populationInitialized = true;
+    rescorePending = true;
+    return true;
+}
+
+void GeneticAlgorithm::evaluateGenomes(Island& island, const float* genomes, int numGenomes,
+                                       float* fitnessOut, bool populationRows)
+{
+    // One batch per pool slot keeps every thread busy with a single model call.
+    // Islands evolving on pool workers land here nested, so this runs inline.
+    const int numBatches = std::min(evaluationPool->getNumSlots(), numGenomes);
+    
+    PPG_TRACE_ZONE("GA evaluate");
+    evaluationPool->parallelFor(numBatches, [&](int batch, int)
+    {
+        if (threadShouldExit())
+            return;
+        
+        int begin = numGenomes * batch / numBatches;
+        int end = numGenomes * (batch + 1) / numBatches;
+        
+        fitnessModel.evaluateBatch(genomes + begin * PARAMETER_COUNT, end - begin,
+                                   PARAMETER_COUNT, fitnessOut + begin);
+    });
+    
+    if (isNoveltyEnabled() && island.population)
+    {
+        PPG_TRACE_ZONE("GA novelty");
+        
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            float novelty = computeNovelty(island, genomes + i * PARAMETER_COUNT, populationRows ? i : -1);
+            fitnessOut[i] = computeCombinedFitness(fitnessOut[i], novelty);
+        }
+    }
+}
+
+void GeneticAlgorithm::setConfig(const GAConfig& cfg)
+{
+    config = cfg;
+    generationBudget.setTarget(config.budgetMode, config.targetLatencyMs, config.targetCpuMsPerSecond);
+    if (config.adaptiveExploration)
+    {
+        currentEpsilon = config.epsilonMax;
+    }
+    else
+    {
+        currentEpsilon = DEFAULT_EXPLORATION_RATE;
+    }
+}
+
+float GeneticAlgorithm::computeNovelty(Island& island, const float* genome, int selfIndex)
+{
+    const auto& population = island.population;
     
-    std::sort(distances.begin(), distances.end());
+    if (!population || population->size() < 2)
+        return 0.0f;
     
-    int k = std::min(config.noveltyK, static_cast<int>(distances.size()));
-    float sum = 0.0f;
-    for (int i = 0; i < k; ++i)
+    if (!island.noveltyIndexValid)
     {
-        sum += distances[i];
+        island.noveltyIndex->rebuild(*population);
+        island.noveltyIndexValid = true;
     }
     
-    float avgDist = sum / static_cast<float>(k);
+    if (selfIndex >= 0)
+        return island.noveltyIndex->memberNovelty(*population, selfIndex, config.noveltyK);
     
-    // Normalize: max distance in unit hypercube is sqrt(PARAMETER_COUNT)
-    float maxDist = std::sqrt(static_cast<float>(PARAMETER_COUNT));
-    return std::min(avgDist / maxDist, 1.0f);
+    return island.noveltyIndex->candidateNovelty(*population, genome, config.noveltyK);
 }
 
 float GeneticAlgorithm::computeCombinedFitness(float mlpFitness, float novelty)
@@ -185,144 +503,713 @@ void GeneticAlgorithm::run()
         DBG("Initializing population on background thread");
         initializePopulation(true);
         
-        if (population && population->size() > 0 && population->hasBest())
-        {
-            Individual& best = population->getBest();
-            parameterBridge->push(best.getParameters(), best.getFitness());
-        }
+        // Seed the queue with each island's best
+        offerIslandBests();
+    }
+    else if (rescorePending)
+    {
+        rescorePopulation(true);
     }
     
+    ensureEvaluationPool();
+    cycleStartTicks = 0;  // Time the thread was stopped isn't a cycle
+    
     // Main GA loop
     while (!threadShouldExit()) 
     {
-        // Handle pause state
+        // Handle pause state (resumeGA/stopGA signal the event)
         if (paused.load()) 
         {
-            pauseEvent.wait(100);
+            pauseEvent.wait();
             continue;
         }
         
         if (threadShouldExit()) 
             break;
-            
-        // Generate and evaluate offspring
-        TournamentSelection selector;
-        selector.tournamentSize = 3;
-        UniformCrossover crossover;
-        UniformMutation mutation;
-        mutation.mutationRate = 0.2f;    // Increased from 0.1f for more diversity
-        mutation.mutationStrength = 0.4f; // Increased from 0.2f for larger jumps
-        
-        // Check if the previous best preset has been picked up by user.
-        // If the mailbox is full, wait.
-        if (parameterBridge->hasData())
-        {
-            // Wait for 100ms and check again
-            pauseEvent.wait(100);
+        
+        // Block while the candidate queue is full; pop() wakes us so the
+        // next generation starts as soon as the user takes a preset
+        if (!parameterBridge->waitForSpace())
             continue;
-        }
         
-        // Generate offspring
-        std::vector<Individual> offspring;
-        offspring.reserve(OFFSPRING_PER_GENERATION);
+        const auto start = juce::Time::getHighResolutionTicks();
+        if (cycleStartTicks != 0)
+            generationBudget.recordCycle(lastBusySeconds, evaluationPool->getNumSlots(),
+                                         juce::Time::highResolutionTicksToSeconds(start - cycleStartTicks));
+        cycleStartTicks = start;
         
-        for (int i = 0; i < OFFSPRING_PER_GENERATION; ++i)
+        stepGeneration();
+        threadCpuMeter.sample();
+        
+        // Idle off whatever the generation used beyond either budget
+        const double busy = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        const int numSlots = evaluationPool->getNumSlots();
+        lastBusySeconds = busy;
+        PPG_TRACE_ZONE("GA budget pause");
+        CpuBudget::pause(*this, std::max(cpuBudget.getPauseSeconds(busy, numSlots),
+                                         generationBudget.getPauseSeconds(busy, numSlots)));
+    }
+}
+
+void GeneticAlgorithm::stepGeneration()
+{
+    PPG_TRACE_ZONE("GA generation");
+    
+    // Generations that also built or re-scored the population aren't
+    // representative of the budget's cost per offspring
+    bool representative = true;
+    
+    if (!populationInitialized)
+    {
+        initializePopulation(false);
+        if (!populationInitialized)
+            return;
+        representative = false;
+    }
+    else if (rescorePending || fitnessModel.getModelVersion() != scoredModelVersion)
+    {
+        // Scores from before a model update would steer selection and replacement
+        rescorePopulation(false);
+        representative = false;
+    }
+    
+    ensureEvaluationPool();
+    
+    const int numIslands = static_cast<int>(islands.size());
+    const auto start = juce::Time::getHighResolutionTicks();
+    
+    // Half the population at most, so a generous budget can't turn the steady state into replacing everyone
+    const int populationSize = islands.front().population->size();
+    const int maxOffspring = juce::jlimit(OFFSPRING_PER_GENERATION, MAX_OFFSPRING_PER_GENERATION, populationSize / 2);
+    offspringPerGeneration = generationBudget.getOffspringCount(OFFSPRING_PER_GENERATION, maxOffspring,
+                                                                evaluationPool->getNumSlots());
+    
+    // Islands evolve concurrently, one per pool slot; a lone island keeps
+    // the pool for batch evaluation instead
+    if (numIslands == 1)
+        evolveIsland(islands.front());
+    else
+        evaluationPool->parallelFor(numIslands, [this](int index, int) { evolveIsland(islands[static_cast<size_t>(index)]); });
+    
+    if (threadShouldExit())
+        return;
+    
+    ++generationCount;
+    
+    if (numIslands > 1 && config.migrationInterval > 0 && generationCount % config.migrationInterval == 0)
+        migrate();
+    
+    PPG_TRACE_COUNTER("GA best fitness", getPopulationStats().bestFitness);
+    
+    // Only this thread produces into the SPSC bridge; candidates beyond its capacity are dropped.
+    // A queued candidate is what the user rates next, so let the model get ahead on it.
+    for (auto& island : islands)
+    {
+        if (island.hasCandidate && !parameterBridge->isFull())
         {
-            // Check for pause/exit periodically
-            if (threadShouldExit())
-                break;
-                
-            if (paused.load())
+            parameterBridge->push(island.candidate.data(), PARAMETER_COUNT, island.candidateFitness);
+            fitnessModel.prefetch(island.candidate.data(), 1, PARAMETER_COUNT);
+            
+            // The first candidate queued since the user last took one
+            const juce::int64 fetchTicks = parameterBridge->getLastPopTicks();
+            if (fetchTicks != measuredFetchTicks)
             {
-                pauseEvent.wait(100);
-                continue;
+                generationBudget.recordFetchLatency(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - fetchTicks));
+                measuredFetchTicks = fetchTicks;
             }
+        }
+    }
+    
+    if (representative)
+        generationBudget.recordGeneration(offspringPerGeneration,
+                                          juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+    
+    // Decay epsilon if adaptive exploration is enabled
+    if (config.adaptiveExploration)
+    {
+        currentEpsilon = std::max(config.epsilonMin, currentEpsilon * config.epsilonDecay);
+    }
+    
+    publishSnapshot();
+}
+
+void GeneticAlgorithm::evolveIsland(Island& island)
+{
+    auto& population = *island.population;
+    auto& islandRng = island.rng;
+    island.hasCandidate = false;
+    
+    // Generate and evaluate offspring
+    UniformCrossover crossover;
+    UniformMutation mutation;
+    mutation.mutationRate = 0.2f;    // Increased from 0.1f for more diversity
+    mutation.mutationStrength = 0.4f; // Increased from 0.2f for larger jumps
+    
+    auto breed = [&](float* child, const int* parents)
+    {
+        // Create offspring via crossover, then mutate in place
+        crossover(population[parents[0]], population[parents[1]], child, islandRng);
+        mutation(child, PARAMETER_COUNT, islandRng);
+    };
+    
+    // Breed straight into the offspring arena, or oversample into the
+    // proposal arena and keep the best. The arena only grows, so a budget
+    // that varies the count doesn't reallocate every generation
+    const int numProposals = getProposalCount(offspringPerGeneration);
+    const size_t proposalCount = static_cast<size_t>(numProposals);
+    const int numBred = numProposals > 0 ? numProposals : offspringPerGeneration;
+    
+    if (island.proposals.size() < proposalCount)
+    {
+        island.proposals.resize(proposalCount);
+        island.proposalScores.resize(proposalCount);
+        island.proposalOrder.resize(proposalCount);
+    }
+    
+    if (island.parents.size() < 2 * static_cast<size_t>(numBred))
+        island.parents.resize(2 * static_cast<size_t>(numBred));
+    
+    {
+        PPG_TRACE_ZONE("GA breed");
+        
+        // Every parent for the generation in one pass, two per child
+        if (config.selectionMode == GAConfig::SelectionMode::Rank)
+        {
+            island.rankSelection.selectionPressure = config.rankPressure;
+            island.rankSelection.prepare(population);
+        }
+        selectParents(island, island.parents.data(), 2 * numBred);
+        
+        for (int i = 0; i < numBred; ++i)
+        {
+            // Check for exit periodically
+            if (threadShouldExit())
+                return;
             
-            // Select two parents using tournament selection
-            int parent1Index = selector(*population, rng);
-            int parent2Index = selector(*population, rng);
-            
-            const Individual& parent1 = (*population)[parent1Index];
-            const Individual& parent2 = (*population)[parent2Index];
-            
-            // Create offspring via crossover
-            Individual child = crossover(parent1, parent2, rng);
-            
-            // Apply mutation
-            mutation(child, rng);
-            
-            // Evaluate offspring fitness
-            float fitness = evaluateIndividual(child);
-            child.setFitness(fitness);
-            
-            offspring.push_back(child);
+            breed(numProposals > 0 ? island.proposals[static_cast<size_t>(i)].data()
+                                   : island.offspringGenomes[static_cast<size_t>(i)].data(),
+                  island.parents.data() + 2 * i);
         }
         
-        // Check if we should exit after generating offspring
-        if (threadShouldExit())
-            break;
+        float* bred = numProposals > 0 ? island.proposals[0].data() : island.offspringGenomes[0].data();
+        GenomeConstraints::repairBatch(bred, numBred, PARAMETER_COUNT);
         
-        // Replace worst individuals with offspring
-        if (!offspring.empty())
+        // Breed again in place of candidates predicted to be inaudible, so no
+        // evaluation (or render) goes on them
+        if (config.silenceRejection)
         {
-            // Find indices of worst individuals
-            std::vector<std::pair<int, float>> indexedFitness;
-            indexedFitness.reserve(population->size());
+            uint64_t numRejected = 0, numKept = 0;
             
-            for (int i = 0; i < population->size(); ++i)
+            for (int i = 0; i < numBred; ++i)
             {
-                const Individual& ind = (*population)[i];
-                if (ind.hasBeenEvaluated())
+                float* child = bred + static_cast<size_t>(i) * PARAMETER_COUNT;
+                
+                for (int retry = 0; !GenomeConstraints::isAudible(child, PARAMETER_COUNT, config.inaudibleLevelDb); ++retry)
                 {
-                    indexedFitness.push_back({i, ind.getFitness()});
+                    if (retry == MAX_SILENCE_RETRIES)
+                    {
+                        ++numKept;
+                        break;
+                    }
+                    
+                    ++numRejected;
+                    int parents[2];
+                    selectParents(island, parents, 2);
+                    breed(child, parents);
+                    GenomeConstraints::repair(child, PARAMETER_COUNT);
                 }
             }
             
-            // Sort by fitness (ascending) to find worst
-            std::sort(indexedFitness.begin(), indexedFitness.end(),
-                     [](const auto& a, const auto& b) { return a.second < b.second; });
-            
-            // Replace worst N individuals with offspring
-            int numToReplace = std::min(static_cast<int>(offspring.size()), 
-                                       static_cast<int>(indexedFitness.size()));
-            
-            for (int i = 0; i < numToReplace; ++i)
-            {
-                int worstIndex = indexedFitness[i].first;
-                population->replace(worstIndex, offspring[i]);
-            }
-            
-            // Update population statistics
-            population->markDirty();
+            silenceScreened += static_cast<uint64_t>(numBred) + numRejected;
+            silenceRejected += numRejected;
+            silenceKept += numKept;
+        }
+    }
+    
+    // Without a surrogate the first proposals, bred like any others, will do
+    if (numProposals > 0 && !screenProposals(island, numProposals))
+        std::copy(island.proposals.begin(), island.proposals.begin() + offspringPerGeneration, island.offspringGenomes.begin());
+    
+    // The surrogate cascade and progressive mode screen offspring cheaply
+    // first; otherwise evaluate them all as one batch across the worker pool
+    int numEvaluated = offspringPerGeneration;
+    const bool progressive = (config.surrogateFiltering && evaluateWithSurrogate(island, numEvaluated))
+                          || (config.progressiveEvaluation && evaluateProgressively(island, numEvaluated));
+    
+    if (!progressive)
+        evaluateGenomes(island, island.offspringGenomes[0].data(), offspringPerGeneration,
+                        island.offspringFitness.data(), false);
+    
+    if (threadShouldExit())
+        return;
+    
+    replaceMembers(island, numEvaluated, progressive);
+    
+    const auto& fitness = island.offspringFitness;
+    const size_t bestOffspring = static_cast<size_t>(std::max_element(fitness.begin(), fitness.begin() + numEvaluated)
+                                                     - fitness.begin());
+    
+    // Remember this generation's best offspring as a novelty elite
+    if (isNoveltyEnabled() && numEvaluated > 0)
+        island.noveltyIndex->addToArchive(island.offspringGenomes[bestOffspring].data());
+    
+    // Optimism under uncertainty replaces epsilon-greedy when the model can
+    // say how unsure it is
+    const int optimistic = config.uncertaintyExploration ? pickByUncertainty(island, numEvaluated) : -1;
+    
+    if (optimistic >= 0)
+    {
+        island.candidate = island.offspringGenomes[static_cast<size_t>(optimistic)];
+        island.candidateFitness = fitness[static_cast<size_t>(optimistic)];
+        island.hasCandidate = true;
+        return;
+    }
+    
+    // Epsilon-greedy choice of the candidate for the parameter bridge
+    // (exploring is the only choice when every offspring was rejected early)
+    bool explore = island.choiceRng.nextFloat() < currentEpsilon || numEvaluated == 0;
+    
+    if (explore)
+    {
+        int randIdx = island.choiceRng.nextInt(population.size());
+        IndividualView exploratory = population[randIdx];
+        std::copy(exploratory.data(), exploratory.data() + PARAMETER_COUNT, island.candidate.begin());
+        island.candidateFitness = exploratory.getFitness();
+    }
+    else
+    {
+        island.candidate = island.offspringGenomes[bestOffspring];
+        island.candidateFitness = fitness[bestOffspring];
+    }
+    
+    island.hasCandidate = true;
+}
+
+int GeneticAlgorithm::pickByUncertainty(Island& island, int numEvaluated)
+{
+    if (numEvaluated <= 0)
+        return -1;
+    
+    // One fused ensemble pass over the evaluated offspring; the means aren't needed
+    float means[MAX_OFFSPRING_PER_GENERATION];
+    auto& variance = island.offspringVariance;
+    if (!fitnessModel.evaluateUncertainty(island.offspringGenomes[0].data(), numEvaluated, PARAMETER_COUNT,
+                                          means, variance.data()))
+        return -1;
+    
+    int best = 0;
+    float bestBound = -std::numeric_limits<float>::infinity();
+    
+    for (int i = 0; i < numEvaluated; ++i)
+    {
+        const float bound = island.offspringFitness[static_cast<size_t>(i)]
+                          + config.uncertaintyBonus * std::sqrt(std::max(0.0f, variance[static_cast<size_t>(i)]));
+        if (bound > bestBound)
+        {
+            bestBound = bound;
+            best = i;
         }
+    }
+    
+    return best;
+}
+
+bool GeneticAlgorithm::estimateGenomes(Island& island, const float* genomes, int numGenomes, float* estimatesOut)
+{
+    // Same batching as evaluateGenomes
+    const int numBatches = std::min(evaluationPool->getNumSlots(), numGenomes);
+    std::atomic<bool> supported { true };
+    
+    evaluationPool->parallelFor(numBatches, [&](int batch, int)
+    {
+        if (threadShouldExit())
+            return;
         
-        // Epsilon-greedy for pushing to parameter bridge
-        bool explore = rng.nextFloat() < currentEpsilon;
+        int begin = numGenomes * batch / numBatches;
+        int end = numGenomes * (batch + 1) / numBatches;
         
-        if (explore)
+        if (!fitnessModel.estimateBatch(genomes + begin * PARAMETER_COUNT, end - begin,
+                                        PARAMETER_COUNT, estimatesOut + begin))
+            supported.store(false);
+    });
+    
+    if (!supported.load())
+        return false;
+    
+    // Estimates are compared against combined fitness, so they get the same bonus
+    if (isNoveltyEnabled() && island.population)
+    {
+        for (int i = 0; i < numGenomes; ++i)
         {
-            int randIdx = rng.nextInt(population->size());
-            const Individual& exploratory = (*population)[randIdx];
-            parameterBridge->push(exploratory.getParameters(), exploratory.getFitness());
+            float novelty = computeNovelty(island, genomes + i * PARAMETER_COUNT, -1);
+            estimatesOut[i] = computeCombinedFitness(estimatesOut[i], novelty);
         }
-        else if (!offspring.empty())
+    }
+    
+    return true;
+}
+
+bool GeneticAlgorithm::evaluateProgressively(Island& island, int& numEvaluated)
+{
+    auto& estimates = island.offspringEstimates;
+    
+    if (!estimateGenomes(island, island.offspringGenomes[0].data(), offspringPerGeneration, estimates.data()))
+        return false;
+    
+    // Clearly below the current worst: could not displace anyone
+    const float worstFitness = island.population->getWorstFitness();
+    const float threshold = worstFitness - config.earlyRejectMargin;
+    
+    // 0 = kept, 1 = rejected but audited, 2 = rejected
+    int outcome[MAX_OFFSPRING_PER_GENERATION];
+    int numKept = 0;
+    int numAudited = 0;
+    
+    for (int i = 0; i < offspringPerGeneration; ++i)
+    {
+        if (!(estimates[static_cast<size_t>(i)] < threshold))
         {
-            auto bestOffspringIt = std::max_element(offspring.begin(), offspring.end(),
-                [](const Individual& a, const Individual& b) { return a.getFitness() < b.getFitness(); });
-                
-            if (bestOffspringIt != offspring.end())
-            {
-                parameterBridge->push(bestOffspringIt->getParameters(), bestOffspringIt->getFitness());
-            }
+            outcome[i] = 0;
+            ++numKept;
         }
-        
-        // Decay epsilon if adaptive exploration is enabled
-        if (config.adaptiveExploration)
+        else if (island.choiceRng.nextFloat() < config.rejectionAuditRate)
+        {
+            outcome[i] = 1;
+            ++numAudited;
+        }
+        else
+        {
+            outcome[i] = 2;
+        }
+    }
+    
+    // Reorder the arena so the offspring to evaluate are contiguous: kept, then audited
+    const auto bred = island.offspringGenomes;
+    int next[3] = { 0, numKept, numKept + numAudited };
+    for (int i = 0; i < offspringPerGeneration; ++i)
+        island.offspringGenomes[static_cast<size_t>(next[outcome[i]]++)] = bred[static_cast<size_t>(i)];
+    
+    numEvaluated = numKept + numAudited;
+    
+    if (numEvaluated > 0)
+        evaluateGenomes(island, island.offspringGenomes[0].data(), numEvaluated,
+                        island.offspringFitness.data(), false);
+    
+    // An audited rejection was wrong if it would have displaced the worst member
+    int numWrong = 0;
+    for (int i = numKept; i < numEvaluated; ++i)
+        if (island.offspringFitness[static_cast<size_t>(i)] > worstFitness)
+            ++numWrong;
+    
+    progressiveEstimated += offspringPerGeneration;
+    progressiveFullyEvaluated += static_cast<uint64_t>(numEvaluated);
+    progressiveRejected += static_cast<uint64_t>(offspringPerGeneration - numKept);
+    progressiveAudited += static_cast<uint64_t>(numAudited);
+    progressiveWrongRejections += static_cast<uint64_t>(numWrong);
+    
+    return true;
+}
+
+bool GeneticAlgorithm::screenProposals(Island& island, int numProposals)
+{
+    auto& scores = island.proposalScores;
+    
+    // One pass over the whole arena
+    {
+        PPG_TRACE_ZONE("GA screen proposals");
+        if (!fitnessModel.surrogateBatch(island.proposals[0].data(), numProposals, PARAMETER_COUNT, scores.data()))
+            return false;
+    }
+    
+    if (isNoveltyEnabled())
+    {
+        for (int i = 0; i < numProposals; ++i)
+        {
+            float novelty = computeNovelty(island, island.proposals[static_cast<size_t>(i)].data(), -1);
+            scores[static_cast<size_t>(i)] = computeCombinedFitness(scores[static_cast<size_t>(i)], novelty);
+        }
+    }
+    
+    // Best first, ties by arena slot
+    auto& order = island.proposalOrder;
+    std::iota(order.begin(), order.begin() + numProposals, 0);
+    std::partial_sort(order.begin(), order.begin() + offspringPerGeneration, order.begin() + numProposals, [&scores](int a, int b)
+    {
+        const float scoreA = scores[static_cast<size_t>(a)], scoreB = scores[static_cast<size_t>(b)];
+        return scoreA > scoreB || (scoreA == scoreB && a < b);
+    });
+    
+    for (int i = 0; i < offspringPerGeneration; ++i)
+        island.offspringGenomes[static_cast<size_t>(i)] = island.proposals[static_cast<size_t>(order[static_cast<size_t>(i)])];
+    
+    return true;
+}
+
+bool GeneticAlgorithm::evaluateWithSurrogate(Island& island, int& numEvaluated)
+{
+    auto& scores = island.offspringEstimates;
+    
+    // Microseconds for the whole arena, so not worth spreading over the pool
+    {
+        PPG_TRACE_ZONE("GA surrogate");
+        if (!fitnessModel.surrogateBatch(island.offspringGenomes[0].data(), offspringPerGeneration,
+                                         PARAMETER_COUNT, scores.data()))
+            return false;
+    }
+    
+    // Ranked as the full stage will be, novelty bonus included
+    if (isNoveltyEnabled())
+    {
+        for (int i = 0; i < offspringPerGeneration; ++i)
+        {
+            float novelty = computeNovelty(island, island.offspringGenomes[static_cast<size_t>(i)].data(), -1);
+            scores[static_cast<size_t>(i)] = computeCombinedFitness(scores[static_cast<size_t>(i)], novelty);
+        }
+    }
+    
+    // Best surrogate score first (ties by arena slot, so runs stay reproducible)
+    int order[MAX_OFFSPRING_PER_GENERATION];
+    std::iota(order, order + offspringPerGeneration, 0);
+    std::sort(order, order + offspringPerGeneration, [&scores](int a, int b)
+    {
+        const float scoreA = scores[static_cast<size_t>(a)], scoreB = scores[static_cast<size_t>(b)];
+        return scoreA > scoreB || (scoreA == scoreB && a < b);
+    });
+    
+    const int numKept = juce::jlimit(1, offspringPerGeneration,
+                                     static_cast<int>(std::ceil(config.surrogateKeepFraction * offspringPerGeneration)));
+    
+    // Reorder the arena (and scores) so the offspring to evaluate are
+    // contiguous: kept in rank order, then audited cuts, then the other cuts
+    const auto bred = island.offspringGenomes;
+    const auto bredScores = scores;
+    int audited[MAX_OFFSPRING_PER_GENERATION], cut[MAX_OFFSPRING_PER_GENERATION];
+    int numAudited = 0, numCut = 0;
+    
+    for (int rank = numKept; rank < offspringPerGeneration; ++rank)
+    {
+        if (island.choiceRng.nextFloat() < config.rejectionAuditRate)
+            audited[numAudited++] = order[rank];
+        else
+            cut[numCut++] = order[rank];
+    }
+    
+    std::copy(audited, audited + numAudited, order + numKept);
+    std::copy(cut, cut + numCut, order + numKept + numAudited);
+    
+    for (int i = 0; i < offspringPerGeneration; ++i)
+    {
+        island.offspringGenomes[static_cast<size_t>(i)] = bred[static_cast<size_t>(order[i])];
+        scores[static_cast<size_t>(i)] = bredScores[static_cast<size_t>(order[i])];
+    }
+    
+    numEvaluated = numKept + numAudited;
+    evaluateGenomes(island, island.offspringGenomes[0].data(), numEvaluated, island.offspringFitness.data(), false);
+    
+    // Rank agreement over every pair both stages scored
+    const auto& fitness = island.offspringFitness;
+    uint64_t concordant = 0, discordant = 0;
+    
+    for (int i = 0; i < numEvaluated; ++i)
+    {
+        for (int j = i + 1; j < numEvaluated; ++j)
         {
-            currentEpsilon = std::max(config.epsilonMin, currentEpsilon * config.epsilonDecay);
+            const float agreement = (scores[static_cast<size_t>(i)] - scores[static_cast<size_t>(j)])
+                                  * (fitness[static_cast<size_t>(i)] - fitness[static_cast<size_t>(j)]);
+            if (agreement > 0.0f)
+                ++concordant;
+            else if (agreement < 0.0f)
+                ++discordant;
         }
+    }
+    
+    // An audited cut was wrong if it would have displaced the worst member
+    const float worstFitness = island.population->getWorstFitness();
+    int numWrong = 0;
+    for (int i = numKept; i < numEvaluated; ++i)
+        if (fitness[static_cast<size_t>(i)] > worstFitness)
+            ++numWrong;
+    
+    surrogateScreened += offspringPerGeneration;
+    surrogateFullyEvaluated += static_cast<uint64_t>(numEvaluated);
+    surrogateCut += static_cast<uint64_t>(offspringPerGeneration - numKept);
+    surrogateAudited += static_cast<uint64_t>(numAudited);
+    surrogateWrongCuts += static_cast<uint64_t>(numWrong);
+    surrogateConcordantPairs += concordant;
+    surrogateDiscordantPairs += discordant;
+    
+    return true;
+}
 
-        juce::Thread::sleep(10);
+void GeneticAlgorithm::selectParents(Island& island, int* indicesOut, int count)
+{
+    switch (config.selectionMode)
+    {
+        case GAConfig::SelectionMode::Rank:
+            island.rankSelection(island.rng, indicesOut, count);
+            break;
+            
+        case GAConfig::SelectionMode::StochasticUniversal:
+            StochasticUniversalSampling()(*island.population, island.rng, indicesOut, count);
+            break;
+            
+        case GAConfig::SelectionMode::Tournament:
+        default:
+        {
+            TournamentSelection selector;
+            selector.tournamentSize = std::max(1, config.tournamentSize);
+            selector(*island.population, island.rng, indicesOut, count);
+            break;
+        }
     }
 }
 
+void GeneticAlgorithm::replaceMembers(Island& island, int numEvaluated, bool progressive)
+{
+    auto& population = *island.population;
+    const float* fitness = island.offspringFitness.data();
+    
+    // Which member each offspring replaces
+    int members[MAX_OFFSPRING_PER_GENERATION];
+    int children[MAX_OFFSPRING_PER_GENERATION];
+    int numReplaced = 0;
+    
+    if (config.replacementMode == GAConfig::ReplacementMode::Crowding)
+    {
+        CrowdingReplacement crowding;
+        crowding.crowdingSize = std::max(1, config.crowdingSize);
+        numReplaced = crowding(population, island.offspringGenomes[0].data(), fitness, numEvaluated,
+                               island.rng, members, children);
+    }
+    else
+    {
+        // Worst members come straight off the population's fitness heap
+        WorstReplacement worst;
+        worst.onlyIfBetter = progressive || config.replacementMode == GAConfig::ReplacementMode::ElitistSteadyState;
+        numReplaced = worst(population, fitness, numEvaluated, members, children);
+    }
+    
+    for (int i = 0; i < numReplaced; ++i)
+    {
+        const size_t child = static_cast<size_t>(children[i]);
+        population.replace(members[i], island.offspringGenomes[child].data(), fitness[child]);
+        
+        // Keep the distance matrix current; drop it while novelty is off
+        if (island.noveltyIndexValid && isNoveltyEnabled())
+            island.noveltyIndex->update(population, members[i]);
+        else
+            island.noveltyIndexValid = false;
+    }
+}
+
+GeneticAlgorithm::ProgressiveStats GeneticAlgorithm::getProgressiveStats() const
+{
+    ProgressiveStats stats;
+    stats.estimated = progressiveEstimated.load();
+    stats.fullyEvaluated = progressiveFullyEvaluated.load();
+    stats.rejected = progressiveRejected.load();
+    stats.audited = progressiveAudited.load();
+    stats.wrongRejections = progressiveWrongRejections.load();
+    return stats;
+}
+
+GeneticAlgorithm::SurrogateStats GeneticAlgorithm::getSurrogateStats() const
+{
+    SurrogateStats stats;
+    stats.screened = surrogateScreened.load();
+    stats.fullyEvaluated = surrogateFullyEvaluated.load();
+    stats.cut = surrogateCut.load();
+    stats.audited = surrogateAudited.load();
+    stats.wrongCuts = surrogateWrongCuts.load();
+    stats.concordantPairs = surrogateConcordantPairs.load();
+    stats.discordantPairs = surrogateDiscordantPairs.load();
+    return stats;
+}
+
+GeneticAlgorithm::SilenceStats GeneticAlgorithm::getSilenceStats() const
+{
+    SilenceStats stats;
+    stats.screened = silenceScreened.load();
+    stats.rejected = silenceRejected.load();
+    stats.kept = silenceKept.load();
+    return stats;
+}
+
+GenerationBudget::Stats GeneticAlgorithm::getBudgetStats() const
+{
+    return generationBudget.getStats();
+}
+
+int GeneticAlgorithm::getProposalCount(int numOffspring) const
+{
+    if (!config.breedsProposals())
+        return 0;
+    
+    // The configured oversampling ratio, however many offspring the budget allows
+    return (config.proposalBatchSize * numOffspring + OFFSPRING_PER_GENERATION - 1) / OFFSPRING_PER_GENERATION;
+}
+
+GeneticAlgorithm::PopulationStats GeneticAlgorithm::getPopulationStats() const
+{
+    PopulationStats stats;
+    stats.generation = generationCount;
+    stats.rescores = rescoreCount;
+    
+    double fitnessSum = 0.0;
+    int evaluated = 0;
+    
+    for (const auto& island : islands)
+    {
+        if (island.population == nullptr || island.population->getEvaluatedCount() == 0)
+            continue;
+        
+        const auto& population = *island.population;
+        const int count = population.getEvaluatedCount();
+        
+        stats.bestFitness = evaluated == 0 ? population.getBestFitness() : std::max(stats.bestFitness, population.getBestFitness());
+        stats.worstFitness = evaluated == 0 ? population.getWorstFitness() : std::min(stats.worstFitness, population.getWorstFitness());
+        fitnessSum += static_cast<double>(population.getAverageFitness()) * count;
+        evaluated += count;
+    }
+    
+    if (evaluated > 0)
+        stats.averageFitness = static_cast<float>(fitnessSum / evaluated);
+    
+    return stats;
+}
+
+void GeneticAlgorithm::migrate()
+{
+    PPG_TRACE_ZONE("GA migrate");
+    
+    const int numIslands = static_cast<int>(islands.size());
+    
+    // Stage every elite first so a migrant never travels twice in one round
+    for (auto& island : islands)
+    {
+        IndividualView best = island.population->getBest();
+        std::copy(best.data(), best.data() + PARAMETER_COUNT, island.migrant.begin());
+        island.migrantFitness = best.getFitness();
+    }
+    
+    for (int source = 0; source < numIslands; ++source)
+    {
+        int destination = config.randomMigration
+            ? (source + 1 + rng.nextInt(numIslands - 1)) % numIslands
+            : (source + 1) % numIslands;
+        
+        auto& target = islands[static_cast<size_t>(destination)];
+        const auto& migrant = islands[static_cast<size_t>(source)];
+        
+        int worstIndex;
+        if (target.population->worstK(1, &worstIndex) == 0)
+            continue;
+        
+        target.population->replace(worstIndex, migrant.migrant.data(), migrant.migrantFitness);
+        
+        if (target.noveltyIndexValid && isNoveltyEnabled())
+            target.noveltyIndex->update(*target.population, worstIndex);
+        else
+            target.noveltyIndexValid = false;
+    }
+}
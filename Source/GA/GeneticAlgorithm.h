@@ -13,16 +13,25 @@
 #include <juce_core/juce_core.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "GAConfig.h"
+#include "Individual.h"
+#include "CpuBudget.h"
+#include "GenerationBudget.h"
+#include "PerformanceMeter.h"
+#include "RandomStream.h"
+#include "SelectionOperators.h"
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 // Forward declarations
 class ParameterBridge;
 class Population;
-class Individual;
 class IFitnessModel;
+class WorkerPool;
+class NoveltyIndex;
 
 class GeneticAlgorithm : public juce::Thread
 {
@@ -40,44 +49,303 @@ public:
     // Access to parameter bridge for processor to poll updates
     ParameterBridge* getParameterBridge() { return parameterBridge.get(); }
     
+    // CPU time of the GA thread, sampled once per generation
+    const ThreadCpuMeter& getThreadCpuMeter() const { return threadCpuMeter; }
+    
+    /**
+     * Average cores the GA thread and its evaluation workers may use
+     * (0 = unlimited). The pool is capped to the whole cores in the budget
+     * and the GA idles between generations to honour any fraction. Applies
+     * from the next generation.
+     */
+    void setCpuBudget(float cores) { cpuBudget.setCores(cores); }
+    float getCpuBudget() const { return cpuBudget.getCores(); }
+    
+    // Audio deadline load; above CpuBudget::backoffLoad generations are spaced out further
+    void setAudioLoad(float load) { cpuBudget.setAudioLoad(load); }
+    
+    // Cores the GA thread and workers may run on (0 = any); applies when the thread or pool next starts
+    void setWorkerAffinityMask(uint32_t mask) { affinityMask.store(mask); }
+    
+    /**
+     * Evaluates on pool, e.g. SharedEngine's, instead of a pool of its own
+     * (nullptr goes back to its own). Its size and affinity are its owner's,
+     * so numEvaluationThreads, the budget's thread cap and the affinity mask
+     * only apply to the GA thread; the budget still limits the average.
+     * While another GA has the pool's workers, generations run inline on
+     * this GA's thread. Applies from the next generation.
+     */
+    void setEvaluationPool(std::shared_ptr<WorkerPool> pool);
+    
     // Configuration for experiment toggles
     void setConfig(const GAConfig& cfg);
     const GAConfig& getConfig() const { return config; }
+    
+    /**
+     * Runs one steady-state generation on the calling thread, initialising the
+     * population first if needed, or re-scoring it in one batch if the model's
+     * version changed since it was scored. Used by the GA thread and by
+     * tests/tools; never call it while the GA thread is running. Once
+     * initialised a generation performs no heap allocation (given an
+     * allocation-free model).
+     */
+    void stepGeneration();
+    
+    /** Early-rejection counters for GAConfig::progressiveEvaluation (cumulative). */
+    struct ProgressiveStats
+    {
+        uint64_t estimated = 0;        // Offspring given a prefix score
+        uint64_t fullyEvaluated = 0;   // Offspring given a full evaluation (audits included)
+        uint64_t rejected = 0;         // Offspring below the rejection threshold
+        uint64_t audited = 0;          // Rejections fully evaluated anyway
+        uint64_t wrongRejections = 0;  // Audited rejections that beat the population's worst
+        
+        // Estimated share of rejections that would have survived
+        float getWrongRejectionRate() const { return audited > 0 ? float(wrongRejections) / float(audited) : 0.0f; }
+    };
+    
+    ProgressiveStats getProgressiveStats() const;
+    
+    /** Cut-off counters for GAConfig::surrogateFiltering (cumulative). */
+    struct SurrogateStats
+    {
+        uint64_t screened = 0;         // Offspring ranked by the surrogate
+        uint64_t fullyEvaluated = 0;   // Offspring given a full evaluation (audits included)
+        uint64_t cut = 0;              // Offspring below the cut-off
+        uint64_t audited = 0;          // Cuts fully evaluated anyway
+        uint64_t wrongCuts = 0;        // Audited cuts that beat the population's worst
+        
+        // Pairs of fully evaluated offspring the two stages order alike or
+        // oppositely (ties in either stage count as neither)
+        uint64_t concordantPairs = 0;
+        uint64_t discordantPairs = 0;
+        
+        // Kendall's tau between the stages' scores, from -1 (reversed) to 1 (same order)
+        float getRankAgreement() const
+        {
+            const uint64_t pairs = concordantPairs + discordantPairs;
+            return pairs > 0 ? (float(concordantPairs) - float(discordantPairs)) / float(pairs) : 0.0f;
+        }
+        
+        float getWrongCutRate() const { return audited > 0 ? float(wrongCuts) / float(audited) : 0.0f; }
+    };
+    
+    SurrogateStats getSurrogateStats() const;
+    
+    /** Counters for GAConfig::silenceRejection (cumulative). */
+    struct SilenceStats
+    {
+        uint64_t screened = 0;  // Candidates whose level was predicted
+        uint64_t rejected = 0;  // Predicted inaudible and bred again: evaluations (renders, in audio mode) saved
+        uint64_t kept = 0;      // Still inaudible after every retry, so evaluated anyway
+    };
+    
+    SilenceStats getSilenceStats() const;
+    
+    /** Generation sizing under GAConfig::budgetMode, and what it measured; any thread. */
+    GenerationBudget::Stats getBudgetStats() const;
+    
+    /** Fitness summary over every island; like stepGeneration(), not while the GA thread runs. */
+    struct PopulationStats
+    {
+        int generation = 0;
+        float bestFitness = 0.0f;
+        float averageFitness = 0.0f;
+        float worstFitness = 0.0f;
+        int rescores = 0;  // Whole-population re-scores (model updates, restored snapshots)
+    };
+    
+    PopulationStats getPopulationStats() const;
+    
+    /**
+     * Reseeds the stream the islands' streams are derived from; applies when
+     * the population is next initialised. For a given seed and config a run
+     * is reproducible at any thread count (given a deterministic model).
+     */
+    void setSeed(juce::int64 seed) { rng = RandomStream(static_cast<uint64_t>(seed)); }
+    
+    /**
+     * Compact binary snapshot of the population: every island's genomes,
+     * fitness and generator, plus the generation count and epsilon. It is
+     * refreshed every generation and when the GA stops, so any thread may
+     * read it, e.g. while the host saves plugin state. False until the
+     * first population exists.
+     */
+    bool getPopulationSnapshot(juce::MemoryBlock& destData) const;
+    
+    /**
+     * Resumes from a snapshot the next time a population would be
+     * initialised, instead of drawing random genomes (stopGA() keeps its
+     * own, so a restart resumes too). The first candidates are offered at
+     * their stored fitness straight away, then the population is re-scored
+     * in one batch, since the model may have changed since. False if the
+     * data isn't a valid snapshot; one saved with a different island count
+     * or population size is ignored at initialisation.
+     */
+    bool setPopulationSnapshot(const void* data, size_t sizeInBytes);
+    void clearPopulationSnapshot();
+    
+    // Per island and generation at a fixed budget; GAConfig::budgetMode varies it
+    static constexpr int getOffspringPerGeneration() { return OFFSPRING_PER_GENERATION; }
 
 private:
     // GA Configuration Constants
-    static constexpr int POPULATION_SIZE = 50;
-    static constexpr int OFFSPRING_PER_GENERATION = 10;
+    static constexpr int OFFSPRING_PER_GENERATION = GAConfig::offspringPerGeneration;
+    static constexpr int MAX_OFFSPRING_PER_GENERATION = 40;  // Arena size, the most any budget allows
     static constexpr int PARAMETER_COUNT = 17;
     static constexpr float DEFAULT_EXPLORATION_RATE = 0.25f;
+    static constexpr int CANDIDATE_QUEUE_CAPACITY = 4;  // Presets kept ready ahead of the user
+    static constexpr int MAX_SILENCE_RETRIES = 4;  // Rebreeds per inaudible candidate before it is kept
     
     GAConfig config;
     float currentEpsilon = DEFAULT_EXPLORATION_RATE;
     
     std::atomic<bool> paused { false };
+    ThreadCpuMeter threadCpuMeter;
+    CpuBudget cpuBudget;
+    GenerationBudget generationBudget;
+    int offspringPerGeneration = OFFSPRING_PER_GENERATION;  // This generation's, per island (GA thread)
+    juce::int64 measuredFetchTicks = 0;  // Bridge pop whose latency was last recorded
+    juce::int64 cycleStartTicks = 0;     // Start of the previous generation for the CPU average
+    double lastBusySeconds = 0.0;
+    std::atomic<uint32_t> affinityMask { 0 };
+    uint32_t poolAffinityMask = 0;  // Mask evaluationPool was built with
     juce::WaitableEvent pauseEvent;
     
+    /**
+        One independently evolved sub-population with its own random
+        streams, novelty index and offspring arena. A single island is the
+        classic GA.
+    */
+    struct Island
+    {
+        std::unique_ptr<Population> population;
+        
+        // Pairwise distances for novelty, patched on replacement while novelty is enabled
+        std::unique_ptr<NoveltyIndex> noveltyIndex;
+        bool noveltyIndexValid = false;
+        
+        RandomStream rng;        // Breeding: selection, crossover, mutation
+        RandomStream choiceRng;  // Audits and exploration picks, so they never shift breeding
+        
+        // Per-generation offspring arena, reused every generation; the first offspringPerGeneration are live
+        std::array<Genome<PARAMETER_COUNT>, MAX_OFFSPRING_PER_GENERATION> offspringGenomes {};
+        std::array<float, MAX_OFFSPRING_PER_GENERATION> offspringFitness {};
+        std::array<float, MAX_OFFSPRING_PER_GENERATION> offspringEstimates {};
+        std::array<float, MAX_OFFSPRING_PER_GENERATION> offspringVariance {};
+        
+        // Oversampled candidates (GAConfig::proposalBatchSize), grown only when a generation needs more
+        std::vector<Genome<PARAMETER_COUNT>> proposals;
+        std::vector<float> proposalScores;
+        std::vector<int> proposalOrder;
+        
+        // Two parents per bred child, drawn together; grown like the proposals
+        std::vector<int> parents;
+        RankSelection rankSelection;  // Keeps its alias table between generations
+        
+        // This generation's pick for the parameter bridge
+        Genome<PARAMETER_COUNT> candidate {};
+        float candidateFitness = 0.0f;
+        bool hasCandidate = false;
+        
+        // Elite staged for migration
+        Genome<PARAMETER_COUNT> migrant {};
+        float migrantFitness = 0.0f;
+    };
+    
+    static_assert(sizeof(Genome<PARAMETER_COUNT>) == PARAMETER_COUNT * sizeof(float),
+                  "Offspring rows must be contiguous for batch evaluation");
+    
     // Population management
-    std::unique_ptr<Population> population;
+    std::vector<Island> islands;
     bool populationInitialized = false;
+    int generationCount = 0;
+    bool rescorePending = false;  // Restored fitness is stale until rescorePopulation()
+    
+    // Model version the population's fitness was scored with; any other means rescore
+    uint64_t scoredModelVersion = 0;
+    int rescoreCount = 0;
+    std::vector<float> populationFitness;  // Whole-population scores, reused
+    bool isNoveltyEnabled() const { return config.multiObjective && config.noveltyBonus; }
     
     // Parameter communication bridge to main synth
     std::unique_ptr<ParameterBridge> parameterBridge;
     
-    // Random number generator for GA operations
-    juce::Random rng;
+    // Run keys for the per-island streams, and random migration (GA thread only)
+    RandomStream rng;
+    
+    // Parallel fitness evaluation (rebuilt when the configured thread count
+    // changes), or the shared pool when one is set
+    std::shared_ptr<WorkerPool> evaluationPool;
+    std::shared_ptr<WorkerPool> sharedPool;  // Set from any thread (guarded by sharedPoolMutex)
+    std::mutex sharedPoolMutex;
+    bool usingSharedPool = false;
+    void ensureEvaluationPool();
     
     // Override from juce::Thread - this is the main thread function
     void run() override;
 
+    // Latest snapshot; written by whichever thread steps generations
+    juce::MemoryBlock snapshot;
+    mutable std::mutex snapshotMutex;
+    void publishSnapshot();
+    bool restoreSnapshot();
+    
     // Helper methods for GA operations
     void initializePopulation(bool checkExitSignal = true);
-    float evaluateIndividual(const Individual& individual);
-    float computeNovelty(const Individual& individual);
+    void rescorePopulation(bool checkExitSignal);
+    // Queues each island's best on the bridge
+    void offerIslandBests();
+    // Breeds, evaluates and replaces one generation of an island (safe to run islands in parallel)
+    void evolveIsland(Island& island);
+    // Moves each island's best into a neighbour's worst slot (GA thread only)
+    void migrate();
+    // Scores a contiguous genome matrix in per-slot batches across the worker pool.
+    // populationRows marks genomes that are rows of the island's population (novelty skips self).
+    void evaluateGenomes(Island& island, const float* genomes, int numGenomes, float* fitnessOut, bool populationRows);
+    // Progressive counterpart of evaluate-and-replace; false if the model has no estimate.
+    // Leaves the fully evaluated offspring at the front of the arena and returns their count.
+    bool evaluateProgressively(Island& island, int& numEvaluated);
+    // Draws count parent indices in one pass with the configured selection
+    void selectParents(Island& island, int* indicesOut, int count);
+    // Puts the first numEvaluated offspring in with the configured replacement;
+    // progressive means only offspring that beat a member may replace it
+    void replaceMembers(Island& island, int numEvaluated, bool progressive);
+    bool estimateGenomes(Island& island, const float* genomes, int numGenomes, float* estimatesOut);
+    // Keeps the surrogate's best proposals as the offspring arena; false if the model has no surrogate
+    bool screenProposals(Island& island, int numProposals);
+    // Proposals to breed for numOffspring at the configured oversampling ratio; 0 when not oversampling
+    int getProposalCount(int numOffspring) const;
+    // Surrogate cascade counterpart of evaluateProgressively, with the same arena layout
+    bool evaluateWithSurrogate(Island& island, int& numEvaluated);
+    // Index of the evaluated offspring with the highest upper confidence bound, or -1 without an uncertainty estimate
+    int pickByUncertainty(Island& island, int numEvaluated);
+    float computeNovelty(Island& island, const float* genome, int selfIndex);
     float computeCombinedFitness(float mlpFitness, float novelty);
     
     // Fitness Model
     IFitnessModel& fitnessModel;
     
+    // ProgressiveStats counters (islands update them concurrently)
+    std::atomic<uint64_t> progressiveEstimated { 0 };
+    std::atomic<uint64_t> progressiveFullyEvaluated { 0 };
+    std::atomic<uint64_t> progressiveRejected { 0 };
+    std::atomic<uint64_t> progressiveAudited { 0 };
+    std::atomic<uint64_t> progressiveWrongRejections { 0 };
+    
+    // SurrogateStats counters
+    std::atomic<uint64_t> surrogateScreened { 0 };
+    std::atomic<uint64_t> surrogateFullyEvaluated { 0 };
+    std::atomic<uint64_t> surrogateCut { 0 };
+    std::atomic<uint64_t> surrogateAudited { 0 };
+    std::atomic<uint64_t> surrogateWrongCuts { 0 };
+    std::atomic<uint64_t> surrogateConcordantPairs { 0 };
+    std::atomic<uint64_t> surrogateDiscordantPairs { 0 };
+    
+    // SilenceStats counters
+    std::atomic<uint64_t> silenceScreened { 0 };
+    std::atomic<uint64_t> silenceRejected { 0 };
+    std::atomic<uint64_t> silenceKept { 0 };
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GeneticAlgorithm)
 };
@@ -8,40 +8,130 @@
 
 #include "GenomeConstraints.h"
 #include <algorithm>
+#include <cmath>
 
 namespace GenomeConstraints
 {
 
-void repair(std::vector<float>& genome)
+namespace
 {
-    if (genome.size() <= FilterEnv)
-        return;
-
-    float filterFreq = genome[FilterFreq];
-    float filterEnv = genome[FilterEnv];
+    // FilterEnv needed for audible output, or the current value if it's enough
+    float repairedFilterEnv(float filterFreq, float filterEnv)
+    {
+        // FilterEnv normalized: 0.0 = -100%, 0.5 = 0%, 1.0 = +100%
+        // Combined audibility: filterFreq + weighted positive envelope
+        // The envelope contribution is weighted because it only opens filter during attack
+        constexpr float envWeight = 0.7f;
+        
+        // Minimum combined score for audible output
+        constexpr float minAudibility = 0.35f;
+        
+        // With the cutoff too low, the positive envelope that makes up the
+        // deficit, converted back to normalized filterEnv (0.5 + requiredPositiveEnv/2).
+        // filterEnv falls below it exactly when filterFreq plus the weighted
+        // positive envelope falls short of minAudibility; it is only ever raised
+        const float requiredPositiveEnv = (minAudibility - filterFreq) / envWeight;
+        const float requiredFilterEnv = filterFreq < minAudibility ? std::min(1.0f, 0.5f + requiredPositiveEnv / 2.0f) : 0.0f;
+        return std::max(filterEnv, requiredFilterEnv);
+    }
+    
+    // Envelope time constant in seconds: SynthParameters' exp(-dt * exp(5.5 - 0.075 * x)) coefficients
+    float timeConstant(float value)
+    {
+        return std::exp(0.075f * value - 5.5f);
+    }
+    
+    // JX11 envelope level t seconds after note-on: rises towards 2 until it
+    // passes 1, then falls towards sustain
+    float envelopeLevel(float t, float attackTau, float decayTau, float sustain)
+    {
+        const float peakTime = attackTau * 0.6931472f;  // ln 2
+        return t < peakTime ? 2.0f * (1.0f - std::exp(-t / attackTau))
+                            : sustain + (1.0f - sustain) * std::exp(-(t - peakTime) / decayTau);
+    }
+}
 
-    // FilterEnv normalized: 0.0 = -100%, 0.5 = 0%, 1.0 = +100%
-    // Positive envelope contribution only when filterEnv > 0.5
-    float positiveEnvContribution = std::max(0.0f, (filterEnv - 0.5f) * 2.0f);
+void repair(std::vector<float>& genome)
+{
+    repair(genome.data(), static_cast<int>(genome.size()));
+}
 
-    // Combined audibility: filterFreq + weighted positive envelope
-    // The envelope contribution is weighted because it only opens filter during attack
-    constexpr float envWeight = 0.7f;
-    float audibilityScore = filterFreq + positiveEnvContribution * envWeight;
+void repair(float* genome, int size)
+{
+    repairBatch(genome, 1, size);
+}
 
-    // Minimum combined score for audible output
-    constexpr float minAudibility = 0.35f;
+void repairBatch(float* genomes, int numGenomes, int size)
+{
+    if (size <= FilterEnv)
+        return;
+    
+    for (int row = 0; row < numGenomes; ++row)
+    {
+        float* genome = genomes + static_cast<size_t>(row) * size;
+        genome[FilterEnv] = repairedFilterEnv(genome[FilterFreq], genome[FilterEnv]);
+    }
+}
 
-    if (audibilityScore < minAudibility)
+float estimateLevelDb(const float* genome, int size)
+{
+    if (size <= EnvRelease)
+        return 0.0f;
+    
+    // The feature phrase: C4, E4, G4, C5 at falling then rising velocity
+    constexpr int numNotes = 4;
+    constexpr float noteFrequencies[numNotes] = { 261.6f, 329.6f, 392.0f, 523.3f };
+    constexpr float noteVelocities[numNotes] = { 110.0f, 80.0f, 50.0f, 100.0f };
+    constexpr float noteSeconds = 0.25f;
+    constexpr int pointsPerNote = 8;
+    
+    // Key tracking glides in from 0 (the synth's filterZip) with this time
+    // constant at the fitness profile's 22050 Hz: 0.005 per 32-sample step
+    constexpr float keyTrackingTau = 32.0f / (0.005f * 22050.0f);
+    
+    const float attackTau = timeConstant(genome[EnvAttack] * 100.0f);
+    const float decayTau = timeConstant(15.0f + genome[EnvDecay] * 85.0f);
+    const float sustain = genome[EnvSustain];
+    
+    const float filterAttackTau = timeConstant(genome[FilterAttack] * 100.0f);
+    const float filterDecayTau = timeConstant(genome[FilterDecay] * 100.0f);
+    const float filterSustain = genome[FilterSustain] * genome[FilterSustain];
+    
+    // Log-cutoff offsets: key tracking and envelope depth, and the fixed
+    // moderate velocity sensitivity
+    const float keyTracking = 8.0f * genome[FilterFreq] - 1.5f;
+    const float envelopeDepth = 12.0f * genome[FilterEnv] - 6.0f;
+    constexpr float velocitySensitivity = 0.025f;
+    constexpr float minimumCutoff = 30.0f;
+    constexpr float pi = 3.14159265f;
+    
+    float sum = 0.0f;
+    
+    for (int note = 0; note < numNotes; ++note)
     {
-        // Calculate how much positive envelope we need to reach minimum
-        float deficit = minAudibility - filterFreq;
-        float requiredPositiveEnv = deficit / envWeight;
+        const float frequency = noteFrequencies[note];
+        const float velocityOffset = velocitySensitivity * (noteVelocities[note] - 64.0f);
         
-        // Convert back to normalized filterEnv (0.5 + requiredPositiveEnv/2)
-        float requiredFilterEnv = 0.5f + requiredPositiveEnv / 2.0f;
-        genome[FilterEnv] = std::min(1.0f, requiredFilterEnv);
+        for (int point = 0; point < pointsPerNote; ++point)
+        {
+            const float t = (static_cast<float>(point) + 0.5f) * noteSeconds / pointsPerNote;
+            const float amp = envelopeLevel(t, attackTau, decayTau, sustain);
+            const float filterEnvelope = envelopeLevel(t, filterAttackTau, filterDecayTau, filterSustain);
+            
+            // Once the cutoff (f / pi at no modulation) falls below the note,
+            // rendered level drops about 3 dB per octave: the saw's low end
+            // still gets through, so even the 30 Hz floor costs only ~10 dB
+            const float glide = 1.0f - std::exp(-(static_cast<float>(note) * noteSeconds + t) / keyTrackingTau);
+            const float modulation = keyTracking * glide + envelopeDepth * filterEnvelope + velocityOffset;
+            const float cutoff = std::max(minimumCutoff, frequency / pi * std::exp(modulation));
+            const float powerGain = std::min(1.0f, cutoff / frequency);
+            
+            sum += amp * amp * powerGain;
+        }
     }
+    
+    const float meanSquare = sum / static_cast<float>(numNotes * pointsPerNote);
+    return 10.0f * std::log10(meanSquare + 1e-12f);
 }
 
 }
@@ -9,13 +9,19 @@
 */
 
 #include "HeadlessSynth.h"
-#include "../JX11/Utils.h"
 #include <cmath>
 
 HeadlessSynth::HeadlessSynth(double sampleRate_, int blockSize_)
     : sampleRate(sampleRate_), blockSize(blockSize_)
 {
     synth.allocateResources(sampleRate, blockSize);
+    synth.fastMath = true;  // Offline fitness renders take the approximate coefficient math
+}
+
+void HeadlessSynth::setOutputGuard(OutputGuard guard)
+{
+    outputGuard = guard;
+    synth.protectOutput = guard == OutputGuard::perBlock;
 }
 
 void HeadlessSynth::setParameters(const std::vector<float>& normalizedParams)
@@ -23,114 +29,81 @@ void HeadlessSynth::setParameters(const std::vector<float>& normalizedParams)
     if (normalizedParams.size() != HeadlessParam::COUNT)
         return;  // Invalid parameter count
     
-    updateSynthParameters(normalizedParams);
+    updateSynthParameters(normalizedParams.data());
 }
 
-void HeadlessSynth::updateSynthParameters(const std::vector<float>& params)
+void HeadlessSynth::updateSynthParameters(const float* params)
 {
-    float inverseSampleRate = 1.0f / static_cast<float>(sampleRate);
-    const float inverseUpdateRate = inverseSampleRate * synth.LFO_MAX;
+    SynthParameters::Values values = synthValues;
     
     // Map normalized [0,1] to actual parameter ranges (17 GA parameters)
-    float oscMixValue = mapParameter(params[HeadlessParam::oscMix], 0.0f, 100.0f);
-    float oscFineValue = mapParameter(params[HeadlessParam::oscFine], -50.0f, 50.0f);
-    float filterFreqValue = mapParameter(params[HeadlessParam::filterFreq], 0.0f, 100.0f);
-    float filterResoValue = mapParameter(params[HeadlessParam::filterReso], 0.0f, 100.0f);
-    float filterEnvValue = mapParameter(params[HeadlessParam::filterEnv], -100.0f, 100.0f);
-    float filterLFOValue = mapParameter(params[HeadlessParam::filterLFO], 0.0f, 100.0f);
-    float filterAttackValue = mapParameter(params[HeadlessParam::filterAttack], 0.0f, 100.0f);
-    float filterDecayValue = mapParameter(params[HeadlessParam::filterDecay], 0.0f, 100.0f);
-    float filterSustainValue = mapParameter(params[HeadlessParam::filterSustain], 0.0f, 100.0f);
-    float filterReleaseValue = mapParameter(params[HeadlessParam::filterRelease], 0.0f, 100.0f);
-    float envAttackValue = mapParameter(params[HeadlessParam::envAttack], 0.0f, 100.0f);
-    float envDecayValue = mapParameter(params[HeadlessParam::envDecay], 15.0f, 100.0f);
-    float envSustainValue = mapParameter(params[HeadlessParam::envSustain], 0.0f, 100.0f);
-    float envReleaseValue = mapParameter(params[HeadlessParam::envRelease], 0.0f, 100.0f);
-    float lfoRateValue = params[HeadlessParam::lfoRate];  // Already 0-1
-    float vibratoValue = mapParameter(params[HeadlessParam::vibrato], -100.0f, 100.0f);
-    float noiseValue = mapParameter(params[HeadlessParam::noise], 0.0f, 100.0f);
-    
-    // Fixed values for excluded parameters (not controlled by GA)
-    float oscTuneValue = 0.0f;
-    float glideBendValue = 0.0f;
-    float filterVelocityValue = 50.0f;
-    float octaveValue = 0.0f;
-    float tuningValue = 0.0f;
-    float outputLevelValue = 0.0f;  // 0 dB
-    
-    // Amplitude envelope
-    synth.envAttack = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envAttackValue));
-    synth.envDecay = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envDecayValue));
-    synth.envSustain = envSustainValue / 100.0f;
-    synth.envRelease = (envReleaseValue < 1.0f) ? 0.75f
-                                                : std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envReleaseValue));
-    
-    // Noise mix (nonlinear scaling)
-    float noiseMix = noiseValue / 100.0f;
-    noiseMix *= noiseMix;
-    synth.noiseMix = noiseMix * 0.06f;
-    
-    // Oscillator mix and tuning
-    synth.oscMix = oscMixValue / 100.0f;
-    synth.detune = std::pow(1.059463094359f, -oscTuneValue - 0.01f * oscFineValue);
-    
-    // Base tuning frequency (using fixed octave and tuning values)
-    float tuneInSemi = -36.3763f - 12.0f * octaveValue - tuningValue / 100.0f;
-    synth.tune = static_cast<float>(sampleRate) * std::exp(0.05776226505f * tuneInSemi);
-    
-    // Voice count (fixed to polyphonic)
-    synth.numVoices = Synth::MAX_VOICES;
-    
-    // Filter modulation
-    float filterLFO = filterLFOValue / 100.0f;
-    synth.filterLFODepth = 2.5f * filterLFO * filterLFO;
-    
-    float filterReso = filterResoValue / 100.0f;
-    synth.filterQ = std::exp(3.0f * filterReso);
-    
-    // Volume trim compensation
-    synth.volumeTrim = 0.0008f * (3.2f - synth.oscMix - 25.0f * synth.noiseMix) * (1.5f - 0.5f * filterReso);
-    
-    // Output level (fixed to 0 dB)
-    synth.outputLevelSmoother.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(outputLevelValue));
-    
-    // Velocity sensitivity (fixed to moderate)
-    synth.velocitySensitivity = 0.0005f * filterVelocityValue;
-    synth.ignoreVelocity = false;
-    
-    // LFO rate
-    float lfoRate = std::exp(7.0f * lfoRateValue - 4.0f);
-    synth.lfoInc = lfoRate * inverseUpdateRate * float(TWO_PI);
-    
-    // Vibrato and PWM
-    float vibrato = vibratoValue / 200.0f;
-    synth.vibrato = 0.2f * vibrato * vibrato;
-    synth.pwmDepth = synth.vibrato;
-    if (vibrato < 0.0f) synth.vibrato = 0.0f;
-    
-    // Glide (fixed to off)
-    synth.glideMode = 0;
-    synth.glideRate = 1.0f;
-    synth.glideBend = glideBendValue;
-    
-    // Filter envelope and tracking
-    synth.filterKeyTracking = 0.08f * filterFreqValue - 1.5f;
-    synth.filterAttack = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * filterAttackValue));
-    synth.filterDecay = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * filterDecayValue));
-    float filterSustain = filterSustainValue / 100.0f;
-    synth.filterSustain = filterSustain * filterSustain;
-    synth.filterRelease = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * filterReleaseValue));
-    synth.filterEnvDepth = 0.06f * filterEnvValue;
+    values[SynthParameters::oscMix] = mapParameter(params[HeadlessParam::oscMix], 0.0f, 100.0f);
+    values[SynthParameters::oscFine] = mapParameter(params[HeadlessParam::oscFine], -50.0f, 50.0f);
+    values[SynthParameters::filterFreq] = mapParameter(params[HeadlessParam::filterFreq], 0.0f, 100.0f);
+    values[SynthParameters::filterReso] = mapParameter(params[HeadlessParam::filterReso], 0.0f, 100.0f);
+    values[SynthParameters::filterEnv] = mapParameter(params[HeadlessParam::filterEnv], -100.0f, 100.0f);
+    values[SynthParameters::filterLFO] = mapParameter(params[HeadlessParam::filterLFO], 0.0f, 100.0f);
+    values[SynthParameters::filterAttack] = mapParameter(params[HeadlessParam::filterAttack], 0.0f, 100.0f);
+    values[SynthParameters::filterDecay] = mapParameter(params[HeadlessParam::filterDecay], 0.0f, 100.0f);
+    values[SynthParameters::filterSustain] = mapParameter(params[HeadlessParam::filterSustain], 0.0f, 100.0f);
+    values[SynthParameters::filterRelease] = mapParameter(params[HeadlessParam::filterRelease], 0.0f, 100.0f);
+    values[SynthParameters::envAttack] = mapParameter(params[HeadlessParam::envAttack], 0.0f, 100.0f);
+    values[SynthParameters::envDecay] = mapParameter(params[HeadlessParam::envDecay], 15.0f, 100.0f);
+    values[SynthParameters::envSustain] = mapParameter(params[HeadlessParam::envSustain], 0.0f, 100.0f);
+    values[SynthParameters::envRelease] = mapParameter(params[HeadlessParam::envRelease], 0.0f, 100.0f);
+    values[SynthParameters::lfoRate] = params[HeadlessParam::lfoRate];  // Already 0-1
+    values[SynthParameters::vibrato] = mapParameter(params[HeadlessParam::vibrato], -100.0f, 100.0f);
+    values[SynthParameters::noise] = mapParameter(params[HeadlessParam::noise], 0.0f, 100.0f);
+    
+    // The first call sets everything, including the fixed parameters; after
+    // that only the genome entries that changed are recomputed
+    const SynthParameters::DirtyMask dirty = synthValuesApplied ? SynthParameters::diff(values, synthValues)
+                                                                : SynthParameters::allDirty;
+    SynthParameters::apply(synth, values, dirty, static_cast<float>(sampleRate));
+    
+    if (!synthValuesApplied)
+    {
+        // Renders start at full level rather than ramping up from silence
+        synth.outputLevelSmoother.setCurrentAndTargetValue(
+            juce::Decibels::decibelsToGain(values[SynthParameters::outputLevel]));
+        synthValuesApplied = true;
+    }
+    
+    synthValues = values;
+}
+
+SynthParameters::Values HeadlessSynth::makeFixedValues()
+{
+    // Fixed values for the parameters the GA never evolves
+    SynthParameters::Values values {};
+    values[SynthParameters::oscTune] = 0.0f;
+    values[SynthParameters::glideMode] = 0.0f;        // Off
+    values[SynthParameters::glideRate] = 0.0f;        // Instant
+    values[SynthParameters::glideBend] = 0.0f;
+    values[SynthParameters::filterVelocity] = 50.0f;  // Moderate
+    values[SynthParameters::octave] = 0.0f;
+    values[SynthParameters::tuning] = 0.0f;
+    values[SynthParameters::outputLevel] = 0.0f;      // 0 dB
+    values[SynthParameters::polyMode] = 1.0f;         // Polyphonic
+    return values;
 }
 
 juce::AudioBuffer<float> HeadlessSynth::renderNote(int midiNote, int velocity, int durationInSamples, float noteOnDuration)
+{
+    juce::AudioBuffer<float> buffer(1, durationInSamples);  // Mono (more efficient for feature extraction)
+    renderNote(midiNote, velocity, buffer, noteOnDuration);
+    return buffer;
+}
+
+void HeadlessSynth::renderNote(int midiNote, int velocity, juce::AudioBuffer<float>& buffer, float noteOnDuration)
 {
     synth.reset();  // Clear state for consistent results
+    renderedSamples = 0;
     
-    juce::AudioBuffer<float> buffer(1, durationInSamples);  // Mono (more efficient for feature extraction)
-    buffer.clear();
+    const int durationInSamples = buffer.getNumSamples();
+    buffer.clear(0, 0, durationInSamples);
     
-    float* outputs[2] = { buffer.getWritePointer(0), buffer.getWritePointer(0) };  // Both outputs point to same buffer
+    float* output = buffer.getWritePointer(0);  // Mono render straight into channel 0
     
     // Send note-on at the beginning
     synth.midiMessage(0x90, static_cast<uint8_t>(midiNote), static_cast<uint8_t>(velocity));
@@ -140,7 +113,7 @@ juce::AudioBuffer<float> HeadlessSynth::renderNote(int midiNote, int velocity, i
     
     // Render up to note-off
     if (noteOffSample > 0)
-        synth.render(outputs, noteOffSample);
+        renderSynth(output, noteOffSample);
     
     // Send note-off
     synth.midiMessage(0x80, static_cast<uint8_t>(midiNote), 0);
@@ -148,57 +121,74 @@ juce::AudioBuffer<float> HeadlessSynth::renderNote(int midiNote, int velocity, i
     // Render remaining samples (release phase)
     int remainingSamples = durationInSamples - noteOffSample;
     if (remainingSamples > 0)
-    {
-        float* offsetOutputs[2] = {
-            outputs[0] + noteOffSample,
-            outputs[1] + noteOffSample
-        };
-        synth.render(offsetOutputs, remainingSamples);
-    }
+        renderTail(output + noteOffSample, remainingSamples);
     
-    return buffer;
+    if (outputGuard == OutputGuard::deferred)
+        protectYourEars(output, durationInSamples);
 }
 
 juce::AudioBuffer<float> HeadlessSynth::renderSequence(const std::vector<MidiEvent>& events, int totalSamples)
+{
+    juce::AudioBuffer<float> buffer(1, totalSamples);  // Mono (more efficient for feature extraction)
+    renderSequence(events, buffer);
+    return buffer;
+}
+
+void HeadlessSynth::renderSequence(const std::vector<MidiEvent>& events, juce::AudioBuffer<float>& buffer)
 {
     synth.reset();  // Clear state
+    renderedSamples = 0;
     
-    juce::AudioBuffer<float> buffer(1, totalSamples);  // Mono (more efficient for feature extraction)
-    buffer.clear();
+    const int totalSamples = buffer.getNumSamples();
+    buffer.clear(0, 0, totalSamples);
     
-    float* outputs[2] = { buffer.getWritePointer(0), buffer.getWritePointer(0) };  // Both outputs point to same buffer
+    float* output = buffer.getWritePointer(0);  // Mono render straight into channel 0
     
-    int currentSample = 0;
     size_t eventIndex = 0;
+    renderEvents(events, eventIndex, 0, output, totalSamples);
+    
+    if (outputGuard == OutputGuard::deferred)
+        protectYourEars(output, totalSamples);
+}
+
+void HeadlessSynth::renderEvents(const std::vector<MidiEvent>& events, size_t& eventIndex,
+                                 int startSample, float* output, int numSamples)
+{
+    int rendered = 0;
     
-    while (currentSample < totalSamples)
+    while (rendered < numSamples)
     {
-        // Find next event
-        int nextEventSample = totalSamples;
-        if (eventIndex < events.size())
-            nextEventSample = events[eventIndex].samplePosition;
-        
-        // Render up to next event
-        int samplesToRender = juce::jmin(nextEventSample - currentSample, totalSamples - currentSample);
-        if (samplesToRender > 0)
-        {
-            float* offsetOutputs[2] = {
-                outputs[0] + currentSample,
-                outputs[1] + currentSample
-            };
-            synth.render(offsetOutputs, samplesToRender);
-            currentSample += samplesToRender;
-        }
-        
-        // Process event if we reached it
-        if (eventIndex < events.size() && currentSample == events[eventIndex].samplePosition)
+        // Process every event due at this position
+        while (eventIndex < events.size() && events[eventIndex].samplePosition <= startSample + rendered)
         {
             const auto& event = events[eventIndex];
             synth.midiMessage(event.status, event.note, event.velocity);
             ++eventIndex;
         }
+        
+        // Past the last event nothing can start a voice again
+        if (eventIndex >= events.size())
+        {
+            renderTail(output + rendered, numSamples - rendered);
+            return;
+        }
+        
+        // Render up to next event
+        int renderEnd = juce::jmin(events[eventIndex].samplePosition - startSample, numSamples);
+        renderSynth(output + rendered, renderEnd - rendered);
+        rendered = renderEnd;
     }
+}
+
+void HeadlessSynth::renderTail(float* output, int numSamples)
+{
+    int rendered = 0;
     
-    return buffer;
+    while (rendered < numSamples && !synth.isSilent())
+    {
+        int chunk = juce::jmin(blockSize, numSamples - rendered);
+        renderSynth(output + rendered, chunk);
+        rendered += chunk;
+    }
 }
 
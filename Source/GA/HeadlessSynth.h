@@ -13,6 +13,9 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "../JX11/Synth.h"
+#include "../JX11/SynthParameters.h"
+#include "../JX11/Utils.h"
+#include <algorithm>
 
 // Simple MIDI event structure for sequencing
 struct MidiEvent
@@ -60,6 +63,9 @@ public:
     // Set parameters from normalized [0,1] values
     void setParameters(const std::vector<float>& normalizedParams);
     
+    // Same, from HeadlessParam::COUNT contiguous values
+    void setParameters(const float* normalizedParams) { updateSynthParameters(normalizedParams); }
+    
     // Render a single note for a fixed duration
     // noteOnDuration: how long to hold the note before releasing (0.0-1.0 of total duration)
     juce::AudioBuffer<float> renderNote(int midiNote, int velocity, int durationInSamples, float noteOnDuration = 0.8f);
@@ -67,16 +73,73 @@ public:
     // Render a sequence of MIDI events
     juce::AudioBuffer<float> renderSequence(const std::vector<MidiEvent>& events, int totalSamples);
     
+    // Render into channel 0 of a caller-owned buffer, for its full length.
+    // Reusing the buffer keeps repeated renders free of heap allocation.
+    void renderNote(int midiNote, int velocity, juce::AudioBuffer<float>& buffer, float noteOnDuration = 0.8f);
+    void renderSequence(const std::vector<MidiEvent>& events, juce::AudioBuffer<float>& buffer);
+    
+    /**
+     * Renders totalSamples of a sequence in blocks of up to scratchSize
+     * samples, calling consumer(const float* block, int numSamples) as each
+     * block finishes. Only the scratch block is held, and the samples match
+     * renderSequence. A deferred guard checks each block on its own.
+     */
+    template <typename Consumer>
+    void streamSequence(const std::vector<MidiEvent>& events, int totalSamples,
+                        float* scratch, int scratchSize, Consumer&& consumer);
+    
     // Get expected parameter count
     static int getParameterCount() { return HeadlessParam::COUNT; }
     
+    // Samples the last render actually synthesised; the rest were left
+    // silent because every voice had already decayed
+    int getRenderedSamples() const { return renderedSamples; }
+    
+    // How rendered audio is guarded against NaN/Inf and overs
+    enum class OutputGuard
+    {
+        perBlock,   // protectYourEars on every rendered block, like the plugin (default)
+        deferred,   // One protectYourEars pass over the finished render
+        off         // No check; for callers that validate the audio themselves
+    };
+    
+    void setOutputGuard(OutputGuard guard);
+    OutputGuard getOutputGuard() const { return outputGuard; }
+    
 private:
+    friend class HeadlessSynthBatch;  // Drives synth in lockstep with other lanes
+    
     Synth synth;
     double sampleRate;
     int blockSize;
+    OutputGuard outputGuard = OutputGuard::perBlock;
+    int renderedSamples = 0;
+    
+    // synth.render<1>, counted in renderedSamples
+    void renderSynth(float* output, int numSamples)
+    {
+        synth.render<1>(&output, numSamples);
+        renderedSamples += numSamples;
+    }
+    
+    // Renders output[0, numSamples) starting at sample startSample of the
+    // sequence, firing events from eventIndex as they fall due (output is
+    // already zeroed)
+    void renderEvents(const std::vector<MidiEvent>& events, size_t& eventIndex,
+                      int startSample, float* output, int numSamples);
     
-    // Convert normalized [0,1] parameters to synth-specific values
-    void updateSynthParameters(const std::vector<float>& normalizedParams);
+    // Renders up to numSamples after the last event in blockSize chunks, stopping
+    // once every voice is silent (the caller's buffer is already zeroed)
+    void renderTail(float* output, int numSamples);
+    
+    // Convert normalized [0,1] parameters (HeadlessParam::COUNT values) to synth-specific values.
+    // Only coefficients whose parameters differ from the previous call are recomputed.
+    void updateSynthParameters(const float* normalizedParams);
+    
+    static SynthParameters::Values makeFixedValues();
+    
+    SynthParameters::Values synthValues = makeFixedValues();  // Plain values last applied to synth
+    bool synthValuesApplied = false;
     
     // Map a single normalized value to a parameter range
     static inline float mapParameter(float normalized, float min, float max)
@@ -85,3 +148,26 @@ private:
     }
 };
 
+template <typename Consumer>
+void HeadlessSynth::streamSequence(const std::vector<MidiEvent>& events, int totalSamples,
+                                   float* scratch, int scratchSize, Consumer&& consumer)
+{
+    synth.reset();  // Clear state
+    renderedSamples = 0;
+    
+    size_t eventIndex = 0;
+    
+    for (int position = 0; position < totalSamples; )
+    {
+        const int numSamples = juce::jmin(scratchSize, totalSamples - position);
+        std::fill(scratch, scratch + numSamples, 0.0f);
+        
+        renderEvents(events, eventIndex, position, scratch, numSamples);
+        
+        if (outputGuard == OutputGuard::deferred)
+            protectYourEars(scratch, numSamples);
+        
+        consumer(static_cast<const float*>(scratch), numSamples);
+        position += numSamples;
+    }
+}
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+    HeadlessSynthBatch.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "HeadlessSynthBatch.h"
+#include "../JX11/Utils.h"
+
+HeadlessSynthBatch::HeadlessSynthBatch(double sampleRate, int blockSize_)
+    : blockSize(blockSize_)
+{
+    for (auto& lane : lanes)
+        lane = std::make_unique<HeadlessSynth>(sampleRate, blockSize);
+}
+
+void HeadlessSynthBatch::setParameters(int lane, const float* normalizedParams)
+{
+    jassert(lane >= 0 && lane < MAX_WIDTH);
+    lanes[static_cast<size_t>(lane)]->updateSynthParameters(normalizedParams);
+}
+
+void HeadlessSynthBatch::setOutputGuard(HeadlessSynth::OutputGuard guard)
+{
+    for (auto& lane : lanes)
+        lane->setOutputGuard(guard);
+}
+
+void HeadlessSynthBatch::renderSequence(const std::vector<MidiEvent>& events, juce::AudioBuffer<float>& output, int width)
+{
+    jassert(width > 0 && width <= MAX_WIDTH && output.getNumChannels() >= width);
+    
+    const int totalSamples = output.getNumSamples();
+    float* outputs[MAX_WIDTH] = {};
+    
+    for (int l = 0; l < width; ++l)
+    {
+        lanes[static_cast<size_t>(l)]->synth.reset();
+        output.clear(l, 0, totalSamples);
+        outputs[l] = output.getWritePointer(l);
+    }
+    
+    int currentSample = 0;
+    size_t eventIndex = 0;
+    
+    while (currentSample < totalSamples)
+    {
+        // Past the last event: render the tail until every lane is silent
+        if (eventIndex >= events.size())
+        {
+            while (currentSample < totalSamples && !allSilent(width))
+            {
+                int chunk = juce::jmin(blockSize, totalSamples - currentSample);
+                renderLockstep(outputs, currentSample, chunk, width);
+                currentSample += chunk;
+            }
+            break;
+        }
+        
+        // Render up to next event
+        int samplesToRender = juce::jmin(events[eventIndex].samplePosition, totalSamples) - currentSample;
+        if (samplesToRender > 0)
+        {
+            renderLockstep(outputs, currentSample, samplesToRender, width);
+            currentSample += samplesToRender;
+        }
+        
+        // Every lane sees the same event
+        if (currentSample == events[eventIndex].samplePosition)
+        {
+            const auto& event = events[eventIndex];
+            for (int l = 0; l < width; ++l)
+                lanes[static_cast<size_t>(l)]->synth.midiMessage(event.status, event.note, event.velocity);
+        }
+        
+        if (currentSample >= events[eventIndex].samplePosition)
+            ++eventIndex;
+    }
+    
+    if (lanes[0]->getOutputGuard() == HeadlessSynth::OutputGuard::deferred)
+        for (int l = 0; l < width; ++l)
+            protectYourEars(outputs[l], totalSamples);
+}
+
+void HeadlessSynthBatch::renderLockstep(float* const* outputs, int offset, int numSamples, int width)
+{
+    for (int l = 0; l < width; ++l)
+        lanes[static_cast<size_t>(l)]->synth.beginRender();
+    
+    int sample = 0;
+    while (sample < numSamples)
+    {
+        // Lanes were reset together and render the same spans, so their LFOs step together
+        int runLength = lanes[0]->synth.beginRun(numSamples - sample);
+        for (int l = 1; l < width; ++l)
+        {
+            int laneRun = lanes[static_cast<size_t>(l)]->synth.beginRun(numSamples - sample);
+            jassert(laneRun == runLength);
+            juce::ignoreUnused(laneRun);
+        }
+        
+        voiceBank.beginLoad();
+        for (int l = 0; l < width; ++l)
+            lanes[static_cast<size_t>(l)]->synth.appendVoices(voiceBank, l);
+        voiceBank.endLoad();
+        
+        float laneNoise[MAX_WIDTH][Synth::LFO_MAX];
+        for (int l = 0; l < width; ++l)
+            lanes[static_cast<size_t>(l)]->synth.fillNoise(laneNoise[l], runLength);
+        
+        for (int i = 0; i < runLength; ++i, ++sample)
+        {
+            float noise[MAX_WIDTH];
+            float laneOutput[MAX_WIDTH] = {};
+            
+            for (int l = 0; l < width; ++l)
+                noise[l] = laneNoise[l][i];
+            
+            // Mono mix, as Synth::render<1> produces for HeadlessSynth
+            voiceBank.renderSample(noise, laneOutput);
+            
+            for (int l = 0; l < width; ++l)
+                outputs[l][offset + sample] = laneOutput[l] * lanes[static_cast<size_t>(l)]->synth.nextOutputLevel();
+        }
+        
+        voiceBank.store();
+    }
+    
+    for (int l = 0; l < width; ++l)
+    {
+        float* laneOutput = outputs[l] + offset;
+        lanes[static_cast<size_t>(l)]->synth.endRender(&laneOutput, 1, numSamples);
+    }
+}
+
+bool HeadlessSynthBatch::allSilent(int width) const
+{
+    for (int l = 0; l < width; ++l)
+        if (!lanes[static_cast<size_t>(l)]->synth.isSilent())
+            return false;
+    return true;
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+    HeadlessSynthBatch.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Renders the same MIDI phrase for several genomes in one lockstep sweep.
+    Each lane is a HeadlessSynth; every lane's voices share one VoiceBank,
+    so the per-sample lane loops cover all candidates at once. Event timing
+    and LFO steps are identical across lanes, and each lane's output matches
+    HeadlessSynth::renderSequence bit for bit.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "HeadlessSynth.h"
+#include <array>
+#include <memory>
+
+class HeadlessSynthBatch
+{
+public:
+    static constexpr int MAX_WIDTH = 8;  // Genomes rendered per sweep
+    
+    HeadlessSynthBatch(double sampleRate = 44100.0, int blockSize = 512);
+    
+    // Set one lane's genome from HeadlessParam::COUNT normalized [0,1] values
+    void setParameters(int lane, const float* normalizedParams);
+    
+    // Applies to every lane (see HeadlessSynth::OutputGuard)
+    void setOutputGuard(HeadlessSynth::OutputGuard guard);
+    
+    /**
+     * Renders events for lanes [0, width), lane i into channel i of output
+     * for its full length. Output must have at least width channels; reusing
+     * it keeps repeated renders free of heap allocation.
+     */
+    void renderSequence(const std::vector<MidiEvent>& events, juce::AudioBuffer<float>& output, int width);
+    
+private:
+    std::array<std::unique_ptr<HeadlessSynth>, MAX_WIDTH> lanes;
+    VoiceBank<MAX_WIDTH * Synth::MAX_VOICES> voiceBank;
+    int blockSize;
+    
+    // One Synth::render-equivalent call on every lane
+    void renderLockstep(float* const* outputs, int offset, int numSamples, int width);
+    bool allSilent(int width) const;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeadlessSynthBatch)
+};
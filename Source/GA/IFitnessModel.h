@@ -11,6 +11,8 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 
 class IFitnessModel
 {
@@ -31,6 +33,93 @@ public:
      */
     virtual float evaluate(const std::vector<float>& genome) = 0;
 
+    /**
+     * Evaluates a batch of genomes in one call.
+     * The default implementation falls back to evaluate() per genome.
+     * @param genomes Row-major numGenomes x genomeSize matrix.
+     * @param fitnessOut Receives numGenomes fitness values.
+     */
+    virtual void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut)
+    {
+        std::vector<float> genome(static_cast<size_t>(genomeSize));
+        
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            const float* row = genomes + static_cast<size_t>(i) * genomeSize;
+            genome.assign(row, row + genomeSize);
+            fitnessOut[i] = evaluate(genome);
+        }
+    }
+
+    /**
+     * Cheap provisional scores from a prefix of the full evaluation (e.g. the
+     * first note of the phrase), used to reject clearly bad candidates early.
+     * Returns false when the model has no cheaper estimate than evaluate().
+     * @param genomes Row-major numGenomes x genomeSize matrix.
+     * @param estimatesOut Receives numGenomes provisional fitness values.
+     */
+    virtual bool estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut)
+    {
+        (void)genomes; (void)numGenomes; (void)genomeSize; (void)estimatesOut;
+        return false;
+    }
+
+    /**
+     * A far cheaper score than evaluate() on a different basis (e.g. a model
+     * of the genome standing in for one of its audio), used to rank
+     * candidates before deciding which deserve a full evaluation; a model
+     * whose evaluate() is already that cheap may return its fitness. Its
+     * values need not be comparable to fitness, only ordered alike. Returns
+     * false when the model has nothing that cheap.
+     * @param genomes Row-major numGenomes x genomeSize matrix.
+     * @param scoresOut Receives numGenomes surrogate scores.
+     */
+    virtual bool surrogateBatch(const float* genomes, int numGenomes, int genomeSize, float* scoresOut)
+    {
+        (void)genomes; (void)numGenomes; (void)genomeSize; (void)scoresOut;
+        return false;
+    }
+
+    /**
+     * Scores with an uncertainty estimate: the mean and variance of the
+     * model's belief about each genome's fitness, for exploration that
+     * favours genomes the model is unsure about. Returns false when the
+     * model has no uncertainty estimate.
+     * @param genomes Row-major numGenomes x genomeSize matrix.
+     * @param meanOut Receives numGenomes mean fitness values.
+     * @param varianceOut Receives numGenomes variances.
+     */
+    virtual bool evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                                     float* meanOut, float* varianceOut)
+    {
+        (void)genomes; (void)numGenomes; (void)genomeSize; (void)meanOut; (void)varianceOut;
+        return false;
+    }
+
+    /**
+     * Changes whenever the same genome may score differently than before,
+     * e.g. when retrained weights are published, so callers holding scores
+     * know to refresh them. Thread-safe. Default: 0, for a model whose
+     * scores never change.
+     */
+    virtual uint64_t getModelVersion() const { return 0; }
+
+    /**
+     * Tells the model how many threads may call evaluate/evaluateBatch at
+     * once, so it can build per-thread render state up front. Default: no-op.
+     */
+    virtual void prepareForConcurrency(int numThreads) { (void)numThreads; }
+
+    /**
+     * Hints that these genomes will probably be evaluated or fed back soon,
+     * so the model can prepare for them in the background (e.g. render audio
+     * features). Must not block. Default: no-op.
+     */
+    virtual void prefetch(const float* genomes, int numGenomes, int genomeSize)
+    {
+        (void)genomes; (void)numGenomes; (void)genomeSize;
+    }
+
     /**
      * Trigger feedback mechanism.
      * @param genome The genome the feedback applies to.
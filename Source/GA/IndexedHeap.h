@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+    IndexedHeap.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Binary heap of slot ids keyed by an external float array, with a position
+    table so any slot can be updated or removed in O(log N).
+    Ties are broken by slot id so ordering is deterministic.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+template <bool MinHeap>
+class IndexedHeap
+{
+public:
+    // Prepares for ids in [0, capacity); storage is reserved once
+    void reset(int capacity)
+    {
+        heap.clear();
+        heap.reserve(static_cast<size_t>(capacity));
+        position.assign(static_cast<size_t>(capacity), -1);
+    }
+    
+    int size() const { return static_cast<int>(heap.size()); }
+    bool empty() const { return heap.empty(); }
+    bool contains(int id) const { return position[static_cast<size_t>(id)] >= 0; }
+    
+    int top() const { return heap.front(); }
+    
+    // Id stored at a heap position (children of p are 2p + 1 and 2p + 2)
+    int at(int heapPosition) const { return heap[static_cast<size_t>(heapPosition)]; }
+    
+    // True when id a belongs above id b
+    static bool before(int a, int b, const float* keys)
+    {
+        if (keys[a] != keys[b])
+            return MinHeap ? keys[a] < keys[b] : keys[a] > keys[b];
+        return a < b;
+    }
+    
+    void push(int id, const float* keys)
+    {
+        position[static_cast<size_t>(id)] = size();
+        heap.push_back(id);
+        siftUp(size() - 1, keys);
+    }
+    
+    void remove(int id, const float* keys)
+    {
+        int pos = position[static_cast<size_t>(id)];
+        int last = size() - 1;
+        
+        swapAt(pos, last);
+        heap.pop_back();
+        position[static_cast<size_t>(id)] = -1;
+        
+        if (pos < size())
+            restore(pos, keys);
+    }
+    
+    // Call after keys[id] changed
+    void update(int id, const float* keys)
+    {
+        restore(position[static_cast<size_t>(id)], keys);
+    }
+    
+    // O(N) heapify from the current contents
+    void rebuild(const float* keys)
+    {
+        for (int pos = size() / 2 - 1; pos >= 0; --pos)
+            siftDown(pos, keys);
+    }
+
+private:
+    std::vector<int> heap;
+    std::vector<int> position;
+    
+    void swapAt(int a, int b)
+    {
+        std::swap(heap[static_cast<size_t>(a)], heap[static_cast<size_t>(b)]);
+        position[static_cast<size_t>(heap[static_cast<size_t>(a)])] = a;
+        position[static_cast<size_t>(heap[static_cast<size_t>(b)])] = b;
+    }
+    
+    void restore(int pos, const float* keys)
+    {
+        if (pos > 0 && before(heap[static_cast<size_t>(pos)], heap[static_cast<size_t>((pos - 1) / 2)], keys))
+            siftUp(pos, keys);
+        else
+            siftDown(pos, keys);
+    }
+    
+    void siftUp(int pos, const float* keys)
+    {
+        while (pos > 0)
+        {
+            int parent = (pos - 1) / 2;
+            if (!before(heap[static_cast<size_t>(pos)], heap[static_cast<size_t>(parent)], keys))
+                break;
+            
+            swapAt(pos, parent);
+            pos = parent;
+        }
+    }
+    
+    void siftDown(int pos, const float* keys)
+    {
+        const int count = size();
+        
+        for (;;)
+        {
+            int first = pos;
+            int left = 2 * pos + 1;
+            int right = left + 1;
+            
+            if (left < count && before(heap[static_cast<size_t>(left)], heap[static_cast<size_t>(first)], keys))
+                first = left;
+            if (right < count && before(heap[static_cast<size_t>(right)], heap[static_cast<size_t>(first)], keys))
+                first = right;
+            
+            if (first == pos)
+                break;
+            
+            swapAt(pos, first);
+            pos = first;
+        }
+    }
+};
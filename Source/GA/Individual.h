@@ -6,12 +6,20 @@
 
     Simple individual class for genetic algorithm population.
     Stores parameters and fitness with variable parameter count support.
+    IndividualView is a lightweight read-only view used for population slots.
+    Genome<N> is a fixed-size, allocation-free genome for per-generation buffers.
   ==============================================================================
 */
 
 #pragma once
 
 #include <vector>
+#include <array>
+#include <cstddef>
+
+// Compile-time sized genome (rows of an array of these are contiguous)
+template <int N>
+using Genome = std::array<float, static_cast<size_t>(N)>;
 
 class Individual
 {
@@ -43,3 +51,39 @@ private:
     float fitness = 0.0f;
     bool isEvaluated = false;
 };
+
+//==============================================================================
+/**
+    Non-owning view of one individual's genome and fitness.
+    Population hands these out for its contiguous storage; an Individual
+    converts implicitly so operators accept either.
+    Only valid while the underlying storage is unchanged.
+*/
+class IndividualView
+{
+public:
+    IndividualView(const float* parameters, int parameterCount, float fitness, bool evaluated)
+        : params(parameters), count(parameterCount), fitness(fitness), evaluated(evaluated) {}
+    
+    IndividualView(const Individual& individual)
+        : params(individual.getParameters().data())
+        , count(individual.getParameterCount())
+        , fitness(individual.getFitness())
+        , evaluated(individual.hasBeenEvaluated()) {}
+    
+    int getParameterCount() const { return count; }
+    float getParameter(int index) const { return (index >= 0 && index < count) ? params[index] : 0.0f; }
+    const float* data() const { return params; }
+    
+    // Copies the genome (for APIs that still take std::vector)
+    std::vector<float> getParameters() const { return std::vector<float>(params, params + count); }
+    
+    float getFitness() const { return fitness; }
+    bool hasBeenEvaluated() const { return evaluated; }
+
+private:
+    const float* params;
+    int count;
+    float fitness;
+    bool evaluated;
+};
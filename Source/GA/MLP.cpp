@@ -7,8 +7,12 @@
 */
 
 #include "MLP.h"
+#include "RandomStream.h"
+#include <algorithm>
+#include <array>
+#include <random>
 
-MLP::MLP(int inputSize, int hiddenSize)
+MLP::MLP(int inputSize, int hiddenSize, uint64_t seed)
     : inputSize(inputSize)
     , hiddenSize(hiddenSize)
     , weightsIH(inputSize * hiddenSize)
@@ -24,18 +28,16 @@ MLP::MLP(int inputSize, int hiddenSize)
     , mBiasO(0.0f)
     , vBiasO(0.0f)
     , timestep(0)
-    , zHidden(hiddenSize)
-    , aHidden(hiddenSize)
-    , zOutput(0.0f)
-    , aOutput(0.5f)
+    , gradIH(inputSize * hiddenSize)
+    , gradBiasH(hiddenSize)
+    , gradHO(hiddenSize)
 {
-    initializeWeights();
+    initializeWeights(seed);
 }
 
-void MLP::initializeWeights()
+void MLP::initializeWeights(uint64_t seed)
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    RandomStream gen(seed);
     
     // Xavier initialization for input->hidden
     float scaleIH = std::sqrt(2.0f / (inputSize + hiddenSize));
@@ -53,94 +55,155 @@ void MLP::initializeWeights()
     biasO = 0.0f;
 }
 
-float MLP::predict(const std::vector<float>& input)
+void MLP::hiddenLayer(const float* input, float* hidden) const
 {
-    // Input -> Hidden (with ReLU)
-    for (int j = 0; j < hiddenSize; ++j)
+    std::copy(biasH.begin(), biasH.end(), hidden);
+    
+    // Broadcast one input across a contiguous weight row; the multiply-add
+    // vectorises over hidden units and contracts to FMA where the target has it
+    for (int i = 0; i < inputSize; ++i)
     {
-        float sum = biasH[j];
-        for (int i = 0; i < inputSize; ++i)
-            sum += input[i] * weightsIH[i * hiddenSize + j];
+        const float x = input[i];
+        const float* w = weightsIH.data() + i * hiddenSize;
         
-        zHidden[j] = sum;
-        aHidden[j] = relu(sum);
+        for (int j = 0; j < hiddenSize; ++j)
+            hidden[j] += x * w[j];
     }
+}
+
+float MLP::predict(const std::vector<float>& input) const
+{
+    float output = 0.0f;
+    predictBatch(input.data(), 1, &output);
+    return output;
+}
+
+void MLP::predictBatch(const float* inputs, int numSamples, float* outputs) const
+{
+    // Hidden activations for a tile of samples live on the stack
+    constexpr int scratchSize = 1024;
+    std::array<float, scratchSize> scratch;
+    std::vector<float> largeScratch;
     
-    // Hidden -> Output (with sigmoid)
-    float sum = biasO;
-    for (int j = 0; j < hiddenSize; ++j)
-        sum += aHidden[j] * weightsHO[j];
+    float* hidden = scratch.data();
+    int tileSize = scratchSize / hiddenSize;
     
-    zOutput = sum;
-    aOutput = sigmoid(sum);
+    if (tileSize < 1)
+    {
+        largeScratch.resize(hiddenSize);
+        hidden = largeScratch.data();
+        tileSize = 1;
+    }
     
-    return aOutput;
+    for (int start = 0; start < numSamples; start += tileSize)
+    {
+        int count = std::min(tileSize, numSamples - start);
+        
+        // Input -> Hidden
+        for (int n = 0; n < count; ++n)
+            hiddenLayer(inputs + static_cast<size_t>(start + n) * inputSize, hidden + n * hiddenSize);
+        
+        // Hidden -> Output (with ReLU then sigmoid)
+        for (int n = 0; n < count; ++n)
+        {
+            const float* h = hidden + n * hiddenSize;
+            
+            float sum = biasO;
+            for (int j = 0; j < hiddenSize; ++j)
+                sum += relu(h[j]) * weightsHO[j];
+            
+            outputs[start + n] = sigmoid(sum);
+        }
+    }
 }
 
 void MLP::train(const std::vector<float>& input, float target, 
                 float learningRate, float sampleWeight)
 {
-    predict(input);
-    ++timestep;
+    trainBatch(input.data(), 1, &target, &sampleWeight, learningRate);
+}
+
+void MLP::trainBatch(const float* inputs, int numSamples, const float* targets,
+                     const float* sampleWeights, float learningRate)
+{
+    if (numSamples <= 0)
+        return;
     
-    float dOutput = (aOutput - target) * sampleWeight;
+    // Forward pass for the whole batch
+    batchHidden.resize(static_cast<size_t>(numSamples) * hiddenSize);
     
-    // Gradient clipping
-    if (dOutput > gradClipThreshold)
-        dOutput = gradClipThreshold;
-    else if (dOutput < -gradClipThreshold)
-        dOutput = -gradClipThreshold;
+    for (int n = 0; n < numSamples; ++n)
+        hiddenLayer(inputs + static_cast<size_t>(n) * inputSize, batchHidden.data() + static_cast<size_t>(n) * hiddenSize);
     
-    float bc1 = 1.0f - std::pow(beta1, timestep);
-    float bc2 = 1.0f - std::pow(beta2, timestep);
+    // Accumulate gradients; hidden deltas use weightsHO from before the update
+    std::fill(gradIH.begin(), gradIH.end(), 0.0f);
+    std::fill(gradBiasH.begin(), gradBiasH.end(), 0.0f);
+    std::fill(gradHO.begin(), gradHO.end(), 0.0f);
+    float gradBiasO = 0.0f;
     
-    // Backprop to hidden layer (compute before updating weightsHO)
-    std::vector<float> dHidden(hiddenSize);
-    for (int j = 0; j < hiddenSize; ++j)
+    for (int n = 0; n < numSamples; ++n)
     {
-        float reluGrad = (zHidden[j] > 0.0f) ? 1.0f : 0.0f;
-        dHidden[j] = dOutput * weightsHO[j] * reluGrad;
+        const float* input = inputs + static_cast<size_t>(n) * inputSize;
+        float* h = batchHidden.data() + static_cast<size_t>(n) * hiddenSize;
+        
+        float sum = biasO;
+        for (int j = 0; j < hiddenSize; ++j)
+            sum += relu(h[j]) * weightsHO[j];
+        
+        // Gradient clipping
+        float dOutput = (sigmoid(sum) - targets[n]) * sampleWeights[n];
+        dOutput = std::clamp(dOutput, -gradClipThreshold, gradClipThreshold);
+        
+        gradBiasO += dOutput;
+        
+        // Hidden deltas overwrite the pre-activations, which aren't needed after this
+        for (int j = 0; j < hiddenSize; ++j)
+        {
+            const bool active = h[j] > 0.0f;
+            gradHO[j] += dOutput * (active ? h[j] : 0.0f);
+            h[j] = active ? dOutput * weightsHO[j] : 0.0f;
+        }
+        
+        for (int j = 0; j < hiddenSize; ++j)
+            gradBiasH[j] += h[j];
+        
+        for (int i = 0; i < inputSize; ++i)
+        {
+            const float x = input[i];
+            float* g = gradIH.data() + i * hiddenSize;
+            
+            for (int j = 0; j < hiddenSize; ++j)
+                g[j] += x * h[j];
+        }
     }
     
-    // Update hidden to output weights with Adam
-    for (int j = 0; j < hiddenSize; ++j)
-    {
-        float grad = dOutput * aHidden[j];
-        mHO[j] = beta1 * mHO[j] + (1.0f - beta1) * grad;
-        vHO[j] = beta2 * vHO[j] + (1.0f - beta2) * grad * grad;
-        float mHat = mHO[j] / bc1;
-        float vHat = vHO[j] / bc2;
-        weightsHO[j] -= learningRate * (mHat / (std::sqrt(vHat) + epsilon) + weightDecay * weightsHO[j]);
-    }
+    // One Adam step on the mean gradient
+    ++timestep;
+    const float bc1 = 1.0f - std::pow(beta1, timestep);
+    const float bc2 = 1.0f - std::pow(beta2, timestep);
+    const float scale = 1.0f / static_cast<float>(numSamples);
     
-    // Update output bias with Adam
-    mBiasO = beta1 * mBiasO + (1.0f - beta1) * dOutput;
-    vBiasO = beta2 * vBiasO + (1.0f - beta2) * dOutput * dOutput;
-    float mHatBiasO = mBiasO / bc1;
-    float vHatBiasO = vBiasO / bc2;
-    biasO -= learningRate * mHatBiasO / (std::sqrt(vHatBiasO) + epsilon);
+    auto adamStep = [&](float& weight, float& m, float& v, float grad, float decay)
+    {
+        grad *= scale;
+        m = beta1 * m + (1.0f - beta1) * grad;
+        v = beta2 * v + (1.0f - beta2) * grad * grad;
+        const float mHat = m / bc1;
+        const float vHat = v / bc2;
+        weight -= learningRate * (mHat / (std::sqrt(vHat) + epsilon) + decay * weight);
+    };
+    
+    // Weights decay; biases don't
+    for (size_t idx = 0; idx < weightsIH.size(); ++idx)
+        adamStep(weightsIH[idx], mIH[idx], vIH[idx], gradIH[idx], weightDecay);
     
-    // Update input to hidden weights with Adam
     for (int j = 0; j < hiddenSize; ++j)
     {
-        for (int i = 0; i < inputSize; ++i)
-        {
-            int idx = i * hiddenSize + j;
-            float grad = dHidden[j] * input[i];
-            mIH[idx] = beta1 * mIH[idx] + (1.0f - beta1) * grad;
-            vIH[idx] = beta2 * vIH[idx] + (1.0f - beta2) * grad * grad;
-            float mHat = mIH[idx] / bc1;
-            float vHat = vIH[idx] / bc2;
-            weightsIH[idx] -= learningRate * (mHat / (std::sqrt(vHat) + epsilon) + weightDecay * weightsIH[idx]);
-        }
-        
-        // Update hidden bias with Adam
-        mBiasH[j] = beta1 * mBiasH[j] + (1.0f - beta1) * dHidden[j];
-        vBiasH[j] = beta2 * vBiasH[j] + (1.0f - beta2) * dHidden[j] * dHidden[j];
-        float mHatB = mBiasH[j] / bc1;
-        float vHatB = vBiasH[j] / bc2;
-        biasH[j] -= learningRate * mHatB / (std::sqrt(vHatB) + epsilon);
+        adamStep(weightsHO[j], mHO[j], vHO[j], gradHO[j], weightDecay);
+        adamStep(biasH[j], mBiasH[j], vBiasH[j], gradBiasH[j], 0.0f);
     }
+    
+    adamStep(biasO, mBiasO, vBiasO, gradBiasO, 0.0f);
 }
 
 int MLP::getWeightCount() const
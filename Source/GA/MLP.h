@@ -13,20 +13,28 @@
 
 #include <vector>
 #include <cmath>
-#include <random>
+#include <cstdint>
 
 class MLP
 {
 public:
-    explicit MLP(int inputSize = 17, int hiddenSize = 32);
+    // The same seed always gives the same initial weights
+    explicit MLP(int inputSize = 17, int hiddenSize = 32, uint64_t seed = 0);
     
     int getInputSize() const { return inputSize; }
     int getHiddenSize() const { return hiddenSize; }
     
     /**
      * Forward pass: predict preference score [0, 1].
+     * Writes no state, so it is safe to call concurrently.
      */
-    float predict(const std::vector<float>& input);
+    float predict(const std::vector<float>& input) const;
+    
+    /**
+     * Batched forward pass over a row-major numSamples x inputSize matrix.
+     * Safe to call concurrently. Results match predict() exactly.
+     */
+    void predictBatch(const float* inputs, int numSamples, float* outputs) const;
     
     /**
      * Train on a single sample using SGD with binary cross-entropy loss.
@@ -38,6 +46,15 @@ public:
     void train(const std::vector<float>& input, float target, 
                float learningRate = 0.05f, float sampleWeight = 1.0f);
     
+    /**
+     * One Adam step on the weighted mean gradient of a mini-batch, given as a
+     * row-major numSamples x inputSize matrix with a target and sample weight
+     * per row. Each sample's output gradient is clipped as in train(), which
+     * is the single-sample case of this.
+     */
+    void trainBatch(const float* inputs, int numSamples, const float* targets,
+                    const float* sampleWeights, float learningRate = 0.05f);
+    
     std::vector<float> getWeights() const;
     
     // Returns true if size matches, false otherwise
@@ -50,7 +67,7 @@ private:
     int hiddenSize;
     
     // Weights and biases
-    std::vector<float> weightsIH;  // Input to Hidden
+    std::vector<float> weightsIH;  // Input to Hidden, input-major: row i holds input i's weight to every hidden unit
     std::vector<float> biasH;
     std::vector<float> weightsHO;  // Hidden to Output
     float biasO;
@@ -69,13 +86,15 @@ private:
     static constexpr float weightDecay = 1e-4f;
     static constexpr float gradClipThreshold = 1.0f;
     
-    // Cached values for backprop
-    std::vector<float> zHidden;
-    std::vector<float> aHidden;
-    float zOutput;
-    float aOutput;
+    // Mini-batch scratch (reused): per-sample hidden pre-activations and summed gradients
+    std::vector<float> batchHidden;
+    std::vector<float> gradIH, gradBiasH, gradHO;
+    
+    void initializeWeights(uint64_t seed);
     
-    void initializeWeights();
+    // Hidden pre-activations for one input: biasH plus each input row of
+    // weightsIH scaled by that input, so every read is contiguous
+    void hiddenLayer(const float* input, float* hidden) const;
     
     static float relu(float x) { return x > 0.0f ? x : 0.0f; }
     static float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
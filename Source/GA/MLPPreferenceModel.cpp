@@ -7,34 +7,60 @@
 */
 
 #include "MLPPreferenceModel.h"
+#include "Trace.h"
+#include "WorkerPool.h"
 #include <algorithm>
+#include <numeric>
 #include <random>
 
+namespace
+{
+    // Streams split from the model's seed, one per consumer
+    enum ModelStream : uint64_t
+    {
+        genomeMLPStream = 1,
+        audioMLPStream,
+        genomeEnsembleStream,
+        audioEnsembleStream,
+        replayStream,
+        trainingStream
+    };
+}
+
 MLPPreferenceModel::MLPPreferenceModel(const std::vector<juce::String>& names,
                                        const juce::File& baseDirectory,
-                                       double sampleRate)
+                                       double sampleRate,
+                                       int replayCapacity,
+                                       uint64_t seed)
     : juce::Thread("MLPTraining")
+    , mlpGenome(RandomStream::deriveSeed(seed, genomeMLPStream))
+    , mlpAudio(RandomStream::deriveSeed(seed, audioMLPStream))
+    , ensembleGenome(RandomStream::deriveSeed(seed, genomeEnsembleStream))
+    , ensembleAudio(RandomStream::deriveSeed(seed, audioEnsembleStream))
+    , initialSampleRate(sampleRate)
+    , replayBuffer(replayCapacity, GenomeMLP::getInputSize(), AudioFeatureCache::AUDIO_FEATURE_COUNT,
+                   RandomStream::deriveSeed(seed, replayStream))
+    , trainingRng(seed, trainingStream)
     , parameterNames(names)
 {
     if (baseDirectory.isDirectory())
         baseDir = baseDirectory;
     else
     {
-        baseDir = juce::File::getSpecialLocation(juce::File::userHomeDirectory)
-                      .getChildFile("Library/Application Support/PresetPreferenceGenerator");
+        baseDir = getDefaultBaseDirectory();
         baseDir.createDirectory();
     }
     
+    feedbackLogFile = baseDir.getChildFile("feedback_log.bin");
     datasetFile = baseDir.getChildFile("feedback_dataset.csv");
     weightsFileGenome = baseDir.getChildFile("mlp_weights_genome.bin");
     weightsFileAudio = baseDir.getChildFile("mlp_weights_audio.bin");
+    checkpointFile = baseDir.getChildFile("mlp_checkpoint.bin");
+    checkpointWriter = std::make_unique<CheckpointWriter>(checkpointFile);
     
-    audioFeatureCache = std::make_unique<AudioFeatureCache>(sampleRate);
+    initFeedbackLog();
     
-    loadWeights();
-    initCSV();
-    
-    // Start training thread
+    // Start training thread; it loads the weights before training
     startThread(juce::Thread::Priority::low);
 }
 
@@ -45,45 +71,300 @@ MLPPreferenceModel::~MLPPreferenceModel()
     queueEvent.signal();
     stopThread(2000);
     
-    // Final save
-    saveWeights();
+    // Final save; the writer finishes it before it is destroyed. Never before
+    // the weights were loaded, as that would overwrite them with fresh ones
+    if (isReady())
+        saveWeights();
+    checkpointWriter.reset();
+    
+    // Writes the rest of the log. The CSV is only written by exportDataset(),
+    // as converting the whole history here would make closing take as long
+    feedbackLog.reset();
 }
 
-float MLPPreferenceModel::evaluate(const std::vector<float>& genome)
+juce::File MLPPreferenceModel::getDefaultBaseDirectory()
 {
-    std::lock_guard<std::mutex> lock(mlpMutex);
+    return juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+               .getChildFile("Library/Application Support/PresetPreferenceGenerator");
+}
+
+float MLPPreferenceModel::evaluate(const std::vector<float>& genome, InputMode mode)
+{
+    if (!isReady())
+        return 0.5f;
     
-    float genomePred = mlpGenome.predict(genome);
-    lastGenomePrediction.store(genomePred);
+    // Only the active input's MLP; genome mode never renders
+    if (mode == InputMode::Genome)
+    {
+        auto genomeNet = std::atomic_load(&genomeSnapshot);
+        
+        float genomePred;
+        genomeNet->predictBatch(genome.data(), 1, &genomePred);
+        lastGenomePrediction.store(genomePred);
+        return genomePred;
+    }
     
+    auto audioNet = std::atomic_load(&audioSnapshot);
     auto features = audioFeatureCache->getFeatures(genome);
-    float audioPred = mlpAudio.predict(features);
+    
+    float audioPred;
+    audioNet->predictBatch(features.data(), 1, &audioPred);
     lastAudioPrediction.store(audioPred);
+    return audioPred;
+}
+
+void MLPPreferenceModel::evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut,
+                                       InputMode mode)
+{
+    if (numGenomes <= 0)
+        return;
+    
+    if (!isReady())
+    {
+        std::fill(fitnessOut, fitnessOut + numGenomes, 0.5f);
+        return;
+    }
     
-    return (inputMode == InputMode::Audio) ? audioPred : genomePred;
+    // One snapshot per batch so every genome is scored by the same weights.
+    // Only the active input's MLP runs, so genome mode never renders
+    if (mode == InputMode::Genome)
+    {
+        auto genomeNet = std::atomic_load(&genomeSnapshot);
+        jassert(genomeSize == genomeNet->getInputSize());
+        
+        {
+            PPG_TRACE_ZONE("MLP inference");
+            genomeNet->predictBatch(genomes, numGenomes, fitnessOut);
+        }
+        
+        lastGenomePrediction.store(fitnessOut[numGenomes - 1]);
+        return;
+    }
+    
+    auto audioNet = std::atomic_load(&audioSnapshot);
+    
+    // Cache misses render together in lockstep sweeps
+    constexpr int featureCount = AudioFeatureCache::AUDIO_FEATURE_COUNT;
+    std::vector<float> features(static_cast<size_t>(numGenomes) * featureCount);
+    audioFeatureCache->getFeaturesBatch(genomes, numGenomes, genomeSize, features.data());
+    
+    {
+        PPG_TRACE_ZONE("MLP inference");
+        audioNet->predictBatch(features.data(), numGenomes, fitnessOut);
+    }
+    
+    lastAudioPrediction.store(fitnessOut[numGenomes - 1]);
+}
+
+bool MLPPreferenceModel::surrogateBatch(const float* genomes, int numGenomes, int genomeSize, float* scoresOut)
+{
+    // Until the model is ready every genome scores 0.5 without a render anyway
+    if (!isReady())
+        return false;
+    
+    if (numGenomes <= 0)
+        return true;
+    
+    // In audio mode it learns from the same feedback as the audio MLP, so it
+    // ranks alike without rendering; in genome mode it is the score itself
+    auto genomeNet = std::atomic_load(&genomeSnapshot);
+    jassert(genomeSize == genomeNet->getInputSize());
+    genomeNet->predictBatch(genomes, numGenomes, scoresOut);
+    return true;
+}
+
+bool MLPPreferenceModel::estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut,
+                                       InputMode mode)
+{
+    if (numGenomes <= 0)
+        return true;
+    
+    if (!isReady())
+    {
+        std::fill(estimatesOut, estimatesOut + numGenomes, 0.5f);
+        return true;
+    }
+    
+    if (mode == InputMode::Genome)
+    {
+        // The genome MLP is the whole score; only the audio preview costs a render
+        auto genomeNet = std::atomic_load(&genomeSnapshot);
+        jassert(genomeSize == genomeNet->getInputSize());
+        genomeNet->predictBatch(genomes, numGenomes, estimatesOut);
+        return true;
+    }
+    
+    constexpr int featureCount = AudioFeatureCache::AUDIO_FEATURE_COUNT;
+    std::vector<float> features(static_cast<size_t>(numGenomes) * featureCount);
+    if (!audioFeatureCache->computePrefixFeaturesBatch(genomes, numGenomes, genomeSize, features.data()))
+        return false;
+    
+    auto audioNet = std::atomic_load(&audioSnapshot);
+    audioNet->predictBatch(features.data(), numGenomes, estimatesOut);
+    return true;
 }
 
-void MLPPreferenceModel::sendFeedback(const std::vector<float>& genome, const Feedback& feedback)
+bool MLPPreferenceModel::evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                                             float* meanOut, float* varianceOut, InputMode mode)
+{
+    if (numGenomes <= 0)
+        return true;
+    
+    // No estimate yet; callers fall back to plain fitness
+    if (!isReady())
+        return false;
+    
+    if (mode == InputMode::Genome)
+    {
+        auto ensemble = std::atomic_load(&genomeEnsembleSnapshot);
+        jassert(genomeSize == ensemble->getInputSize());
+        ensemble->predictBatch(genomes, numGenomes, meanOut, varianceOut);
+        return true;
+    }
+    
+    // Usually cache hits: uncertainty is asked of genomes just evaluated
+    constexpr int featureCount = AudioFeatureCache::AUDIO_FEATURE_COUNT;
+    std::vector<float> features(static_cast<size_t>(numGenomes) * featureCount);
+    audioFeatureCache->getFeaturesBatch(genomes, numGenomes, genomeSize, features.data());
+    
+    auto ensemble = std::atomic_load(&audioEnsembleSnapshot);
+    ensemble->predictBatch(features.data(), numGenomes, meanOut, varianceOut);
+    return true;
+}
+
+void MLPPreferenceModel::publishSnapshots()
+{
+    std::atomic_store(&genomeSnapshot, std::shared_ptr<const QuantizedGenomeMLP>(std::make_shared<QuantizedGenomeMLP>(mlpGenome)));
+    std::atomic_store(&audioSnapshot, std::shared_ptr<const QuantizedAudioMLP>(std::make_shared<QuantizedAudioMLP>(mlpAudio)));
+    std::atomic_store(&genomeEnsembleSnapshot, std::shared_ptr<const GenomeEnsemble>(std::make_shared<GenomeEnsemble>(ensembleGenome)));
+    std::atomic_store(&audioEnsembleSnapshot, std::shared_ptr<const AudioEnsemble>(std::make_shared<AudioEnsemble>(ensembleAudio)));
+    ++modelVersion;
+}
+
+void MLPPreferenceModel::sendFeedback(const std::vector<float>& genome, const Feedback& feedback,
+                                      InputMode mode, const juce::String& flags)
 {
     size_t index = ++sampleCount;
     
     {
         std::lock_guard<std::mutex> lock(queueMutex);
-        feedbackQueue.push_back({genome, feedback, index});
+        feedbackQueue.push_back({genome, feedback, index, mode, flags});
     }
     queueEvent.signal();
 }
 
+void MLPPreferenceModel::setConfigFlags(const juce::String& flags)
+{
+    std::lock_guard<std::mutex> lock(configFlagsMutex);
+    configFlags = flags;
+}
+
+juce::String MLPPreferenceModel::getConfigFlags() const
+{
+    std::lock_guard<std::mutex> lock(configFlagsMutex);
+    return configFlags;
+}
+
+bool MLPPreferenceModel::waitUntilTrained(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(trainedMutex);
+    const size_t target = sampleCount.load();
+    return trainedChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, target] { return trainedCount >= target; });
+}
+
+void MLPPreferenceModel::prepareForConcurrency(int numThreads)
+{
+    configureCache([numThreads](AudioFeatureCache& cache) { cache.reserveContexts(numThreads); });
+}
+
+void MLPPreferenceModel::prefetch(const float* genomes, int numGenomes, int genomeSize)
+{
+    // Only a hint, so dropped until the cache exists
+    if (isReady())
+        audioFeatureCache->prefetch(genomes, numGenomes, genomeSize);
+}
+
 void MLPPreferenceModel::setSampleRate(double newSampleRate)
 {
-    std::lock_guard<std::mutex> lock(mlpMutex);
-    audioFeatureCache->setSampleRate(newSampleRate);
+    // Never waits on a context rebuild; renders use the old rate until it's done
+    configureCache([newSampleRate](AudioFeatureCache& cache) { cache.requestSampleRate(newSampleRate); });
+}
+
+void MLPPreferenceModel::requestRetrain()
+{
+    retrainProgress.store(0.0f);
+    retraining.store(true);
+    retrainRequested.fetch_or(retrainAll);
+    queueEvent.signal();
+}
+
+void MLPPreferenceModel::setFeatureKeyTolerance(float tolerance)
+{
+    configureCache([tolerance](AudioFeatureCache& cache) { cache.setKeyTolerance(tolerance); });
+}
+
+void MLPPreferenceModel::setFeatureCacheBudget(size_t bytes)
+{
+    configureCache([bytes](AudioFeatureCache& cache) { cache.setMemoryBudget(bytes); });
+}
+
+void MLPPreferenceModel::configureCache(std::function<void(AudioFeatureCache&)> setup)
+{
+    std::lock_guard<std::mutex> lock(cacheSetupMutex);
+    
+    if (isReady())
+        setup(*audioFeatureCache);
+    else
+        pendingCacheSetup.push_back(std::move(setup));
+}
+
+void MLPPreferenceModel::initialise()
+{
+    // Fixed-rate profile: audio features don't depend on the host sample rate
+    audioFeatureCache = std::make_unique<AudioFeatureCache>(initialSampleRate, getAudioRenderProfile());
+    audioFeatureCache->setPersistentDirectory(baseDir);  // Rated genomes keep their features across sessions
+    
+    // Lost or incompatible weights are rebuilt from the log once ready; the
+    // models that did load keep theirs
+    const int unloaded = loadWeights();
+    retraining.store(unloaded != 0);
+    retrainRequested.store(unloaded);
+    publishSnapshots();
+    
+    // Settings made meanwhile are applied in order before anyone else sees the cache
+    std::lock_guard<std::mutex> lock(cacheSetupMutex);
+    for (auto& setup : pendingCacheSetup)
+        setup(*audioFeatureCache);
+    pendingCacheSetup.clear();
+    
+    ready.store(true, std::memory_order_release);
+    readyEvent.signal();
+}
+
+void MLPPreferenceModel::rebuildMetrics()
+{
+    // Metrics over earlier sessions' ratings, as they were predicted at the time
+    FeedbackLog::readRecords(feedbackLogFile, GenomeMLP::getInputSize(), [this](const FeedbackLog::Record& record, const float*)
+    {
+        onlineMetrics.add(record.rating, record.genomePrediction, record.audioPrediction, record.sampleIndex);
+    });
+    restoringMetrics.store(false);
 }
 
 void MLPPreferenceModel::run()
 {
+    initialise();
+    PPG_TRACE_THREAD_NAME("MLPTraining");
+    
+    // Once ready, so a long history doesn't hold up the first evaluations; still
+    // before any new rating is counted, as only this thread adds them
+    rebuildMetrics();
+    
     while (!threadShouldExit())
     {
+        if (const int scope = retrainRequested.exchange(0))
+            retrainFromHistory(scope);
+        
         queueEvent.wait(100);
         
         QueuedFeedback item;
@@ -96,220 +377,397 @@ void MLPPreferenceModel::run()
                 item = std::move(feedbackQueue.front());
                 feedbackQueue.pop_front();
                 hasItem = true;
+                
+                // Signals sent while the queue filled wake the wait only once
+                if (!feedbackQueue.empty())
+                    queueEvent.signal();
             }
         }
         
         if (hasItem)
         {
+            const auto start = juce::Time::getHighResolutionTicks();
             processQueuedFeedback(item);
+            
+            {
+                std::lock_guard<std::mutex> lock(trainedMutex);
+                trainedCount = item.sampleIndex;
+            }
+            trainedChanged.notify_all();
+            
+            throttle(start, 1);
         }
+        
+        threadCpuMeter.sample();
     }
 }
 
+void MLPPreferenceModel::throttle(juce::int64 startTicks, int numThreads)
+{
+    const double busy = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    CpuBudget::pause(*this, cpuBudget.getPauseSeconds(busy, numThreads));
+}
+
 void MLPPreferenceModel::processQueuedFeedback(const QueuedFeedback& item)
 {
+    PPG_TRACE_ZONE("MLP feedback");
+    
     const auto& genome = item.genome;
     const auto& feedback = item.feedback;
     
-    float genomePrediction, audioPrediction;
-    std::vector<float> features;
+    // Get predictions before training; rated genomes keep their features across sessions
+    float genomePrediction = mlpGenome.predict(genome);
+    std::vector<float> features = audioFeatureCache->getFeatures(genome, true);
+    float audioPrediction = mlpAudio.predict(features);
     
-    {
-        std::lock_guard<std::mutex> lock(mlpMutex);
-        
-        // Get predictions before training
-        genomePrediction = mlpGenome.predict(genome);
-        features = audioFeatureCache->getFeatures(genome);
-        audioPrediction = mlpAudio.predict(features);
-        
-        // Train both MLPs
-        mlpGenome.train(genome, feedback.rating, learningRate, feedback.sampleWeight);
-        mlpAudio.train(features, feedback.rating, learningRate, feedback.sampleWeight);
-    }
+    // Train both MLPs
+    mlpGenome.train(genome, feedback.rating, learningRate, feedback.sampleWeight);
+    mlpAudio.train(features, feedback.rating, learningRate, feedback.sampleWeight);
+    ensembleGenome.trainBatch(genome.data(), 1, &feedback.rating, &feedback.sampleWeight, learningRate);
+    ensembleAudio.trainBatch(features.data(), 1, &feedback.rating, &feedback.sampleWeight, learningRate);
     
-    // Add to replay buffer (only accessed by this thread)
-    if (replayBuffer.size() < maxBufferSize)
-        replayBuffer.push_back({genome, feedback});
-    else
-    {
-        replayBuffer[bufferIndex] = {genome, feedback};
-        bufferIndex = (bufferIndex + 1) % maxBufferSize;
-    }
+    // Add to replay buffer with its features, so replay never waits on a render
+    if (static_cast<int>(genome.size()) == GenomeMLP::getInputSize())
+        replayBuffer.add(genome.data(), features.data(), feedback.rating, feedback.sampleWeight);
     
-    // Replay training
-    {
-        std::lock_guard<std::mutex> lock(mlpMutex);
-        replayTrain();
-    }
+    replayTrain(item.mode);
+    
+    // Make the updated weights visible to evaluators
+    publishSnapshots();
     
-    // Append to CSV
-    appendToCSV(genome, feedback, genomePrediction, audioPrediction, item.sampleIndex);
+    // Buffered; written off this thread
+    logFeedback(item, genomePrediction, audioPrediction);
     
-    // Debounced weight saving
+    // Debounced weight saving, and the stored features with them
     if (item.sampleIndex - lastSaveCount >= saveDebounceCount)
     {
-        std::lock_guard<std::mutex> lock(mlpMutex);
         saveWeights();
+        audioFeatureCache->flushStore();
         lastSaveCount = item.sampleIndex;
     }
 }
 
-void MLPPreferenceModel::loadWeights()
+int MLPPreferenceModel::loadWeights()
 {
-    if (weightsFileGenome.existsAsFile())
+    ModelCheckpoint::Sections sections;
+    if (ModelCheckpoint::read(checkpointFile, sections))
     {
-        juce::FileInputStream stream(weightsFileGenome);
-        if (stream.openedOk())
+        auto restore = [&sections](uint32_t id, auto& model)
         {
-            uint32_t count = 0;
-            stream.read(&count, sizeof(count));
-            
-            if (static_cast<int>(count) == mlpGenome.getWeightCount())
-            {
-                std::vector<float> weights(count);
-                stream.read(weights.data(), count * sizeof(float));
-                if (mlpGenome.setWeights(weights))
-                    DBG("Loaded genome MLP weights");
-            }
-        }
+            const auto* weights = ModelCheckpoint::find(sections, id);
+            return weights != nullptr && model.setWeights(*weights);
+        };
+        
+        // Audio models trained on other features would score miscalibrated;
+        // they keep their initial weights and are retrained
+        const auto* audioTag = ModelCheckpoint::find(sections, audioFeatureTagSection);
+        const bool audioCurrent = audioTag != nullptr && *audioTag == getAudioFeatureTag();
+        if (!audioCurrent)
+            DBG("Audio MLP weights were trained on other audio features; retraining them");
+        
+        const bool genome = restore(genomeMLPSection, mlpGenome) && restore(genomeEnsembleSection, ensembleGenome);
+        const bool audio = audioCurrent && restore(audioMLPSection, mlpAudio) && restore(audioEnsembleSection, ensembleAudio);
+        if (genome && audio)
+            DBG("Loaded MLP checkpoint");
+        
+        return (genome ? 0 : retrainGenome) | (audio ? 0 : retrainAudio);
     }
     
-    if (weightsFileAudio.existsAsFile())
-    {
-        juce::FileInputStream stream(weightsFileAudio);
-        if (stream.openedOk())
-        {
-            uint32_t count = 0;
-            stream.read(&count, sizeof(count));
-            
-            if (static_cast<int>(count) == mlpAudio.getWeightCount())
-            {
-                std::vector<float> weights(count);
-                stream.read(weights.data(), count * sizeof(float));
-                if (mlpAudio.setWeights(weights))
-                    DBG("Loaded audio MLP weights");
-            }
-        }
-    }
+    // Weights saved before checkpoints existed; the next save moves them over.
+    // They never held the ensembles, so those are retrained.
+    std::vector<float> weights;
+    
+    if (readWeightsFile(weightsFileGenome, mlpGenome.getWeightCount(), weights) && mlpGenome.setWeights(weights))
+        DBG("Loaded genome MLP weights");
+    
+    if (readWeightsFile(weightsFileAudio, mlpAudio.getWeightCount(), weights, getAudioFeatureTag()) && mlpAudio.setWeights(weights))
+        DBG("Loaded audio MLP weights");
+    
+    return retrainAll;
 }
 
 void MLPPreferenceModel::saveWeights()
 {
-    {
-        juce::FileOutputStream stream(weightsFileGenome);
-        if (stream.openedOk())
-        {
-            stream.setPosition(0);
-            stream.truncate();
-            
-            auto weights = mlpGenome.getWeights();
-            uint32_t count = static_cast<uint32_t>(weights.size());
-            
-            stream.write(&count, sizeof(count));
-            stream.write(weights.data(), count * sizeof(float));
-            stream.flush();
-        }
-    }
+    checkpointWriter->submit({
+        { genomeMLPSection, mlpGenome.getWeights() },
+        { audioMLPSection, mlpAudio.getWeights() },
+        { genomeEnsembleSection, ensembleGenome.getWeights() },
+        { audioEnsembleSection, ensembleAudio.getWeights() },
+        { audioFeatureTagSection, getAudioFeatureTag() }
+    });
+}
+
+std::vector<float> MLPPreferenceModel::getAudioFeatureTag()
+{
+    const auto profile = getAudioRenderProfile();
+    return {
+        static_cast<float>(AudioFeatureCache::RENDER_VERSION),
+        static_cast<float>(AudioFeatureCache::AUDIO_FEATURE_COUNT),
+        static_cast<float>(profile.sampleRate),
+        static_cast<float>(profile.durationMs),
+        static_cast<float>(profile.fftSize),
+        static_cast<float>(profile.hopSize)
+    };
+}
+
+bool MLPPreferenceModel::readWeightsFile(const juce::File& file, int expectedCount, std::vector<float>& weights,
+                                         const std::vector<float>& tag)
+{
+    if (!file.existsAsFile())
+        return false;
     
+    juce::FileInputStream stream(file);
+    if (!stream.openedOk())
+        return false;
+    
+    if (!tag.empty())
     {
-        juce::FileOutputStream stream(weightsFileAudio);
-        if (stream.openedOk())
-        {
-            stream.setPosition(0);
-            stream.truncate();
-            
-            auto weights = mlpAudio.getWeights();
-            uint32_t count = static_cast<uint32_t>(weights.size());
-            
-            stream.write(&count, sizeof(count));
-            stream.write(weights.data(), count * sizeof(float));
-            stream.flush();
-        }
+        uint32_t tagCount = 0;
+        stream.read(&tagCount, sizeof(tagCount));
+        
+        if (tagCount != tag.size())
+            return false;
+        
+        std::vector<float> savedTag(tagCount);
+        stream.read(savedTag.data(), static_cast<int>(tagCount * sizeof(float)));
+        
+        if (savedTag != tag)
+            return false;
     }
+    
+    uint32_t count = 0;
+    stream.read(&count, sizeof(count));
+    
+    if (static_cast<int>(count) != expectedCount)
+        return false;
+    
+    weights.resize(count);
+    return stream.read(weights.data(), static_cast<int>(count * sizeof(float))) == static_cast<int>(count * sizeof(float));
 }
 
-void MLPPreferenceModel::initCSV()
+void MLPPreferenceModel::initFeedbackLog()
 {
-    const juce::ScopedLock lock(fileLock);
+    const bool legacyDataset = !feedbackLogFile.exists() && datasetFile.existsAsFile();
     
-    if (datasetFile.existsAsFile())
+    feedbackLog = std::make_unique<FeedbackLog>(feedbackLogFile, parameterNames);
+    
+    // A CSV without a log predates the log. Its samples start the log, so they
+    // are trained on and counted, and it is kept as a backup, as exporting
+    // would overwrite it; once the log exists it is never imported again
+    if (legacyDataset)
     {
-        juce::StringArray lines;
-        datasetFile.readLines(lines);
-        
-        if (lines.size() > 0 && lines[0].trim() == getHeaderString().trim())
-            return;
+        const int imported = feedbackLog->importCSV(datasetFile);
+        feedbackLog->flush();
         
         juce::String timestamp = juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S");
         juce::File backupFile = datasetFile.getSiblingFile("feedback_dataset_backup_" + timestamp + ".csv");
         datasetFile.moveFileTo(backupFile);
-        DBG("Schema changed. Rotated old dataset to " << backupFile.getFileName());
+        DBG("Started feedback log with " << juce::jmax(imported, 0) << " samples. Rotated old dataset to "
+            << backupFile.getFileName());
     }
+}
+
+void MLPPreferenceModel::logFeedback(const QueuedFeedback& item, float genomePrediction, float audioPrediction)
+{
+    const auto& genome = item.genome;
+    const auto& feedback = item.feedback;
+    const auto sampleIndex = item.sampleIndex;
+    
+    if (static_cast<int>(genome.size()) != static_cast<int>(parameterNames.size()))
+        return;
+    
+    FeedbackLog::Record record;
+    record.timestampMs = juce::Time::getCurrentTime().toMilliseconds();
+    record.sampleIndex = sampleIndex;
+    record.rating = feedback.rating;
+    record.playTimeSeconds = feedback.playTimeSeconds;
+    record.genomePrediction = genomePrediction;
+    record.audioPrediction = audioPrediction;
+    record.sampleWeight = feedback.sampleWeight;
+    record.setConfigFlags(item.configFlags);
     
-    datasetFile.create();
-    datasetFile.appendText(getHeaderString() + "\n");
+    feedbackLog->append(genome.data(), record);
+    
+    // Counts exactly what the log holds, so it agrees with the exported CSV
+    onlineMetrics.add(record.rating, genomePrediction, audioPrediction, sampleIndex);
+}
+
+bool MLPPreferenceModel::exportDataset(const juce::File& csvFile)
+{
+    feedbackLog->flush();
+    return FeedbackLog::exportCSV(feedbackLogFile, csvFile);
 }
 
-juce::String MLPPreferenceModel::getHeaderString() const
+bool MLPPreferenceModel::exportDataset()
 {
-    juce::String header;
-    for (const auto& name : parameterNames)
-        header += name + ",";
-    header += "rating,playTimeSeconds,sampleIndex,mlpGenomePrediction,mlpAudioPrediction,configFlags,timestamp,sampleWeight";
-    return header;
+    return exportDataset(datasetFile);
 }
 
-void MLPPreferenceModel::appendToCSV(const std::vector<float>& genome, const Feedback& feedback,
-                                      float genomePrediction, float audioPrediction, size_t sampleIndex)
+void MLPPreferenceModel::replayTrain(InputMode mode)
 {
-    const juce::ScopedLock lock(fileLock);
+    PPG_TRACE_ZONE("MLP replay");
+    
+    if (replayBuffer.size() == 0)
+        return;
+    
+    const int numSamples = std::min(replayBuffer.size(), replayBatchSize);
+    replayBuffer.sample(numSamples, replayIndices.data(), replayImportance.data());
     
-    juce::String line;
-    for (float param : genome)
-        line += juce::String(param, 6) + ",";
+    // Gather the batch as matrices so each MLP takes a single optimizer step;
+    // importance weights undo the bias of prioritized sampling
+    constexpr int genomeSize = GenomeMLP::getInputSize();
+    constexpr int featureCount = AudioFeatureCache::AUDIO_FEATURE_COUNT;
     
-    line += juce::String(feedback.rating, 1) + ",";
-    line += juce::String(feedback.playTimeSeconds, 2) + ",";
-    line += juce::String(static_cast<int>(sampleIndex)) + ",";
-    line += juce::String(genomePrediction, 6) + ",";
-    line += juce::String(audioPrediction, 6) + ",";
-    line += configFlags + ",";
-    line += juce::Time::getCurrentTime().toISO8601(true) + ",";
-    line += juce::String(feedback.sampleWeight, 2);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int index = replayIndices[static_cast<size_t>(i)];
+        
+        std::copy(replayBuffer.genome(index), replayBuffer.genome(index) + genomeSize,
+                  replayGenomes.begin() + i * genomeSize);
+        std::copy(replayBuffer.features(index), replayBuffer.features(index) + featureCount,
+                  replayFeatures.begin() + i * featureCount);
+        replayTargets[static_cast<size_t>(i)] = replayBuffer.rating(index);
+        replayWeights[static_cast<size_t>(i)] = replayBuffer.sampleWeight(index) * replayImportance[static_cast<size_t>(i)];
+    }
+    
+    // Priorities follow the error of the model steering the rating's GA, before this step
+    if (mode == InputMode::Audio)
+        mlpAudio.predictBatch(replayFeatures.data(), numSamples, replayPredictions.data());
+    else
+        mlpGenome.predictBatch(replayGenomes.data(), numSamples, replayPredictions.data());
+    
+    mlpGenome.trainBatch(replayGenomes.data(), numSamples, replayTargets.data(), replayWeights.data(), learningRate);
+    ensembleGenome.trainBatch(replayGenomes.data(), numSamples, replayTargets.data(), replayWeights.data(), learningRate);
+    mlpAudio.trainBatch(replayFeatures.data(), numSamples, replayTargets.data(), replayWeights.data(), learningRate);
+    ensembleAudio.trainBatch(replayFeatures.data(), numSamples, replayTargets.data(), replayWeights.data(), learningRate);
     
-    datasetFile.appendText(line + "\n");
+    for (int i = 0; i < numSamples; ++i)
+        replayBuffer.updatePriority(replayIndices[static_cast<size_t>(i)],
+                                    replayTargets[static_cast<size_t>(i)] - replayPredictions[static_cast<size_t>(i)]);
 }
 
-void MLPPreferenceModel::replayTrain()
+void MLPPreferenceModel::retrainFromHistory(int scope)
 {
-    if (replayBuffer.empty())
-        return;
+    PPG_TRACE_ZONE("MLP retrain");
     
-    int numSamples = std::min(static_cast<int>(replayBuffer.size()), replayBatchSize);
+    constexpr int genomeSize = GenomeMLP::getInputSize();
+    constexpr int featureCount = AudioFeatureCache::AUDIO_FEATURE_COUNT;
     
-    std::vector<size_t> indices(replayBuffer.size());
-    for (size_t i = 0; i < indices.size(); ++i)
-        indices[i] = i;
+    // Stream the whole log into matrices; history only grows, so this isn't the hot path
+    std::vector<float> genomes;
+    std::vector<float> targets;
+    std::vector<float> sampleWeights;
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(indices.begin(), indices.end(), gen);
+    feedbackLog->flush();
+    FeedbackLog::readRecords(feedbackLogFile, genomeSize, [&](const FeedbackLog::Record& record, const float* genome)
+    {
+        genomes.insert(genomes.end(), genome, genome + genomeSize);
+        targets.push_back(record.rating);
+        sampleWeights.push_back(record.sampleWeight);
+    });
+    
+    const int numSamples = static_cast<int>(targets.size());
+    if (numSamples == 0)
+    {
+        retraining.store(false);
+        return;
+    }
+    
+    DBG("Retraining from " << numSamples << " rated samples");
+    
+    // Features first, in parallel (replay needs them whatever the scope): rated
+    // genomes are usually in the persistent store, and the rest render on one
+    // context per pool slot
+    constexpr float featureShare = 0.5f;  // Of the progress bar
+    std::vector<float> features(static_cast<size_t>(numSamples) * featureCount);
     
-    for (int i = 0; i < numSamples; ++i)
     {
-        const auto& sample = replayBuffer[indices[i]];
-        const auto& genome = sample.first;
-        float rating = sample.second.rating;
-        float weight = sample.second.sampleWeight;
+        WorkerPool pool(cpuBudget.capThreads(juce::SystemStats::getNumCpus()), juce::Thread::Priority::low);
+        audioFeatureCache->reserveContexts(pool.getNumSlots());
+        
+        const int numChunks = (numSamples + retrainChunkSize - 1) / retrainChunkSize;
+        std::atomic<int> chunksDone{0};
         
-        mlpGenome.train(genome, rating, learningRate, weight);
+        // A round of one chunk per slot at a time, so the budget can pause between rounds
+        for (int first = 0; first < numChunks && !threadShouldExit(); first += pool.getNumSlots())
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            
+            pool.parallelFor(std::min(pool.getNumSlots(), numChunks - first), [&](int task, int)
+            {
+                if (threadShouldExit())
+                    return;
+                
+                const int begin = (first + task) * retrainChunkSize;
+                const int count = std::min(retrainChunkSize, numSamples - begin);
+                audioFeatureCache->getFeaturesBatch(genomes.data() + static_cast<size_t>(begin) * genomeSize, count, genomeSize,
+                                                    features.data() + static_cast<size_t>(begin) * featureCount, true);
+                
+                retrainProgress.store(featureShare * static_cast<float>(++chunksDone) / static_cast<float>(numChunks));
+            });
+            
+            throttle(start, pool.getNumSlots());
+        }
+    }
+    
+    audioFeatureCache->flushStore();
+    
+    // Epochs of shuffled mini-batches, one Adam step per batch for every model in scope
+    std::vector<int> order(static_cast<size_t>(numSamples));
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<float> batchGenomes(static_cast<size_t>(retrainBatchSize) * genomeSize);
+    std::vector<float> batchFeatures(static_cast<size_t>(retrainBatchSize) * featureCount);
+    std::vector<float> batchTargets(retrainBatchSize);
+    std::vector<float> batchWeights(retrainBatchSize);
+    
+    for (int epoch = 0; epoch < retrainEpochs; ++epoch)
+    {
+        std::shuffle(order.begin(), order.end(), trainingRng);
         
-        // Only train audio MLP if features are cached (avoid blocking)
-        if (audioFeatureCache->hasCached(genome))
+        for (int start = 0; start < numSamples; start += retrainBatchSize)
         {
-            auto features = audioFeatureCache->getFeatures(genome);
-            mlpAudio.train(features, rating, learningRate, weight);
+            if (threadShouldExit())
+                return;
+            
+            threadCpuMeter.sample();
+            const auto batchStart = juce::Time::getHighResolutionTicks();
+            const int count = std::min(retrainBatchSize, numSamples - start);
+            
+            for (int i = 0; i < count; ++i)
+            {
+                const auto index = static_cast<size_t>(order[static_cast<size_t>(start + i)]);
+                std::copy_n(genomes.begin() + static_cast<std::ptrdiff_t>(index * genomeSize), genomeSize,
+                            batchGenomes.begin() + i * genomeSize);
+                std::copy_n(features.begin() + static_cast<std::ptrdiff_t>(index * featureCount), featureCount,
+                            batchFeatures.begin() + i * featureCount);
+                batchTargets[static_cast<size_t>(i)] = targets[index];
+                batchWeights[static_cast<size_t>(i)] = sampleWeights[index];
+            }
+            
+            if ((scope & retrainGenome) != 0)
+            {
+                mlpGenome.trainBatch(batchGenomes.data(), count, batchTargets.data(), batchWeights.data(), learningRate);
+                ensembleGenome.trainBatch(batchGenomes.data(), count, batchTargets.data(), batchWeights.data(), learningRate);
+            }
+            if ((scope & retrainAudio) != 0)
+            {
+                mlpAudio.trainBatch(batchFeatures.data(), count, batchTargets.data(), batchWeights.data(), learningRate);
+                ensembleAudio.trainBatch(batchFeatures.data(), count, batchTargets.data(), batchWeights.data(), learningRate);
+            }
+            throttle(batchStart, 1);
         }
+        
+        // The GA sees the models improve epoch by epoch
+        publishSnapshots();
+        retrainProgress.store(featureShare + (1.0f - featureShare) * static_cast<float>(epoch + 1) / retrainEpochs);
     }
+    
+    // Replay carries on from the newest ratings
+    replayBuffer.clear();
+    for (int i = std::max(0, numSamples - replayBuffer.capacity()); i < numSamples; ++i)
+        replayBuffer.add(genomes.data() + static_cast<size_t>(i) * genomeSize, features.data() + static_cast<size_t>(i) * featureCount,
+                         targets[static_cast<size_t>(i)], sampleWeights[static_cast<size_t>(i)]);
+    
+    saveWeights();
+    retraining.store(false);
 }
-
@@ -7,44 +7,189 @@
     IFitnessModel implementation using dual MLPs for preference learning.
     Supports both genome-based and audio feature-based prediction.
     Training runs on a background thread for instant UI response.
+    The training thread owns private MLPs and publishes immutable snapshots;
+    evaluators read the latest snapshot without taking any lock. Snapshots
+    are int8-quantized (QuantizedMLP), as they are only ever used to score.
+    A bootstrapped ensemble per input trains alongside each MLP and supplies
+    uncertainty estimates. Construction does no file I/O beyond a header
+    check: weights load and the audio feature cache is built on the training
+    thread, and until then every genome scores a neutral 0.5.
   ==============================================================================
 */
 
 #pragma once
 
 #include "IFitnessModel.h"
-#include "MLP.h"
+#include "FixedMLP.h"
+#include "QuantizedMLP.h"
+#include "EnsembleMLP.h"
+#include "ReplayBuffer.h"
+#include "RandomStream.h"
+#include "ModelCheckpoint.h"
+#include "CpuBudget.h"
+#include "FeedbackLog.h"
+#include "OnlineMetrics.h"
+#include "PerformanceMeter.h"
 #include "AudioFeatureCache.h"
 #include "GAConfig.h"
 #include <juce_core/juce_core.h>
+#include <array>
+#include <condition_variable>
 #include <mutex>
 #include <deque>
+#include <functional>
 #include <atomic>
+#include <memory>
 
 class MLPPreferenceModel : public IFitnessModel, private juce::Thread
 {
 public:
     using InputMode = GAConfig::MLPInputMode;
     
+    static constexpr int defaultReplayCapacity = 1024;
+    
+    // replayCapacity: rated samples kept for replay (preallocated)
+    // seed: initial weights, bootstraps, replay draws and retrain shuffles
     MLPPreferenceModel(const std::vector<juce::String>& parameterNames,
                        const juce::File& baseDirectory = juce::File(),
-                       double sampleRate = 44100.0);
+                       double sampleRate = 44100.0,
+                       int replayCapacity = defaultReplayCapacity,
+                       uint64_t seed = 0);
     ~MLPPreferenceModel() override;
+    
+    // Where weights, the feedback log and cached features live when no directory is given
+    static juce::File getDefaultBaseDirectory();
+    juce::File getBaseDirectory() const { return baseDir; }
+    
+    // True once weights are loaded and the feature cache is built
+    bool isReady() const { return ready.load(std::memory_order_acquire); }
+    bool waitUntilReady(int timeoutMs = 5000) const { return readyEvent.wait(timeoutMs); }
 
-    float evaluate(const std::vector<float>& genome) override;
+    // The IFitnessModel calls score in getInputMode(); the overloads taking a
+    // mode let callers sharing the model (SharedEngine::ModelHandle) each
+    // keep their own. Neutral 0.5 until ready
+    float evaluate(const std::vector<float>& genome) override { return evaluate(genome, getInputMode()); }
+    float evaluate(const std::vector<float>& genome, InputMode mode);
+    
+    // Scores the whole batch with one matrix pass of the input mode's MLP
+    void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut) override
+    {
+        evaluateBatch(genomes, numGenomes, genomeSize, fitnessOut, getInputMode());
+    }
+    void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut, InputMode mode);
+    
+    // The genome MLP in either mode: ranks offspring before any render
+    bool surrogateBatch(const float* genomes, int numGenomes, int genomeSize, float* scoresOut) override;
+    
+    // Genome mode scores exactly (no render); audio mode scores the first note only
+    bool estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut) override
+    {
+        return estimateBatch(genomes, numGenomes, genomeSize, estimatesOut, getInputMode());
+    }
+    bool estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut, InputMode mode);
+    
+    // Mean and variance over the input mode's ensemble heads
+    bool evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                             float* meanOut, float* varianceOut) override
+    {
+        return evaluateUncertainty(genomes, numGenomes, genomeSize, meanOut, varianceOut, getInputMode());
+    }
+    bool evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                             float* meanOut, float* varianceOut, InputMode mode);
 
-    // Non-blocking: queues feedback for background processing
-    void sendFeedback(const std::vector<float>& genome, const Feedback& feedback) override;
+    // Non-blocking: queues feedback for background processing. The rating is
+    // logged with flags, and replay prioritises by the error of mode's MLP
+    void sendFeedback(const std::vector<float>& genome, const Feedback& feedback) override
+    {
+        sendFeedback(genome, feedback, getInputMode(), getConfigFlags());
+    }
+    void sendFeedback(const std::vector<float>& genome, const Feedback& feedback,
+                      InputMode mode, const juce::String& flags);
+    
+    // Blocks until every rating sent so far has been trained on (after any
+    // retrain ahead of it), so a scripted run trains at the same points each
+    // time; false on timeout
+    bool waitUntilTrained(int timeoutMs = 5000);
+    
+    // Counts weight publications and input mode changes; 0 until ready
+    uint64_t getModelVersion() const override { return isReady() ? modelVersion.load() : 0; }
+    
+    // Pre-builds one audio render context per evaluating thread
+    void prepareForConcurrency(int numThreads) override;
+    
+    // Renders audio features on the cache's background thread
+    void prefetch(const float* genomes, int numGenomes, int genomeSize) override;
     
-    // Update sample rate (thread-safe, clears audio cache)
+    // Update sample rate without blocking (the fixed-rate features don't depend on it)
     void setSampleRate(double newSampleRate);
     
-    void setConfigFlags(const juce::String& flags) { configFlags = flags; }
-    void setInputMode(InputMode mode) { inputMode = mode; }
-    InputMode getInputMode() const { return inputMode; }
+    // Cache settings made before the model is ready are applied once it is
+    
+    // Near-duplicate audio feature lookups (AudioFeatureCache::setKeyTolerance)
+    void setFeatureKeyTolerance(float tolerance);
+    AudioFeatureCache::DriftStats getFeatureDrift() const { return isReady() ? audioFeatureCache->getDriftStats() : AudioFeatureCache::DriftStats {}; }
+    
+    // Audio feature cache memory and telemetry
+    void setFeatureCacheBudget(size_t bytes);
+    AudioFeatureCache::Stats getFeatureCacheStats() const { return isReady() ? audioFeatureCache->getStats() : AudioFeatureCache::Stats {}; }
+    
+    // Defaults for the calls that don't pass their own; any thread
+    void setConfigFlags(const juce::String& flags);
+    juce::String getConfigFlags() const;
+    
+    // Writes everything logged so far as the CSV analysis/compute_metrics.py
+    // reads; by default to feedback_dataset.csv, where the script looks
+    bool exportDataset(const juce::File& csvFile);
+    bool exportDataset();
+    void setInputMode(InputMode mode) { inputMode.store(mode); ++modelVersion; }
+    InputMode getInputMode() const { return inputMode.load(); }
     
     float getLastGenomePrediction() const { return lastGenomePrediction; }
     float getLastAudioPrediction() const { return lastAudioPrediction; }
+    
+    // compute_metrics.py's metrics over the whole feedback log, live: rebuilt
+    // from the log on the training thread once the model is ready (partial
+    // while isRestoringMetrics()), then updated as each rating is trained on
+    OnlineMetrics::Stats getOnlineMetrics() const { return onlineMetrics.getStats(); }
+    bool isRestoringMetrics() const { return restoringMetrics.load(); }
+    
+    /**
+     * Queues a bulk retrain of every model from the whole feedback log,
+     * warm-started from the current weights: audio features are computed in
+     * parallel, then the models take retrainEpochs passes of shuffled
+     * mini-batches on the training thread. It also runs by itself, for just
+     * the models the checkpoint didn't restore (the audio ones alone when
+     * the audio features changed). Feedback sent meanwhile waits until it is done.
+     */
+    void requestRetrain();
+    bool isRetraining() const { return retraining.load(); }
+    float getRetrainProgress() const { return retrainProgress.load(); }  // 0 to 1 while retraining
+    
+    // CPU time of the training thread, sampled once per loop and per retrain batch
+    const ThreadCpuMeter& getThreadCpuMeter() const { return threadCpuMeter; }
+    
+    // Average cores training and retrain feature renders may use (0 = unlimited)
+    void setCpuBudget(float cores) { cpuBudget.setCores(cores); }
+    float getCpuBudget() const { return cpuBudget.getCores(); }
+    
+    // Audio deadline load; training backs off above CpuBudget::backoffLoad
+    void setAudioLoad(float load) { cpuBudget.setAudioLoad(load); }
+    float getAudioLoad() const { return cpuBudget.getAudioLoad(); }
+    
+    // Section ids in the checkpoint file
+    enum CheckpointSection : uint32_t { genomeMLPSection = 1, audioMLPSection, genomeEnsembleSection, audioEnsembleSection,
+                                        audioFeatureTagSection };
+    
+    // Render and analysis settings behind every audio feature the audio models see
+    static AudioFeatureCache::RenderProfile getAudioRenderProfile() { return AudioFeatureCache::RenderProfile::fitness(); }
+    
+    /**
+     * What audioFeatureTagSection holds: the feature render version, feature
+     * count and audio render profile. Audio weights saved under any other
+     * tag (or none) were trained on different features, so they are
+     * discarded on load and retrained from the feedback log.
+     */
+    static std::vector<float> getAudioFeatureTag();
 
 private:
     // Training thread run loop
@@ -56,34 +201,68 @@ private:
         std::vector<float> genome;
         Feedback feedback;
         size_t sampleIndex;
+        InputMode mode = InputMode::Genome;
+        juce::String configFlags;  // Of the session that rated it
     };
     
     std::deque<QueuedFeedback> feedbackQueue;
     std::mutex queueMutex;
     juce::WaitableEvent queueEvent;
     
-    // MLPs and cache
-    MLP mlpGenome{17, 32};
-    MLP mlpAudio{24, 32};
-    mutable std::mutex mlpMutex;
+    std::mutex trainedMutex;
+    std::condition_variable trainedChanged;
+    size_t trainedCount = 0;  // Sample index of the newest rating trained on
+    
+    // Training copies - only touched by the training thread (and ctor/dtor)
+    GenomeMLP mlpGenome;
+    AudioMLP mlpAudio;
+    GenomeEnsemble ensembleGenome;
+    AudioEnsemble ensembleAudio;
+    
+    // Published read-only quantized copies for evaluators (std::atomic_load/atomic_store)
+    std::shared_ptr<const QuantizedGenomeMLP> genomeSnapshot;
+    std::shared_ptr<const QuantizedAudioMLP> audioSnapshot;
+    std::shared_ptr<const GenomeEnsemble> genomeEnsembleSnapshot;
+    std::shared_ptr<const AudioEnsemble> audioEnsembleSnapshot;
+    std::atomic<uint64_t> modelVersion { 0 };
+    void publishSnapshots();
     
+    // Built by the training thread; read only once ready is set
     std::unique_ptr<AudioFeatureCache> audioFeatureCache;
-    InputMode inputMode = InputMode::Genome;
+    const double initialSampleRate;
+    std::atomic<bool> ready{false};
+    juce::WaitableEvent readyEvent{true};
+    
+    // Cache settings waiting for the cache to exist
+    std::mutex cacheSetupMutex;
+    std::vector<std::function<void(AudioFeatureCache&)>> pendingCacheSetup;
+    void configureCache(std::function<void(AudioFeatureCache&)> setup);
+    
+    // Loads weights and builds the feature cache, then sets ready
+    void initialise();
+    void rebuildMetrics();  // From the log, on the training thread once ready
+    
+    std::atomic<InputMode> inputMode { InputMode::Genome };
     
     std::atomic<float> lastGenomePrediction{0.5f};
     std::atomic<float> lastAudioPrediction{0.5f};
     
-    // Replay buffer - only accessed by training thread
-    static constexpr size_t maxBufferSize = 64;
-    std::vector<std::pair<std::vector<float>, Feedback>> replayBuffer;
-    size_t bufferIndex = 0;
+    // Prioritized replay of rated genomes with their features - only accessed by training thread
+    ReplayBuffer replayBuffer;
+    RandomStream trainingRng;  // Retrain shuffles
     
-    // CSV logging
+    // Feedback logging: binary log, exported to the CSV dataset on demand
+    juce::File feedbackLogFile;
     juce::File datasetFile;
     const std::vector<juce::String> parameterNames;
-    juce::CriticalSection fileLock;
+    std::unique_ptr<FeedbackLog> feedbackLog;
+    OnlineMetrics onlineMetrics;
+    std::atomic<bool> restoringMetrics{true};
     
-    // Weight persistence
+    // Weight persistence: one checkpoint written off the training thread;
+    // the older per-MLP files are only read, when there is no checkpoint yet
+    juce::File checkpointFile;
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
     juce::File weightsFileGenome;
     juce::File weightsFileAudio;
     juce::File baseDir;
@@ -91,18 +270,51 @@ private:
     static constexpr float learningRate = 0.001f;
     static constexpr int replayBatchSize = 8;
     static constexpr int saveDebounceCount = 5;  // Save weights every N samples
+    static constexpr int retrainEpochs = 20;
+    static constexpr int retrainBatchSize = 32;
+    static constexpr int retrainChunkSize = 64;  // Genomes per parallel feature task
+    
+    // Replay batch gathered from the buffer (reused)
+    std::array<int, replayBatchSize> replayIndices {};
+    std::array<float, replayBatchSize> replayImportance {};
+    std::array<float, replayBatchSize * GenomeMLP::getInputSize()> replayGenomes {};
+    std::array<float, replayBatchSize * AudioFeatureCache::AUDIO_FEATURE_COUNT> replayFeatures {};
+    std::array<float, replayBatchSize> replayTargets {};
+    std::array<float, replayBatchSize> replayWeights {};
+    std::array<float, replayBatchSize> replayPredictions {};
     
     std::atomic<size_t> sampleCount{0};
+    mutable std::mutex configFlagsMutex;
     juce::String configFlags = "baseline";
     size_t lastSaveCount = 0;
     
-    void loadWeights();
+    // Models retrained together, as each MLP and its ensemble see the same inputs
+    enum RetrainScope : int { retrainGenome = 1, retrainAudio = 2, retrainAll = retrainGenome | retrainAudio };
+    
+    // The scope of the models whose weights weren't restored (0 = none)
+    int loadWeights();
+    
+    // Snapshots the weights and queues them for the checkpoint writer
     void saveWeights();
-    void initCSV();
-    void appendToCSV(const std::vector<float>& genome, const Feedback& feedback,
-                     float genomePrediction, float audioPrediction, size_t sampleIndex);
-    juce::String getHeaderString() const;
+    
+    // Legacy per-MLP file: a uint32 count, then the floats. A non-empty tag
+    // comes first (its own count, then the floats); a file saved under a
+    // different tag is skipped.
+    static bool readWeightsFile(const juce::File& file, int expectedCount, std::vector<float>& weights,
+                                const std::vector<float>& tag = {});
+    void initFeedbackLog();
+    void logFeedback(const QueuedFeedback& item, float genomePrediction, float audioPrediction);
     void processQueuedFeedback(const QueuedFeedback& item);
-    void replayTrain();
+    void replayTrain(InputMode mode);
+    
+    std::atomic<int> retrainRequested{0};  // RetrainScope
+    std::atomic<bool> retraining{false};
+    std::atomic<float> retrainProgress{0.0f};
+    ThreadCpuMeter threadCpuMeter;
+    CpuBudget cpuBudget;
+    
+    // Seconds since startTicks, then idles off whatever exceeded the budget
+    void throttle(juce::int64 startTicks, int numThreads);
+    void retrainFromHistory(int scope);
 };
 
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+    ModelCheckpoint.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "ModelCheckpoint.h"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t formatVersion = 1;
+
+    // On-disk header; numSections sections (id, count, count floats) follow it
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t formatVersion;
+        uint32_t numSections;
+        uint32_t reserved;
+        uint64_t payloadBytes;
+        uint64_t checksum;  // FNV-1a over the payload
+    };
+
+    struct SectionHeader
+    {
+        uint32_t id;
+        uint32_t count;
+    };
+
+    uint64_t checksum(const void* data, size_t bytes)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        const auto* p = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            hash ^= p[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    bool readMapped(const juce::File& file, ModelCheckpoint::Sections& sectionsOut)
+    {
+        if (!file.existsAsFile())
+            return false;
+
+        juce::MemoryMappedFile mapping(file, juce::MemoryMappedFile::readOnly);
+        const auto* data = static_cast<const char*>(mapping.getData());
+        const size_t size = mapping.getSize();
+
+        if (data == nullptr || size < sizeof(FileHeader))
+            return false;
+
+        FileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (std::memcmp(header.magic, "PPGC", 4) != 0 || header.formatVersion != formatVersion
+            || header.payloadBytes != size - sizeof(FileHeader)
+            || checksum(data + sizeof(FileHeader), static_cast<size_t>(header.payloadBytes)) != header.checksum)
+            return false;
+
+        ModelCheckpoint::Sections sections;
+        size_t offset = sizeof(FileHeader);
+
+        for (uint32_t s = 0; s < header.numSections; ++s)
+        {
+            SectionHeader section;
+            if (size - offset < sizeof(section))
+                return false;
+
+            std::memcpy(&section, data + offset, sizeof(section));
+            offset += sizeof(section);
+
+            const size_t bytes = sizeof(float) * section.count;
+            if (size - offset < bytes)
+                return false;
+
+            sections.push_back({ section.id, std::vector<float>(section.count) });
+            std::memcpy(sections.back().values.data(), data + offset, bytes);
+            offset += bytes;
+        }
+
+        sectionsOut = std::move(sections);
+        return true;
+    }
+}
+
+juce::File ModelCheckpoint::getTemporaryFile(const juce::File& file)
+{
+    return file.getSiblingFile(file.getFileName() + ".tmp");
+}
+
+bool ModelCheckpoint::write(const juce::File& file, const Sections& sections)
+{
+    std::vector<char> payload;
+    for (const auto& section : sections)
+    {
+        const SectionHeader sectionHeader { section.id, static_cast<uint32_t>(section.values.size()) };
+        const auto* values = reinterpret_cast<const char*>(section.values.data());
+        payload.insert(payload.end(), reinterpret_cast<const char*>(&sectionHeader),
+                       reinterpret_cast<const char*>(&sectionHeader) + sizeof(sectionHeader));
+        payload.insert(payload.end(), values, values + sizeof(float) * section.values.size());
+    }
+
+    FileHeader header;
+    std::memset(static_cast<void*>(&header), 0, sizeof(header));  // Padding is written too, so keep it deterministic
+    std::memcpy(header.magic, "PPGC", 4);
+    header.formatVersion = formatVersion;
+    header.numSections = static_cast<uint32_t>(sections.size());
+    header.payloadBytes = payload.size();
+    header.checksum = checksum(payload.data(), payload.size());
+
+    const juce::File temporary = getTemporaryFile(file);
+    {
+        juce::FileOutputStream stream(temporary);
+        if (!stream.openedOk())
+            return false;
+
+        stream.setPosition(0);
+        stream.truncate();
+
+        if (!stream.write(&header, sizeof(header)) || !stream.write(payload.data(), payload.size()))
+            return false;
+
+        stream.flush();
+    }
+
+    // rename() replaces the old checkpoint atomically on POSIX; where it won't
+    // replace an existing file (Windows) fall back to JUCE's delete-then-move,
+    // and read() recovers from the temporary if a crash lands in between
+    if (std::rename(temporary.getFullPathName().toRawUTF8(), file.getFullPathName().toRawUTF8()) == 0)
+        return true;
+
+    return temporary.moveFileTo(file);
+}
+
+bool ModelCheckpoint::read(const juce::File& file, Sections& sectionsOut)
+{
+    return readMapped(file, sectionsOut) || readMapped(getTemporaryFile(file), sectionsOut);
+}
+
+const std::vector<float>* ModelCheckpoint::find(const Sections& sections, uint32_t id)
+{
+    for (const auto& section : sections)
+        if (section.id == id)
+            return &section.values;
+
+    return nullptr;
+}
+
+CheckpointWriter::CheckpointWriter(const juce::File& file_)
+    : juce::Thread("CheckpointWriter")
+    , file(file_)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    changed.notify_all();
+    stopThread(5000);
+}
+
+void CheckpointWriter::submit(ModelCheckpoint::Sections sections)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = std::move(sections);
+        hasPending = true;
+    }
+
+    changed.notify_all();
+}
+
+bool CheckpointWriter::waitUntilWritten(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return !hasPending && !writing; });
+}
+
+void CheckpointWriter::run()
+{
+    ModelCheckpoint::Sections sections;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            writing = false;
+            changed.notify_all();
+            changed.wait(lock, [this] { return stopping || hasPending; });
+
+            // Stop only once the last checkpoint is on disk
+            if (!hasPending)
+                return;
+
+            sections = std::move(pending);
+            hasPending = false;
+            writing = true;
+        }
+
+        if (ModelCheckpoint::write(file, sections))
+            ++writeCount;
+        else
+            DBG("CheckpointWriter: failed to write " << file.getFullPathName());
+    }
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+    ModelCheckpoint.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Single-file checkpoint of every model's weights. The file is a versioned
+    header with a payload checksum, then one tagged section of floats per
+    model. It is written to a temporary sibling and renamed over the old
+    checkpoint, so a crash mid-write leaves the previous checkpoint intact,
+    and it is read through a memory mapping and rejected unless the
+    checksum matches. CheckpointWriter does the writing on its own thread.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ModelCheckpoint
+{
+    // One model's flat weights; ids let sections be added without breaking older files
+    struct Section
+    {
+        uint32_t id = 0;
+        std::vector<float> values;
+    };
+
+    using Sections = std::vector<Section>;
+
+    // Writes sections to a temporary sibling of file, then renames it into place
+    bool write(const juce::File& file, const Sections& sections);
+
+    /**
+     * Reads a checkpoint written by write(). Falls back to the temporary
+     * sibling when file is missing or damaged, which only happens if a
+     * crash hit between writing it and renaming it. False if neither
+     * holds a valid checkpoint.
+     */
+    bool read(const juce::File& file, Sections& sectionsOut);
+
+    // Values stored for id, or nullptr
+    const std::vector<float>* find(const Sections& sections, uint32_t id);
+
+    juce::File getTemporaryFile(const juce::File& file);
+}
+
+/**
+    Writes checkpoints on a low-priority thread so disk latency stays off the
+    caller. Only the latest submitted checkpoint matters: one submitted while
+    another waits replaces it. Anything pending is written before the writer
+    is destroyed.
+*/
+class CheckpointWriter : private juce::Thread
+{
+public:
+    explicit CheckpointWriter(const juce::File& file);
+    ~CheckpointWriter() override;
+
+    // Non-blocking: queues sections to be written
+    void submit(ModelCheckpoint::Sections sections);
+
+    // Blocks until nothing is pending or being written; false on timeout
+    bool waitUntilWritten(int timeoutMs);
+
+    int getWriteCount() const { return writeCount.load(); }
+
+private:
+    void run() override;
+
+    const juce::File file;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    ModelCheckpoint::Sections pending;
+    bool hasPending = false;
+    bool writing = false;
+    bool stopping = false;
+
+    std::atomic<int> writeCount { 0 };
+};
@@ -10,37 +10,34 @@
 
 #include "MutationOperators.h"
 #include "Individual.h"
-#include "GenomeConstraints.h"
 
-void UniformMutation::operator()(Individual& individual, juce::Random& rng) const
+void UniformMutation::operator()(Individual& individual, RandomStream& rng) const
+{
+    // Invalidate fitness if any parameter changed
+    if ((*this)(individual.getParameters().data(), individual.getParameterCount(), rng))
+    {
+        individual.invalidateFitness();
+    }
+}
+
+bool UniformMutation::operator()(float* genome, int parameterCount, RandomStream& rng) const
 {
-    auto& parameters = individual.getParameters();
-    const int paramCount = individual.getParameterCount();
-    
     bool mutated = false;
     
-    for (int i = 0; i < paramCount; ++i)
+    for (int i = 0; i < parameterCount; ++i)
     {
         if (rng.nextFloat() < mutationRate)
         {
             // Apply random perturbation in range [-strength, +strength]
             float perturbation = (rng.nextFloat() * 2.0f - 1.0f) * mutationStrength;
-            float newValue = parameters[i] + perturbation;
+            float newValue = genome[i] + perturbation;
             
             // Clamp to [0, 1] range
-            parameters[i] = juce::jlimit(0.0f, 1.0f, newValue);
+            genome[i] = juce::jlimit(0.0f, 1.0f, newValue);
             
             mutated = true;
         }
     }
     
-    // Repair genome to ensure audible output
-    GenomeConstraints::repair(parameters);
-    
-    // Invalidate fitness if any parameter changed
-    if (mutated)
-    {
-        individual.invalidateFitness();
-    }
+    return mutated;
 }
-
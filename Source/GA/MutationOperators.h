@@ -11,6 +11,7 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include "RandomStream.h"
 
 // Forward declarations
 class Individual;
@@ -19,12 +20,17 @@ class Individual;
 /**
     Uniform mutation operator.
     Each parameter has a probability of being perturbed by a random amount.
+    Genomes aren't repaired here: the GA repairs a whole arena of offspring
+    at once with GenomeConstraints::repairBatch.
 */
 struct UniformMutation
 {
     float mutationRate = 0.1f;      // Probability per parameter [0,1]
     float mutationStrength = 0.2f;  // Maximum perturbation amount [0,1]
     
-    void operator()(Individual& individual, juce::Random& rng) const;
+    void operator()(Individual& individual, RandomStream& rng) const;
+    
+    // In-place variant on a raw genome; returns true if any parameter changed
+    bool operator()(float* genome, int parameterCount, RandomStream& rng) const;
 };
 
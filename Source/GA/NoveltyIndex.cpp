@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+    NoveltyIndex.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "NoveltyIndex.h"
+#include "Population.h"
+#include <algorithm>
+#include <cmath>
+
+NoveltyIndex::NoveltyIndex(int parameterCount_, int archiveCapacity_)
+    : parameterCount(parameterCount_)
+    , archiveCapacity(std::max(0, archiveCapacity_))
+    , archive(static_cast<size_t>(archiveCapacity) * parameterCount_, 0.0f)
+{
+}
+
+void NoveltyIndex::rebuild(const Population& population)
+{
+    numMembers = population.size();
+    distances.assign(static_cast<size_t>(numMembers) * numMembers, 0.0f);
+    scratch.resize(static_cast<size_t>(numMembers + archiveCapacity));
+    
+    for (int i = 0; i < numMembers; ++i)
+    {
+        for (int j = i + 1; j < numMembers; ++j)
+        {
+            float d = distance(population.getGenome(i), population.getGenome(j));
+            distances[static_cast<size_t>(i) * numMembers + j] = d;
+            distances[static_cast<size_t>(j) * numMembers + i] = d;
+        }
+    }
+}
+
+void NoveltyIndex::update(const Population& population, int index)
+{
+    if (population.size() != numMembers)
+    {
+        rebuild(population);
+        return;
+    }
+    
+    const float* genome = population.getGenome(index);
+    
+    for (int j = 0; j < numMembers; ++j)
+    {
+        float d = (j == index) ? 0.0f : distance(genome, population.getGenome(j));
+        distances[static_cast<size_t>(index) * numMembers + j] = d;
+        distances[static_cast<size_t>(j) * numMembers + index] = d;
+    }
+}
+
+float NoveltyIndex::memberNovelty(const Population& population, int index, int k) const
+{
+    if (index < 0 || index >= numMembers)
+        return 0.0f;
+    
+    // Copy the row, skipping the self-distance
+    const float* row = distances.data() + static_cast<size_t>(index) * numMembers;
+    int count = 0;
+    
+    for (int j = 0; j < numMembers; ++j)
+        if (j != index)
+            scratch[count++] = row[j];
+    
+    appendArchiveDistances(population.getGenome(index), count);
+    
+    return meanOfNearest(count, k);
+}
+
+float NoveltyIndex::candidateNovelty(const Population& population, const float* genome, int k) const
+{
+    int count = 0;
+    
+    for (int j = 0; j < population.size(); ++j)
+        scratch[count++] = distance(genome, population.getGenome(j));
+    
+    appendArchiveDistances(genome, count);
+    
+    return meanOfNearest(count, k);
+}
+
+void NoveltyIndex::addToArchive(const float* genome)
+{
+    if (archiveCapacity == 0)
+        return;
+    
+    std::copy(genome, genome + parameterCount, archive.begin() + static_cast<size_t>(archiveNext) * parameterCount);
+    archiveNext = (archiveNext + 1) % archiveCapacity;
+    archiveCount = std::min(archiveCount + 1, archiveCapacity);
+}
+
+float NoveltyIndex::distance(const float* a, const float* b) const
+{
+    float sumSq = 0.0f;
+    for (int i = 0; i < parameterCount; ++i)
+    {
+        float diff = a[i] - b[i];
+        sumSq += diff * diff;
+    }
+    return std::sqrt(sumSq);
+}
+
+void NoveltyIndex::appendArchiveDistances(const float* genome, int& count) const
+{
+    for (int a = 0; a < archiveCount; ++a)
+        scratch[count++] = distance(genome, archive.data() + static_cast<size_t>(a) * parameterCount);
+}
+
+float NoveltyIndex::meanOfNearest(int count, int k) const
+{
+    if (count == 0)
+        return 0.0f;
+    
+    k = std::max(1, std::min(k, count));
+    
+    // k-selection in O(count) instead of a full sort
+    std::nth_element(scratch.begin(), scratch.begin() + (k - 1), scratch.begin() + count);
+    
+    float sum = 0.0f;
+    for (int i = 0; i < k; ++i)
+        sum += scratch[i];
+    
+    float avgDist = sum / static_cast<float>(k);
+    
+    // Normalize: max distance in unit hypercube is sqrt(parameterCount)
+    float maxDist = std::sqrt(static_cast<float>(parameterCount));
+    return std::min(avgDist / maxDist, 1.0f);
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+    NoveltyIndex.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Maintained k-nearest-neighbour novelty structure for a population.
+    Keeps the full pairwise distance matrix and patches one row/column when
+    a slot changes, so novelty queries cost O(N) instead of O(N log N).
+    Optionally keeps an archive of past elites that also counts as neighbours.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+class Population;
+
+class NoveltyIndex
+{
+public:
+    NoveltyIndex(int parameterCount, int archiveCapacity = 0);
+    
+    // Recompute every pairwise distance (O(N^2)), e.g. after initialisation
+    void rebuild(const Population& population);
+    
+    // Patch distances after the genome in one slot changed (O(N))
+    void update(const Population& population, int index);
+    
+    /**
+     * Novelty of a population member: mean distance to its k nearest
+     * neighbours (excluding itself), normalised to [0, 1].
+     */
+    float memberNovelty(const Population& population, int index, int k) const;
+    
+    /**
+     * Novelty of a genome that is not in the population (e.g. an offspring).
+     */
+    float candidateNovelty(const Population& population, const float* genome, int k) const;
+    
+    // Elite archive (no-op when archiveCapacity is 0)
+    void addToArchive(const float* genome);
+    int getArchiveSize() const { return archiveCount; }
+    
+    int size() const { return numMembers; }
+
+private:
+    int parameterCount;
+    int numMembers = 0;
+    std::vector<float> distances;  // numMembers x numMembers, symmetric
+    
+    int archiveCapacity;
+    int archiveCount = 0;
+    int archiveNext = 0;
+    std::vector<float> archive;    // archiveCapacity x parameterCount ring buffer
+    
+    // Query scratch; queries are made from the GA thread only
+    mutable std::vector<float> scratch;
+    
+    float distance(const float* a, const float* b) const;
+    void appendArchiveDistances(const float* genome, int& count) const;
+    float meanOfNearest(int count, int k) const;
+};
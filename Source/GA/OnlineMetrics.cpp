@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+    OnlineMetrics.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "OnlineMetrics.h"
+#include <cmath>
+
+void OnlineMetrics::BucketTree::insert(int bucket)
+{
+    for (size_t i = static_cast<size_t>(bucket) + 1; i < counts.size(); i += i & (~i + 1))
+        ++counts[i];
+}
+
+uint64_t OnlineMetrics::BucketTree::countBelow(int bucket) const
+{
+    uint64_t count = 0;
+    for (size_t i = static_cast<size_t>(bucket); i > 0; i -= i & (~i + 1))
+        count += counts[i];
+    return count;
+}
+
+void OnlineMetrics::Predictor::add(float rating, float prediction, bool liked, bool disliked,
+                                   const Stats& totals, int slot)
+{
+    const double error = std::abs(static_cast<double>(prediction) - rating);
+    rollingSum += error - recentErrors[static_cast<size_t>(slot)];
+    recentErrors[static_cast<size_t>(slot)] = error;
+    errorSum += error;
+
+    const auto numRecent = std::min<uint64_t>(totals.ratings, rollingWindow);
+    stats.rollingError = static_cast<float>(std::max(0.0, rollingSum) / static_cast<double>(numRecent));
+    stats.meanError = static_cast<float>(errorSum / static_cast<double>(totals.ratings));
+
+    // The new rating's pairs with every earlier rating of the other kind
+    const int bucket = toBucket(prediction);
+    if (liked)
+    {
+        stats.agreeingPairs += dislikes.countBelow(bucket);
+        likes.insert(bucket);
+    }
+    else if (disliked)
+    {
+        stats.agreeingPairs += totals.likes - likes.countBelow(bucket + 1);
+        dislikes.insert(bucket);
+    }
+
+    stats.pairs = totals.likes * totals.dislikes;
+}
+
+void OnlineMetrics::Predictor::reset()
+{
+    likes.clear();
+    dislikes.clear();
+    recentErrors.fill(0.0);
+    rollingSum = 0.0;
+    errorSum = 0.0;
+    stats = {};
+}
+
+int OnlineMetrics::toBucket(float prediction)
+{
+    // NaN lands in the lowest bucket
+    const float scaled = prediction * static_cast<float>(numBuckets);
+    return scaled > 0.0f ? std::min(numBuckets - 1, static_cast<int>(scaled)) : 0;
+}
+
+void OnlineMetrics::add(float rating, float genomePrediction, float audioPrediction, uint64_t sampleIndex)
+{
+    const bool liked = rating >= 1.0f;
+    const bool disliked = rating <= 0.0f;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const int slot = static_cast<int>(stats.ratings % rollingWindow);
+    ++stats.ratings;
+    stats.likes += liked ? 1 : 0;
+    stats.dislikes += disliked ? 1 : 0;
+    if (liked && stats.firstLikeIndex < 0)
+        stats.firstLikeIndex = static_cast<int64_t>(sampleIndex);
+
+    genome.add(rating, genomePrediction, liked, disliked, stats, slot);
+    audio.add(rating, audioPrediction, liked, disliked, stats, slot);
+    stats.genome = genome.stats;
+    stats.audio = audio.stats;
+}
+
+void OnlineMetrics::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = {};
+    genome.reset();
+    audio.reset();
+}
+
+OnlineMetrics::Stats OnlineMetrics::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+    OnlineMetrics.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    The metrics analysis/compute_metrics.py computes from the feedback CSV,
+    maintained as each rating is processed: like rate, the first like,
+    rolling and mean prediction error, and pairwise agreement (the share of
+    liked/disliked pairs the model ranked the right way round), for the
+    genome and audio MLPs' predictions made before training on the rating.
+    Ratings of 1 are likes and 0 dislikes, as in the script; anything in
+    between counts only towards the total and the errors. Pairwise
+    agreement keeps the likes' and dislikes' predictions in Fenwick trees
+    over numBuckets prediction buckets, so each rating adds the pairs it
+    forms in O(log numBuckets) instead of revisiting the whole history.
+    Predictions in the same bucket count as ties, which, as in the script,
+    don't agree. Rolling error is a running sum over a ring buffer. Updated
+    by one thread; getStats() may be called from any.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class OnlineMetrics
+{
+public:
+    static constexpr int rollingWindow = 10;      // compute_metrics.py's default window
+    static constexpr int numBuckets = 1 << 14;    // Prediction resolution for pairwise agreement
+
+    // One processed rating with the predictions made before training on it
+    void add(float rating, float genomePrediction, float audioPrediction, uint64_t sampleIndex);
+    void reset();
+
+    struct PredictorStats
+    {
+        float rollingError = 0.0f;    // Mean |prediction - rating| over the last rollingWindow ratings
+        float meanError = 0.0f;       // Over every rating
+        uint64_t agreeingPairs = 0;   // Liked/disliked pairs with the like predicted higher
+        uint64_t pairs = 0;           // likes x dislikes
+
+        float getPairwiseAgreement() const { return pairs > 0 ? float(double(agreeingPairs) / double(pairs)) : 0.0f; }
+    };
+
+    struct Stats
+    {
+        uint64_t ratings = 0;
+        uint64_t likes = 0;
+        uint64_t dislikes = 0;
+        int64_t firstLikeIndex = -1;  // Sample index of the first like; -1 = none yet
+        PredictorStats genome, audio;
+
+        float getLikeRate() const { return ratings > 0 ? float(likes) / float(ratings) : 0.0f; }
+    };
+
+    Stats getStats() const;
+
+private:
+    // Counts of predictions per bucket, as a Fenwick tree
+    class BucketTree
+    {
+    public:
+        BucketTree() : counts(static_cast<size_t>(numBuckets) + 1, 0) {}
+
+        void insert(int bucket);
+        uint64_t countBelow(int bucket) const;  // Predictions in buckets < bucket
+        void clear() { std::fill(counts.begin(), counts.end(), 0u); }
+
+    private:
+        std::vector<uint32_t> counts;
+    };
+
+    struct Predictor
+    {
+        BucketTree likes, dislikes;
+        std::array<double, rollingWindow> recentErrors {};
+        double rollingSum = 0.0;
+        double errorSum = 0.0;
+        PredictorStats stats;
+
+        // totals already count this rating; slot is its place in recentErrors
+        void add(float rating, float prediction, bool liked, bool disliked, const Stats& totals, int slot);
+        void reset();
+    };
+
+    static int toBucket(float prediction);
+
+    mutable std::mutex mutex;
+    Stats stats;
+    Predictor genome, audio;
+};
@@ -4,37 +4,83 @@
     Created: 8 Oct 2025
     Author:  Daniel Lister
 
-    Implementation of mailbox-style parameter communication bridge.
+    Implementation of the lock-free SPSC parameter queue.
   ==============================================================================
 */
 
 #include "ParameterBridge.h"
+#include <algorithm>
 
-void ParameterBridge::push(const std::vector<float>& params, float fitness)
+ParameterBridge::ParameterBridge(int capacityToUse, int maxParametersToUse)
+    : capacity(std::max(1, capacityToUse))
+    , maxParameters(std::max(1, maxParametersToUse))
+    , slotParameters(static_cast<size_t>(capacity) * static_cast<size_t>(maxParameters), 0.0f)
+    , slotCounts(static_cast<size_t>(capacity), 0)
+    , slotFitness(static_cast<size_t>(capacity), 0.0f)
 {
-    std::lock_guard<std::mutex> lock(mtx);
-    parameters = params;
-    storedFitness = fitness;
-    ready.store(true, std::memory_order_release);
 }
 
-bool ParameterBridge::pop(std::vector<float>& params, float& fitness)
+bool ParameterBridge::push(const std::vector<float>& params, float fitness)
 {
-    if (!ready.load(std::memory_order_acquire))
+    return push(params.data(), static_cast<int>(params.size()), fitness);
+}
+
+bool ParameterBridge::push(const float* params, int count, float fitness)
+{
+    jassert(count <= maxParameters);
+    count = std::min(count, maxParameters);
+    
+    const uint32_t writeIndex = head.load(std::memory_order_relaxed);
+    if (writeIndex - tail.load(std::memory_order_acquire) >= static_cast<uint32_t>(capacity))
         return false;
     
-    std::lock_guard<std::mutex> lock(mtx);
-    if (!ready.load(std::memory_order_relaxed))
+    const size_t slot = writeIndex % static_cast<uint32_t>(capacity);
+    std::copy(params, params + count, slotParameters.begin() + static_cast<std::ptrdiff_t>(slot * maxParameters));
+    slotCounts[slot] = count;
+    slotFitness[slot] = fitness;
+    
+    // Publish the slot contents
+    head.store(writeIndex + 1, std::memory_order_release);
+    return true;
+}
+
+bool ParameterBridge::pop(std::vector<float>& params, float& fitness)
+{
+    const uint32_t readIndex = tail.load(std::memory_order_relaxed);
+    if (readIndex == head.load(std::memory_order_acquire))
         return false;
     
-    params = parameters;
-    fitness = storedFitness;
-    ready.store(false, std::memory_order_release);
+    const size_t slot = readIndex % static_cast<uint32_t>(capacity);
+    const float* row = slotParameters.data() + slot * maxParameters;
+    params.assign(row, row + slotCounts[slot]);
+    fitness = slotFitness[slot];
+    
+    // Hand the slot back to the producer
+    lastPopTicks.store(juce::Time::getHighResolutionTicks(), std::memory_order_release);
+    tail.store(readIndex + 1, std::memory_order_release);
+    spaceAvailable.signal();
     return true;
 }
 
+int ParameterBridge::getNumAvailable() const
+{
+    const uint32_t readIndex = tail.load(std::memory_order_acquire);
+    return static_cast<int>(head.load(std::memory_order_acquire) - readIndex);
+}
+
 void ParameterBridge::clear()
 {
-    std::lock_guard<std::mutex> lock(mtx);
-    ready.store(false, std::memory_order_release);
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    spaceAvailable.signal();
+}
+
+bool ParameterBridge::waitForSpace(int timeoutMs)
+{
+    // A pop between the check and the wait leaves the event signalled,
+    // so the wait returns straight away rather than missing the wake-up
+    if (!isFull())
+        return true;
+    
+    spaceAvailable.wait(timeoutMs);
+    return !isFull();
 }
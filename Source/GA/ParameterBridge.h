@@ -4,9 +4,10 @@
     Created: 8 Oct 2025
     Author:  Daniel Lister
 
-    Mailbox-style parameter bridge for sending evolved parameters from GA thread
-    to the main synth instance on the message thread. Always holds only the
-    latest "best" preset.
+    Parameter bridge for sending evolved parameters from the GA thread to the
+    main synth instance on the message thread. A bounded, lock-free
+    single-producer/single-consumer FIFO of preallocated candidates, so the GA
+    can keep a few presets ready ahead of the user.
   ==============================================================================
 */
 
@@ -15,33 +16,61 @@
 #include <juce_core/juce_core.h>
 #include <vector>
 #include <atomic>
-#include <mutex>
+#include <cstdint>
 
 class ParameterBridge
 {
 public:
-    ParameterBridge() = default;
+    static constexpr int DEFAULT_CAPACITY = 4;
+    static constexpr int DEFAULT_MAX_PARAMETERS = 32;
+    
+    explicit ParameterBridge(int capacity = DEFAULT_CAPACITY,
+                             int maxParameters = DEFAULT_MAX_PARAMETERS);
     
     // Push a parameter set from GA thread (producer)
-    // Overwrites any existing pending preset
-    void push(const std::vector<float>& params, float fitness);
+    // Returns false (and drops the candidate) if the queue is full
+    bool push(const std::vector<float>& params, float fitness);
+    bool push(const float* params, int count, float fitness);
     
-    // Pop a parameter set on message thread (consumer)
+    // Pop the oldest parameter set on message thread (consumer)
     // Returns true if a preset was available, false if empty
     bool pop(std::vector<float>& params, float& fitness);
     
     // Check if a preset is ready
-    bool hasData() const { return ready.load(std::memory_order_acquire); }
+    bool hasData() const { return getNumAvailable() > 0; }
+    int getNumAvailable() const;
+    int getCapacity() const { return capacity; }
+    bool isFull() const { return getNumAvailable() >= capacity; }
     
-    // Clear pending preset
+    // Drop all pending presets (consumer side)
     void clear();
+    
+    // Blocks the producer until a slot is freed by pop()/clear() or
+    // wakeProducer() is called. Returns immediately if there is room.
+    // timeoutMs < 0 waits indefinitely. Returns true if there is room.
+    bool waitForSpace(int timeoutMs = -1);
+    
+    // Releases a producer blocked in waitForSpace (e.g. on shutdown/pause)
+    void wakeProducer() { spaceAvailable.signal(); }
+    
+    // High-resolution ticks of the last successful pop(); 0 before the first
+    juce::int64 getLastPopTicks() const { return lastPopTicks.load(std::memory_order_acquire); }
 
 private:
-    std::vector<float> parameters;
-    float storedFitness = 0.0f;
+    const int capacity;
+    const int maxParameters;
+    
+    // Slot storage, allocated once: capacity rows of maxParameters floats
+    std::vector<float> slotParameters;
+    std::vector<int> slotCounts;
+    std::vector<float> slotFitness;
+    
+    // Monotonic counters; head is written only by the producer, tail only by the consumer
+    std::atomic<uint32_t> head { 0 };
+    std::atomic<uint32_t> tail { 0 };
+    std::atomic<juce::int64> lastPopTicks { 0 };
     
-    std::atomic<bool> ready { false };
-    std::mutex mtx;
+    juce::WaitableEvent spaceAvailable;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterBridge)
 };
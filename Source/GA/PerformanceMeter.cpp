@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+    PerformanceMeter.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "PerformanceMeter.h"
+#include <algorithm>
+#include <cmath>
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+void AudioLoadMeter::prepare(double newSampleRate)
+{
+    sampleRate.store(newSampleRate > 0.0 ? newSampleRate : 44100.0);
+    lastLoad.store(0.0f);
+    averageLoad.store(0.0f);
+    peakLoad.store(0.0f);
+    blocks.store(0);
+
+    for (auto& bin : histogram)
+        bin.store(0);
+}
+
+void AudioLoadMeter::addBlock(double renderSeconds, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    const double deadlineSeconds = numSamples / sampleRate.load(std::memory_order_relaxed);
+    const float load = static_cast<float>(renderSeconds / deadlineSeconds);
+
+    lastLoad.store(load, std::memory_order_relaxed);
+
+    // Smoothed over averageTimeSeconds of audio, whatever the block size
+    const float alpha = 1.0f - std::exp(-static_cast<float>(deadlineSeconds) / averageTimeSeconds);
+    const float average = averageLoad.load(std::memory_order_relaxed);
+    averageLoad.store(average + (load - average) * alpha, std::memory_order_relaxed);
+
+    // Readers reset the peak, so this can't be a plain store
+    float peak = peakLoad.load(std::memory_order_relaxed);
+    while (load > peak && !peakLoad.compare_exchange_weak(peak, load, std::memory_order_relaxed))
+    {
+    }
+
+    const int bin = std::min(static_cast<int>(load * 10.0f), numBins - 1);
+    histogram[static_cast<size_t>(std::max(bin, 0))].fetch_add(1, std::memory_order_relaxed);
+    blocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioLoadMeter::Snapshot AudioLoadMeter::getSnapshot(bool takePeak)
+{
+    Snapshot snapshot;
+    snapshot.lastLoad = lastLoad.load(std::memory_order_relaxed);
+    snapshot.averageLoad = averageLoad.load(std::memory_order_relaxed);
+    snapshot.peakLoad = takePeak ? peakLoad.exchange(0.0f, std::memory_order_relaxed)
+                                 : peakLoad.load(std::memory_order_relaxed);
+    snapshot.blocks = blocks.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < numBins; ++i)
+        snapshot.histogram[static_cast<size_t>(i)] = histogram[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+void ThreadCpuMeter::sample()
+{
+    cpuNanos.store(getCurrentThreadCpuNanos(), std::memory_order_relaxed);
+}
+
+float ThreadCpuMeter::getUsage(Reading& previous) const
+{
+    const Reading now { getCpuNanos(), juce::Time::getHighResolutionTicks() };
+    const bool first = previous.wallTicks == 0;
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(now.wallTicks - previous.wallTicks);
+    const int64_t cpu = now.cpuNanos - previous.cpuNanos;
+    previous = now;
+
+    if (first || wallSeconds <= 0.0 || cpu < 0)
+        return 0.0f;
+
+    return static_cast<float>(static_cast<double>(cpu) * 1.0e-9 / wallSeconds);
+}
+
+int64_t ThreadCpuMeter::getCurrentThreadCpuNanos()
+{
+   #if JUCE_WINDOWS
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        return 0;
+
+    auto toTicks = [](const FILETIME& t) { return (static_cast<int64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime; };
+    return (toTicks(kernel) + toTicks(user)) * 100;  // 100 ns units
+   #else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0;
+
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+   #endif
+}
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+    PerformanceMeter.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Lock-free load measurements for the diagnostics view. AudioLoadMeter
+    times each processBlock against its buffer deadline; ThreadCpuMeter
+    publishes the CPU time a background thread has used. The measured
+    thread only does atomic stores, and any thread can read the values.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+    Render time of each audio block as a fraction of the time the block
+    plays for, so 1.0 means the block only just met its deadline. Keeps the
+    last and a smoothed value, the peak since it was last read, and a
+    histogram of every block since prepare().
+*/
+class AudioLoadMeter
+{
+public:
+    static constexpr int numBins = 11;            // 10% wide; the last counts overruns (>= 100%)
+    static constexpr float averageTimeSeconds = 0.3f;
+
+    struct Snapshot
+    {
+        float lastLoad = 0.0f;
+        float averageLoad = 0.0f;
+        float peakLoad = 0.0f;     // Highest since the previous takePeak read
+        uint64_t blocks = 0;
+        std::array<uint64_t, numBins> histogram {};
+
+        uint64_t getOverruns() const { return histogram[numBins - 1]; }
+    };
+
+    // Message thread, before rendering starts: clears the history
+    void prepare(double sampleRate);
+
+    // Audio thread
+    void addBlock(double renderSeconds, int numSamples);
+
+    /**
+     * Any thread. With takePeak, the peak restarts from zero, so a reader
+     * polling on a timer sees the worst block of each interval.
+     */
+    Snapshot getSnapshot(bool takePeak);
+
+    float getAverageLoad() const { return averageLoad.load(std::memory_order_relaxed); }
+
+    // Times the enclosing scope as one block
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(AudioLoadMeter& meter, int numSamples)
+            : meter(meter), numSamples(numSamples), startTicks(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedBlock()
+        {
+            const auto elapsed = juce::Time::getHighResolutionTicks() - startTicks;
+            meter.addBlock(juce::Time::highResolutionTicksToSeconds(elapsed), numSamples);
+        }
+
+    private:
+        AudioLoadMeter& meter;
+        const int numSamples;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+private:
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<float> lastLoad { 0.0f };
+    std::atomic<float> averageLoad { 0.0f };
+    std::atomic<float> peakLoad { 0.0f };
+    std::atomic<uint64_t> blocks { 0 };
+    std::array<std::atomic<uint64_t>, numBins> histogram {};
+};
+
+/**
+    CPU time used by one thread. The thread calls sample() as it works, which
+    publishes its running total; readers turn two readings into a usage
+    fraction with getUsage(). A thread that blocks for a long time without
+    sampling shows its usage late rather than never.
+*/
+class ThreadCpuMeter
+{
+public:
+    // Called by the measured thread
+    void sample();
+
+    int64_t getCpuNanos() const { return cpuNanos.load(std::memory_order_relaxed); }
+
+    // A reader's previous reading
+    struct Reading
+    {
+        int64_t cpuNanos = 0;
+        juce::int64 wallTicks = 0;
+    };
+
+    // Fraction of one core used since previous, which is then updated; 0 on the first call
+    float getUsage(Reading& previous) const;
+
+    // CPU time the calling thread has used so far, or 0 where unsupported
+    static int64_t getCurrentThreadCpuNanos();
+
+private:
+    std::atomic<int64_t> cpuNanos { 0 };
+};
@@ -12,175 +12,204 @@
 #include "GenomeConstraints.h"
 #include <juce_core/juce_core.h>
 #include <algorithm>
-#include <limits>
 
 Population::Population(int size, int parameterCount)
-    : parameterCount(parameterCount)
+    : numIndividuals(size)
+    , parameterCount(parameterCount)
+    , genomeStorage(static_cast<size_t>(size) * parameterCount + alignmentBytes / sizeof(float), 0.0f)
+    , fitness(static_cast<size_t>(size), 0.0f)
+    , evaluated(static_cast<size_t>(size), 0)
 {
-    individuals.reserve(size);
-    for (int i = 0; i < size; ++i)
-    {
-        individuals.emplace_back(parameterCount);
-    }
+    markDirty();
 }
 
-void Population::initializeRandom()
+float* Population::genomeBase()
 {
-    juce::Random random;
-    
-    for (auto& individual : individuals)
+    return const_cast<float*>(static_cast<const Population*>(this)->genomeBase());
+}
+
+const float* Population::genomeBase() const
+{
+    auto address = reinterpret_cast<std::uintptr_t>(genomeStorage.data());
+    auto misalignment = address % alignmentBytes;
+    auto offset = misalignment == 0 ? 0 : (alignmentBytes - misalignment) / sizeof(float);
+    return genomeStorage.data() + offset;
+}
+
+void Population::initializeRandom(uint64_t seed)
+{
+    RandomStream random(seed);
+    initializeRandom(random);
+}
+
+void Population::initializeRandom(RandomStream& random)
+{
+    for (int index = 0; index < numIndividuals; ++index)
     {
-        std::vector<float> params(parameterCount);
+        float* params = genomeBase() + static_cast<size_t>(index) * parameterCount;
         for (int i = 0; i < parameterCount; ++i)
         {
             params[i] = random.nextFloat();  // [0, 1]
         }
-        
-        // Repair genome to ensure audible output
-        GenomeConstraints::repair(params);
-        
-        individual.setParameters(params);
-        individual.invalidateFitness();
     }
     
+    // Repair every genome to ensure audible output
+    GenomeConstraints::repairBatch(genomeBase(), numIndividuals, parameterCount);
+    
+    std::fill(evaluated.begin(), evaluated.end(), 0);
     markDirty();
 }
 
 void Population::clear()
 {
-    for (auto& individual : individuals)
-    {
-        std::vector<float> params(parameterCount, 0.0f);
-        individual.setParameters(params);
-        individual.invalidateFitness();
-    }
+    std::fill(genomeStorage.begin(), genomeStorage.end(), 0.0f);
+    std::fill(evaluated.begin(), evaluated.end(), 0);
     
     markDirty();
 }
 
-const Individual& Population::operator[](int index) const
+IndividualView Population::operator[](int index) const
 {
-    jassert(index >= 0 && index < static_cast<int>(individuals.size()));
-    return individuals[index];
+    jassert(index >= 0 && index < numIndividuals);
+    return IndividualView(getGenome(index), parameterCount, fitness[index], evaluated[index] != 0);
 }
 
-Individual& Population::getBest()
+IndividualView Population::getBest() const
 {
-    if (statisticsDirty)
-    {
-        updateStatistics();
-    }
-    
-    jassert(bestIndex >= 0 && bestIndex < static_cast<int>(individuals.size()));
-    return individuals[bestIndex];
+    jassert(hasBest());
+    return (*this)[bestHeap.top()];
 }
 
-int Population::getBestIndex()
+int Population::getBestIndex() const
 {
-    if (statisticsDirty)
-    {
-        updateStatistics();
-    }
-    
-    return bestIndex;
+    return bestHeap.empty() ? -1 : bestHeap.top();
 }
 
-bool Population::hasBest()
+bool Population::hasBest() const
 {
-    if (statisticsDirty)
-    {
-        updateStatistics();
-    }
-    
-    return bestIndex >= 0;
+    return !bestHeap.empty();
 }
 
-float Population::getBestFitness()
+float Population::getBestFitness() const
 {
-    if (statisticsDirty)
-    {
-        updateStatistics();
-    }
-    
-    return bestIndex >= 0 ? individuals[bestIndex].getFitness() : 0.0f;
+    return bestHeap.empty() ? 0.0f : fitness[bestHeap.top()];
 }
 
-float Population::getAverageFitness()
+float Population::getAverageFitness() const
 {
-    if (statisticsDirty)
-    {
-        updateStatistics();
-    }
-    
-    return cachedAvgFitness;
+    return worstHeap.empty() ? 0.0f : static_cast<float>(fitnessSum / worstHeap.size());
+}
+
+float Population::getWorstFitness() const
+{
+    return worstHeap.empty() ? 0.0f : fitness[worstHeap.top()];
 }
 
-float Population::getWorstFitness()
+int Population::worstK(int k, int* indicesOut) const
 {
-    if (statisticsDirty)
+    k = std::min(k, worstHeap.size());
+    if (k <= 0)
+        return 0;
+    
+    // Best-first walk of the min-heap: the next smallest is always a child
+    // of something already taken, so only O(k) positions are ever examined
+    const float* keys = fitness.data();
+    auto later = [this, keys](int a, int b)
+    {
+        return IndexedHeap<true>::before(worstHeap.at(b), worstHeap.at(a), keys);
+    };
+    
+    worstFrontier.clear();
+    worstFrontier.push_back(0);
+    
+    const int heapSize = worstHeap.size();
+    int count = 0;
+    
+    while (count < k)
     {
-        updateStatistics();
+        std::pop_heap(worstFrontier.begin(), worstFrontier.end(), later);
+        int position = worstFrontier.back();
+        worstFrontier.pop_back();
+        
+        indicesOut[count++] = worstHeap.at(position);
+        
+        for (int child = 2 * position + 1; child <= 2 * position + 2 && child < heapSize; ++child)
+        {
+            worstFrontier.push_back(child);
+            std::push_heap(worstFrontier.begin(), worstFrontier.end(), later);
+        }
     }
     
-    return cachedWorstFitness;
+    return count;
+}
+
+void Population::setFitness(int index, float newFitness)
+{
+    jassert(index >= 0 && index < numIndividuals);
+    untrack(index);
+    fitness[index] = newFitness;
+    evaluated[index] = 1;
+    track(index);
+}
+
+void Population::setGenome(int index, const float* parameters)
+{
+    jassert(index >= 0 && index < numIndividuals);
+    std::copy(parameters, parameters + parameterCount, genomeBase() + static_cast<size_t>(index) * parameterCount);
+    untrack(index);
+    evaluated[index] = 0;
 }
 
 void Population::replace(int index, const Individual& newIndividual)
 {
-    if (index >= 0 && index < static_cast<int>(individuals.size()))
+    if (index >= 0 && index < numIndividuals)
     {
-        individuals[index] = newIndividual;
-        markDirty();
+        jassert(newIndividual.getParameterCount() == parameterCount);
+        
+        std::copy(newIndividual.getParameters().begin(), newIndividual.getParameters().end(),
+                  genomeBase() + static_cast<size_t>(index) * parameterCount);
+        
+        untrack(index);
+        fitness[index] = newIndividual.getFitness();
+        evaluated[index] = newIndividual.hasBeenEvaluated() ? 1 : 0;
+        
+        if (evaluated[index])
+            track(index);
     }
 }
 
+void Population::replace(int index, const float* parameters, float newFitness)
+{
+    jassert(index >= 0 && index < numIndividuals);
+    std::copy(parameters, parameters + parameterCount, genomeBase() + static_cast<size_t>(index) * parameterCount);
+    setFitness(index, newFitness);
+}
+
 void Population::markDirty()
 {
-    statisticsDirty = true;
+    worstHeap.reset(numIndividuals);
+    bestHeap.reset(numIndividuals);
+    worstFrontier.reserve(static_cast<size_t>(numIndividuals) + 1);
+    fitnessSum = 0.0;
+    
+    for (int i = 0; i < numIndividuals; ++i)
+        if (evaluated[i])
+            track(i);
 }
 
-void Population::updateStatistics()
+void Population::track(int index)
 {
-    if (individuals.empty())
-    {
-        bestIndex = -1;
-        cachedAvgFitness = 0.0f;
-        cachedWorstFitness = 0.0f;
-        statisticsDirty = false;
+    worstHeap.push(index, fitness.data());
+    bestHeap.push(index, fitness.data());
+    fitnessSum += fitness[index];
+}
+
+void Population::untrack(int index)
+{
+    if (!worstHeap.contains(index))
         return;
-    }
     
-    float bestFitness = -std::numeric_limits<float>::max();
-    float worstFitness = std::numeric_limits<float>::max();
-    float sumFitness = 0.0f;
-    int evaluatedCount = 0;
-    
-    bestIndex = -1;
-    
-    for (int i = 0; i < static_cast<int>(individuals.size()); ++i)
-    {
-        if (individuals[i].hasBeenEvaluated())
-        {
-            float fitness = individuals[i].getFitness();
-            sumFitness += fitness;
-            ++evaluatedCount;
-            
-            if (fitness > bestFitness)
-            {
-                bestFitness = fitness;
-                bestIndex = i;
-            }
-            
-            if (fitness < worstFitness)
-            {
-                worstFitness = fitness;
-            }
-        }
-    }
-    
-    cachedAvgFitness = evaluatedCount > 0 ? sumFitness / evaluatedCount : 0.0f;
-    cachedWorstFitness = evaluatedCount > 0 ? worstFitness : 0.0f;
-    
-    statisticsDirty = false;
+    worstHeap.remove(index, fitness.data());
+    bestHeap.remove(index, fitness.data());
+    fitnessSum -= fitness[index];
 }
-
@@ -6,13 +6,22 @@
 
     Simple population container for genetic algorithm.
     Manages storage, access, and statistics without evolutionary operators.
+    Storage is structure-of-arrays: one contiguous, cache-line aligned
+    size x parameterCount genome matrix plus parallel fitness/evaluated arrays.
+    Evaluated slots are tracked in indexed min/max heaps so best, worst-k and
+    average are maintained incrementally instead of rescanned per generation.
   ==============================================================================
 */
 
 #pragma once
 
+#include <juce_core/juce_core.h>
 #include "Individual.h"
+#include "IndexedHeap.h"
+#include "RandomStream.h"
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
 class Population
 {
@@ -20,35 +29,66 @@ public:
     Population(int size, int parameterCount);
     
     // Initialization
-    void initializeRandom();  // Random [0,1] for each parameter
+    void initializeRandom(uint64_t seed = 0);  // Random [0,1] for each parameter, from RandomStream(seed)
+    void initializeRandom(RandomStream& random);  // Same, drawn from the caller's stream
     void clear();
     
     // Access
-    const Individual& operator[](int index) const;
-    Individual& getBest();
-    int getBestIndex();
-    bool hasBest();
-    int size() const { return static_cast<int>(individuals.size()); }
+    IndividualView operator[](int index) const;
+    IndividualView getBest() const;
+    int getBestIndex() const;  // O(1)
+    bool hasBest() const;
+    int size() const { return numIndividuals; }
+    int getParameterCount() const { return parameterCount; }
     
-    // Statistics (efficient with caching)
-    float getBestFitness();
-    float getAverageFitness();
-    float getWorstFitness();
+    // Contiguous storage access (row-major, rows are parameterCount floats)
+    const float* getGenomeMatrix() const { return genomeBase(); }
+    const float* getGenome(int index) const { return genomeBase() + static_cast<size_t>(index) * parameterCount; }
+    const float* getFitnessArray() const { return fitness.data(); }
+    float getFitness(int index) const { return fitness[static_cast<size_t>(index)]; }
+    bool isEvaluated(int index) const { return evaluated[static_cast<size_t>(index)] != 0; }
+    
+    // Statistics (O(1), maintained on every fitness change)
+    float getBestFitness() const;
+    float getAverageFitness() const;
+    float getWorstFitness() const;
+    int getEvaluatedCount() const { return worstHeap.size(); }
+    
+    /**
+     * Writes up to k evaluated indices to indicesOut, lowest fitness first
+     * (ties by index). Returns the number written. O(k log k), no allocation.
+     */
+    int worstK(int k, int* indicesOut) const;
     
     // Replacement/modification
+    void setFitness(int index, float newFitness);
+    void setGenome(int index, const float* parameters);  // Invalidates fitness
     void replace(int index, const Individual& newIndividual);
-    void markDirty();  // Call when external code modifies individuals
+    void replace(int index, const float* parameters, float newFitness);  // Evaluated row, no allocation
+    void markDirty();  // Rebuilds heaps and statistics from scratch (O(N))
     
 private:
-    std::vector<Individual> individuals;
+    static constexpr size_t alignmentBytes = 64;
+    
+    int numIndividuals;
     int parameterCount;
     
-    // Cached statistics
-    int bestIndex = -1;
-    bool statisticsDirty = true;
-    float cachedAvgFitness = 0.0f;
-    float cachedWorstFitness = 0.0f;
+    // Over-allocated so the matrix can start on a cache-line boundary
+    std::vector<float> genomeStorage;
+    std::vector<float> fitness;
+    std::vector<uint8_t> evaluated;
+    
+    float* genomeBase();
+    const float* genomeBase() const;
     
-    void updateStatistics();
+    // Evaluated slots keyed by fitness
+    IndexedHeap<true> worstHeap;
+    IndexedHeap<false> bestHeap;
+    double fitnessSum = 0.0;
+    
+    // Frontier of heap positions for worstK (capacity reserved up front)
+    mutable std::vector<int> worstFrontier;
+    
+    void track(int index);
+    void untrack(int index);
 };
-
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+    QuantizedMLP.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "QuantizedMLP.h"
+#include <algorithm>
+#include <cmath>
+
+template <int InputSize, int HiddenSize>
+QuantizedMLP<InputSize, HiddenSize>::QuantizedMLP(const FixedMLP<InputSize, HiddenSize>& model)
+    : biasH(model.biasH)
+    , weightsHO(model.weightsHO)
+    , biasO(model.biasO)
+{
+    for (int j = 0; j < HiddenSize; ++j)
+    {
+        float maxAbs = 0.0f;
+        for (int i = 0; i < InputSize; ++i)
+            maxAbs = std::max(maxAbs, std::abs(model.weightsIH[i * HiddenSize + j]));
+
+        // An all-zero unit keeps zero weights and any scale
+        const float scale = maxAbs > 0.0f ? maxAbs / weightLevels : 1.0f;
+        hiddenScale[j] = scale / inputLevels;
+
+        for (int i = 0; i < InputSize; ++i)
+        {
+            const float level = std::round(model.weightsIH[i * HiddenSize + j] / scale);
+            weightsIH[i * HiddenSize + j] = static_cast<int8_t>(std::clamp(level, -127.0f, 127.0f));
+        }
+    }
+}
+
+template <int InputSize, int HiddenSize>
+float QuantizedMLP<InputSize, HiddenSize>::predictRow(const float* input) const
+{
+    // Input -> Hidden: integer multiply-accumulate, each weight row read contiguously
+    std::array<int32_t, HiddenSize> accumulators {};
+
+    for (int i = 0; i < InputSize; ++i)
+    {
+        const int32_t x = static_cast<int32_t>(std::clamp(input[i], 0.0f, 1.0f) * inputLevels + 0.5f);
+        const int8_t* w = weightsIH.data() + i * HiddenSize;
+
+        for (int j = 0; j < HiddenSize; ++j)
+            accumulators[j] += x * static_cast<int32_t>(w[j]);
+    }
+
+    // Hidden -> Output (with ReLU then sigmoid) in float
+    float sum = biasO;
+    for (int j = 0; j < HiddenSize; ++j)
+    {
+        const float h = biasH[j] + static_cast<float>(accumulators[j]) * hiddenScale[j];
+        sum += (h > 0.0f ? h : 0.0f) * weightsHO[j];
+    }
+
+    return 1.0f / (1.0f + std::exp(-sum));
+}
+
+template <int InputSize, int HiddenSize>
+float QuantizedMLP<InputSize, HiddenSize>::predict(const std::vector<float>& input) const
+{
+    return predictRow(input.data());
+}
+
+template <int InputSize, int HiddenSize>
+void QuantizedMLP<InputSize, HiddenSize>::predictBatch(const float* inputs, int numSamples, float* outputs) const
+{
+    for (int n = 0; n < numSamples; ++n)
+        outputs[n] = predictRow(inputs + static_cast<size_t>(n) * InputSize);
+}
+
+template class QuantizedMLP<17, 32>;
+template class QuantizedMLP<24, 32>;
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+    QuantizedMLP.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Inference-only int8 copy of a FixedMLP for GA fitness scoring. Input to
+    hidden weights are quantized per hidden unit (each unit's weights share
+    one scale) and inputs, which are normalized to [0, 1], to 8 bits, so the
+    hidden layer is an integer dot product accumulated in int32. The hidden
+    to output layer is small and stays in float. A quarter of the weight
+    bytes of the float model, so the weights stay in L1 beside the
+    population being scored. Immutable once built: safe to share.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FixedMLP.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+template <int InputSize, int HiddenSize>
+class QuantizedMLP
+{
+public:
+    // Quantizes model's current weights
+    explicit QuantizedMLP(const FixedMLP<InputSize, HiddenSize>& model);
+
+    static constexpr int getInputSize() { return InputSize; }
+
+    // Preference score [0, 1]; inputs outside [0, 1] are clamped
+    float predict(const std::vector<float>& input) const;
+
+    // Batched predict over a row-major numSamples x InputSize matrix
+    void predictBatch(const float* inputs, int numSamples, float* outputs) const;
+
+private:
+    static constexpr int inputLevels = 255;   // Input x in [0, 1] -> round(x * 255)
+    static constexpr int weightLevels = 127;  // Weight w -> round(w / scale), |q| <= 127
+
+    // Input-major like FixedMLP: row i holds input i's weight to every hidden unit
+    std::array<int8_t, InputSize * HiddenSize> weightsIH {};
+    std::array<float, HiddenSize> hiddenScale {};  // Accumulator -> pre-activation, per hidden unit
+    std::array<float, HiddenSize> biasH {};
+    std::array<float, HiddenSize> weightsHO {};
+    float biasO = 0.0f;
+
+    float predictRow(const float* input) const;
+};
+
+extern template class QuantizedMLP<17, 32>;
+extern template class QuantizedMLP<24, 32>;
+
+using QuantizedGenomeMLP = QuantizedMLP<17, 32>;
+using QuantizedAudioMLP = QuantizedMLP<24, 32>;
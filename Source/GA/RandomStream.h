@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+    RandomStream.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Seeded counter-based random numbers. The n-th value of a stream is a
+    SplitMix64-style hash of the stream's two-word key and n, so a stream is
+    just a key and a counter: it can be copied, saved, jumped anywhere with
+    setPosition(), and split() into child streams whose keys hash in an id,
+    one per island, worker or call site, without any of them sharing state.
+    A given seed gives the same numbers on any thread. It satisfies
+    UniformRandomBitGenerator for the <random> distributions and
+    std::shuffle, and has juce::Random's nextInt/nextFloat/nextBool for the
+    GA operators.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+class RandomStream
+{
+public:
+    using result_type = uint64_t;
+
+    // The whole state, e.g. for population snapshots
+    struct State
+    {
+        uint64_t key0 = 0;
+        uint64_t key1 = 0;
+        uint64_t counter = 0;
+    };
+
+    explicit RandomStream(uint64_t seed = 0, uint64_t streamId = 0) noexcept
+        : key0(mix(seed)), key1(mix(mix(seed ^ streamSalt) + streamId))
+    {
+    }
+
+    // An independent stream; the same id always gives the same child
+    RandomStream split(uint64_t streamId) const noexcept
+    {
+        RandomStream child;
+        child.key0 = mix(key0 ^ mix(streamId));
+        child.key1 = mix(key1 + mix(streamId ^ streamSalt));
+        return child;
+    }
+
+    // Seed for something that takes a plain seed, e.g. a model's weights
+    static uint64_t deriveSeed(uint64_t seed, uint64_t streamId) noexcept
+    {
+        return RandomStream(seed, streamId).next64();
+    }
+
+    uint64_t next64() noexcept { return mix(mix(key0 + ++counter * gamma) ^ key1); }
+    uint64_t operator()() noexcept { return next64(); }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return std::numeric_limits<uint64_t>::max(); }
+
+    // juce::Random equivalents; the bounded ones use the top bits
+    int nextInt() noexcept { return static_cast<int>(static_cast<uint32_t>(next64() >> 32)); }
+    int nextInt(int maxValue) noexcept
+    {
+        return static_cast<int>(((next64() >> 32) * static_cast<uint64_t>(maxValue)) >> 32);
+    }
+    int64_t nextInt64() noexcept { return static_cast<int64_t>(next64()); }
+    float nextFloat() noexcept { return static_cast<float>(next64() >> 40) * 0x1.0p-24f; }  // [0, 1)
+    double nextDouble() noexcept { return static_cast<double>(next64() >> 11) * 0x1.0p-53; }
+    bool nextBool() noexcept { return (next64() >> 63) != 0; }
+
+    // Values drawn so far; setting it replays or skips ahead in O(1)
+    uint64_t getPosition() const noexcept { return counter; }
+    void setPosition(uint64_t position) noexcept { counter = position; }
+
+    State getState() const noexcept { return { key0, key1, counter }; }
+    void setState(const State& state) noexcept
+    {
+        key0 = state.key0;
+        key1 = state.key1;
+        counter = state.counter;
+    }
+
+private:
+    static constexpr uint64_t gamma = 0x9e3779b97f4a7c15ull;
+    static constexpr uint64_t streamSalt = 0xd1b54a32d192ed03ull;
+
+    // SplitMix64's finaliser
+    static constexpr uint64_t mix(uint64_t z) noexcept
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t key0 = 0;
+    uint64_t key1 = 0;
+    uint64_t counter = 0;
+};
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+    ReplayBuffer.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "ReplayBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+ReplayBuffer::ReplayBuffer(int capacity, int genomeSize_, int featureSize_, uint64_t seed)
+    : maxSamples(std::max(1, capacity))
+    , genomeSize(genomeSize_)
+    , featureSize(featureSize_)
+    , genomes(static_cast<size_t>(maxSamples) * genomeSize_)
+    , featureRows(static_cast<size_t>(maxSamples) * featureSize_)
+    , ratings(static_cast<size_t>(maxSamples))
+    , sampleWeights(static_cast<size_t>(maxSamples))
+    , rng(seed)
+{
+    while (leaves < maxSamples)
+        leaves <<= 1;
+
+    tree.assign(static_cast<size_t>(leaves) * 2, 0.0);
+}
+
+int ReplayBuffer::add(const float* genome, const float* features, float rating, float sampleWeight)
+{
+    const int index = next;
+    next = (next + 1) % maxSamples;
+    count = std::min(count + 1, maxSamples);
+
+    std::copy(genome, genome + genomeSize, genomes.begin() + static_cast<size_t>(index) * genomeSize);
+    std::copy(features, features + featureSize, featureRows.begin() + static_cast<size_t>(index) * featureSize);
+    ratings[static_cast<size_t>(index)] = rating;
+    sampleWeights[static_cast<size_t>(index)] = sampleWeight;
+
+    setLeaf(index, std::pow(static_cast<double>(maxPriority), static_cast<double>(alpha)));
+    return index;
+}
+
+void ReplayBuffer::sample(int numSamples, int* indicesOut, float* importanceOut)
+{
+    if (count == 0 || numSamples <= 0)
+        return;
+
+    // Stratified: one draw from each of numSamples equal slices of the total,
+    // so a batch doesn't pile onto the few highest priorities
+    const double total = tree[1];
+    const double slice = total / numSamples;
+    float maxImportance = 0.0f;
+
+    for (int k = 0; k < numSamples; ++k)
+    {
+        const int index = findLeaf((k + rng.nextDouble()) * slice);
+        const double probability = tree[static_cast<size_t>(leaves + index)] / total;
+
+        indicesOut[k] = index;
+        importanceOut[k] = static_cast<float>(std::pow(count * probability, -static_cast<double>(beta)));
+        maxImportance = std::max(maxImportance, importanceOut[k]);
+    }
+
+    for (int k = 0; k < numSamples; ++k)
+        importanceOut[k] /= maxImportance;
+}
+
+void ReplayBuffer::updatePriority(int index, float error)
+{
+    const float priority = std::abs(error) + minimumPriority;
+    maxPriority = std::max(maxPriority, priority);
+    setLeaf(index, std::pow(static_cast<double>(priority), static_cast<double>(alpha)));
+}
+
+void ReplayBuffer::clear()
+{
+    count = 0;
+    next = 0;
+    maxPriority = 1.0f;
+    std::fill(tree.begin(), tree.end(), 0.0);
+}
+
+void ReplayBuffer::setLeaf(int index, double value)
+{
+    size_t node = static_cast<size_t>(leaves + index);
+    tree[node] = value;
+
+    // Re-summing rather than adding deltas keeps rounding from drifting
+    for (node >>= 1; node >= 1; node >>= 1)
+        tree[node] = tree[node * 2] + tree[node * 2 + 1];
+}
+
+int ReplayBuffer::findLeaf(double target) const
+{
+    size_t node = 1;
+
+    while (node < static_cast<size_t>(leaves))
+    {
+        const size_t left = node * 2;
+        if (target < tree[left])
+        {
+            node = left;
+        }
+        else
+        {
+            target -= tree[left];
+            node = left + 1;
+        }
+    }
+
+    // Rounding can carry a draw at the very top past the last stored sample
+    return std::min(static_cast<int>(node) - leaves, count - 1);
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+    ReplayBuffer.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Fixed-capacity store of rated samples for experience replay. Genomes,
+    their audio features, ratings and sample weights sit in preallocated
+    columns (structure of arrays), so adding or sampling never allocates;
+    once full, each new sample overwrites the oldest. Sampling is
+    prioritized: a sample is drawn in proportion to its priority^alpha,
+    kept in a sum tree, and priorities follow the model's prediction error
+    on it, so samples the model still gets wrong are replayed more. New
+    samples take the highest priority seen, so each is replayed soon.
+    Importance weights undo the sampling bias. Not thread-safe.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RandomStream.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ReplayBuffer
+{
+public:
+    ReplayBuffer(int capacity, int genomeSize, int featureSize, uint64_t seed = 0);
+
+    int size() const { return count; }
+    int capacity() const { return maxSamples; }
+
+    // Stores a sample (overwriting the oldest when full) and returns its index
+    int add(const float* genome, const float* features, float rating, float sampleWeight);
+
+    const float* genome(int index) const { return genomes.data() + static_cast<size_t>(index) * genomeSize; }
+    const float* features(int index) const { return featureRows.data() + static_cast<size_t>(index) * featureSize; }
+    float rating(int index) const { return ratings[static_cast<size_t>(index)]; }
+    float sampleWeight(int index) const { return sampleWeights[static_cast<size_t>(index)]; }
+
+    /**
+     * Draws numSamples indices (with replacement) by priority. importanceOut
+     * receives each draw's importance weight, (N * P(i))^-beta scaled so the
+     * largest in the draw is 1. Nothing is drawn while the buffer is empty.
+     */
+    void sample(int numSamples, int* indicesOut, float* importanceOut);
+
+    // Sets a sample's priority from the model's absolute error on it
+    void updatePriority(int index, float error);
+
+    void clear();
+
+    static constexpr float alpha = 0.6f;             // 0 = uniform sampling, 1 = fully proportional
+    static constexpr float beta = 0.4f;              // Importance correction strength
+    static constexpr float minimumPriority = 0.01f;  // Keeps learnt samples drawable
+
+private:
+    int maxSamples;
+    int genomeSize;
+    int featureSize;
+
+    // Columns, one row per sample
+    std::vector<float> genomes;
+    std::vector<float> featureRows;
+    std::vector<float> ratings;
+    std::vector<float> sampleWeights;
+
+    int count = 0;
+    int next = 0;  // Slot the next sample goes to
+    float maxPriority = 1.0f;
+
+    // Sum tree over priority^alpha: leaves at [leaves, 2 * leaves), node i sums 2i and 2i + 1
+    int leaves = 1;
+    std::vector<double> tree;
+
+    RandomStream rng;
+
+    void setLeaf(int index, double value);
+    int findLeaf(double target) const;
+};
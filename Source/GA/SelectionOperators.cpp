@@ -10,20 +10,22 @@
 
 #include "SelectionOperators.h"
 #include "Population.h"
+#include <algorithm>
+#include <numeric>
 
-int TournamentSelection::operator()(const Population& population, juce::Random& rng) const
+int TournamentSelection::operator()(const Population& population, RandomStream& rng) const
 {
     const int popSize = population.size();
     
     // Select first random individual as initial best
     int bestIndex = rng.nextInt(popSize);
-    float bestFitness = population[bestIndex].getFitness();
+    float bestFitness = population.getFitness(bestIndex);
     
     // Compare against remaining tournament participants
     for (int i = 1; i < tournamentSize; ++i)
     {
         int candidateIndex = rng.nextInt(popSize);
-        float candidateFitness = population[candidateIndex].getFitness();
+        float candidateFitness = population.getFitness(candidateIndex);
         
         if (candidateFitness > bestFitness)
         {
@@ -35,3 +37,209 @@ int TournamentSelection::operator()(const Population& population, juce::Random&
     return bestIndex;
 }
 
+
+void TournamentSelection::operator()(const Population& population, RandomStream& rng, int* indicesOut, int count) const
+{
+    const int popSize = population.size();
+    const float* fitness = population.getFitnessArray();
+    
+    for (int t = 0; t < count; ++t)
+    {
+        int bestIndex = rng.nextInt(popSize);
+        float bestFitness = fitness[bestIndex];
+        
+        for (int i = 1; i < tournamentSize; ++i)
+        {
+            int candidateIndex = rng.nextInt(popSize);
+            if (fitness[candidateIndex] > bestFitness)
+            {
+                bestIndex = candidateIndex;
+                bestFitness = fitness[candidateIndex];
+            }
+        }
+        
+        indicesOut[t] = bestIndex;
+    }
+}
+
+void RankSelection::prepare(const Population& population)
+{
+    const int popSize = population.size();
+    const float* fitness = population.getFitnessArray();
+    
+    if (static_cast<int>(byRank.size()) != popSize || selectionPressure != tablePressure)
+        buildAliasTable(popSize);
+    
+    std::iota(byRank.begin(), byRank.end(), 0);
+    std::sort(byRank.begin(), byRank.end(), [fitness](int a, int b)
+    {
+        return fitness[a] != fitness[b] ? fitness[a] < fitness[b] : a < b;
+    });
+}
+
+void RankSelection::buildAliasTable(int size)
+{
+    byRank.resize(static_cast<size_t>(size));
+    aliasProbability.assign(static_cast<size_t>(size), 1.0f);
+    alias.resize(static_cast<size_t>(size));
+    std::iota(alias.begin(), alias.end(), 0);
+    tablePressure = selectionPressure;
+    
+    if (size < 2)
+        return;
+    
+    // Vose's method over probabilities scaled by N, so a fair share is 1
+    const double pressure = juce::jlimit(1.0, 2.0, static_cast<double>(selectionPressure));
+    std::vector<double> scaled(static_cast<size_t>(size));
+    for (int r = 0; r < size; ++r)
+        scaled[static_cast<size_t>(r)] = 2.0 - pressure + 2.0 * (pressure - 1.0) * r / (size - 1);
+    
+    std::vector<int> small, large;
+    for (int r = 0; r < size; ++r)
+        (scaled[static_cast<size_t>(r)] < 1.0 ? small : large).push_back(r);
+    
+    while (!small.empty() && !large.empty())
+    {
+        const int less = small.back();
+        const int more = large.back();
+        small.pop_back();
+        
+        aliasProbability[static_cast<size_t>(less)] = static_cast<float>(scaled[static_cast<size_t>(less)]);
+        alias[static_cast<size_t>(less)] = more;
+        
+        scaled[static_cast<size_t>(more)] -= 1.0 - scaled[static_cast<size_t>(less)];
+        if (scaled[static_cast<size_t>(more)] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    
+    // Whatever is left is a full share, up to rounding
+    for (int r : small)
+        aliasProbability[static_cast<size_t>(r)] = 1.0f;
+    for (int r : large)
+        aliasProbability[static_cast<size_t>(r)] = 1.0f;
+}
+
+void RankSelection::operator()(RandomStream& rng, int* indicesOut, int count) const
+{
+    jassert(!byRank.empty());
+    const int size = static_cast<int>(byRank.size());
+    
+    for (int i = 0; i < count; ++i)
+    {
+        const int column = rng.nextInt(size);
+        const int rank = rng.nextFloat() < aliasProbability[static_cast<size_t>(column)] ? column
+                                                                                          : alias[static_cast<size_t>(column)];
+        indicesOut[i] = byRank[static_cast<size_t>(rank)];
+    }
+}
+
+void StochasticUniversalSampling::operator()(const Population& population, RandomStream& rng, int* indicesOut, int count) const
+{
+    const int popSize = population.size();
+    const float* fitness = population.getFitnessArray();
+    
+    if (count <= 0 || popSize <= 0)
+        return;
+    
+    const auto range = std::minmax_element(fitness, fitness + popSize);
+    const double worst = *range.first;
+    const double floorShare = std::max(1.0e-6, 0.01 * (*range.second - worst));
+    
+    double total = 0.0;
+    for (int i = 0; i < popSize; ++i)
+        total += fitness[i] - worst + floorShare;
+    
+    // One pass down the cumulative weights with all count pointers
+    const double spacing = total / count;
+    double pointer = rng.nextDouble() * spacing;
+    double cumulative = 0.0;
+    int member = -1;
+    
+    for (int i = 0; i < count; ++i)
+    {
+        while (cumulative <= pointer && member < popSize - 1)
+            cumulative += fitness[++member] - worst + floorShare;
+        
+        indicesOut[i] = member;
+        pointer += spacing;
+    }
+    
+    for (int i = count - 1; i > 0; --i)
+        std::swap(indicesOut[i], indicesOut[rng.nextInt(i + 1)]);
+}
+
+int WorstReplacement::operator()(const Population& population, const float* offspringFitness, int numOffspring,
+                                 int* membersOut, int* childrenOut) const
+{
+    const int numWorst = population.worstK(numOffspring, membersOut);
+    std::iota(childrenOut, childrenOut + numOffspring, 0);
+    
+    if (!onlyIfBetter)
+        return numWorst;
+    
+    // Best offspring against worst members, in step
+    std::sort(childrenOut, childrenOut + numOffspring, [offspringFitness](int a, int b)
+    {
+        return offspringFitness[a] > offspringFitness[b];
+    });
+    
+    int count = 0;
+    while (count < numWorst && offspringFitness[childrenOut[count]] > population.getFitness(membersOut[count]))
+        ++count;
+    
+    return count;
+}
+
+int CrowdingReplacement::operator()(const Population& population, const float* offspringGenomes, const float* offspringFitness,
+                                    int numOffspring, RandomStream& rng, int* membersOut, int* childrenOut) const
+{
+    const int popSize = population.size();
+    const int parameterCount = population.getParameterCount();
+    int count = 0;
+    
+    auto claimed = [&](int member)
+    {
+        return std::find(membersOut, membersOut + count, member) != membersOut + count;
+    };
+    
+    for (int child = 0; child < numOffspring; ++child)
+    {
+        const float* genome = offspringGenomes + static_cast<size_t>(child) * parameterCount;
+        int nearest = -1;
+        float nearestDistance = 0.0f;
+        
+        for (int i = 0; i < crowdingSize; ++i)
+        {
+            // Redraw members already taken this plan (a few tries; they're a minority)
+            int member = rng.nextInt(popSize);
+            for (int retry = 0; retry < 8 && claimed(member); ++retry)
+                member = rng.nextInt(popSize);
+            
+            if (claimed(member))
+                continue;
+            
+            const float* other = population.getGenome(member);
+            float distance = 0.0f;
+            for (int p = 0; p < parameterCount; ++p)
+                distance += (genome[p] - other[p]) * (genome[p] - other[p]);
+            
+            if (nearest < 0 || distance < nearestDistance)
+            {
+                nearest = member;
+                nearestDistance = distance;
+            }
+        }
+        
+        if (nearest >= 0 && (!population.isEvaluated(nearest) || offspringFitness[child] > population.getFitness(nearest)))
+        {
+            membersOut[count] = nearest;
+            childrenOut[count] = child;
+            ++count;
+        }
+    }
+    
+    return count;
+}
@@ -6,12 +6,18 @@
 
     Selection operator functors for genetic algorithm.
     Used for both parent and survivor selection.
+    Parent selectors draw a whole generation's parent indices in one pass
+    over the population's contiguous fitness array. Survivor selectors
+    (replacement) write a plan of which population slot each offspring
+    takes, for the GA to apply.
   ==============================================================================
 */
 
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include "RandomStream.h"
+#include <vector>
 
 // Forward declarations
 class Population;
@@ -25,6 +31,86 @@ struct TournamentSelection
 {
     int tournamentSize = 3;
     
-    int operator()(const Population& population, juce::Random& rng) const;
+    int operator()(const Population& population, RandomStream& rng) const;
+    
+    // count tournaments, one winner each, into indicesOut
+    void operator()(const Population& population, RandomStream& rng, int* indicesOut, int count) const;
+};
+
+//==============================================================================
+/**
+    Linear rank selection.
+    The member of rank r (0 = worst) is drawn with probability
+    (2 - s + 2 (s - 1) r / (N - 1)) / N for selection pressure s in [1, 2],
+    so the best is drawn s times as often as the average member. Draws come
+    from a Walker alias table over ranks, which depends only on N and s and
+    so is only rebuilt when either changes; prepare() ranks the population.
+*/
+class RankSelection
+{
+public:
+    float selectionPressure = 1.5f;
+    
+    // Call once per generation, before drawing
+    void prepare(const Population& population);
+    
+    void operator()(RandomStream& rng, int* indicesOut, int count) const;
+    
+private:
+    std::vector<int> byRank;  // Population indices, worst first (ties by index)
+    
+    std::vector<float> aliasProbability;
+    std::vector<int> alias;
+    float tablePressure = 0.0f;
+    
+    void buildAliasTable(int size);
+};
+
+//==============================================================================
+/**
+    Stochastic universal sampling.
+    Fitness-proportional selection with count equally spaced pointers and a
+    single random offset, so each member is drawn within one of its expected
+    count. Fitness is shifted so the worst member keeps a small share (and
+    equal fitness gives uniform draws); the draws are then shuffled so
+    consecutive pairs aren't biased towards neighbouring members.
+*/
+struct StochasticUniversalSampling
+{
+    void operator()(const Population& population, RandomStream& rng, int* indicesOut, int count) const;
+};
+
+//==============================================================================
+/**
+    Worst-N replacement.
+    Offspring i takes the i-th worst evaluated member. With onlyIfBetter
+    (elitist steady state) the best offspring are matched against the worst
+    members in step and replacement stops at the first offspring that isn't
+    fitter, so the population keeps the best of both groups.
+    Writes up to numOffspring pairs; returns how many.
+*/
+struct WorstReplacement
+{
+    bool onlyIfBetter = false;
+    
+    int operator()(const Population& population, const float* offspringFitness, int numOffspring,
+                   int* membersOut, int* childrenOut) const;
+};
+
+//==============================================================================
+/**
+    Crowding replacement (restricted tournament).
+    Each offspring is compared with crowdingSize randomly drawn members and
+    takes the slot of the one nearest it in genome space, if it is fitter.
+    Similar presets compete with each other, so distinct niches survive.
+    Members are drawn at most once per plan. Offspring genomes are rows of
+    the population's parameter count.
+*/
+struct CrowdingReplacement
+{
+    int crowdingSize = 3;
+    
+    int operator()(const Population& population, const float* offspringGenomes, const float* offspringFitness,
+                   int numOffspring, RandomStream& rng, int* membersOut, int* childrenOut) const;
 };
 
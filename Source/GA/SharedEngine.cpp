@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+    SharedEngine.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "SharedEngine.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+namespace SharedEngine
+{
+    struct Profile
+    {
+        juce::String key;  // Full path of the profile directory
+        std::unique_ptr<MLPPreferenceModel> model;
+        int numHandles = 0;  // Guarded by the registry mutex
+
+        // Each handle's latest audio load; a negative entry is free
+        std::mutex loadMutex;
+        std::vector<float> audioLoads;
+
+        // Call with loadMutex held
+        void publishAudioLoad()
+        {
+            float highest = 0.0f;
+            for (float load : audioLoads)
+                highest = std::max(highest, load);
+            model->setAudioLoad(highest);
+        }
+    };
+
+    namespace
+    {
+        struct Registry
+        {
+            std::mutex mutex;
+            std::map<juce::String, std::shared_ptr<Profile>> profiles;
+            std::weak_ptr<WorkerPool> workerPool;
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+    }
+
+    ModelHandle::ModelHandle(std::shared_ptr<Profile> sharedProfile, int loadSlot)
+        : profile(std::move(sharedProfile)), slot(loadSlot)
+    {
+    }
+
+    ModelHandle::~ModelHandle()
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        {
+            std::lock_guard<std::mutex> loadLock(profile->loadMutex);
+            profile->audioLoads[static_cast<size_t>(slot)] = -1.0f;
+            profile->publishAudioLoad();
+        }
+
+        // The last handle destroys the model here, under the registry lock,
+        // so its final save is done before the directory can be acquired again
+        if (--profile->numHandles == 0)
+            registry.profiles.erase(profile->key);
+        profile.reset();
+    }
+
+    MLPPreferenceModel& ModelHandle::getModel() const
+    {
+        return *profile->model;
+    }
+
+    void ModelHandle::setInputMode(InputMode mode)
+    {
+        // Scores cached in the other mode are stale for this instance only
+        if (inputMode.exchange(mode) != mode)
+            ++modeChanges;
+    }
+
+    void ModelHandle::setConfigFlags(const juce::String& flags)
+    {
+        std::lock_guard<std::mutex> lock(configFlagsMutex);
+        configFlags = flags;
+    }
+
+    juce::String ModelHandle::getConfigFlags() const
+    {
+        std::lock_guard<std::mutex> lock(configFlagsMutex);
+        return configFlags;
+    }
+
+    float ModelHandle::evaluate(const std::vector<float>& genome)
+    {
+        return profile->model->evaluate(genome, getInputMode());
+    }
+
+    void ModelHandle::evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut)
+    {
+        profile->model->evaluateBatch(genomes, numGenomes, genomeSize, fitnessOut, getInputMode());
+    }
+
+    bool ModelHandle::estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut)
+    {
+        return profile->model->estimateBatch(genomes, numGenomes, genomeSize, estimatesOut, getInputMode());
+    }
+
+    bool ModelHandle::surrogateBatch(const float* genomes, int numGenomes, int genomeSize, float* scoresOut)
+    {
+        return profile->model->surrogateBatch(genomes, numGenomes, genomeSize, scoresOut);
+    }
+
+    bool ModelHandle::evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                                          float* meanOut, float* varianceOut)
+    {
+        return profile->model->evaluateUncertainty(genomes, numGenomes, genomeSize, meanOut, varianceOut, getInputMode());
+    }
+
+    void ModelHandle::sendFeedback(const std::vector<float>& genome, const Feedback& feedback)
+    {
+        profile->model->sendFeedback(genome, feedback, getInputMode(), getConfigFlags());
+    }
+
+    uint64_t ModelHandle::getModelVersion() const
+    {
+        const uint64_t version = profile->model->getModelVersion();
+        return version > 0 ? version + modeChanges.load() : 0;
+    }
+
+    void ModelHandle::prepareForConcurrency(int numThreads)
+    {
+        profile->model->prepareForConcurrency(numThreads);
+    }
+
+    void ModelHandle::prefetch(const float* genomes, int numGenomes, int genomeSize)
+    {
+        profile->model->prefetch(genomes, numGenomes, genomeSize);
+    }
+
+    void ModelHandle::setAudioLoad(float load)
+    {
+        std::lock_guard<std::mutex> lock(profile->loadMutex);
+        profile->audioLoads[static_cast<size_t>(slot)] = std::max(0.0f, load);
+        profile->publishAudioLoad();
+    }
+
+    int ModelHandle::getNumSharing() const
+    {
+        std::lock_guard<std::mutex> lock(getRegistry().mutex);
+        return profile->numHandles;
+    }
+
+    std::unique_ptr<ModelHandle> acquireModel(const std::vector<juce::String>& parameterNames,
+                                              const juce::File& profileDirectory)
+    {
+        const auto directory = profileDirectory.isDirectory() ? profileDirectory
+                                                              : MLPPreferenceModel::getDefaultBaseDirectory();
+
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto& profile = registry.profiles[directory.getFullPathName()];
+        if (profile == nullptr)
+        {
+            profile = std::make_shared<Profile>();
+            profile->key = directory.getFullPathName();
+            profile->model = std::make_unique<MLPPreferenceModel>(parameterNames, directory);
+        }
+
+        ++profile->numHandles;
+
+        std::lock_guard<std::mutex> loadLock(profile->loadMutex);
+        auto& loads = profile->audioLoads;
+        auto freeSlot = std::find_if(loads.begin(), loads.end(), [](float load) { return load < 0.0f; });
+        if (freeSlot == loads.end())
+            freeSlot = loads.insert(loads.end(), 0.0f);
+        *freeSlot = 0.0f;
+
+        const int slot = static_cast<int>(freeSlot - loads.begin());
+        return std::unique_ptr<ModelHandle>(new ModelHandle(profile, slot));
+    }
+
+    std::shared_ptr<WorkerPool> getWorkerPool()
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto pool = registry.workerPool.lock();
+        if (pool == nullptr)
+        {
+            pool = std::make_shared<WorkerPool>(0, juce::Thread::Priority::normal);
+            registry.workerPool = pool;
+        }
+
+        return pool;
+    }
+
+    int getNumProfiles()
+    {
+        std::lock_guard<std::mutex> lock(getRegistry().mutex);
+        return static_cast<int>(getRegistry().profiles.size());
+    }
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+    SharedEngine.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    What every plugin instance in a process shares. The instances evaluate
+    on one WorkerPool, and each user profile directory has one
+    MLPPreferenceModel, with its training thread, feature cache and files,
+    so instances never duplicate it or race on its weights and logs. Both
+    are reference counted: they are made for the first instance that asks
+    and go with the last one. Each instance keeps its own GeneticAlgorithm,
+    population and candidate queue on top, evaluating through its handle,
+    which scores and logs in that instance's input mode and config flags.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "MLPPreferenceModel.h"
+#include "WorkerPool.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SharedEngine
+{
+    struct Profile;
+
+    // One instance's hold on a profile's model; the model goes with the last handle
+    class ModelHandle : public IFitnessModel
+    {
+    public:
+        using InputMode = MLPPreferenceModel::InputMode;
+
+        ~ModelHandle() override;
+
+        // Settings made on it apply to every instance sharing the profile
+        MLPPreferenceModel& getModel() const;
+
+        // This instance's, passed with every call it makes on the model; any thread
+        void setInputMode(InputMode mode);
+        InputMode getInputMode() const { return inputMode.load(); }
+        void setConfigFlags(const juce::String& flags);
+        juce::String getConfigFlags() const;
+
+        float evaluate(const std::vector<float>& genome) override;
+        void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut) override;
+        bool estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut) override;
+        bool surrogateBatch(const float* genomes, int numGenomes, int genomeSize, float* scoresOut) override;
+        bool evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                                 float* meanOut, float* varianceOut) override;
+        void sendFeedback(const std::vector<float>& genome, const Feedback& feedback) override;
+
+        // The model's version, also moved by this handle's mode changes
+        uint64_t getModelVersion() const override;
+        void prepareForConcurrency(int numThreads) override;
+        void prefetch(const float* genomes, int numGenomes, int genomeSize) override;
+
+        // This instance's audio deadline load; training yields to the highest reported
+        void setAudioLoad(float load);
+
+        // Instances holding the profile, this one included
+        int getNumSharing() const;
+
+    private:
+        friend std::unique_ptr<ModelHandle> acquireModel(const std::vector<juce::String>&, const juce::File&);
+        ModelHandle(std::shared_ptr<Profile> profile, int slot);
+
+        std::shared_ptr<Profile> profile;
+        const int slot;  // This handle's audio load entry
+
+        std::atomic<InputMode> inputMode { InputMode::Genome };
+        std::atomic<uint64_t> modeChanges { 0 };
+        mutable std::mutex configFlagsMutex;
+        juce::String configFlags = "baseline";
+
+        JUCE_DECLARE_NON_COPYABLE(ModelHandle)
+    };
+
+    /**
+     * The model for profileDirectory (MLPPreferenceModel's default directory
+     * if it isn't one), made with parameterNames if nothing holds it yet.
+     * Releasing the last handle stops the model's training and saves it
+     * before another acquire for the same directory can build a new one.
+     */
+    std::unique_ptr<ModelHandle> acquireModel(const std::vector<juce::String>& parameterNames,
+                                              const juce::File& profileDirectory = {});
+
+    // The evaluation pool, one slot per core; for GeneticAlgorithm::setEvaluationPool
+    std::shared_ptr<WorkerPool> getWorkerPool();
+
+    // Profiles with a live model
+    int getNumProfiles();
+}
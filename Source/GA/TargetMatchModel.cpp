@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+    TargetMatchModel.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "TargetMatchModel.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Per-feature distance weights, 1 / scale^2. The scales are the original
+    // target matcher's (MFCCs 15, centroid 5000 Hz, attack 0.5 s, RMS 1), in
+    // units of AudioFeatureCache's normalization ranges
+    constexpr float inverseSquare(float scale) { return 1.0f / (scale * scale); }
+
+    constexpr float mfccMeanWeight = inverseSquare(15.0f / 100.0f);
+    constexpr float mfccStdWeight = inverseSquare(15.0f / 50.0f);
+    constexpr float centroidWeight = inverseSquare(5000.0f / 7900.0f);
+    constexpr float attackWeight = inverseSquare(0.5f / 0.5f);
+    constexpr float rmsWeight = inverseSquare(1.0f / 0.3f);
+
+    constexpr std::array<float, TargetMatchModel::FEATURE_COUNT> featureWeights
+    {
+        mfccMeanWeight, mfccMeanWeight, mfccMeanWeight, mfccMeanWeight, mfccMeanWeight,
+        mfccMeanWeight, mfccMeanWeight, mfccMeanWeight, mfccMeanWeight, mfccMeanWeight,
+        mfccStdWeight, mfccStdWeight, mfccStdWeight, mfccStdWeight, mfccStdWeight,
+        mfccStdWeight, mfccStdWeight, mfccStdWeight, mfccStdWeight, mfccStdWeight,
+        centroidWeight, centroidWeight,
+        attackWeight,
+        rmsWeight
+    };
+
+    float similarity(float squaredDistance)
+    {
+        return 1.0f / (1.0f + std::sqrt(squaredDistance));
+    }
+}
+
+TargetMatchModel::TargetMatchModel(double sampleRate, AudioFeatureCache::RenderProfile profile)
+    : featureCache(sampleRate, profile)
+{
+}
+
+TargetMatchModel::LoadResult TargetMatchModel::loadTarget(const juce::File& file)
+{
+    LoadResult result;
+
+    if (!file.existsAsFile())
+    {
+        result.errorMessage = "File does not exist: " + file.getFullPathName();
+        return result;
+    }
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr)
+    {
+        result.errorMessage = "Could not read audio file. Unsupported format?";
+        return result;
+    }
+
+    return loadTarget(*reader);
+}
+
+TargetMatchModel::LoadResult TargetMatchModel::loadTarget(juce::AudioFormatReader& reader)
+{
+    PPG_TRACE_ZONE("Load target");
+    LoadResult result;
+
+    const double sourceRate = reader.sampleRate;
+    const int numChannels = static_cast<int>(reader.numChannels);
+    const juce::int64 sourceLength = reader.lengthInSamples;
+
+    if (sourceLength <= 0)
+    {
+        result.errorMessage = "Audio file is empty (0 samples)";
+        return result;
+    }
+
+    if (sourceRate <= 0.0)
+    {
+        result.errorMessage = "Invalid sample rate: " + juce::String(sourceRate);
+        return result;
+    }
+
+    if (numChannels <= 0)
+    {
+        result.errorMessage = "Invalid number of channels: " + juce::String(numChannels);
+        return result;
+    }
+
+    // Analysed exactly as a candidate's phrase is, and for no longer
+    const auto profile = featureCache.getRenderProfile();
+    const double renderRate = featureCache.getRenderSampleRate();
+    const int maxSamples = static_cast<int>(renderRate * profile.durationMs / 1000.0);
+
+    FeatureExtractor extractor(renderRate, profile.fftSize, profile.hopSize);
+    extractor.beginStream();
+
+    // 1 Hz tolerance avoids resampling for rounding differences
+    const bool resample = std::abs(sourceRate - renderRate) > 1.0;
+    const double speedRatio = sourceRate / renderRate;  // Source samples per output sample
+    juce::LagrangeInterpolator interpolator;
+    std::vector<float> pending;    // Mono source samples the interpolator hasn't consumed
+    std::vector<float> resampled;
+
+    juce::AudioBuffer<float> block(numChannels, readBlockSize);
+    juce::int64 position = 0;
+    int analysed = 0;
+
+    while (position < sourceLength && analysed < maxSamples)
+    {
+        const int numRead = static_cast<int>(std::min<juce::int64>(readBlockSize, sourceLength - position));
+        reader.read(block.getArrayOfWritePointers(), numChannels, position, numRead);
+        position += numRead;
+
+        // Mix down to mono in channel 0
+        float* mono = block.getWritePointer(0);
+        for (int channel = 1; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::add(mono, block.getReadPointer(channel), numRead);
+        if (numChannels > 1)
+            juce::FloatVectorOperations::multiply(mono, 1.0f / static_cast<float>(numChannels), numRead);
+
+        if (!resample)
+        {
+            const int numPushed = std::min(numRead, maxSamples - analysed);
+            extractor.pushSamples(mono, numPushed);
+            analysed += numPushed;
+            continue;
+        }
+
+        // Only produce output the input read so far covers (leaving the
+        // interpolator a sample of slack), except once the input is done
+        pending.insert(pending.end(), mono, mono + numRead);
+        const double usable = position < sourceLength ? static_cast<double>(pending.size()) - 2.0
+                                                      : static_cast<double>(pending.size());
+        const int numOut = std::min(static_cast<int>(std::max(0.0, usable / speedRatio)), maxSamples - analysed);
+        if (numOut <= 0)
+            continue;
+
+        resampled.resize(std::max(resampled.size(), static_cast<size_t>(numOut)));
+        const int consumed = interpolator.process(speedRatio, pending.data(), resampled.data(), numOut,
+                                                  static_cast<int>(pending.size()), 0);
+        pending.erase(pending.begin(), pending.begin() + std::min(static_cast<size_t>(consumed), pending.size()));
+
+        extractor.pushSamples(resampled.data(), numOut);
+        analysed += numOut;
+    }
+
+    if (analysed == 0)
+    {
+        result.errorMessage = "Audio file is too short to analyse";
+        return result;
+    }
+
+    setTargetFeatures(extractor.finishStream());
+    result.success = true;
+    return result;
+}
+
+void TargetMatchModel::setTargetFeatures(const FeatureVector& features)
+{
+    std::array<float, FEATURE_COUNT> row;
+    AudioFeatureCache::flattenFeatures(features, row.data());
+
+    std::lock_guard<std::mutex> lock(targetMutex);
+    targetFeatures = features;
+    targetRow = row;
+    targetLoaded = true;
+    ++targetVersion;
+}
+
+FeatureVector TargetMatchModel::getTargetFeatures() const
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    return targetFeatures;
+}
+
+bool TargetMatchModel::hasTarget() const
+{
+    std::lock_guard<std::mutex> lock(targetMutex);
+    return targetLoaded;
+}
+
+void TargetMatchModel::scoreFeatures(const float* features, int numRows, float* fitnessOut) const
+{
+    std::array<float, FEATURE_COUNT> target;
+    {
+        std::lock_guard<std::mutex> lock(targetMutex);
+        if (!targetLoaded)
+        {
+            std::fill(fitnessOut, fitnessOut + numRows, 0.0f);
+            return;
+        }
+        target = targetRow;
+    }
+
+    // Lanes accumulate independently over the same feature order, so the
+    // inner loop vectorises; a short last block is padded out with copies of
+    // the target, so every row takes the same path and sums as it would alone
+    std::array<float, MAX_LANES * FEATURE_COUNT> padded;
+
+    for (int row = 0; row < numRows; row += MAX_LANES)
+    {
+        const int width = std::min(MAX_LANES, numRows - row);
+        const float* block = features + static_cast<size_t>(row) * FEATURE_COUNT;
+
+        if (width < MAX_LANES)
+        {
+            std::copy(block, block + width * FEATURE_COUNT, padded.begin());
+            for (int lane = width; lane < MAX_LANES; ++lane)
+                std::copy(target.begin(), target.end(), padded.begin() + lane * FEATURE_COUNT);
+            block = padded.data();
+        }
+
+        std::array<float, MAX_LANES> sums {};
+
+        for (int feature = 0; feature < FEATURE_COUNT; ++feature)
+        {
+            const float targetValue = target[static_cast<size_t>(feature)];
+            const float weight = featureWeights[static_cast<size_t>(feature)];
+
+            for (int lane = 0; lane < MAX_LANES; ++lane)
+            {
+                const float difference = block[lane * FEATURE_COUNT + feature] - targetValue;
+                sums[static_cast<size_t>(lane)] += difference * difference * weight;
+            }
+        }
+
+        for (int lane = 0; lane < width; ++lane)
+            fitnessOut[row + lane] = similarity(sums[static_cast<size_t>(lane)]);
+    }
+}
+
+float TargetMatchModel::evaluate(const std::vector<float>& genome)
+{
+    const auto features = featureCache.getFeatures(genome);
+
+    float fitness = 0.0f;
+    scoreFeatures(features.data(), 1, &fitness);
+    return fitness;
+}
+
+void TargetMatchModel::evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut)
+{
+    if (numGenomes <= 0)
+        return;
+
+    std::vector<float> features(static_cast<size_t>(numGenomes) * FEATURE_COUNT);
+    featureCache.getFeaturesBatch(genomes, numGenomes, genomeSize, features.data());
+    scoreFeatures(features.data(), numGenomes, fitnessOut);
+}
+
+void TargetMatchModel::prepareForConcurrency(int numThreads)
+{
+    featureCache.reserveContexts(numThreads);
+}
+
+void TargetMatchModel::prefetch(const float* genomes, int numGenomes, int genomeSize)
+{
+    featureCache.prefetch(genomes, numGenomes, genomeSize);
+}
+
+void TargetMatchModel::sendFeedback(const std::vector<float>& genome, const Feedback& feedback)
+{
+    (void)genome; (void)feedback;
+}
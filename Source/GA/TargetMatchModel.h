@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+    TargetMatchModel.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Fitness for sound matching: how close a genome's audio features come
+    to those of a target recording. The target is decoded once in blocks,
+    mixed to mono, resampled to the feature cache's render rate as it is
+    read and streamed into the same FeatureExtractor analysis candidates
+    get, so only its FeatureVector is kept. Candidates are rendered and
+    analysed through an AudioFeatureCache and scored against it by a
+    weighted Euclidean distance, several rows at a time.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "IFitnessModel.h"
+#include "AudioFeatureCache.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+class TargetMatchModel : public IFitnessModel
+{
+public:
+    static constexpr int FEATURE_COUNT = AudioFeatureCache::AUDIO_FEATURE_COUNT;
+    static constexpr int MAX_LANES = 8;  // Rows scoreFeatures() scores together
+
+    struct LoadResult
+    {
+        bool success = false;
+        juce::String errorMessage;
+    };
+
+    explicit TargetMatchModel(double sampleRate = 44100.0,
+                              AudioFeatureCache::RenderProfile profile = AudioFeatureCache::RenderProfile::fitness());
+
+    /**
+     * Decodes and analyses a target file. Only as much is read as a
+     * candidate's phrase lasts; until a target loads, everything scores 0.
+     */
+    LoadResult loadTarget(const juce::File& file);
+    LoadResult loadTarget(juce::AudioFormatReader& reader);
+
+    // Targets analysed elsewhere, e.g. one decode shared by several models
+    void setTargetFeatures(const FeatureVector& features);
+    FeatureVector getTargetFeatures() const;
+    bool hasTarget() const;
+
+    /**
+     * Similarity of numRows rows of normalized features (AudioFeatureCache
+     * layout) to the target: 1 / (1 + weighted distance), so 1 is a perfect
+     * match. Rows are scored MAX_LANES at a time; every row's score is the
+     * same as when scored alone, so evaluate() and evaluateBatch() agree.
+     */
+    void scoreFeatures(const float* features, int numRows, float* fitnessOut) const;
+
+    float evaluate(const std::vector<float>& genome) override;
+    void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut) override;
+    void prepareForConcurrency(int numThreads) override;
+    void prefetch(const float* genomes, int numGenomes, int genomeSize) override;
+
+    // Nothing to learn: the target is the whole objective
+    void sendFeedback(const std::vector<float>& genome, const Feedback& feedback) override;
+    
+    // Counts target changes
+    uint64_t getModelVersion() const override { return targetVersion.load(); }
+
+    AudioFeatureCache& getFeatureCache() { return featureCache; }
+
+private:
+    AudioFeatureCache featureCache;
+
+    mutable std::mutex targetMutex;
+    FeatureVector targetFeatures;
+    std::array<float, FEATURE_COUNT> targetRow {};  // targetFeatures, normalized
+    bool targetLoaded = false;
+    std::atomic<uint64_t> targetVersion { 0 };
+
+    static constexpr int readBlockSize = 8192;  // Source frames decoded per read
+};
@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+    Trace.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "Trace.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+    struct Event
+    {
+        const char* name = nullptr;
+        juce::int64 startTicks = 0;
+        union
+        {
+            juce::int64 endTicks;  // Zone
+            double value;          // Counter
+        };
+        bool isCounter = false;
+    };
+
+    // One writer (the thread that claimed it); read only once recording has stopped
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]> events;
+        std::atomic<uint64_t> written { 0 };  // Events ever written; the ring keeps the newest
+        char threadName[32] {};
+    };
+
+    struct Recorder
+    {
+        std::mutex controlMutex;  // start/stop/export only, never the event path
+        std::atomic<bool> recording { false };
+        std::atomic<uint32_t> session { 0 };
+        std::atomic<int> claimedBuffers { 0 };
+        std::unique_ptr<ThreadBuffer[]> buffers;  // Allocated by the first start()
+        juce::int64 startTicks = 0;
+        juce::File environmentFile;
+    };
+
+    Recorder& getRecorder()
+    {
+        static Recorder recorder;
+        return recorder;
+    }
+
+    struct ThreadState
+    {
+        uint32_t session = 0;
+        ThreadBuffer* buffer = nullptr;
+        const char* name = nullptr;
+    };
+
+    thread_local ThreadState threadState;
+
+    void copyName(char* destination, const char* name)
+    {
+        std::strncpy(destination, name, sizeof(ThreadBuffer::threadName) - 1);
+        destination[sizeof(ThreadBuffer::threadName) - 1] = '\0';
+    }
+
+    // The calling thread's buffer for this recording, claimed on its first event; nullptr once all are taken
+    ThreadBuffer* getThreadBuffer()
+    {
+        auto& recorder = getRecorder();
+        const uint32_t session = recorder.session.load(std::memory_order_acquire);
+
+        if (threadState.session != session)
+        {
+            threadState.session = session;
+            const int slot = recorder.claimedBuffers.fetch_add(1, std::memory_order_relaxed);
+            threadState.buffer = slot < Trace::maxThreads ? &recorder.buffers[static_cast<size_t>(slot)] : nullptr;
+
+            if (threadState.buffer != nullptr)
+            {
+                if (threadState.name != nullptr)
+                    copyName(threadState.buffer->threadName, threadState.name);
+                else if (auto* thread = juce::Thread::getCurrentThread())
+                    copyName(threadState.buffer->threadName, thread->getThreadName().toRawUTF8());
+            }
+        }
+
+        return threadState.buffer;
+    }
+
+    void append(const Event& event)
+    {
+        if (auto* buffer = getThreadBuffer())
+        {
+            const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+            buffer->events[static_cast<size_t>(index % Trace::eventsPerThread)] = event;
+            buffer->written.store(index + 1, std::memory_order_release);
+        }
+    }
+
+    juce::String escape(const char* text)
+    {
+        return juce::String(text).replace("\\", "\\\\").replace("\"", "\\\"");
+    }
+}
+
+namespace Trace
+{
+    void start()
+    {
+        auto& recorder = getRecorder();
+        std::lock_guard<std::mutex> lock(recorder.controlMutex);
+
+        if (recorder.buffers == nullptr)
+        {
+            recorder.buffers = std::make_unique<ThreadBuffer[]>(static_cast<size_t>(maxThreads));
+            for (int i = 0; i < maxThreads; ++i)
+                recorder.buffers[static_cast<size_t>(i)].events = std::make_unique<Event[]>(static_cast<size_t>(eventsPerThread));
+        }
+
+        recorder.recording.store(false);
+
+        for (int i = 0; i < maxThreads; ++i)
+        {
+            auto& buffer = recorder.buffers[static_cast<size_t>(i)];
+            buffer.written.store(0);
+            buffer.threadName[0] = '\0';
+        }
+
+        // Threads reclaim a buffer when they see the new session
+        recorder.claimedBuffers.store(0);
+        recorder.startTicks = juce::Time::getHighResolutionTicks();
+        recorder.session.fetch_add(1, std::memory_order_release);
+        recorder.recording.store(true, std::memory_order_release);
+    }
+
+    void stop()
+    {
+        getRecorder().recording.store(false);
+    }
+
+    bool isRecording()
+    {
+        return getRecorder().recording.load(std::memory_order_acquire);
+    }
+
+    void setThreadName(const char* name)
+    {
+        // Cheap enough to call per block: a buffer claimed later picks the name up itself
+        if (threadState.name == name)
+            return;
+
+        threadState.name = name;
+
+        if (isRecording())
+            if (auto* buffer = getThreadBuffer())
+                copyName(buffer->threadName, name);
+    }
+
+    void recordZone(const char* name, juce::int64 startTicks, juce::int64 endTicks)
+    {
+        if (!isRecording())
+            return;
+
+        Event event;
+        event.name = name;
+        event.startTicks = startTicks;
+        event.endTicks = endTicks;
+        append(event);
+    }
+
+    void recordCounter(const char* name, double value)
+    {
+        if (!isRecording())
+            return;
+
+        Event event;
+        event.name = name;
+        event.startTicks = juce::Time::getHighResolutionTicks();
+        event.value = value;
+        event.isCounter = true;
+        append(event);
+    }
+
+    bool exportChromeTrace(const juce::File& file)
+    {
+        auto& recorder = getRecorder();
+        std::lock_guard<std::mutex> lock(recorder.controlMutex);
+
+        // An event in flight when recording stopped may still land; it is read as it stands
+        jassert(!recorder.recording.load());
+
+        juce::FileOutputStream stream(file);
+        if (!stream.openedOk())
+            return false;
+
+        stream.setPosition(0);
+        stream.truncate();
+
+        const double ticksPerMicrosecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+        auto toMicroseconds = [&](juce::int64 ticks)
+        {
+            return juce::String(static_cast<double>(ticks - recorder.startTicks) / ticksPerMicrosecond, 3);
+        };
+
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&first]() -> const char* { const char* text = first ? "" : ",\n"; first = false; return text; };
+
+        const int numBuffers = recorder.buffers == nullptr ? 0 : juce::jmin(recorder.claimedBuffers.load(), maxThreads);
+
+        for (int tid = 0; tid < numBuffers; ++tid)
+        {
+            const auto& buffer = recorder.buffers[static_cast<size_t>(tid)];
+            const uint64_t written = buffer.written.load(std::memory_order_acquire);
+            const uint64_t oldest = written > static_cast<uint64_t>(eventsPerThread) ? written - eventsPerThread : 0;
+
+            const juce::String threadName = buffer.threadName[0] != '\0' ? escape(buffer.threadName)
+                                                                         : "Thread " + juce::String(tid);
+            stream << separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << tid
+                   << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+
+            for (uint64_t i = oldest; i < written; ++i)
+            {
+                const auto& event = buffer.events[static_cast<size_t>(i % eventsPerThread)];
+
+                if (event.isCounter)
+                {
+                    stream << separator() << "{\"ph\":\"C\",\"name\":\"" << escape(event.name) << "\",\"pid\":1,\"tid\":" << tid
+                           << ",\"ts\":" << toMicroseconds(event.startTicks)
+                           << ",\"args\":{\"value\":" << juce::String(event.value, 6) << "}}";
+                }
+                else
+                {
+                    const double duration = static_cast<double>(event.endTicks - event.startTicks) / ticksPerMicrosecond;
+                    stream << separator() << "{\"ph\":\"X\",\"name\":\"" << escape(event.name) << "\",\"pid\":1,\"tid\":" << tid
+                           << ",\"ts\":" << toMicroseconds(event.startTicks)
+                           << ",\"dur\":" << juce::String(duration, 3) << "}";
+                }
+            }
+        }
+
+        stream << "\n]}\n";
+        stream.flush();
+        return stream.getStatus().wasOk();
+    }
+
+    void startFromEnvironment()
+    {
+        const juce::String value = juce::SystemStats::getEnvironmentVariable("PPG_TRACE", {});
+        if (value.isEmpty())
+            return;
+
+        {
+            auto& recorder = getRecorder();
+            std::lock_guard<std::mutex> lock(recorder.controlMutex);
+            recorder.environmentFile = value == "1" ? juce::File()
+                                                    : juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        }
+
+        start();
+    }
+
+    juce::File stopAndExport(const juce::File& file)
+    {
+        stop();
+
+        juce::File target = file;
+        if (target == juce::File())
+        {
+            auto& recorder = getRecorder();
+            std::lock_guard<std::mutex> lock(recorder.controlMutex);
+            target = recorder.environmentFile;
+        }
+
+        if (target == juce::File())
+            target = getDefaultFile();
+
+        target.getParentDirectory().createDirectory();
+        return exportChromeTrace(target) ? target : juce::File();
+    }
+
+    juce::File getDefaultFile()
+    {
+        return juce::File::getSpecialLocation(juce::File::userHomeDirectory)
+                   .getChildFile("Library/Application Support/PresetPreferenceGenerator/Traces")
+                   .getChildFile("trace_" + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S") + ".json");
+    }
+}
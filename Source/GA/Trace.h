@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+    Trace.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Scoped hot-path tracing, exported as Chrome trace JSON (chrome://tracing
+    or ui.perfetto.dev). PPG_TRACE_ZONE("name") times the enclosing scope and
+    PPG_TRACE_COUNTER("name", value) records a value. Each thread writes to
+    its own preallocated ring buffer, claimed lock-free on its first event of
+    a recording, so neither ever locks or allocates and both are safe on the
+    audio thread. While not recording an event costs one atomic load. Names
+    must be string literals. Building with PPG_TRACING=0 compiles them out.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#ifndef PPG_TRACING
+ #define PPG_TRACING 1
+#endif
+
+namespace Trace
+{
+    static constexpr int maxThreads = 64;           // Threads that can record; later ones are dropped
+    static constexpr int eventsPerThread = 1 << 15; // Ring size; a thread keeps its newest events
+
+    // Clears the buffers and starts recording (allocates them on first use)
+    void start();
+
+    // Stops recording; the recorded events stay until the next start()
+    void stop();
+
+    bool isRecording();
+
+    /**
+     * Writes what the last recording captured as Chrome trace JSON. Call it
+     * after stop(). False if the file can't be written.
+     */
+    bool exportChromeTrace(const juce::File& file);
+
+    /**
+     * Starts recording if the PPG_TRACE environment variable is set. Its value
+     * is the file stopAndExport() writes to when no file is given; "1" picks
+     * getDefaultFile().
+     */
+    void startFromEnvironment();
+
+    // Stops and exports to file, or to the PPG_TRACE / default file; returns the file written or {}
+    juce::File stopAndExport(const juce::File& file = {});
+
+    juce::File getDefaultFile();
+
+    // Labels the calling thread in exported traces (threads without a juce::Thread name need it)
+    void setThreadName(const char* name);
+
+    void recordZone(const char* name, juce::int64 startTicks, juce::int64 endTicks);
+    void recordCounter(const char* name, double value);
+
+    // Zone from construction to destruction; does nothing unless recording when constructed
+    class ScopedZone
+    {
+    public:
+        explicit ScopedZone(const char* zoneName)
+            : name(zoneName), startTicks(isRecording() ? juce::Time::getHighResolutionTicks() : 0) {}
+
+        ~ScopedZone()
+        {
+            if (startTicks != 0)
+                recordZone(name, startTicks, juce::Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* const name;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedZone)
+    };
+}
+
+#if PPG_TRACING
+ #define PPG_TRACE_ZONE(name) const Trace::ScopedZone JUCE_JOIN_MACRO(traceZone_, __LINE__)(name)
+ #define PPG_TRACE_COUNTER(name, value) do { if (Trace::isRecording()) Trace::recordCounter(name, static_cast<double>(value)); } while (false)
+ #define PPG_TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+ #define PPG_TRACE_ZONE(name) ((void) 0)
+ #define PPG_TRACE_COUNTER(name, value) ((void) 0)
+ #define PPG_TRACE_THREAD_NAME(name) ((void) 0)
+#endif
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+    WorkerPool.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "WorkerPool.h"
+
+namespace
+{
+    // Set on pool worker threads so nested parallelFor calls run inline
+    thread_local bool isPoolWorkerThread = false;
+}
+
+WorkerPool::WorkerPool(int numSlots, juce::Thread::Priority priority, uint32_t affinityMask)
+{
+    if (numSlots < 1)
+        numSlots = juce::SystemStats::getNumCpus();
+
+    for (int slot = 1; slot < numSlots; ++slot)
+        workers.push_back(std::make_unique<Worker>(*this, slot));
+
+    for (auto& worker : workers)
+    {
+        if (affinityMask != 0)
+            worker->setAffinityMask(affinityMask);  // Applies from the next start
+
+        worker->startThread(priority);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->startEvent.signal();
+    }
+
+    for (auto& worker : workers)
+        worker->stopThread(2000);
+}
+
+void WorkerPool::run(int numTasks, void* context, InvokeFn invoke)
+{
+    if (numTasks <= 0)
+        return;
+
+    if (workers.empty() || numTasks == 1 || isPoolWorkerThread)
+    {
+        runInline(numTasks, context, invoke);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(dispatchMutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        // Another thread is using the pool; don't queue behind it
+        runInline(numTasks, context, invoke);
+        return;
+    }
+
+    taskContext = context;
+    taskInvoke = invoke;
+    taskCount = numTasks;
+    nextTaskIndex.store(0, std::memory_order_relaxed);
+    pendingWorkers.store(static_cast<int>(workers.size()), std::memory_order_release);
+
+    for (auto& worker : workers)
+        worker->startEvent.signal();
+
+    // Calling thread takes part as slot 0
+    drainTasks(0);
+
+    jobDone.wait();
+}
+
+void WorkerPool::drainTasks(int slot)
+{
+    for (;;)
+    {
+        int index = nextTaskIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= taskCount)
+            break;
+
+        taskInvoke(taskContext, index, slot);
+    }
+}
+
+void WorkerPool::runInline(int numTasks, void* context, InvokeFn invoke)
+{
+    for (int i = 0; i < numTasks; ++i)
+        invoke(context, i, 0);
+}
+
+//==============================================================================
+WorkerPool::Worker::Worker(WorkerPool& owner, int slotIndex)
+    : juce::Thread("GAWorker" + juce::String(slotIndex))
+    , pool(owner)
+    , slot(slotIndex)
+{
+}
+
+void WorkerPool::Worker::run()
+{
+    isPoolWorkerThread = true;
+
+    while (!threadShouldExit())
+    {
+        startEvent.wait();
+
+        if (threadShouldExit())
+            break;
+
+        pool.drainTasks(slot);
+
+        if (pool.pendingWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            pool.jobDone.signal();
+    }
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+    WorkerPool.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Fixed-size pool of worker threads for data-parallel GA work.
+    The calling thread participates as slot 0, so a pool of N slots
+    owns N - 1 background threads and a single-slot pool runs inline.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+class WorkerPool
+{
+public:
+    /**
+     * @param numSlots Total concurrency including the calling thread.
+     *                 Values < 1 select one slot per CPU core.
+     * @param affinityMask Cores the background threads may run on (bit i =
+     *                 core i); 0 leaves them to the scheduler.
+     */
+    explicit WorkerPool(int numSlots = 0,
+                        juce::Thread::Priority priority = juce::Thread::Priority::normal,
+                        uint32_t affinityMask = 0);
+    ~WorkerPool();
+
+    int getNumSlots() const { return static_cast<int>(workers.size()) + 1; }
+
+    /**
+     * Runs task(index, slot) for every index in [0, numTasks) and blocks until
+     * all have finished. slot is in [0, getNumSlots()) and identifies the thread
+     * running the task, so callers can keep per-slot scratch state.
+     * Runs inline when called from a worker or while another job is in flight.
+     */
+    template <typename Task>
+    void parallelFor(int numTasks, Task&& task)
+    {
+        using TaskType = std::remove_reference_t<Task>;
+        auto invoke = [](void* context, int index, int slot)
+        {
+            (*static_cast<TaskType*>(context))(index, slot);
+        };
+
+        run(numTasks, const_cast<void*>(static_cast<const void*>(std::addressof(task))), invoke);
+    }
+
+private:
+    using InvokeFn = void (*)(void*, int, int);
+
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(WorkerPool& owner, int slot);
+        void run() override;
+
+        juce::WaitableEvent startEvent;
+
+    private:
+        WorkerPool& pool;
+        const int slot;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Current job (written by the dispatching thread before workers are woken)
+    void* taskContext = nullptr;
+    InvokeFn taskInvoke = nullptr;
+    int taskCount = 0;
+    std::atomic<int> nextTaskIndex { 0 };
+    std::atomic<int> pendingWorkers { 0 };
+    juce::WaitableEvent jobDone;
+    std::mutex dispatchMutex;
+
+    void run(int numTasks, void* context, InvokeFn invoke);
+    void drainTasks(int slot);
+    static void runInline(int numTasks, void* context, InvokeFn invoke);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WorkerPool)
+};
@@ -79,6 +79,7 @@ public:
     }
 
 private:
+    template <int> friend class VoiceBank;  // Renders lanes of this state directly
     // Internal state: current target value and stage-specific multiplier
     float multiplier;
     float target;
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    FastMath.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Approximations for the per-LFO-step coefficient math (cutoff exp and the
+    SVF prewarp tan). Opt-in through Synth::fastMath; bounds are checked
+    against the std versions in FastMathTests.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace FastMath
+{
+    /**
+     * exp(x) by reduction to 2^n * exp(r), |r| <= ln2 / 2, with a degree-6
+     * polynomial for exp(r). Relative error below 1e-6 over [-80, 80].
+     */
+    inline float exp(float x)
+    {
+        x = std::clamp(x, -87.0f, 88.0f);
+        
+        const float n = std::floor(x * 1.44269504f + 0.5f);
+        
+        // Cody-Waite split of ln2 keeps r exact for large n
+        const float r = (x - n * 0.693145751953125f) - n * 1.42860677e-6f;
+        
+        float p = 1.0f / 720.0f;
+        p = p * r + 1.0f / 120.0f;
+        p = p * r + 1.0f / 24.0f;
+        p = p * r + 1.0f / 6.0f;
+        p = p * r + 0.5f;
+        p = p * r + 1.0f;
+        p = p * r + 1.0f;
+        
+        // 2^n assembled directly in the exponent bits
+        const int32_t bits = (static_cast<int32_t>(n) + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+    }
+    
+    /**
+     * tan(x) for the filter prewarp, x in [0, Filter::MAX_PREWARP]. JUCE's
+     * Pade approximant holds a relative error below 1e-6 there.
+     */
+    inline float tan(float x)
+    {
+        return juce::dsp::FastMathApproximations::tan(x);
+    }
+}
@@ -12,22 +12,30 @@
 
 #pragma once
 
+#include "FastMath.h"
+
 class Filter
 {
 public:
     float sampleRate;  // Sample rate used to compute filter coefficients
 
+    // Prewarp angle limit, just above 20 kHz at 44.1 kHz. Keeps tan below
+    // Nyquist when the synth renders at lower rates.
+    static constexpr float MAX_PREWARP = 1.43f;
+
     // Update filter coefficients based on cutoff frequency and Q factor
     void updateCoefficients(float cutoff, float Q)
     {
         // Convert normalized frequency (0–1) to bilinear transform variable
-        g = std::tan(PI * cutoff / sampleRate); // Pre-warped cutoff frequency
-        k = 1.0f / Q;                            // Inverse of quality factor
+        g = std::tan(prewarpAngle(cutoff)); // Pre-warped cutoff frequency
+        updateFromPrewarp(Q);
+    }
 
-        // Coefficient calculations for TPT-based state variable filter
-        a1 = 1.0f / (1.0f + g * (g + k));
-        a2 = g * a1;
-        a3 = g * a2;
+    // Same, with FastMath::tan for the prewarp
+    void updateCoefficientsFast(float cutoff, float Q)
+    {
+        g = FastMath::tan(prewarpAngle(cutoff));
+        updateFromPrewarp(Q);
     }
 
     // Reset internal state and coefficients
@@ -59,8 +67,24 @@ public:
     }
 
 private:
+    template <int> friend class VoiceBank;  // Renders lanes of this state directly
     const float PI = 3.1415926535897932f;
 
+    float prewarpAngle(float cutoff) const
+    {
+        return std::min(PI * cutoff / sampleRate, MAX_PREWARP);
+    }
+
+    void updateFromPrewarp(float Q)
+    {
+        k = 1.0f / Q;  // Inverse of quality factor
+
+        // Coefficient calculations for TPT-based state variable filter
+        a1 = 1.0f / (1.0f + g * (g + k));
+        a2 = g * a1;
+        a3 = g * a2;
+    }
+
     // Filter coefficients (computed from cutoff & Q)
     float g, k, a1, a2, a3;
 
@@ -8,6 +8,10 @@
     A simple pseudo-random number generator used to produce white noise.
     This is used in the JX11 synth for adding noise to oscillator output.
 
+    fill() produces a block of the same sequence as four interleaved LCG
+    streams, each jumping four steps at a time, so there's no serial
+    dependency between neighbouring samples and the lane loop vectorises.
+
   ==============================================================================
 */
 
@@ -27,7 +31,7 @@ public:
     float nextValue()
     {
         // Linear congruential generator step: update the seed
-        noiseSeed = noiseSeed * 196314165 + 907633515;
+        noiseSeed = noiseSeed * multiplier + increment;
 
         // Shift down and convert to signed int range
         // >> 7 reduces resolution slightly to ensure symmetric distribution
@@ -37,7 +41,50 @@ public:
         return float(temp) / 16777216.0f;
     }
 
+    // Writes the next count values, each times gain, into output; bit for
+    // bit what count calls to nextValue() * gain would produce
+    void fill(float* output, int count, float gain)
+    {
+        constexpr int lanes = 4;
+        int i = 0;
+
+        if (count >= lanes)
+        {
+            // Seeds of the next four samples, then four steps per lane per pass
+            unsigned int seeds[lanes];
+            for (int l = 0; l < lanes; ++l)
+            {
+                noiseSeed = noiseSeed * multiplier + increment;
+                seeds[l] = noiseSeed;
+            }
+
+            for (; i + lanes <= count; i += lanes)
+            {
+                // The last lane holds the state nextValue() would be left in
+                noiseSeed = seeds[lanes - 1];
+
+                for (int l = 0; l < lanes; ++l)
+                {
+                    int temp = int(seeds[l] >> 7) - 16777216;
+                    output[i + l] = float(temp) / 16777216.0f * gain;
+                    seeds[l] = seeds[l] * jumpMultiplier + jumpIncrement;
+                }
+            }
+        }
+
+        for (; i < count; ++i)
+            output[i] = nextValue() * gain;
+    }
+
 private:
+    static constexpr unsigned int multiplier = 196314165u;
+    static constexpr unsigned int increment = 907633515u;
+
+    // Four LCG steps as one: seed * a^4 + c * (a^3 + a^2 + a + 1), mod 2^32
+    static constexpr unsigned int jumpMultiplier = multiplier * multiplier * multiplier * multiplier;
+    static constexpr unsigned int jumpIncrement = increment * (multiplier * multiplier * multiplier
+                                                             + multiplier * multiplier + multiplier + 1u);
+
     // The internal state of the noise generator
     // Uses unsigned int for full 32-bit arithmetic wraparound
     unsigned int noiseSeed;
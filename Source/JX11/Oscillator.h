@@ -32,6 +32,7 @@ public:
     {
         inc = 0.0f;
         phase = 0.0f;
+        modulation = 1.0f;
 
         sin0 = 0.0f;
         sin1 = 0.0f;
@@ -123,6 +124,7 @@ public:
     }
 
 private:
+    template <int> friend class VoiceBank;  // Renders lanes of this state directly
     // Internal phase state
     float phase;      // Current phase of the oscillator
     float phaseMax;   // Maximum phase before reflection
@@ -36,6 +36,7 @@ void Synth::reset()
 {
     for (int v = 0; v < MAX_VOICES; ++v)
         voices[v].reset();
+    numActiveVoices = 0;
 
     noiseGen.reset();
     pitchBend = 1.0f;
@@ -51,16 +52,78 @@ void Synth::reset()
     filterZip = 0.0f;
 }
 
-// Render stereo output for N samples
+// Render N samples of stereo or mono output
+template <int Channels>
 void Synth::render(float** outputBuffers, int sampleCount)
 {
+    static_assert(Channels == 1 || Channels == 2, "Mono or stereo output");
+
     float* outputBufferLeft = outputBuffers[0];
-    float* outputBufferRight = outputBuffers[1];
 
+    beginRender();
+
+    // Audio rendering loop, in runs between LFO steps. Voices only change
+    // on an LFO step, so each run renders all voices from the lane bank,
+    // with the run's noise generated up front.
+    int sample = 0;
+    while (sample < sampleCount)
+    {
+        int runLength = beginRun(sampleCount - sample);
+
+        voiceBank.beginLoad();
+        appendVoices(voiceBank, 0);
+        voiceBank.endLoad();
+
+        float noise[LFO_MAX];
+        fillNoise(noise, runLength);
+
+        for (int i = 0; i < runLength; ++i, ++sample)
+        {
+            if constexpr (Channels == 1)
+            {
+                float output = 0.0f;
+                voiceBank.renderSample(noise[i], output);
+                outputBufferLeft[sample] = output * nextOutputLevel();
+            }
+            else
+            {
+                float* outputBufferRight = outputBuffers[1];
+
+                float outputLeft = 0.0f;
+                float outputRight = 0.0f;
+                voiceBank.renderSample(noise[i], outputLeft, outputRight);
+
+                float outputLevel = nextOutputLevel();
+                outputLeft *= outputLevel;
+                outputRight *= outputLevel;
+
+                if (outputBufferRight != nullptr)
+                {
+                    outputBufferLeft[sample] = outputLeft;
+                    outputBufferRight[sample] = outputRight;
+                }
+                else
+                {
+                    outputBufferLeft[sample] = 0.5f * (outputLeft + outputRight);
+                }
+            }
+        }
+
+        voiceBank.store();
+    }
+
+    endRender(outputBuffers, Channels, sampleCount);
+}
+
+template void Synth::render<1>(float** outputBuffers, int sampleCount);
+template void Synth::render<2>(float** outputBuffers, int sampleCount);
+
+void Synth::beginRender()
+{
     // Preprocess active voices
-    for (int v = 0; v < MAX_VOICES; ++v)
+    for (int i = 0; i < numActiveVoices; ++i)
     {
-        Voice& voice = voices[v];
+        Voice& voice = voices[activeVoices[i]];
         if (voice.env.isActive())
         {
             updatePeriod(voice);
@@ -68,57 +131,68 @@ void Synth::render(float** outputBuffers, int sampleCount)
             voice.filterQ = filterQ * resonanceCtl;
             voice.pitchBend = pitchBend;
             voice.filterEnvDepth = filterEnvDepth;
+            voice.fastMath = fastMath;
         }
     }
+}
 
-    // Audio rendering loop
-    for (int sample = 0; sample < sampleCount; ++sample)
-    {
-        updateLFO();
-        float noise = noiseGen.nextValue() * noiseMix;
-
-        float outputLeft = 0.0f;
-        float outputRight = 0.0f;
-
-        for (int v = 0; v < MAX_VOICES; ++v)
-        {
-            Voice& voice = voices[v];
-            if (voice.env.isActive())
-            {
-                float output = voice.render(noise);
-                outputLeft += output * voice.panLeft;
-                outputRight += output * voice.panRight;
-            }
-        }
+int Synth::beginRun(int maxSamples)
+{
+    updateLFO();
 
-        float outputLevel = outputLevelSmoother.getNextValue();
-        outputLeft *= outputLevel;
-        outputRight *= outputLevel;
+    // updateLFO() steps on the sample after lfoStep reaches 1
+    int runLength = std::min(lfoStep, maxSamples);
+    lfoStep -= runLength - 1;
+    return runLength;
+}
 
-        if (outputBufferRight != nullptr)
+void Synth::endRender(float** outputBuffers, int numChannels, int sampleCount)
+{
+    // Reset voices that went silent to free them; the rest stay listed
+    int kept = 0;
+    for (int i = 0; i < numActiveVoices; ++i)
+    {
+        Voice& voice = voices[activeVoices[i]];
+        if (voice.env.isActive())
         {
-            outputBufferLeft[sample] = outputLeft;
-            outputBufferRight[sample] = outputRight;
+            activeVoices[kept++] = activeVoices[i];
         }
         else
         {
-            outputBufferLeft[sample] = 0.5f * (outputLeft + outputRight);
+            voice.env.reset();
+            voice.filter.reset();
         }
     }
+    numActiveVoices = kept;
 
-    // Reset inactive voices to free them
-    for (int v = 0; v < MAX_VOICES; ++v)
+    // Optional: prevent NaNs/clipping
+    if (protectOutput)
+        for (int c = 0; c < numChannels; ++c)
+            protectYourEars(outputBuffers[c], sampleCount);
+}
+
+bool Synth::isSilent() const
+{
+    for (int i = 0; i < numActiveVoices; ++i)
+        if (voices[activeVoices[i]].env.isActive())
+            return false;
+    return true;
+}
+
+void Synth::markActive(int v)
+{
+    int i = numActiveVoices;
+    while (i > 0 && activeVoices[i - 1] >= v)
     {
-        if (!voices[v].env.isActive())
-        {
-            voices[v].env.reset();
-            voices[v].filter.reset();
-        }
+        if (activeVoices[i - 1] == v)
+            return;  // Retriggered voice, already listed
+        --i;
     }
 
-    // Optional: prevent NaNs/clipping
-    protectYourEars(outputBufferLeft, sampleCount);
-    protectYourEars(outputBufferRight, sampleCount);
+    for (int j = numActiveVoices; j > i; --j)
+        activeVoices[j] = activeVoices[j - 1];
+    activeVoices[i] = v;
+    ++numActiveVoices;
 }
 
 // Handle incoming note-on event
@@ -181,6 +255,8 @@ void Synth::startVoice(int v, int note, int velocity)
     voice.filterEnv.sustainLevel = filterSustain;
     voice.filterEnv.releaseMultiplier = filterRelease;
     voice.filterEnv.attack();
+
+    markActive(v);
 }
 
 // Handle note-off event
@@ -267,6 +343,7 @@ void Synth::controlChange(uint8_t data1, uint8_t data2)
             if (data1 >= 0x78)
             {
                 for (auto& v : voices) v.reset();
+                numActiveVoices = 0;
                 sustainPedalPressed = false;
             }
             break;
@@ -282,6 +359,7 @@ void Synth::restartMonoVoice(int note, int velocity)
     if (glideMode == 0) voice.period = period;
 
     voice.env.level += SILENCE + SILENCE;
+    markActive(0);  // The level bump can wake a voice that had died
     voice.note = note;
     voice.updatePanning();
 
@@ -332,9 +410,9 @@ void Synth::updateLFO()
 
         filterZip += 0.005f * (filterMod - filterZip);
 
-        for (int v = 0; v < MAX_VOICES; ++v)
+        for (int i = 0; i < numActiveVoices; ++i)
         {
-            Voice& voice = voices[v];
+            Voice& voice = voices[activeVoices[i]];
             if (voice.env.isActive())
             {
                 voice.osc1.modulation = vibratoMod;
@@ -15,6 +15,7 @@
 #include <juce_dsp/juce_dsp.h>
 #include "Voice.h"
 #include "NoiseGenerator.h"
+#include "VoiceBank.h"
 
 class Synth
 {
@@ -46,7 +47,7 @@ public:
     bool ignoreVelocity;
 
     // LFO settings
-    const int LFO_MAX = 32; // Number of steps per LFO cycle
+    static constexpr int LFO_MAX = 32; // Number of steps per LFO cycle
     float lfoInc;           // LFO increment per sample
     float vibrato;          // Vibrato modulation depth
     float pwmDepth;         // Used for PWM or vibrato routing
@@ -68,6 +69,13 @@ public:
     float filterAttack, filterDecay, filterSustain, filterRelease;
     float filterEnvDepth;   // Depth of filter envelope modulation
 
+    // Per-LFO-step cutoff math through FastMath instead of std::exp/std::tan
+    bool fastMath = false;
+
+    // Run protectYourEars over every rendered block. Only offline renderers
+    // that guard their output some other way may turn this off.
+    bool protectOutput = true;
+
     // === Lifecycle ===
 
     // Called during plugin prepareToPlay()
@@ -79,9 +87,39 @@ public:
     // Reset internal state (voices, envelopes, etc.)
     void reset();
 
-    // Render audio from all active voices into stereo buffers
+    // Render audio from all active voices. Channels = 2 fills the stereo
+    // pair; Channels = 1 writes a single mix to outputBuffers[0] (headless
+    // rendering), skipping the left accumulation and the second channel.
+    template <int Channels = 2>
     void render(float** outputBuffers, int sampleCount);
 
+    // True once every voice envelope has decayed below SILENCE
+    bool isSilent() const;
+
+    // === Staged rendering ===
+    // render() is beginRender(), then per run: beginRun(), load the voices,
+    // fillNoise() for the run, per sample renderSample/nextOutputLevel(),
+    // store; then
+    // endRender(). Lockstep batch renderers drive several synths this way.
+
+    // Push block-constant settings into the active voices
+    void beginRender();
+
+    // Step the LFO; returns how many samples (at most LFO_MAX) may render
+    // before the next step
+    int beginRun(int maxSamples);
+
+    // Add this synth's active voices to a lane bank as one group
+    template <int Lanes>
+    void appendVoices(VoiceBank<Lanes>& bank, int group) { bank.append(voices, activeVoices.data(), numActiveVoices, group); }
+
+    // The run's noise input, one value per sample
+    void fillNoise(float* noise, int count) { noiseGen.fill(noise, count, noiseMix); }
+    float nextOutputLevel() { return outputLevelSmoother.getNextValue(); }
+
+    // Free finished voices and guard the first numChannels rendered buffers
+    void endRender(float** outputBuffers, int numChannels, int sampleCount);
+
     // Handle incoming MIDI messages (note on/off, CC, etc.)
     void midiMessage(uint8_t data0, uint8_t data1, uint8_t data2);
 
@@ -94,6 +132,18 @@ private:
     // Array of all voices (synth is voice-managed)
     std::array<Voice, MAX_VOICES> voices;
 
+    // Indices of the voices that may be sounding, in voice order. Voices
+    // join on startVoice and leave in endRender once their envelope dies,
+    // so the render passes never scan idle voices.
+    std::array<int, MAX_VOICES> activeVoices;
+    int numActiveVoices = 0;
+
+    // Add voice v to activeVoices, keeping voice order
+    void markActive(int v);
+    
+    // Lane view of the voices used by the render loop
+    VoiceBank<MAX_VOICES> voiceBank;
+
     NoiseGenerator noiseGen; // Noise source for noiseMix
 
     // MIDI & modulation state
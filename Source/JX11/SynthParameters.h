@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+    SynthParameters.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Maps plain parameter values onto the synth's derived coefficients. Each
+    coefficient is recomputed only when a parameter it depends on is marked
+    dirty, so a block where one knob moved costs one exp() rather than the
+    whole set. Shared by the plugin and HeadlessSynth so the two mappings
+    cannot drift apart.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include "Oscillator.h" // for TWO_PI
+#include "Synth.h"
+
+namespace SynthParameters
+{
+    // Every parameter that feeds the synth, in plugin declaration order
+    enum Index
+    {
+        oscMix = 0,
+        oscTune,
+        oscFine,
+        glideMode,   // Choice index
+        glideRate,
+        glideBend,
+        filterFreq,
+        filterReso,
+        filterEnv,
+        filterLFO,
+        filterVelocity,
+        filterAttack,
+        filterDecay,
+        filterSustain,
+        filterRelease,
+        envAttack,
+        envDecay,
+        envSustain,
+        envRelease,
+        lfoRate,
+        vibrato,
+        noise,
+        octave,
+        tuning,
+        outputLevel,
+        polyMode,    // Choice index
+
+        COUNT
+    };
+
+    using Values = std::array<float, COUNT>;  // Plain (not normalized) values
+    using DirtyMask = uint32_t;               // Bit i set: values[i] changed
+
+    static_assert(COUNT <= 32, "DirtyMask needs a bit per parameter");
+
+    constexpr DirtyMask allDirty = (DirtyMask(1) << COUNT) - 1;
+
+    constexpr DirtyMask bit(int index) { return DirtyMask(1) << index; }
+
+    // Bits of the entries of values that differ from previous
+    inline DirtyMask diff(const Values& values, const Values& previous)
+    {
+        DirtyMask dirty = 0;
+        for (int i = 0; i < COUNT; ++i)
+            if (values[i] != previous[i])
+                dirty |= bit(i);
+        return dirty;
+    }
+
+    // Parameters whose coefficients depend on no parameter outside this set:
+    // a preset's timbre, which applyTimbre() can compute ahead of time
+    constexpr DirtyMask timbreMask = bit(oscMix) | bit(filterFreq) | bit(filterReso) | bit(filterEnv)
+                                   | bit(filterLFO) | bit(filterAttack) | bit(filterDecay) | bit(filterSustain)
+                                   | bit(filterRelease) | bit(envAttack) | bit(envDecay) | bit(envSustain)
+                                   | bit(envRelease) | bit(lfoRate) | bit(vibrato) | bit(noise);
+
+    /**
+     * The synth coefficients applyTimbre() computes, held apart from a synth
+     * so they can be prepared off the audio thread and switched in with a
+     * copy. Plain floats only, so it can be passed through atomics.
+     */
+    struct TimbreCoefficients
+    {
+        static constexpr int LFO_MAX = 32;  // Same as the synth's
+
+        float envAttack = 0.0f, envDecay = 0.0f, envSustain = 0.0f, envRelease = 0.0f;
+        float noiseMix = 0.0f, oscMix = 0.0f, volumeTrim = 0.0f;
+        float filterLFODepth = 0.0f, filterQ = 0.0f, filterKeyTracking = 0.0f, filterEnvDepth = 0.0f;
+        float filterAttack = 0.0f, filterDecay = 0.0f, filterSustain = 0.0f, filterRelease = 0.0f;
+        float lfoInc = 0.0f, vibrato = 0.0f, pwmDepth = 0.0f;
+
+        static constexpr int FLOAT_COUNT = 18;
+
+        template <typename SynthType>
+        void copyTo(SynthType& synth) const
+        {
+            jassert(synth.LFO_MAX == LFO_MAX);
+
+            synth.envAttack = envAttack;
+            synth.envDecay = envDecay;
+            synth.envSustain = envSustain;
+            synth.envRelease = envRelease;
+            synth.noiseMix = noiseMix;
+            synth.oscMix = oscMix;
+            synth.volumeTrim = volumeTrim;
+            synth.filterLFODepth = filterLFODepth;
+            synth.filterQ = filterQ;
+            synth.filterKeyTracking = filterKeyTracking;
+            synth.filterEnvDepth = filterEnvDepth;
+            synth.filterAttack = filterAttack;
+            synth.filterDecay = filterDecay;
+            synth.filterSustain = filterSustain;
+            synth.filterRelease = filterRelease;
+            synth.lfoInc = lfoInc;
+            synth.vibrato = vibrato;
+            synth.pwmDepth = pwmDepth;
+        }
+    };
+
+    static_assert(sizeof(TimbreCoefficients) == TimbreCoefficients::FLOAT_COUNT * sizeof(float)
+                      && std::is_trivially_copyable<TimbreCoefficients>::value,
+                  "TimbreCoefficients must be copyable as an array of floats");
+
+    /**
+     * Recomputes the coefficients of target that depend only on dirty
+     * timbreMask entries of values. Target is a synth or TimbreCoefficients;
+     * its volumeTrim reads the oscMix and noiseMix already there, so pass
+     * timbreMask when target starts out empty.
+     */
+    template <typename Target>
+    void applyTimbre(Target& target, const Values& values, DirtyMask dirty, float sampleRate)
+    {
+        auto changed = [dirty](DirtyMask inputs) { return (dirty & inputs) != 0; };
+
+        const float inverseSampleRate = 1.0f / sampleRate;
+        const float inverseUpdateRate = inverseSampleRate * target.LFO_MAX;
+
+        // Convert ADSR times using exponential scaling for natural-feeling envelopes
+        if (changed(bit(envAttack)))
+            target.envAttack = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * values[envAttack]));
+        if (changed(bit(envDecay)))
+            target.envDecay = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * values[envDecay]));
+        if (changed(bit(envSustain)))
+            target.envSustain = values[envSustain] / 100.0f;
+        if (changed(bit(envRelease)))
+        {
+            float envRelease = values[SynthParameters::envRelease];
+            target.envRelease = (envRelease < 1.0f) ? 0.75f
+                                                    : std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envRelease));
+        }
+
+        // Nonlinear scaling for noise mix to increase control resolution at low values
+        if (changed(bit(noise)))
+        {
+            float noiseMix = values[noise] / 100.0f;
+            noiseMix *= noiseMix;
+            target.noiseMix = noiseMix * 0.06f;
+        }
+
+        // Oscillator mix
+        if (changed(bit(oscMix)))
+            target.oscMix = values[oscMix] / 100.0f;
+
+        // Filter modulation and resonance
+        if (changed(bit(filterLFO)))
+        {
+            float filterLFO = values[SynthParameters::filterLFO] / 100.0f;
+            target.filterLFODepth = 2.5f * filterLFO * filterLFO;
+        }
+        const float filterReso = values[SynthParameters::filterReso] / 100.0f;
+        if (changed(bit(SynthParameters::filterReso)))
+            target.filterQ = std::exp(3.0f * filterReso);
+
+        // Output gain normalization (volume trim compensation)
+        if (changed(bit(oscMix) | bit(noise) | bit(SynthParameters::filterReso)))
+            target.volumeTrim = 0.0008f * (3.2f - target.oscMix - 25.0f * target.noiseMix) * (1.5f - 0.5f * filterReso);
+
+        // LFO rate (in radians/sample)
+        if (changed(bit(lfoRate)))
+        {
+            float lfoRate = std::exp(7.0f * values[SynthParameters::lfoRate] - 4.0f);
+            target.lfoInc = lfoRate * inverseUpdateRate * float(TWO_PI);
+        }
+
+        // Vibrato and PWM depth (nonlinear scale)
+        if (changed(bit(vibrato)))
+        {
+            float vibrato = values[SynthParameters::vibrato] / 200.0f;
+            target.vibrato = 0.2f * vibrato * vibrato;
+            target.pwmDepth = target.vibrato;
+            if (vibrato < 0.0f) target.vibrato = 0.0f;
+        }
+
+        // Filter envelope and tracking
+        if (changed(bit(filterFreq)))
+            target.filterKeyTracking = 0.08f * values[filterFreq] - 1.5f;
+        if (changed(bit(filterAttack)))
+            target.filterAttack = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * values[filterAttack]));
+        if (changed(bit(filterDecay)))
+            target.filterDecay = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * values[filterDecay]));
+        if (changed(bit(filterSustain)))
+        {
+            float filterSustain = values[SynthParameters::filterSustain] / 100.0f;
+            target.filterSustain = filterSustain * filterSustain;
+        }
+        if (changed(bit(filterRelease)))
+            target.filterRelease = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * values[filterRelease]));
+        if (changed(bit(filterEnv)))
+            target.filterEnvDepth = 0.06f * values[filterEnv];
+    }
+
+    /**
+     * Recomputes the coefficients of synth that depend on a dirty entry of
+     * values. Pass allDirty after the sample rate changes, since every
+     * time-based coefficient depends on it. The output level only gets a
+     * new smoother target, so level changes still ramp.
+     */
+    template <typename SynthType>
+    void apply(SynthType& synth, const Values& values, DirtyMask dirty, float sampleRate)
+    {
+        auto changed = [dirty](DirtyMask inputs) { return (dirty & inputs) != 0; };
+
+        applyTimbre(synth, values, dirty, sampleRate);
+
+        const float inverseUpdateRate = (1.0f / sampleRate) * synth.LFO_MAX;
+
+        // Oscillator tuning
+        if (changed(bit(oscTune) | bit(oscFine)))
+            synth.detune = std::pow(1.059463094359f, -values[oscTune] - 0.01f * values[oscFine]); // semitone + cents to ratio
+
+        // Base tuning frequency (Hz) from octave/tuning parameters
+        if (changed(bit(octave) | bit(tuning)))
+        {
+            float tuneInSemi = -36.3763f - 12.0f * values[octave] - values[tuning] / 100.0f;
+            synth.tune = sampleRate * std::exp(0.05776226505f * tuneInSemi);
+        }
+
+        // Mono or polyphonic voice count
+        if (changed(bit(polyMode)))
+            synth.numVoices = (static_cast<int>(values[polyMode]) == 0) ? 1 : Synth::MAX_VOICES;
+
+        // Target level smoothing for volume control
+        if (changed(bit(outputLevel)))
+            synth.outputLevelSmoother.setTargetValue(juce::Decibels::decibelsToGain(values[outputLevel]));
+
+        // Velocity sensitivity (OFF if less than -90)
+        if (changed(bit(filterVelocity)))
+        {
+            float filterVelocity = values[SynthParameters::filterVelocity];
+            synth.ignoreVelocity = filterVelocity < -90.0f;
+            synth.velocitySensitivity = synth.ignoreVelocity ? 0.0f : 0.0005f * filterVelocity;
+        }
+
+        // Glide (portamento) rate and bend amount
+        if (changed(bit(glideMode)))
+            synth.glideMode = static_cast<int>(values[glideMode]);
+        if (changed(bit(glideRate)))
+        {
+            float glideRate = values[SynthParameters::glideRate];
+            synth.glideRate = (glideRate < 2.0f) ? 1.0f
+                                                 : 1.0f - std::exp(-inverseUpdateRate * std::exp(6.0f - 0.07f * glideRate));
+        }
+        if (changed(bit(glideBend)))
+            synth.glideBend = values[glideBend];
+    }
+}
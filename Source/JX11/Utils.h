@@ -15,8 +15,51 @@
 
 #include <cstring> // for memset
 #include <cmath>   // for std::isnan, std::isinf
+#include <algorithm>
 #include <juce_audio_processors/juce_audio_processors.h> // for DBG, jassert, JUCE types
 
+//================================================================================
+// Fast check behind protectYourEars: true when every sample is finite and
+// inside [-1.0, 1.0], i.e. when protectYourEars would leave the buffer alone.
+//
+// - Keeps eight independent peak/poison lanes so the loop vectorises.
+// - x * 0 is NaN exactly when x is NaN or Inf, so the poison sums catch both.
+//================================================================================
+inline bool isWithinUnitRange(const float* buffer, int sampleCount)
+{
+    constexpr int lanes = 8;
+    alignas(32) float peak[lanes] = {};
+    alignas(32) float poison[lanes] = {};
+
+    int i = 0;
+    for (; i + lanes <= sampleCount; i += lanes)
+    {
+        for (int j = 0; j < lanes; ++j)
+        {
+            float x = buffer[i + j];
+            float magnitude = std::abs(x);
+            peak[j] = magnitude > peak[j] ? magnitude : peak[j];
+            poison[j] += x * 0.0f;
+        }
+    }
+
+    float maxMagnitude = 0.0f;
+    float poisonSum = 0.0f;
+    for (int j = 0; j < lanes; ++j)
+    {
+        maxMagnitude = std::max(maxMagnitude, peak[j]);
+        poisonSum += poison[j];
+    }
+
+    for (; i < sampleCount; ++i)
+    {
+        maxMagnitude = std::max(maxMagnitude, std::abs(buffer[i]));
+        poisonSum += buffer[i] * 0.0f;
+    }
+
+    return maxMagnitude <= 1.0f && poisonSum == 0.0f;
+}
+
 //================================================================================
 // This function is used to protect the user's ears and speakers from potentially
 // dangerous or undefined audio sample values.
@@ -26,11 +69,15 @@
 //   it silences the entire buffer.
 // - If any sample is slightly out of bounds (e.g. above 1.0 or below -1.0),
 //   it clamps that sample and prints a warning only once.
+// - Clean buffers (nearly all of them) pass one vectorised scan and return;
+//   the per-sample checks below only run when that scan finds a problem.
 //================================================================================
 inline void protectYourEars(float* buffer, int sampleCount)
 {
     if (buffer == nullptr) return;
 
+    if (isWithinUnitRange(buffer, sampleCount)) return;
+
     bool firstWarning = true;
 
     for (int i = 0; i < sampleCount; ++i)
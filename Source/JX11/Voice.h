@@ -39,6 +39,8 @@ struct Voice
     Envelope filterEnv;     // Filter envelope
     float filterEnvDepth;   // Filter envelope modulation depth
 
+    bool fastMath = false;  // Use FastMath approximations for cutoff updates
+
     // Reset voice to default state
     void reset()
     {
@@ -100,12 +102,16 @@ struct Voice
         float fenv = filterEnv.nextValue();
 
         // Calculate modulated filter cutoff
-        float modulatedCutoff = cutoff * std::exp(filterMod + filterEnvDepth * fenv) / pitchBend;
+        float modulation = filterMod + filterEnvDepth * fenv;
+        float modulatedCutoff = cutoff * (fastMath ? FastMath::exp(modulation) : std::exp(modulation)) / pitchBend;
 
         // Clamp to safe audio frequency range
         modulatedCutoff = std::clamp(modulatedCutoff, 30.0f, 20000.0f);
 
         // Update filter coefficients for this voice
-        filter.updateCoefficients(modulatedCutoff, filterQ);
+        if (fastMath)
+            filter.updateCoefficientsFast(modulatedCutoff, filterQ);
+        else
+            filter.updateCoefficients(modulatedCutoff, filterQ);
     }
 };
@@ -0,0 +1,428 @@
+/*
+  ==============================================================================
+    VoiceBank.h
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+
+    Structure-of-arrays view of the synth's voices for rendering. The
+    per-sample oscillator, filter and envelope state of the active voices
+    lives in aligned lanes so one pass of straight-line lane loops renders
+    all voices per sample (the compiler vectorises these into SSE/NEON/AVX).
+    Output matches Voice::render bit for bit.
+
+    Voices stay authoritative for everything else: Synth loads the bank at
+    the start of each LFO step and stores it back before touching voices.
+    A bank may also hold the voices of several synths at once, one group
+    per synth, so lockstep batch renders share the same lane loops.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Voice.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+template <int Lanes>
+class VoiceBank
+{
+public:
+    // Copies per-sample state in from the active voices, packed into the
+    // leading lanes in voice order and padded with silent lanes to a
+    // multiple of 4 so the lane loops only cover voices that are playing
+    template <size_t N>
+    void load(std::array<Voice, N>& voices)
+    {
+        static_assert(static_cast<int>(N) <= Lanes, "One lane per voice");
+        
+        beginLoad();
+        append(voices, 0);
+        endLoad();
+    }
+    
+    // Multi-synth loading: beginLoad(), append() each synth's voices as its
+    // own group (in group order), then endLoad()
+    void beginLoad()
+    {
+        activeLanes = 0;
+    }
+    
+    template <size_t N>
+    void append(std::array<Voice, N>& voices, int group)
+    {
+        for (Voice& voice : voices)
+            appendVoice(voice, group);
+    }
+    
+    // Same, visiting only voices[indices[0..count)]; indices must be in
+    // voice order so lanes still accumulate as the scalar loop would
+    template <size_t N>
+    void append(std::array<Voice, N>& voices, const int* indices, int count, int group)
+    {
+        for (int i = 0; i < count; ++i)
+            appendVoice(voices[static_cast<size_t>(indices[i])], group);
+    }
+    
+    // Takes one lane for the voice if it is still sounding
+    void appendVoice(Voice& voice, int group)
+    {
+        if (voice.env.isActive())
+        {
+            jassert(activeLanes < Lanes);
+            const int v = activeLanes++;
+            laneVoice[v] = &voice;
+            laneGroup[v] = group;
+            live[v] = 1;
+            
+            osc1.load(voice.osc1, v);
+            osc2.load(voice.osc2, v);
+            saw[v] = voice.saw;
+            panLeft[v] = voice.panLeft;
+            panRight[v] = voice.panRight;
+            
+            a1[v] = voice.filter.a1;
+            a2[v] = voice.filter.a2;
+            a3[v] = voice.filter.a3;
+            ic1eq[v] = voice.filter.ic1eq;
+            ic2eq[v] = voice.filter.ic2eq;
+            
+            envLevel[v] = voice.env.level;
+            envMultiplier[v] = voice.env.multiplier;
+            envTarget[v] = voice.env.target;
+            envDecayMultiplier[v] = voice.env.decayMultiplier;
+            envSustainLevel[v] = voice.env.sustainLevel;
+        }
+    }
+    
+    void endLoad()
+    {
+        numLanes = std::min(Lanes, (activeLanes + 3) & ~3);
+        for (int v = activeLanes; v < numLanes; ++v)
+            clearLane(v);
+        
+        liveLanes = activeLanes;
+    }
+    
+    // Writes the evolved state back into the voices still playing
+    void store() const
+    {
+        for (int v = 0; v < activeLanes; ++v)
+            if (live[v] != 0)
+                storeLane(*laneVoice[v], v);
+    }
+    
+    int getActiveLaneCount() const { return activeLanes; }
+    
+    /**
+     * Advances every playing lane by one sample (the lane form of
+     * Voice::render) and adds the panned output to outputLeft/Right.
+     * Lanes are accumulated in voice order, matching the scalar loop.
+     * A voice whose envelope fell below SILENCE is written back to its
+     * Voice and stops rendering, as Synth would stop calling Voice::render.
+     */
+    void renderSample(float noise, float& outputLeft, float& outputRight)
+    {
+        if (liveLanes == 0)
+            return;
+        
+        alignas(32) float laneNoise[Lanes];
+        for (int v = 0; v < numLanes; ++v)
+            laneNoise[v] = noise;
+        
+        alignas(32) float output[Lanes];
+        renderLanes(laneNoise, output);
+        
+        for (int v = 0; v < numLanes; ++v)
+        {
+            outputLeft += output[v] * panLeft[v];
+            outputRight += output[v] * panRight[v];
+        }
+    }
+    
+    /**
+     * Mono form: adds one mix per sample instead of the panned pair. It
+     * carries the right-channel gains, which is the channel HeadlessSynth
+     * always kept when it passed one buffer as both outputs.
+     */
+    void renderSample(float noise, float& output)
+    {
+        if (liveLanes == 0)
+            return;
+        
+        alignas(32) float laneNoise[Lanes];
+        for (int v = 0; v < numLanes; ++v)
+            laneNoise[v] = noise;
+        
+        alignas(32) float laneOutput[Lanes];
+        renderLanes(laneNoise, laneOutput);
+        
+        for (int v = 0; v < numLanes; ++v)
+            output += laneOutput[v] * panRight[v];
+    }
+    
+    // Grouped form: groupNoise, groupLeft and groupRight are indexed by group
+    void renderSample(const float* groupNoise, float* groupLeft, float* groupRight)
+    {
+        if (liveLanes == 0)
+            return;
+        
+        alignas(32) float laneNoise[Lanes];
+        for (int v = 0; v < numLanes; ++v)
+            laneNoise[v] = groupNoise[laneGroup[v]];
+        
+        alignas(32) float output[Lanes];
+        renderLanes(laneNoise, output);
+        
+        for (int v = 0; v < numLanes; ++v)
+        {
+            groupLeft[laneGroup[v]] += output[v] * panLeft[v];
+            groupRight[laneGroup[v]] += output[v] * panRight[v];
+        }
+    }
+    
+    // Grouped mono form
+    void renderSample(const float* groupNoise, float* groupOutput)
+    {
+        if (liveLanes == 0)
+            return;
+        
+        alignas(32) float laneNoise[Lanes];
+        for (int v = 0; v < numLanes; ++v)
+            laneNoise[v] = groupNoise[laneGroup[v]];
+        
+        alignas(32) float output[Lanes];
+        renderLanes(laneNoise, output);
+        
+        for (int v = 0; v < numLanes; ++v)
+            groupOutput[laneGroup[v]] += output[v] * panRight[v];
+    }
+
+private:
+    void renderLanes(const float* laneNoise, float* output)
+    {
+        retireSilentLanes();
+        
+        alignas(32) float sample1[Lanes];
+        alignas(32) float sample2[Lanes];
+        osc1.nextSample(live, numLanes, sample1);
+        osc2.nextSample(live, numLanes, sample2);
+        
+        for (int v = 0; v < numLanes; ++v)
+        {
+            // Saw blend and noise
+            float newSaw = saw[v] * 0.997f + sample1[v] - sample2[v];
+            float x = newSaw + laneNoise[v];
+            saw[v] = newSaw;
+            
+            // TPT state variable filter
+            float c1 = ic1eq[v];
+            float c2 = ic2eq[v];
+            float v3 = x - c2;
+            float v1 = a1[v] * c1 + a2[v] * v3;
+            float v2 = c2 + a2[v] * c1 + a3[v] * v3;
+            ic1eq[v] = 2.0f * v1 - c1;
+            ic2eq[v] = 2.0f * v2 - c2;
+            
+            // Amplitude envelope; attack hands over to decay past 2.0
+            float target = envTarget[v];
+            float level = envMultiplier[v] * (envLevel[v] - target) + target;
+            const bool toDecay = level + target > 3.0f;
+            envLevel[v] = level;
+            envMultiplier[v] = select(toDecay, envDecayMultiplier[v], envMultiplier[v]);
+            envTarget[v] = select(toDecay, envSustainLevel[v], target);
+            
+            output[v] = select(live[v] != 0, v2 * level, 0.0f);
+        }
+    }
+    
+    // Branch-free lane select. A plain ternary that may keep the old value gets
+    // turned into a conditional store, which stops the loop vectorising.
+    static inline float select(bool condition, float ifTrue, float ifFalse)
+    {
+        uint32_t a, b;
+        std::memcpy(&a, &ifTrue, sizeof(a));
+        std::memcpy(&b, &ifFalse, sizeof(b));
+        
+        const uint32_t mask = 0u - static_cast<uint32_t>(condition);
+        const uint32_t bits = (a & mask) | (b & ~mask);
+        
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+    
+    //==============================================================================
+    // Lane form of Oscillator; the rare re-initialisation runs the scalar code
+    struct OscillatorLanes
+    {
+        alignas(32) float phase[Lanes];
+        alignas(32) float phaseMax[Lanes];
+        alignas(32) float inc[Lanes];
+        alignas(32) float sin0[Lanes];
+        alignas(32) float sin1[Lanes];
+        alignas(32) float dsin[Lanes];
+        alignas(32) float dc[Lanes];
+        
+        // Only read by the scalar re-initialisation path
+        float period[Lanes];
+        float amplitude[Lanes];
+        float modulation[Lanes];
+        
+        void load(const Oscillator& osc, int v)
+        {
+            phase[v] = osc.phase;
+            phaseMax[v] = osc.phaseMax;
+            inc[v] = osc.inc;
+            sin0[v] = osc.sin0;
+            sin1[v] = osc.sin1;
+            dsin[v] = osc.dsin;
+            dc[v] = osc.dc;
+            period[v] = osc.period;
+            amplitude[v] = osc.amplitude;
+            modulation[v] = osc.modulation;
+        }
+        
+        void store(Oscillator& osc, int v) const
+        {
+            osc.phase = phase[v];
+            osc.phaseMax = phaseMax[v];
+            osc.inc = inc[v];
+            osc.sin0 = sin0[v];
+            osc.sin1 = sin1[v];
+            osc.dsin = dsin[v];
+            osc.dc = dc[v];
+        }
+        
+        // Finite, non-restarting state for padding lanes
+        void clear(int v)
+        {
+            phase[v] = phaseMax[v] = 1.0f;
+            inc[v] = sin0[v] = sin1[v] = dsin[v] = dc[v] = 0.0f;
+            period[v] = amplitude[v] = modulation[v] = 0.0f;
+        }
+        
+        // Oscillator::nextSample for every lane; only live lanes may restart
+        void nextSample(const int* live, int numLanes, float* output)
+        {
+            alignas(32) float startPhase[Lanes];
+            alignas(32) int restart[Lanes];
+            int anyRestart = 0;
+            
+            for (int v = 0; v < numLanes; ++v)
+            {
+                float p = phase[v] + inc[v];
+                startPhase[v] = p;
+                restart[v] = live[v] & static_cast<int>(p <= PI_OVER_4);
+                anyRestart |= restart[v];
+                
+                // Reflect past the maximum phase, then step the sine recursion
+                float pm = phaseMax[v];
+                const bool reflect = p > pm;
+                float reflected = select(reflect, pm + pm - p, p);
+                inc[v] = select(reflect, -inc[v], inc[v]);
+                
+                float sinp = dsin[v] * sin0[v] - sin1[v];
+                sin1[v] = sin0[v];
+                sin0[v] = sinp;
+                phase[v] = reflected;
+                output[v] = sinp / reflected - dc[v];
+            }
+            
+            if (anyRestart == 0)
+                return;
+            
+            // Startup region: the scalar oscillator rebuilds the recursion,
+            // overwriting everything the lane loop stepped
+            for (int v = 0; v < numLanes; ++v)
+            {
+                if (restart[v] == 0)
+                    continue;
+                
+                Oscillator osc;
+                store(osc, v);
+                osc.period = period[v];
+                osc.amplitude = amplitude[v];
+                osc.modulation = modulation[v];
+                osc.phase = startPhase[v];
+                osc.inc = 0.0f;
+                
+                output[v] = osc.nextSample();
+                load(osc, v);
+            }
+        }
+    };
+    
+    OscillatorLanes osc1;
+    OscillatorLanes osc2;
+    
+    alignas(32) float saw[Lanes];
+    alignas(32) float panLeft[Lanes];
+    alignas(32) float panRight[Lanes];
+    
+    // Filter coefficients and integrator state
+    alignas(32) float a1[Lanes];
+    alignas(32) float a2[Lanes];
+    alignas(32) float a3[Lanes];
+    alignas(32) float ic1eq[Lanes];
+    alignas(32) float ic2eq[Lanes];
+    
+    // Amplitude envelope
+    alignas(32) float envLevel[Lanes];
+    alignas(32) float envMultiplier[Lanes];
+    alignas(32) float envTarget[Lanes];
+    alignas(32) float envDecayMultiplier[Lanes];
+    alignas(32) float envSustainLevel[Lanes];
+    
+    // Lane v renders laneVoice[v] for group laneGroup[v]; lanes in
+    // [activeLanes, numLanes) are padding (group 0, never live)
+    alignas(32) int live[Lanes] = {};
+    Voice* laneVoice[Lanes] = {};
+    int laneGroup[Lanes] = {};
+    int activeLanes = 0;
+    int liveLanes = 0;
+    int numLanes = 0;
+    
+    void retireSilentLanes()
+    {
+        for (int v = 0; v < activeLanes; ++v)
+        {
+            if (live[v] != 0 && !(envLevel[v] > SILENCE))
+            {
+                // Freeze exactly where Voice::render would have stopped
+                storeLane(*laneVoice[v], v);
+                live[v] = 0;
+                --liveLanes;
+            }
+        }
+    }
+    
+    void storeLane(Voice& voice, int v) const
+    {
+        osc1.store(voice.osc1, v);
+        osc2.store(voice.osc2, v);
+        voice.saw = saw[v];
+        
+        voice.filter.ic1eq = ic1eq[v];
+        voice.filter.ic2eq = ic2eq[v];
+        
+        voice.env.level = envLevel[v];
+        voice.env.multiplier = envMultiplier[v];
+        voice.env.target = envTarget[v];
+    }
+    
+    void clearLane(int v)
+    {
+        live[v] = 0;
+        laneGroup[v] = 0;
+        osc1.clear(v);
+        osc2.clear(v);
+        saw[v] = panLeft[v] = panRight[v] = 0.0f;
+        a1[v] = a2[v] = a3[v] = ic1eq[v] = ic2eq[v] = 0.0f;
+        envLevel[v] = envMultiplier[v] = envTarget[v] = 0.0f;
+        envDecayMultiplier[v] = envSustainLevel[v] = 0.0f;
+    }
+};
@@ -10,6 +10,8 @@
 #include "JX11/Utils.h"
 #include "GA/ParameterBridge.h"
 #include "GA/MLPPreferenceModel.h"
+#include "GA/Trace.h"
+#include <cstring>
 
 //==============================================================================
 JX11AudioProcessor::JX11AudioProcessor()
@@ -60,25 +62,46 @@ JX11AudioProcessor::JX11AudioProcessor()
     for (const auto& pid : getGAParameterIDs())
         paramNames.push_back(pid.getParamID());
         
-    fitnessModel = std::make_unique<MLPPreferenceModel>(paramNames);
+    sharedModel = SharedEngine::acquireModel(paramNames);
+    fitnessModel = sharedModel.get();  // Scores in this instance's input mode
     
     // Initialize GA engine with reference to fitness model
     gaEngine = std::make_unique<GeneticAlgorithm>(*fitnessModel);
+    gaEngine->setEvaluationPool(SharedEngine::getWorkerPool());
     
-    // Initialize parameter smoothing vectors (17 GA parameters)
-    targetParameters.resize(17, 0.0f);
-    currentParameters.resize(17, 0.0f);
+    // The 17 GA-controlled parameters, in HeadlessParam order
+    // Excluded: oscTune, glideMode, glideRate, glideBend, filterVelocity, octave, tuning, outputLevel, polyMode
+    gaParameters =
+    {
+        oscMixParam, oscFineParam,
+        filterFreqParam, filterResoParam, filterEnvParam, filterLFOParam,
+        filterAttackParam, filterDecayParam, filterSustainParam, filterReleaseParam,
+        envAttackParam, envDecayParam, envSustainParam, envReleaseParam,
+        lfoRateParam, vibratoParam, noiseParam
+    };
+    gaSynthIndices =
+    {
+        SynthParameters::oscMix, SynthParameters::oscFine,
+        SynthParameters::filterFreq, SynthParameters::filterReso, SynthParameters::filterEnv, SynthParameters::filterLFO,
+        SynthParameters::filterAttack, SynthParameters::filterDecay, SynthParameters::filterSustain, SynthParameters::filterRelease,
+        SynthParameters::envAttack, SynthParameters::envDecay, SynthParameters::envSustain, SynthParameters::envRelease,
+        SynthParameters::lfoRate, SynthParameters::vibrato, SynthParameters::noise
+    };
     
     // Start timer for parameter bridge polling (50ms = 20Hz)
     startTimer(static_cast<int>(timerInterval * 1000.0f));
+    
+    Trace::startFromEnvironment();
 
-    apvts.state.addListener(this); // Listen for parameter tree changes
 }
 
 JX11AudioProcessor::~JX11AudioProcessor()
 {
     stopTimer();
-    apvts.state.removeListener(this);
+    
+    // A trace nobody stopped from the UI (e.g. one started by PPG_TRACE) is kept
+    if (Trace::isRecording())
+        stopTrace();
 }
 
 //==============================================================================
@@ -166,9 +189,10 @@ void JX11AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     DBG("Plugin loaded and DBG active");
     synth.allocateResources(sampleRate, samplesPerBlock);
     parametersChanged.store(true); // Mark for update on next block
+    audioLoadMeter.prepare(sampleRate);
     
     // Update sample rate for audio feature extraction
-    if (auto* mlpModel = dynamic_cast<MLPPreferenceModel*>(fitnessModel.get()))
+    if (auto* mlpModel = getPreferenceModel())
         mlpModel->setSampleRate(sampleRate);
     
     reset();
@@ -220,6 +244,9 @@ void JX11AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                        juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    AudioLoadMeter::ScopedBlock loadTiming(audioLoadMeter, buffer.getNumSamples());
+    PPG_TRACE_THREAD_NAME("Audio");
+    PPG_TRACE_ZONE("processBlock");
 
     // Clear any output channels beyond the number of inputs
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -227,102 +254,57 @@ void JX11AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Apply parameter updates if needed (deferred for thread safety)
-    bool expected = true;
-    if (isNonRealtime() || parametersChanged.compare_exchange_strong(expected, false))
-        update();
+    // Pick up parameter changes; a flagged change (sample rate, state restore) redoes everything
+    update(parametersChanged.exchange(false));
+    
+    pollGATarget();
 
     // Render audio in chunks around MIDI events
     splitBufferByEvents(buffer, midiMessages);
 }
 
-// Recalculates internal synth parameters when a plugin parameter changes
-void JX11AudioProcessor::update()
+// Recalculates the synth coefficients whose plugin parameters changed since the last call
+void JX11AudioProcessor::update(bool all)
 {
-    float sampleRate = float(getSampleRate());
-    float inverseSampleRate = 1.0f / sampleRate;
-
-    // Convert ADSR times using exponential scaling for natural-feeling envelopes
-    synth.envAttack = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envAttackParam->get()));
-    synth.envDecay = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envDecayParam->get()));
-    synth.envSustain = envSustainParam->get() / 100.0f;
-
-    float envRelease = envReleaseParam->get();
-    synth.envRelease = (envRelease < 1.0f) ? 0.75f
-                                           : std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * envRelease));
-
-    // Nonlinear scaling for noise mix to increase control resolution at low values
-    float noiseMix = noiseParam->get() / 100.0f;
-    noiseMix *= noiseMix;
-    synth.noiseMix = noiseMix * 0.06f;
-
-    // Oscillator mix and tuning
-    synth.oscMix = oscMixParam->get() / 100.0f;
-    float semi = oscTuneParam->get();
-    float cent = oscFineParam->get();
-    synth.detune = std::pow(1.059463094359f, -semi - 0.01f * cent); // convert semitone + cents to ratio
-
-    // Calculate base tuning frequency (Hz) from octave/tuning parameters
-    float octave = octaveParam->get();
-    float tuning = tuningParam->get();
-    float tuneInSemi = -36.3763f - 12.0f * octave - tuning / 100.0f;
-    synth.tune = sampleRate * std::exp(0.05776226505f * tuneInSemi);
-
-    // Set mono or polyphonic voice count
-    synth.numVoices = (polyModeParam->getIndex() == 0) ? 1 : Synth::MAX_VOICES;
-
-    // Filter modulation and resonance
-    float filterLFO = filterLFOParam->get() / 100.0f;
-    synth.filterLFODepth = 2.5f * filterLFO * filterLFO;
-
-    float filterReso = filterResoParam->get() / 100.0f;
-    synth.filterQ = std::exp(3.0f * filterReso);
-
-    // Output gain normalization (volume trim compensation)
-    synth.volumeTrim = 0.0008f * (3.2f - synth.oscMix - 25.0f * synth.noiseMix) * (1.5f - 0.5f * filterReso);
-
-    // Target level smoothing for volume control
-    synth.outputLevelSmoother.setTargetValue(juce::Decibels::decibelsToGain(outputLevelParam->get()));
-
-    // Velocity sensitivity (OFF if less than -90)
-    float filterVelocity = filterVelocityParam->get();
-    if (filterVelocity < -90.0f)
-    {
-        synth.velocitySensitivity = 0.0f;
-        synth.ignoreVelocity = true;
-    }
-    else
-    {
-        synth.velocitySensitivity = 0.0005f * filterVelocity;
-        synth.ignoreVelocity = false;
-    }
-
-    // LFO rate (in radians/sample)
-    const float inverseUpdateRate = inverseSampleRate * synth.LFO_MAX;
-    float lfoRate = std::exp(7.0f * lfoRateParam->get() - 4.0f);
-    synth.lfoInc = lfoRate * inverseUpdateRate * float(TWO_PI);
-
-    // Vibrato and PWM depth (nonlinear scale)
-    float vibrato = vibratoParam->get() / 200.0f;
-    synth.vibrato = 0.2f * vibrato * vibrato;
-    synth.pwmDepth = synth.vibrato;
-    if (vibrato < 0.0f) synth.vibrato = 0.0f;
-
-    // Glide (portamento) rate and bend amount
-    synth.glideMode = glideModeParam->getIndex();
-    float glideRate = glideRateParam->get();
-    synth.glideRate = (glideRate < 2.0f) ? 1.0f
-                                         : 1.0f - std::exp(-inverseUpdateRate * std::exp(6.0f - 0.07f * glideRate));
-    synth.glideBend = glideBendParam->get();
+    // GA-controlled parameters follow a preset glide while one is running
+    auto value = [this](juce::AudioParameterFloat* param) { return getEffectiveValue(param); };
+
+    SynthParameters::Values values;
+    values[SynthParameters::oscMix] = value(oscMixParam);
+    values[SynthParameters::oscTune] = oscTuneParam->get();
+    values[SynthParameters::oscFine] = value(oscFineParam);
+    values[SynthParameters::glideMode] = static_cast<float>(glideModeParam->getIndex());
+    values[SynthParameters::glideRate] = glideRateParam->get();
+    values[SynthParameters::glideBend] = glideBendParam->get();
+    values[SynthParameters::filterFreq] = value(filterFreqParam);
+    values[SynthParameters::filterReso] = value(filterResoParam);
+    values[SynthParameters::filterEnv] = value(filterEnvParam);
+    values[SynthParameters::filterLFO] = value(filterLFOParam);
+    values[SynthParameters::filterVelocity] = filterVelocityParam->get();
+    values[SynthParameters::filterAttack] = value(filterAttackParam);
+    values[SynthParameters::filterDecay] = value(filterDecayParam);
+    values[SynthParameters::filterSustain] = value(filterSustainParam);
+    values[SynthParameters::filterRelease] = value(filterReleaseParam);
+    values[SynthParameters::envAttack] = value(envAttackParam);
+    values[SynthParameters::envDecay] = value(envDecayParam);
+    values[SynthParameters::envSustain] = value(envSustainParam);
+    values[SynthParameters::envRelease] = value(envReleaseParam);
+    values[SynthParameters::lfoRate] = value(lfoRateParam);
+    values[SynthParameters::vibrato] = value(vibratoParam);
+    values[SynthParameters::noise] = value(noiseParam);
+    values[SynthParameters::octave] = octaveParam->get();
+    values[SynthParameters::tuning] = tuningParam->get();
+    values[SynthParameters::outputLevel] = outputLevelParam->get();
+    values[SynthParameters::polyMode] = static_cast<float>(polyModeParam->getIndex());
+
+    const SynthParameters::DirtyMask dirty = all ? SynthParameters::allDirty
+                                                 : SynthParameters::diff(values, appliedSynthValues);
+    if (dirty == 0)
+        return;
 
-    // Filter envelope and tracking
-    synth.filterKeyTracking = 0.08f * filterFreqParam->get() - 1.5f;
-    synth.filterAttack = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * filterAttackParam->get()));
-    synth.filterDecay = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * filterDecayParam->get()));
-    float filterSustain = filterSustainParam->get() / 100.0f;
-    synth.filterSustain = filterSustain * filterSustain;
-    synth.filterRelease = std::exp(-inverseUpdateRate * std::exp(5.5f - 0.075f * filterReleaseParam->get()));
-    synth.filterEnvDepth = 0.06f * filterEnvParam->get();
+    synth.fastMath = fastMathEnabled.load();
+    SynthParameters::apply(synth, values, dirty, float(getSampleRate()));
+    appliedSynthValues = values;
 }
 
 
@@ -393,13 +375,25 @@ void JX11AudioProcessor::handleMIDI(uint8_t data0, uint8_t data1, uint8_t data2)
 // Renders audio for a given buffer range using active voices
 void JX11AudioProcessor::render(juce::AudioBuffer<float> &buffer, int sampleCount, int bufferOffset)
 {
-    float* outputBuffers[2] = { nullptr, nullptr };
-    outputBuffers[0] = buffer.getWritePointer(0) + bufferOffset;
-    if (getTotalNumOutputChannels() > 1)
+    // While a GA preset glides in, render in short chunks so the synth's
+    // coefficients follow the smoothed values
+    while (sampleCount > 0)
     {
-        outputBuffers[1] = buffer.getWritePointer(1) + bufferOffset;
+        const int chunk = gaGliding ? std::min(sampleCount, gaSmoothingChunkSize) : sampleCount;
+        if (gaGliding)
+            advanceGAGlide(chunk);
+
+        float* outputBuffers[2] = { nullptr, nullptr };
+        outputBuffers[0] = buffer.getWritePointer(0) + bufferOffset;
+        if (getTotalNumOutputChannels() > 1)
+        {
+            outputBuffers[1] = buffer.getWritePointer(1) + bufferOffset;
+        }
+        synth.render(outputBuffers, chunk);
+
+        sampleCount -= chunk;
+        bufferOffset += chunk;
     }
-    synth.render(outputBuffers, sampleCount);
 }
 
 //==============================================================================
@@ -426,6 +420,26 @@ void JX11AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // Save experiment mode
     xml->setAttribute("ExperimentMode", static_cast<int>(currentExperimentMode));
     
+    if (featureCacheBudget > 0)
+        xml->setAttribute("FeatureCacheBytes", juce::String(static_cast<juce::int64>(featureCacheBudget)));
+    
+    if (backgroundCpuBudget > 0.0f)
+        xml->setAttribute("BackgroundCpuCores", backgroundCpuBudget);
+    
+    if (generationBudgetMode != GAConfig::BudgetMode::Fixed)
+    {
+        xml->setAttribute("GenerationBudget", generationBudgetMode == GAConfig::BudgetMode::Latency ? "Latency" : "CpuTime");
+        xml->setAttribute("GenerationBudgetMs", generationBudgetTargetMs);
+    }
+    
+    if (getPresetTransition() == PresetTransition::Instant)
+        xml->setAttribute("PresetTransition", "Instant");
+    
+    // The GA resumes from this population when the project is reopened
+    juce::MemoryBlock populationSnapshot;
+    if (gaEngine && gaEngine->getPopulationSnapshot(populationSnapshot))
+        xml->setAttribute("GAPopulation", populationSnapshot.toBase64Encoding());
+    
     copyXmlToBinary(*xml, destData);
 }
 
@@ -446,6 +460,37 @@ void JX11AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
                 setExperimentMode(static_cast<ExperimentMode>(modeIdx));
             }
         }
+        
+        // Restore feature cache budget
+        if (xml->hasAttribute("FeatureCacheBytes"))
+        {
+            auto bytes = xml->getStringAttribute("FeatureCacheBytes").getLargeIntValue();
+            if (bytes > 0)
+                setFeatureCacheBudget(static_cast<size_t>(bytes));
+        }
+        
+        // Restore background CPU budget
+        setBackgroundCpuBudget(static_cast<float>(xml->getDoubleAttribute("BackgroundCpuCores", 0.0)));
+        
+        // Restore the generation budget; projects without one keep the fixed size
+        const auto budget = xml->getStringAttribute("GenerationBudget");
+        setGenerationBudget(budget == "Latency" ? GAConfig::BudgetMode::Latency
+                                : budget == "CpuTime" ? GAConfig::BudgetMode::CpuTime
+                                                      : GAConfig::BudgetMode::Fixed,
+                            static_cast<float>(xml->getDoubleAttribute("GenerationBudgetMs", 0.0)));
+        
+        // Restore preset transition
+        setPresetTransition(xml->getStringAttribute("PresetTransition") == "Instant" ? PresetTransition::Instant
+                                                                                   : PresetTransition::Morph);
+        
+        // Restore the GA population; a project saved without one starts fresh
+        if (gaEngine)
+        {
+            juce::MemoryBlock populationSnapshot;
+            if (!populationSnapshot.fromBase64Encoding(xml->getStringAttribute("GAPopulation"))
+                || !gaEngine->setPopulationSnapshot(populationSnapshot.getData(), populationSnapshot.getSize()))
+                gaEngine->clearPopulationSnapshot();
+        }
     }
 }
 
@@ -774,24 +819,32 @@ void JX11AudioProcessor::startGA()
         // Load the first candidate immediately so tracking begins with a GA preset
         fetchNextPreset();
     }
+    
+    publishGAState();
 }
 
 void JX11AudioProcessor::stopGA()
 {
     if (gaEngine)
         gaEngine->stopGA();
+    
+    publishGAState();
 }
 
 void JX11AudioProcessor::pauseGA()
 {
     if (gaEngine)
         gaEngine->pauseGA();
+    
+    publishGAState();
 }
 
 void JX11AudioProcessor::resumeGA()
 {
     if (gaEngine)
         gaEngine->resumeGA();
+    
+    publishGAState();
 }
 
 bool JX11AudioProcessor::isGARunning() const
@@ -808,11 +861,22 @@ void JX11AudioProcessor::logFeedback(const IFitnessModel::Feedback& feedback)
 {
     if (fitnessModel)
     {
-        // Capture current parameter values directly from the plugin state
+        // A preset still gliding in isn't in the plugin state yet; rate its target
         const auto& gaParams = getGAParameterIDs();
         std::vector<float> currentGenome;
         currentGenome.reserve(gaParams.size());
         
+        const uint32_t version = gaTargetVersion.load();
+        if (version != gaReleasedVersion.load())
+        {
+            for (const auto& target : gaTarget)
+                currentGenome.push_back(target.load());
+            
+            fitnessModel->sendFeedback(currentGenome, feedback);
+            return;
+        }
+        
+        // Capture current parameter values directly from the plugin state
         for (const auto& pid : gaParams)
         {
             if (auto* param = apvts.getParameter(pid.getParamID()))
@@ -829,17 +893,20 @@ void JX11AudioProcessor::logFeedback(const IFitnessModel::Feedback& feedback)
     }
 }
 
-void JX11AudioProcessor::setGAConfig(const GAConfig& config)
+void JX11AudioProcessor::setGAConfig(const GAConfig& requestedConfig)
 {
+    GAConfig config = requestedConfig;
+    applyGenerationBudget(config);
+    
     if (gaEngine)
     {
         gaEngine->setConfig(config);
     }
     
-    // Update config flags in preference model for CSV logging
-    if (auto* mlpModel = dynamic_cast<MLPPreferenceModel*>(fitnessModel.get()))
+    // Update config flags for CSV logging; this instance's ratings only
+    if (sharedModel)
     {
-        mlpModel->setConfigFlags(config.toString());
+        sharedModel->setConfigFlags(config.toString());
     }
 }
 
@@ -876,10 +943,10 @@ void JX11AudioProcessor::setInputMode(GAConfig::MLPInputMode mode)
 {
     currentInputMode = mode;
     
-    // Update MLPPreferenceModel directly
-    if (auto* mlpModel = dynamic_cast<MLPPreferenceModel*>(fitnessModel.get()))
+    // Only this instance's GA switches; others sharing the model keep theirs
+    if (sharedModel)
     {
-        mlpModel->setInputMode(static_cast<MLPPreferenceModel::InputMode>(mode));
+        sharedModel->setInputMode(mode);
     }
     
     // Update config flags in preference model to include input mode
@@ -905,25 +972,177 @@ void JX11AudioProcessor::setInputMode(GAConfig::MLPInputMode mode)
             break;
     }
     
-    if (auto* mlpModel = dynamic_cast<MLPPreferenceModel*>(fitnessModel.get()))
+    applyGenerationBudget(config);
+    
+    if (sharedModel)
     {
-        mlpModel->setConfigFlags(config.toString());
+        sharedModel->setConfigFlags(config.toString());
     }
 }
 
+void JX11AudioProcessor::setFeatureCacheBudget(size_t bytes)
+{
+    featureCacheBudget = bytes;
+    
+    if (auto* mlpModel = getPreferenceModel())
+        mlpModel->setFeatureCacheBudget(bytes);
+}
+
+void JX11AudioProcessor::setBackgroundCpuBudget(float cores)
+{
+    backgroundCpuBudget = std::max(0.0f, cores);
+    
+    if (gaEngine)
+        gaEngine->setCpuBudget(backgroundCpuBudget);
+    
+    if (auto* mlpModel = getPreferenceModel())
+        mlpModel->setCpuBudget(backgroundCpuBudget);
+}
+
+void JX11AudioProcessor::setGenerationBudget(GAConfig::BudgetMode mode, float targetMs)
+{
+    generationBudgetMode = mode;
+    generationBudgetTargetMs = std::max(0.0f, targetMs);
+    
+    // Keeps the rest of the running configuration
+    if (gaEngine)
+        setGAConfig(gaEngine->getConfig());
+}
+
+void JX11AudioProcessor::applyGenerationBudget(GAConfig& config) const
+{
+    config.budgetMode = generationBudgetMode;
+    
+    // A zero target keeps GAConfig's default for the mode
+    if (generationBudgetTargetMs > 0.0f && generationBudgetMode == GAConfig::BudgetMode::Latency)
+        config.targetLatencyMs = generationBudgetTargetMs;
+    else if (generationBudgetTargetMs > 0.0f && generationBudgetMode == GAConfig::BudgetMode::CpuTime)
+        config.targetCpuMsPerSecond = generationBudgetTargetMs;
+}
+
+bool JX11AudioProcessor::getGenerationBudgetStats(GenerationBudget::Stats& statsOut) const
+{
+    if (!gaEngine)
+        return false;
+    
+    statsOut = gaEngine->getBudgetStats();
+    return true;
+}
+
+bool JX11AudioProcessor::getFeatureCacheStats(AudioFeatureCache::Stats& statsOut) const
+{
+    auto* mlpModel = getPreferenceModel();
+    if (mlpModel == nullptr)
+        return false;
+    
+    statsOut = mlpModel->getFeatureCacheStats();
+    return true;
+}
+
+bool JX11AudioProcessor::getModelMetrics(OnlineMetrics::Stats& statsOut) const
+{
+    auto* mlpModel = getPreferenceModel();
+    if (mlpModel == nullptr)
+        return false;
+    
+    statsOut = mlpModel->getOnlineMetrics();
+    return true;
+}
+
+void JX11AudioProcessor::startTrace()
+{
+    Trace::start();
+}
+
+juce::File JX11AudioProcessor::stopTrace()
+{
+    const auto file = Trace::stopAndExport();
+    DBG("Trace written to " << file.getFullPathName());
+    return file;
+}
+
+bool JX11AudioProcessor::isTracing() const
+{
+    return Trace::isRecording();
+}
+
+AudioLoadMeter::Snapshot JX11AudioProcessor::getAudioLoad(bool takePeak)
+{
+    return audioLoadMeter.getSnapshot(takePeak);
+}
+
+const ThreadCpuMeter* JX11AudioProcessor::getGAThreadCpuMeter() const
+{
+    return gaEngine != nullptr ? &gaEngine->getThreadCpuMeter() : nullptr;
+}
+
+const ThreadCpuMeter* JX11AudioProcessor::getTrainingThreadCpuMeter() const
+{
+    auto* mlpModel = getPreferenceModel();
+    return mlpModel != nullptr ? &mlpModel->getThreadCpuMeter() : nullptr;
+}
+
+void JX11AudioProcessor::retrainPreferenceModel()
+{
+    if (auto* mlpModel = getPreferenceModel())
+        mlpModel->requestRetrain();
+}
+
+bool JX11AudioProcessor::getRetrainProgress(float& progressOut) const
+{
+    auto* mlpModel = getPreferenceModel();
+    if (mlpModel == nullptr || !mlpModel->isRetraining())
+        return false;
+    
+    progressOut = mlpModel->getRetrainProgress();
+    return true;
+}
+
+void JX11AudioProcessor::setFastMathEnabled(bool enabled)
+{
+    fastMathEnabled.store(enabled);
+    parametersChanged.store(true);  // Picked up by update() on the audio thread
+}
+
 //==============================================================================
 // Parameter Bridge Integration
 
 void JX11AudioProcessor::timerCallback()
 {
-    if (!gaEngine || !gaEngine->getParameterBridge())
-        return;
-             
-    // Gradually interpolate toward target
-    if (isInterpolating)
+    // Background work yields while the audio thread is near its deadline
+    const float audioLoad = audioLoadMeter.getAverageLoad();
+    if (gaEngine)
+        gaEngine->setAudioLoad(audioLoad);
+    if (sharedModel)
+        sharedModel->setAudioLoad(audioLoad);
+    
+    // Tell the host about a settled glide, once per preset
+    const uint32_t settled = gaSettledVersion.load(std::memory_order_acquire);
+    if (settled != gaReleasedVersion.load() && settled == gaTargetVersion.load())
     {
-        interpolateAndApplyParameters();
+        for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+            gaParameters[i]->setValueNotifyingHost(gaTarget[i].load());
+        
+        gaReleasedVersion.store(settled, std::memory_order_release);
     }
+    
+    // Candidates arrive from the GA thread; the UI hears about them from here
+    publishGAState();
+}
+
+void JX11AudioProcessor::publishGAState()
+{
+    const bool running = isGARunning();
+    const bool paused = isGAPaused();
+    const int candidates = getNumCandidatesAvailable();
+    
+    if (running == publishedRunning && paused == publishedPaused && candidates == publishedCandidates)
+        return;
+    
+    publishedRunning = running;
+    publishedPaused = paused;
+    publishedCandidates = candidates;
+    gaStateBroadcaster.sendChangeMessage();
 }
 
 bool JX11AudioProcessor::fetchNextPreset()
@@ -937,10 +1156,33 @@ bool JX11AudioProcessor::fetchNextPreset()
     // Pop a single solution from the queue
     if (gaEngine->getParameterBridge()->pop(params, fitness))
     {
-        targetParameters = params;
-        isInterpolating = true;
+        // An instant switch gets its coefficients computed here, off the audio thread
+        const float sampleRate = float(getSampleRate());
+        const bool instant = getPresetTransition() == PresetTransition::Instant && sampleRate > 0.0f;
+        if (instant)
+        {
+            SynthParameters::Values values {};
+            for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+                values[gaSynthIndices[i]] = gaParameters[i]->convertFrom0to1(params[static_cast<size_t>(i)]);
+            
+            SynthParameters::TimbreCoefficients coefficients;
+            SynthParameters::applyTimbre(coefficients, values, SynthParameters::timbreMask, sampleRate);
+            
+            float raw[SynthParameters::TimbreCoefficients::FLOAT_COUNT];
+            std::memcpy(raw, &coefficients, sizeof(coefficients));
+            for (size_t i = 0; i < gaTargetCoefficients.size(); ++i)
+                gaTargetCoefficients[i].store(raw[i], std::memory_order_relaxed);
+        }
+        
+        // Picked up by the audio thread on its next block
+        for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+            gaTarget[i].store(params[static_cast<size_t>(i)], std::memory_order_relaxed);
+        gaTargetSampleRate.store(instant ? sampleRate : 0.0f, std::memory_order_relaxed);
+        gaTargetVersion.fetch_add(1, std::memory_order_release);
+        
         lastGAFitness = fitness;
         presetLoadTime = juce::Time::getCurrentTime();
+        publishGAState();
         return true;
     }
     
@@ -957,50 +1199,98 @@ int JX11AudioProcessor::getNumCandidatesAvailable() const
     if (!gaEngine || !gaEngine->getParameterBridge())
         return 0;
         
-    return gaEngine->getParameterBridge()->hasData() ? 1 : 0;
+    return gaEngine->getParameterBridge()->getNumAvailable();
 }
 
-void JX11AudioProcessor::interpolateAndApplyParameters()
+void JX11AudioProcessor::pollGATarget()
 {
-    // Calculate exponential smoothing coefficient
-    // alpha = 1 - e^(-dt/tau) where dt = timer interval, tau = smoothing time
-    float alpha = 1.0f - std::exp(-timerInterval / parameterSmoothingTime);
-    
-    bool allParamsReached = true;
-    const float threshold = 0.001f;  // Consider "reached" if within 0.1%
-    
-    // Array of 17 GA-controlled parameter pointers (matches HeadlessParam order)
-    // Excluded: oscTune, glideMode, glideRate, glideBend, filterVelocity, octave, tuning, outputLevel, polyMode
-    juce::RangedAudioParameter* params[17] =
-    {
-        oscMixParam, oscFineParam,
-        filterFreqParam, filterResoParam, filterEnvParam, filterLFOParam,
-        filterAttackParam, filterDecayParam, filterSustainParam, filterReleaseParam,
-        envAttackParam, envDecayParam, envSustainParam, envReleaseParam,
-        lfoRateParam, vibratoParam, noiseParam
-    };
+    const uint32_t version = gaTargetVersion.load(std::memory_order_acquire);
     
-    // Interpolate and apply each GA parameter
-    for (int i = 0; i < 17; ++i)
+    if (version != gaAppliedVersion)
     {
-        // Exponential smoothing toward target
-        currentParameters[i] += (targetParameters[i] - currentParameters[i]) * alpha;
+        // Glide on from wherever the last one got to, else from the plugin state
+        for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+        {
+            if (!gaOverride)
+                gaSmoothed[i] = gaParameters[i]->getValue();
+            gaGlideTarget[i] = gaTarget[i].load(std::memory_order_relaxed);
+        }
+        
+        gaAppliedVersion = version;
+        gaOverride = true;
         
-        // Check if we've reached the target
-        if (std::abs(targetParameters[i] - currentParameters[i]) > threshold)
+        const float coefficientRate = gaTargetSampleRate.load(std::memory_order_relaxed);
+        if (coefficientRate == 0.0f)
         {
-            allParamsReached = false;
+            gaGliding = true;
+            return;
         }
         
-        // Apply to APVTS (already normalized [0,1])
-        params[i]->setValueNotifyingHost(currentParameters[i]);
+        // Instant: jump to the target. Its timbre coefficients are copied in
+        // and marked applied, leaving update() the rest (oscFine's detune);
+        // computed at another sample rate they are left for update() too.
+        gaSmoothed = gaGlideTarget;
+        gaGliding = false;
+        
+        if (coefficientRate == float(getSampleRate()))
+        {
+            float raw[SynthParameters::TimbreCoefficients::FLOAT_COUNT];
+            for (size_t i = 0; i < gaTargetCoefficients.size(); ++i)
+                raw[i] = gaTargetCoefficients[i].load(std::memory_order_relaxed);
+            
+            SynthParameters::TimbreCoefficients coefficients;
+            std::memcpy(&coefficients, raw, sizeof(coefficients));
+            coefficients.copyTo(synth);
+            
+            for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+                if ((SynthParameters::timbreMask & SynthParameters::bit(gaSynthIndices[i])) != 0)
+                    appliedSynthValues[gaSynthIndices[i]] = gaParameters[i]->convertFrom0to1(gaSmoothed[i]);
+        }
+        
+        update();
+        gaSettledVersion.store(version, std::memory_order_release);
+    }
+    else if (gaOverride && !gaGliding && gaReleasedVersion.load(std::memory_order_acquire) == version)
+    {
+        // The plugin state holds the same values now
+        gaOverride = false;
+    }
+}
+
+void JX11AudioProcessor::advanceGAGlide(int numSamples)
+{
+    // Exponential smoothing: alpha = 1 - e^(-dt/tau) for a chunk dt seconds long
+    const float alpha = 1.0f - std::exp(-static_cast<float>(numSamples) / (parameterSmoothingTime * float(getSampleRate())));
+    const float threshold = 0.001f;  // Consider "reached" if within 0.1%
+    bool allParamsReached = true;
+    
+    for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+    {
+        gaSmoothed[i] += (gaGlideTarget[i] - gaSmoothed[i]) * alpha;
+        if (std::abs(gaGlideTarget[i] - gaSmoothed[i]) > threshold)
+            allParamsReached = false;
     }
     
-    // If all parameters reached target, stop interpolating to save CPU
     if (allParamsReached)
     {
-        isInterpolating = false;
+        gaSmoothed = gaGlideTarget;
+        gaGliding = false;
+        gaSettledVersion.store(gaAppliedVersion, std::memory_order_release);
     }
+    
+    update();
+}
+
+float JX11AudioProcessor::getEffectiveValue(juce::AudioParameterFloat* param) const
+{
+    if (gaOverride)
+    {
+        for (int i = 0; i < GA_PARAMETER_COUNT; ++i)
+            if (gaParameters[i] == param)
+                return param->convertFrom0to1(gaSmoothed[i]);
+    }
+    
+    return param->get();
 }
 
 //==============================================================================
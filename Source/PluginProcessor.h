@@ -12,9 +12,13 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "JX11/Synth.h"
+#include "JX11/SynthParameters.h"
 #include "JX11/Preset.h"
 #include "GA/GeneticAlgorithm.h"
 #include "GA/IFitnessModel.h"
+#include "GA/AudioFeatureCache.h"
+#include "GA/SharedEngine.h"
+#include "GA/PerformanceMeter.h"
 
 // Namespace containing string identifiers for all plugin parameters,
 // each with a version number (used for state compatibility).
@@ -75,10 +79,17 @@ enum class ExperimentMode
     AllEnhancements  // All features enabled
 };
 
+//==============================================================================
+// How a fetched GA preset replaces the one sounding
+enum class PresetTransition
+{
+    Morph,   // Glide the parameters over parameterSmoothingTime
+    Instant  // Switch to coefficients prepared when the preset was fetched
+};
+
 //==============================================================================
 // Main plugin processor class for JX11
 class JX11AudioProcessor  : public juce::AudioProcessor,
-                            private juce::ValueTree::Listener,
                             private juce::Timer
 {
 public:
@@ -146,8 +157,16 @@ public:
 
     // Manual preset fetching (called from UI)
     bool fetchNextPreset();
+    
+    // Applies from the next fetched preset on (saved with the plugin state)
+    void setPresetTransition(PresetTransition transition) { presetTransition.store(transition); }
+    PresetTransition getPresetTransition() const { return presetTransition.load(); }
     int getNumCandidatesAvailable() const;
     
+    // Sends a change message when the GA starts, stops, pauses or resumes, or
+    // the number of queued candidates changes, so the UI needn't poll them
+    juce::ChangeBroadcaster& getGAStateBroadcaster() { return gaStateBroadcaster; }
+    
     // Feedback mechanism
     void logFeedback(const IFitnessModel::Feedback& feedback);
     float getPlayTimeSeconds() const;
@@ -163,14 +182,72 @@ public:
     // MLP input mode (Genome vs Audio)
     void setInputMode(GAConfig::MLPInputMode mode);
     GAConfig::MLPInputMode getInputMode() const { return currentInputMode; }
+    
+    // Audio feature cache memory (saved with the plugin state; 0 = cache default)
+    void setFeatureCacheBudget(size_t bytes);
+    size_t getFeatureCacheBudget() const { return featureCacheBudget; }
+    
+    // Feature cache telemetry; false if the fitness model has no feature cache
+    bool getFeatureCacheStats(AudioFeatureCache::Stats& statsOut) const;
+    
+    // Live model quality (like rate, pairwise agreement, errors); false if the fitness model isn't the MLP
+    bool getModelMetrics(OnlineMetrics::Stats& statsOut) const;
+    
+    // Rebuilds the preference model from every rating in the feedback log
+    void retrainPreferenceModel();
+    
+    // Retrain progress from 0 to 1; false while no retrain is running
+    bool getRetrainProgress(float& progressOut) const;
+    
+    // Approximate per-LFO-step filter math (off by default; applied on the next block)
+    void setFastMathEnabled(bool enabled);
+    bool isFastMathEnabled() const { return fastMathEnabled.load(); }
+    
+    // processBlock render time against the buffer deadline; takePeak restarts the peak
+    AudioLoadMeter::Snapshot getAudioLoad(bool takePeak);
+    
+    // CPU meters of the GA and training threads; nullptr if there is no such thread
+    const ThreadCpuMeter* getGAThreadCpuMeter() const;
+    const ThreadCpuMeter* getTrainingThreadCpuMeter() const;
+    
+    // Average cores the GA and, separately, training may use (saved with the
+    // plugin state; 0 = unlimited). Both also back off under audio load.
+    void setBackgroundCpuBudget(float cores);
+    float getBackgroundCpuBudget() const { return backgroundCpuBudget; }
+    
+    // GA generation sizing (GAConfig::budgetMode), kept across experiment modes and
+    // saved with the plugin state; targetMs is ms per generation, or CPU ms per second
+    void setGenerationBudget(GAConfig::BudgetMode mode, float targetMs);
+    GAConfig::BudgetMode getGenerationBudgetMode() const { return generationBudgetMode; }
+    float getGenerationBudgetTarget() const { return generationBudgetTargetMs; }
+    
+    // What the budget chose and measured; false if there is no GA
+    bool getGenerationBudgetStats(GenerationBudget::Stats& statsOut) const;
+    
+    // Chrome trace of the GA, training and audio hot paths (GA/Trace.h); also
+    // started at load when PPG_TRACE is set. stopTrace() returns the file written, or {}.
+    void startTrace();
+    juce::File stopTrace();
+    bool isTracing() const;
 
 private:
-    // Timer callback - polls parameter bridge and applies smoothed updates
+    // Timer callback - hands settled GA preset glides to the host, audio load to background work
     void timerCallback() override;
+    
+    // Message thread: broadcasts the GA state if it changed since last time
+    void publishGAState();
+    juce::ChangeBroadcaster gaStateBroadcaster;
+    bool publishedRunning = false, publishedPaused = false;
+    int publishedCandidates = -1;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JX11AudioProcessor)
     
-    // Fitness model (owned by Processor)
-    std::unique_ptr<IFitnessModel> fitnessModel;
+    // Fitness model: the user profile's, shared with every other instance in
+    // the process (declared before gaEngine, which must go first)
+    std::unique_ptr<SharedEngine::ModelHandle> sharedModel;
+    IFitnessModel* fitnessModel = nullptr;
+    
+    // The model behind the handle, for the settings and stats every instance shares
+    MLPPreferenceModel* getPreferenceModel() const { return sharedModel ? &sharedModel->getModel() : nullptr; }
 
     // Splits the audio buffer based on incoming MIDI events
     void splitBufferByEvents(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
@@ -181,16 +258,15 @@ private:
     // Renders audio for a given buffer range using active voices
     void render(juce::AudioBuffer<float>& buffer, int sampleCount, int bufferOffset);
 
-    // Called when a parameter value changes in the APVTS
-    void valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) override
-    {
-        parametersChanged.store(true); // Flag for deferred DSP update
-    }
-
-    std::atomic<bool> parametersChanged { false }; // Used to trigger synth update on param change
+    std::atomic<bool> parametersChanged { false }; // Forces a full synth update (sample rate, state restore)
+    std::atomic<bool> fastMathEnabled { false };   // Mirrored into synth.fastMath by update()
+    AudioLoadMeter audioLoadMeter;
 
-    // Recalculates synth internals after parameters have changed
-    void update();
+    // Called every block: compares the parameter values with the last ones
+    // applied and recomputes only the synth coefficients that depend on the
+    // ones that moved, or all of them when all is set
+    void update(bool all = false);
+    SynthParameters::Values appliedSynthValues {};  // Audio thread only
 
     // Initializes the list of factory presets
     void createPrograms();
@@ -201,21 +277,57 @@ private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     Synth synth; // The core synthesizer engine
-    std::unique_ptr<GeneticAlgorithm> gaEngine; // The genetic algorithm engine
+    std::unique_ptr<GeneticAlgorithm> gaEngine; // This instance's GA, on the shared worker pool
+    
+    // GA preset transitions, smoothed on the audio thread. fetchNextPreset
+    // publishes the target once; processBlock glides toward it, overriding the
+    // GA parameters' values in update(), and the host is told the new values
+    // once, by the timer, when the glide has settled.
+    static constexpr int GA_PARAMETER_COUNT = 17;
+    std::array<juce::AudioParameterFloat*, GA_PARAMETER_COUNT> gaParameters {};  // HeadlessParam order
+    std::array<SynthParameters::Index, GA_PARAMETER_COUNT> gaSynthIndices {};    // Each one's SynthParameters entry
+    std::array<std::atomic<float>, GA_PARAMETER_COUNT> gaTarget {};  // Normalized [0,1], written before gaTargetVersion
+    std::atomic<uint32_t> gaTargetVersion { 0 };
+    std::atomic<uint32_t> gaSettledVersion { 0 };   // Set by the audio thread when a glide ends
+    std::atomic<uint32_t> gaReleasedVersion { 0 };  // Set once the host has the settled values
+    
+    // Instant transitions skip the glide: fetchNextPreset also publishes the
+    // target's timbre coefficients, so the audio thread copies them in rather
+    // than computing them mid-block
+    std::atomic<PresetTransition> presetTransition { PresetTransition::Morph };
+    std::array<std::atomic<float>, SynthParameters::TimbreCoefficients::FLOAT_COUNT> gaTargetCoefficients {};
+    std::atomic<float> gaTargetSampleRate { 0.0f };  // Rate they were computed at; 0 = glide to the target
+    
+    // Audio thread only
+    std::array<float, GA_PARAMETER_COUNT> gaSmoothed {};
+    std::array<float, GA_PARAMETER_COUNT> gaGlideTarget {};
+    uint32_t gaAppliedVersion = 0;
+    bool gaGliding = false;
+    bool gaOverride = false;  // update() reads gaSmoothed instead of the APVTS values
     
-    // Parameter smoothing for GA updates
-    std::vector<float> targetParameters;   // Target from GA (17 floats, normalized [0,1])
-    std::vector<float> currentParameters;  // Current smoothed values
-    bool isInterpolating = false;
     float lastGAFitness = 0.0f;            // Most recent fitness from GA
-    static constexpr float parameterSmoothingTime = 0.7f;  // 700ms to reach target
+    static constexpr float parameterSmoothingTime = 0.7f;  // Time constant of the glide
     static constexpr float timerInterval = 0.02f;          // 20ms timer rate (50Hz)
+    static constexpr int gaSmoothingChunkSize = 128;       // Samples between coefficient updates while gliding
     juce::Time presetLoadTime;             // When current preset was loaded (for play time tracking)
     ExperimentMode currentExperimentMode = ExperimentMode::Baseline;
     GAConfig::MLPInputMode currentInputMode = GAConfig::MLPInputMode::Genome;
+    size_t featureCacheBudget = 0;
+    float backgroundCpuBudget = 0.0f;
+    GAConfig::BudgetMode generationBudgetMode = GAConfig::BudgetMode::Fixed;
+    float generationBudgetTargetMs = 0.0f;
+    
+    // Copies the processor's generation budget into config
+    void applyGenerationBudget(GAConfig& config) const;
 
-    // Apply interpolated parameters to synth
-    void interpolateAndApplyParameters();
+    // Audio thread: takes up a new GA target, or drops the override once the host has it
+    void pollGATarget();
+    
+    // Audio thread: steps the glide by numSamples and recomputes the synth coefficients
+    void advanceGAGlide(int numSamples);
+    
+    // A parameter's plain value as the synth should see it (the glide's while one overrides it)
+    float getEffectiveValue(juce::AudioParameterFloat* param) const;
 
     // Pointers to all individual plugin parameters (linked to APVTS)
     // These are read during audio rendering or used in the UI
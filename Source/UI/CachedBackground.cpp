@@ -0,0 +1,29 @@
+#include "CachedBackground.h"
+
+void CachedBackground::draw(juce::Graphics& g, juce::Rectangle<int> bounds,
+                            const std::function<void(juce::Graphics&)>& render)
+{
+    if (bounds.isEmpty())
+        return;
+
+    // Rendered at physical pixels, so it stays sharp on high-DPI displays
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (!image.isValid() || bounds != imageBounds || scale != imageScale)
+    {
+        image = juce::Image(juce::Image::ARGB,
+                            juce::jmax(1, juce::roundToInt(bounds.getWidth() * scale)),
+                            juce::jmax(1, juce::roundToInt(bounds.getHeight() * scale)),
+                            true);
+
+        juce::Graphics imageGraphics(image);
+        imageGraphics.addTransform(juce::AffineTransform::scale(scale));
+        imageGraphics.setOrigin(-bounds.getPosition());
+        render(imageGraphics);
+
+        imageBounds = bounds;
+        imageScale = scale;
+    }
+
+    g.drawImage(image, bounds.toFloat());
+}
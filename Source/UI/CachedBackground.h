@@ -0,0 +1,25 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <functional>
+
+// A component's static backdrop (fills, cards, titles) rendered once into an
+// image at the display's pixel scale, then blitted. Repaints of the controls
+// on top, which repaint the region beneath them too, become image copies
+// instead of rebuilding rounded-rectangle paths and glyphs.
+class CachedBackground
+{
+public:
+    // Draws bounds from the cache, first re-rendering it with render (in
+    // local coordinates) if the size or pixel scale changed since
+    void draw(juce::Graphics& g, juce::Rectangle<int> bounds,
+              const std::function<void(juce::Graphics&)>& render);
+
+    // Re-render on the next draw, e.g. when the layout or a title changed
+    void invalidate() { image = {}; }
+
+private:
+    juce::Image image;
+    juce::Rectangle<int> imageBounds;
+    float imageScale = 0.0f;
+};
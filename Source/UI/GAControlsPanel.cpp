@@ -100,23 +100,172 @@ GAControlsPanel::GAControlsPanel(JX11AudioProcessor& processor)
     };
     addAndMakeVisible(inputModeBox);
 
+    // Preset transition: glide to the next preset, or switch to it at once
+    transitionLabel.setText("Audition", juce::dontSendNotification);
+    transitionLabel.setJustificationType(juce::Justification::centredRight);
+    transitionLabel.setFont(juce::Font(juce::FontOptions().withHeight(12.0f)));
+    addAndMakeVisible(transitionLabel);
+
+    transitionBox.addItem("Smooth Morph", 1);
+    transitionBox.addItem("Instant", 2);
+    transitionBox.setSelectedId(static_cast<int>(audioProcessor.getPresetTransition()) + 1,
+                                juce::dontSendNotification);
+    transitionBox.onChange = [this]()
+    {
+        int id = transitionBox.getSelectedId();
+        audioProcessor.setPresetTransition(static_cast<PresetTransition>(id - 1));
+    };
+    addAndMakeVisible(transitionBox);
+
+    // Generation budget: a fixed offspring count, or sized to a time target
+    budgetLabel.setText("Budget", juce::dontSendNotification);
+    budgetLabel.setJustificationType(juce::Justification::centredRight);
+    budgetLabel.setFont(juce::Font(juce::FontOptions().withHeight(12.0f)));
+    addAndMakeVisible(budgetLabel);
+
+    struct BudgetChoice { GAConfig::BudgetMode mode; float targetMs; const char* name; };
+    static const BudgetChoice budgetChoices[] =
+    {
+        { GAConfig::BudgetMode::Fixed, 0.0f, "Fixed Size" },
+        { GAConfig::BudgetMode::Latency, 150.0f, "Latency 150 ms" },
+        { GAConfig::BudgetMode::Latency, 500.0f, "Latency 500 ms" },
+        { GAConfig::BudgetMode::CpuTime, 100.0f, "CPU 100 ms/s" },
+        { GAConfig::BudgetMode::CpuTime, 250.0f, "CPU 250 ms/s" }
+    };
+
+    int selectedBudget = 1;
+    for (int i = 0; i < static_cast<int>(std::size(budgetChoices)); ++i)
+    {
+        const auto& choice = budgetChoices[i];
+        budgetBox.addItem(choice.name, i + 1);
+        if (choice.mode == audioProcessor.getGenerationBudgetMode()
+            && (choice.mode == GAConfig::BudgetMode::Fixed || choice.targetMs == audioProcessor.getGenerationBudgetTarget()))
+            selectedBudget = i + 1;
+    }
+
+    budgetBox.setSelectedId(selectedBudget, juce::dontSendNotification);
+    budgetBox.onChange = [this]()
+    {
+        const auto& choice = budgetChoices[budgetBox.getSelectedId() - 1];
+        audioProcessor.setGenerationBudget(choice.mode, choice.targetMs);
+    };
+    addAndMakeVisible(budgetBox);
+
+    // Feature cache telemetry
+    cacheStatsLabel.setJustificationType(juce::Justification::centredLeft);
+    cacheStatsLabel.setFont(juce::Font(juce::FontOptions().withHeight(11.0f)));
+    cacheStatsLabel.setColour(juce::Label::textColourId, juce::Colour(PPGLookAndFeel::kGroupHeader));
+    addAndMakeVisible(cacheStatsLabel);
+
+    // Bulk retrain from the feedback history
+    retrainButton.setButtonText("Retrain");
+    retrainButton.setColour(juce::TextButton::buttonColourId, juce::Colour(PPGLookAndFeel::kNeutral));
+    retrainButton.setColour(juce::TextButton::textColourOffId, juce::Colours::white);
+    retrainButton.onClick = [this]()
+    {
+        audioProcessor.retrainPreferenceModel();
+        updateRetrainStatus();
+    };
+    addAndMakeVisible(retrainButton);
+
+    retrainStatusLabel.setJustificationType(juce::Justification::centredLeft);
+    retrainStatusLabel.setFont(juce::Font(juce::FontOptions().withHeight(11.0f)));
+    retrainStatusLabel.setColour(juce::Label::textColourId, juce::Colour(PPGLookAndFeel::kGroupHeader));
+    addAndMakeVisible(retrainStatusLabel);
+
+    // Audio deadline and background thread load
+    for (auto* label : { &audioLoadLabel, &threadCpuLabel, &budgetStatsLabel, &modelMetricsLabel, &traceStatusLabel })
+    {
+        label->setJustificationType(juce::Justification::centredLeft);
+        label->setFont(juce::Font(juce::FontOptions().withHeight(11.0f)));
+        label->setColour(juce::Label::textColourId, juce::Colour(PPGLookAndFeel::kGroupHeader));
+        addAndMakeVisible(*label);
+    }
+
+    // Hot-path trace capture, written as Chrome trace JSON when stopped
+    traceButton.setColour(juce::TextButton::buttonColourId, juce::Colour(PPGLookAndFeel::kNeutral));
+    traceButton.setColour(juce::TextButton::textColourOffId, juce::Colours::white);
+    traceButton.onClick = [this]()
+    {
+        if (audioProcessor.isTracing())
+        {
+            const auto file = audioProcessor.stopTrace();
+            traceStatusLabel.setText(file != juce::File() ? "Trace: " + file.getFileName() : "Trace could not be written",
+                                     juce::dontSendNotification);
+        }
+        else
+        {
+            audioProcessor.startTrace();
+            traceStatusLabel.setText("Tracing...", juce::dontSendNotification);
+        }
+        updateTraceButton();
+    };
+    addAndMakeVisible(traceButton);
+
+    setOpaque(true);
+    audioProcessor.getGAStateBroadcaster().addChangeListener(this);
+
     updateButtonState();
-    startTimer(33); // 30fps
+    updateCacheStats();
+    updateRetrainStatus();
+    updateDiagnostics();
+    updateTraceButton();
+    startTimer(500); // Stats change slowly; twice a second is plenty
 }
 
 GAControlsPanel::~GAControlsPanel()
 {
     stopTimer();
+    audioProcessor.getGAStateBroadcaster().removeChangeListener(this);
 }
 
 //==============================================================================
 void GAControlsPanel::paint(juce::Graphics& g)
+{
+    background.draw(g, getLocalBounds(), [this](juce::Graphics& bg) { paintBackground(bg); });
+    paintLoadHistogram(g);
+}
+
+void GAControlsPanel::paintBackground(juce::Graphics& g)
 {
     g.fillAll(juce::Colour(PPGLookAndFeel::kBackground));
 
     paintCard(g, controlsCardBounds, "CONTROLS");
     paintCard(g, feedbackCardBounds, "FEEDBACK");
     paintCard(g, configCardBounds, "CONFIGURATION");
+    paintCard(g, diagnosticsCardBounds, "DIAGNOSTICS");
+}
+
+void GAControlsPanel::paintLoadHistogram(juce::Graphics& g)
+{
+    if (loadHistogramBounds.isEmpty())
+        return;
+
+    uint64_t largest = 1;
+    for (auto count : loadHistogram)
+        largest = std::max(largest, count);
+
+    // Log scale, so a handful of slow blocks still shows next to thousands of fast ones
+    const float scale = 1.0f / std::log1p(static_cast<float>(largest));
+    const float barWidth = loadHistogramBounds.getWidth() / static_cast<float>(AudioLoadMeter::numBins);
+    auto area = loadHistogramBounds.toFloat();
+
+    g.setColour(juce::Colour(PPGLookAndFeel::kSliderTrack));
+    g.drawHorizontalLine(loadHistogramBounds.getBottom(), area.getX(), area.getRight());
+
+    for (int bin = 0; bin < AudioLoadMeter::numBins; ++bin)
+    {
+        const auto count = loadHistogram[static_cast<size_t>(bin)];
+        if (count == 0)
+            continue;
+
+        const float height = area.getHeight() * std::log1p(static_cast<float>(count)) * scale;
+        const bool overrun = bin == AudioLoadMeter::numBins - 1;
+
+        g.setColour(juce::Colour(overrun ? PPGLookAndFeel::kNegative : PPGLookAndFeel::kAccent));
+        g.fillRect(juce::Rectangle<float>(area.getX() + bin * barWidth, area.getBottom() - height,
+                                          barWidth, height).reduced(1.0f, 0.0f));
+    }
 }
 
 void GAControlsPanel::paintCard(juce::Graphics& g, const juce::Rectangle<int>& bounds,
@@ -142,22 +291,27 @@ void GAControlsPanel::paintCard(juce::Graphics& g, const juce::Rectangle<int>& b
 //==============================================================================
 void GAControlsPanel::resized()
 {
+    background.invalidate();
+
     auto area = getLocalBounds().reduced(20);
 
     int cardGap = 12;
-    int numGaps = 2;
+    int numGaps = 3;
     int availableHeight = area.getHeight() - numGaps * cardGap;
 
-    // Proportional card heights: Controls ~28%, Feedback ~40%, Config ~32%
-    int controlsH = (int)(availableHeight * 0.28f);
-    int feedbackH = (int)(availableHeight * 0.40f);
+    // Proportional card heights: Controls ~22%, Feedback ~28%, Config ~30%, Diagnostics ~20%
+    int controlsH = (int)(availableHeight * 0.22f);
+    int feedbackH = (int)(availableHeight * 0.28f);
+    int configH = (int)(availableHeight * 0.30f);
     auto content = area;
 
     controlsCardBounds = content.removeFromTop(controlsH);
     content.removeFromTop(cardGap);
     feedbackCardBounds = content.removeFromTop(feedbackH);
     content.removeFromTop(cardGap);
-    configCardBounds = content;
+    configCardBounds = content.removeFromTop(configH);
+    content.removeFromTop(cardGap);
+    diagnosticsCardBounds = content;
 
     // Layout inside Controls card
     {
@@ -184,7 +338,7 @@ void GAControlsPanel::resized()
     {
         auto inner = configCardBounds.reduced(20, 0);
         inner.removeFromTop(30);
-        int rowH = juce::jmin(36, (inner.getHeight() - 10) / 2);
+        int rowH = juce::jmin(36, (inner.getHeight() - 50) / 6);
 
         auto row1 = inner.removeFromTop(rowH);
         experimentLabel.setBounds(row1.removeFromLeft(100));
@@ -195,18 +349,147 @@ void GAControlsPanel::resized()
         auto row2 = inner.removeFromTop(rowH);
         inputModeLabel.setBounds(row2.removeFromLeft(100));
         inputModeBox.setBounds(row2.reduced(6, 4));
+
+        inner.removeFromTop(10);
+
+        auto row3 = inner.removeFromTop(rowH);
+        transitionLabel.setBounds(row3.removeFromLeft(100));
+        transitionBox.setBounds(row3.reduced(6, 4));
+
+        inner.removeFromTop(10);
+
+        auto row4 = inner.removeFromTop(rowH);
+        budgetLabel.setBounds(row4.removeFromLeft(100));
+        budgetBox.setBounds(row4.reduced(6, 4));
+
+        inner.removeFromTop(10);
+
+        cacheStatsLabel.setBounds(inner.removeFromTop(rowH));
+
+        inner.removeFromTop(10);
+
+        auto row6 = inner.removeFromTop(rowH);
+        retrainButton.setBounds(row6.removeFromLeft(100).reduced(6, 4));
+        retrainStatusLabel.setBounds(row6);
+    }
+
+    // Layout inside Diagnostics card
+    {
+        auto inner = diagnosticsCardBounds.reduced(20, 0);
+        inner.removeFromTop(28);
+        audioLoadLabel.setBounds(inner.removeFromTop(16));
+        threadCpuLabel.setBounds(inner.removeFromTop(16));
+        budgetStatsLabel.setBounds(inner.removeFromTop(16));
+        modelMetricsLabel.setBounds(inner.removeFromTop(16));
+        auto traceRow = inner.removeFromTop(24);
+        traceButton.setBounds(traceRow.removeFromLeft(100).reduced(6, 2));
+        traceStatusLabel.setBounds(traceRow);
+        inner.removeFromTop(4);
+        loadHistogramBounds = inner.removeFromTop(juce::jmax(0, inner.getHeight() - 12));
     }
 }
 
 //==============================================================================
 void GAControlsPanel::timerCallback()
+{
+    updateCacheStats();
+    updateRetrainStatus();
+    updateDiagnostics();
+    updateTraceButton();
+}
+
+void GAControlsPanel::changeListenerCallback(juce::ChangeBroadcaster*)
 {
     updateButtonState();
+}
 
-    bool hasPreset = audioProcessor.getNumCandidatesAvailable() > 0;
-    likeButton.setEnabled(hasPreset);
-    dislikeButton.setEnabled(hasPreset);
-    skipButton.setEnabled(hasPreset);
+void GAControlsPanel::updateCacheStats()
+{
+    AudioFeatureCache::Stats stats;
+    if (!audioProcessor.getFeatureCacheStats(stats))
+    {
+        cacheStatsLabel.setText({}, juce::dontSendNotification);
+        return;
+    }
+
+    juce::String text = "Feature cache: ";
+    if (stats.hits + stats.misses == 0)
+        text += "idle, ";
+    else
+        text += juce::String(juce::roundToInt(stats.getHitRate() * 100.0f)) + "% hits, "
+              + juce::String(stats.getAverageMissMs(), 1) + " ms/miss, ";
+
+    text += juce::String(static_cast<int>(stats.entries)) + "/" + juce::String(static_cast<int>(stats.capacity))
+          + " (" + juce::String(static_cast<int>(stats.memoryBytes / 1024)) + " KB)";
+
+    if (stats.evictions > 0)
+        text += ", " + juce::String(static_cast<int>(stats.evictions)) + " evicted";
+
+    cacheStatsLabel.setText(text, juce::dontSendNotification);
+}
+
+void GAControlsPanel::updateRetrainStatus()
+{
+    float progress = 0.0f;
+    const bool active = audioProcessor.getRetrainProgress(progress);
+
+    retrainButton.setEnabled(!active);
+    retrainStatusLabel.setText(active ? "Retraining from history: " + juce::String(juce::roundToInt(progress * 100.0f)) + "%"
+                                      : juce::String(),
+                               juce::dontSendNotification);
+}
+
+void GAControlsPanel::updateDiagnostics()
+{
+    // The peak is the worst block since the previous refresh
+    const auto load = audioProcessor.getAudioLoad(true);
+    auto percent = [](float fraction) { return juce::String(juce::roundToInt(fraction * 100.0f)) + "%"; };
+
+    audioLoadLabel.setText("Audio: " + percent(load.averageLoad) + " of deadline, peak " + percent(load.peakLoad)
+                               + ", " + juce::String(static_cast<juce::int64>(load.getOverruns())) + " overruns",
+                           juce::dontSendNotification);
+
+    juce::String cpu = "Thread CPU:";
+    if (auto* meter = audioProcessor.getGAThreadCpuMeter())
+        cpu += " GA " + percent(meter->getUsage(gaCpuReading));
+    if (auto* meter = audioProcessor.getTrainingThreadCpuMeter())
+        cpu += ", training " + percent(meter->getUsage(trainingCpuReading));
+
+    threadCpuLabel.setText(cpu, juce::dontSendNotification);
+
+    GenerationBudget::Stats budget;
+    juce::String budgetText;
+    if (audioProcessor.getGenerationBudgetStats(budget) && budget.offspringPerGeneration > 0)
+    {
+        budgetText = "Generations: " + juce::String(budget.offspringPerGeneration) + " offspring, "
+                   + juce::String(budget.generationMs, 1) + " ms";
+        if (budget.targetMs > 0.0f)
+            budgetText += " (target " + juce::String(budget.targetMs, 1) + ")";
+        if (budget.fetchLatencyMs > 0.0f)
+            budgetText += ", next preset " + juce::String(budget.fetchLatencyMs, 1) + " ms after a fetch";
+    }
+
+    budgetStatsLabel.setText(budgetText, juce::dontSendNotification);
+
+    // The predictions of the MLP the GA is currently scoring with
+    OnlineMetrics::Stats metrics;
+    juce::String metricsText;
+    if (audioProcessor.getModelMetrics(metrics) && metrics.ratings > 0)
+    {
+        const auto& model = audioProcessor.getInputMode() == GAConfig::MLPInputMode::Audio ? metrics.audio : metrics.genome;
+        metricsText = "Model: " + juce::String(static_cast<juce::int64>(metrics.ratings)) + " ratings, "
+                    + percent(metrics.getLikeRate()) + " liked, error " + juce::String(model.rollingError, 2);
+        if (model.pairs > 0)
+            metricsText += ", pairwise agreement " + percent(model.getPairwiseAgreement());
+    }
+
+    modelMetricsLabel.setText(metricsText, juce::dontSendNotification);
+
+    if (load.histogram != loadHistogram)
+    {
+        loadHistogram = load.histogram;
+        repaint(loadHistogramBounds);
+    }
 }
 
 void GAControlsPanel::updateButtonState()
@@ -227,6 +510,11 @@ void GAControlsPanel::updateButtonState()
 
     pauseResumeButton.setEnabled(isRunning);
 
+    bool hasPreset = audioProcessor.getNumCandidatesAvailable() > 0;
+    likeButton.setEnabled(hasPreset);
+    dislikeButton.setEnabled(hasPreset);
+    skipButton.setEnabled(hasPreset);
+
     if (isPaused)
     {
         pauseResumeButton.setButtonText("Resume");
@@ -238,3 +526,8 @@ void GAControlsPanel::updateButtonState()
         pauseResumeButton.setColour(juce::TextButton::buttonColourId, juce::Colour(PPGLookAndFeel::kNeutral));
     }
 }
+
+void GAControlsPanel::updateTraceButton()
+{
+    traceButton.setButtonText(audioProcessor.isTracing() ? "Stop Trace" : "Trace");
+}
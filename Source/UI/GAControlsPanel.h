@@ -2,9 +2,13 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../PluginProcessor.h"
+#include "CachedBackground.h"
 
+// Buttons follow the processor's GA state broadcasts; only the slowly
+// changing statistics are refreshed on a timer
 class GAControlsPanel : public juce::Component,
-                        public juce::Timer
+                        public juce::Timer,
+                        private juce::ChangeListener
 {
 public:
     explicit GAControlsPanel(JX11AudioProcessor& processor);
@@ -31,13 +35,41 @@ private:
     juce::ComboBox experimentModeBox;
     juce::Label inputModeLabel;
     juce::ComboBox inputModeBox;
+    juce::Label transitionLabel;
+    juce::ComboBox transitionBox;
+    juce::Label budgetLabel;
+    juce::ComboBox budgetBox;
+    juce::Label cacheStatsLabel;
+    juce::TextButton retrainButton;
+    juce::Label retrainStatusLabel;
+
+    // Diagnostics card
+    juce::Label audioLoadLabel;
+    juce::Label threadCpuLabel;
+    juce::Label budgetStatsLabel;
+    juce::Label modelMetricsLabel;
+    juce::TextButton traceButton;
+    juce::Label traceStatusLabel;
+    std::array<uint64_t, AudioLoadMeter::numBins> loadHistogram {};
+    ThreadCpuMeter::Reading gaCpuReading;
+    ThreadCpuMeter::Reading trainingCpuReading;
 
     // Card bounds for painting
     juce::Rectangle<int> controlsCardBounds;
     juce::Rectangle<int> feedbackCardBounds;
     juce::Rectangle<int> configCardBounds;
+    juce::Rectangle<int> diagnosticsCardBounds;
+    juce::Rectangle<int> loadHistogramBounds;
+    CachedBackground background;  // Background and cards, re-rendered only on resize or a display scale change
 
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
     void updateButtonState();
+    void updateCacheStats();
+    void updateRetrainStatus();
+    void updateDiagnostics();
+    void updateTraceButton();
+    void paintBackground(juce::Graphics& g);
+    void paintLoadHistogram(juce::Graphics& g);
     void paintCard(juce::Graphics& g, const juce::Rectangle<int>& bounds, const juce::String& title);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GAControlsPanel)
@@ -40,6 +40,41 @@ PPGLookAndFeel::PPGLookAndFeel()
 }
 
 //==============================================================================
+const juce::Image& PPGLookAndFeel::getKnobTrack(int width, int height, float startAngle, float endAngle, float scale)
+{
+    for (const auto& track : knobTracks)
+        if (track.width == width && track.height == height && track.startAngle == startAngle
+            && track.endAngle == endAngle && track.scale == scale)
+            return track.image;
+
+    // A handful of knob sizes per editor size; drop the oldest beyond that
+    if (knobTracks.size() >= maxKnobTracks)
+        knobTracks.erase(knobTracks.begin());
+
+    KnobTrack track { width, height, startAngle, endAngle, scale,
+                      juce::Image(juce::Image::ARGB, juce::jmax(1, juce::roundToInt(width * scale)),
+                                  juce::jmax(1, juce::roundToInt(height * scale)), true) };
+
+    {
+        juce::Graphics g(track.image);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
+        auto bounds = juce::Rectangle<int>(0, 0, width, height).toFloat().reduced(4.0f);
+        auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
+        auto trackWidth = 3.0f;
+
+        juce::Path path;
+        path.addCentredArc(bounds.getCentreX(), bounds.getCentreY(), radius - trackWidth * 0.5f, radius - trackWidth * 0.5f,
+                           0.0f, startAngle, endAngle, true);
+        g.setColour(juce::Colour(kSliderTrack));
+        g.strokePath(path, juce::PathStrokeType(trackWidth, juce::PathStrokeType::curved,
+                                                juce::PathStrokeType::rounded));
+    }
+
+    knobTracks.push_back(std::move(track));
+    return knobTracks.back().image;
+}
+
 void PPGLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
                                        float sliderPos, float rotaryStartAngle,
                                        float rotaryEndAngle, juce::Slider&)
@@ -52,15 +87,10 @@ void PPGLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width
 
     auto trackWidth = 3.0f;
 
-    // Background track (full arc)
-    {
-        juce::Path track;
-        track.addCentredArc(centreX, centreY, radius - trackWidth * 0.5f, radius - trackWidth * 0.5f,
-                            0.0f, rotaryStartAngle, rotaryEndAngle, true);
-        g.setColour(juce::Colour(kSliderTrack));
-        g.strokePath(track, juce::PathStrokeType(trackWidth, juce::PathStrokeType::curved,
-                                                  juce::PathStrokeType::rounded));
-    }
+    // Background track (full arc), from the cache
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    g.drawImage(getKnobTrack(width, height, rotaryStartAngle, rotaryEndAngle, scale),
+                juce::Rectangle<int>(x, y, width, height).toFloat());
 
     // Filled arc (value)
     if (sliderPos > 0.0f)
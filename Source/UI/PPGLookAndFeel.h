@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <vector>
 
 class PPGLookAndFeel : public juce::LookAndFeel_V4
 {
@@ -58,5 +59,19 @@ public:
     juce::Font getPopupMenuFont() override;
 
 private:
+    // Knob background tracks, pre-rendered per knob size, angles and pixel
+    // scale; knobs then only stroke their value arc and thumb
+    struct KnobTrack
+    {
+        int width = 0, height = 0;
+        float startAngle = 0.0f, endAngle = 0.0f, scale = 0.0f;
+        juce::Image image;
+    };
+
+    static constexpr size_t maxKnobTracks = 8;
+    std::vector<KnobTrack> knobTracks;
+
+    const juce::Image& getKnobTrack(int width, int height, float startAngle, float endAngle, float scale);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PPGLookAndFeel)
 };
@@ -51,6 +51,9 @@ SynthControlsPanel::SynthControlsPanel(juce::AudioProcessorValueTreeState& apvts
     ampEnvCard     = { "AMP ENVELOPE", { &envAttack, &envDecay, &envSustain, &envRelease }, {}, {} };
     lfoCard        = { "LFO",        { &lfoRate, &vibrato }, {}, {} };
     outputCard     = { "OUTPUT",     { &noise, &octave, &tuning, &outputLevel }, { &polyMode }, {} };
+
+    // The background covers every pixel, so nothing behind the panel needs repainting
+    setOpaque(true);
 }
 
 void SynthControlsPanel::initKnob(ParamControl& ctrl, juce::AudioProcessorValueTreeState& apvts,
@@ -100,6 +103,11 @@ void SynthControlsPanel::initCombo(ChoiceControl& ctrl, juce::AudioProcessorValu
 
 //==============================================================================
 void SynthControlsPanel::paint(juce::Graphics& g)
+{
+    background.draw(g, getLocalBounds(), [this](juce::Graphics& bg) { paintBackground(bg); });
+}
+
+void SynthControlsPanel::paintBackground(juce::Graphics& g)
 {
     g.fillAll(juce::Colour(PPGLookAndFeel::kBackground));
 
@@ -139,6 +147,8 @@ void SynthControlsPanel::paintCard(juce::Graphics& g, const juce::Rectangle<int>
 //==============================================================================
 void SynthControlsPanel::resized()
 {
+    background.invalidate();
+
     auto area = getLocalBounds().reduced(12);
 
     auto cardGap = 10;
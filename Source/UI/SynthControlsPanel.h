@@ -2,6 +2,7 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "CachedBackground.h"
 
 class SynthControlsPanel : public juce::Component
 {
@@ -51,11 +52,15 @@ private:
     CardGroup glideCard, ampEnvCard, lfoCard;
     CardGroup outputCard;
 
+    // Background and cards, re-rendered only on resize or a display scale change
+    CachedBackground background;
+
     void initKnob(ParamControl& ctrl, juce::AudioProcessorValueTreeState& apvts,
                   const juce::String& paramId, const juce::String& labelText);
     void initCombo(ChoiceControl& ctrl, juce::AudioProcessorValueTreeState& apvts,
                    const juce::String& paramId, const juce::String& labelText);
 
+    void paintBackground(juce::Graphics& g);
     void paintCard(juce::Graphics& g, const juce::Rectangle<int>& bounds, const juce::String& title);
     void layoutCard(const juce::Rectangle<int>& bounds, const std::vector<ParamControl*>& knobs,
                     const std::vector<ChoiceControl*>& combos);
@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/GeneticAlgorithm.h"
+#include "GA/IFitnessModel.h"
+#include "GA/AudioFeatureCache.h"
+#include "GA/FixedMLP.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts global allocations made by the thread that enabled counting
+namespace
+{
+    thread_local bool countAllocations = false;
+    std::atomic<int> allocationCount { 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations)
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    // Batch-scores without touching the heap
+    class AllocationFreeModel : public IFitnessModel
+    {
+    public:
+        float evaluate(const std::vector<float>& genome) override
+        {
+            return genome.empty() ? 0.0f : genome[0];
+        }
+        
+        void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut) override
+        {
+            for (int i = 0; i < numGenomes; ++i)
+                fitnessOut[i] = genomes[i * genomeSize];
+        }
+        
+        void sendFeedback(const std::vector<float>&, const Feedback&) override {}
+    };
+}
+
+TEST_CASE("Steady-state generation performs no heap allocation")
+{
+    struct Setup { int threads; int islands; };
+    
+    for (auto setup : { Setup { 1, 1 }, Setup { 4, 1 }, Setup { 4, 3 } })
+    {
+        AllocationFreeModel model;
+        GeneticAlgorithm ga(model);
+        
+        GAConfig config;
+        config.numEvaluationThreads = setup.threads;
+        config.numIslands = setup.islands;
+        config.migrationInterval = 2;
+        ga.setConfig(config);
+        
+        // Warm up: initialise population, pool and bridge storage
+        for (int i = 0; i < 5; ++i)
+            ga.stepGeneration();
+        
+        allocationCount.store(0);
+        countAllocations = true;
+        
+        for (int i = 0; i < 50; ++i)
+            ga.stepGeneration();
+        
+        countAllocations = false;
+        
+        INFO("threads = " << setup.threads << ", islands = " << setup.islands);
+        REQUIRE(allocationCount.load() == 0);
+    }
+}
+
+TEST_CASE("Steady-state feature rendering performs no heap allocation")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    
+    // Quiet genomes: protectYourEars logs (and allocates) on clipping in debug builds
+    std::vector<std::vector<float>> genomes;
+    for (int i = 0; i < 4; ++i)
+        genomes.push_back(std::vector<float>(17, 0.05f + 0.1f * i));
+    
+    float features[AudioFeatureCache::AUDIO_FEATURE_COUNT];
+    
+    // Warm up: frame storage grows to the phrase length on first use
+    cache.computeFeatures(genomes[0], features);
+    
+    allocationCount.store(0);
+    countAllocations = true;
+    
+    for (const auto& genome : genomes)
+        cache.computeFeatures(genome, features);
+    
+    countAllocations = false;
+    
+    REQUIRE(allocationCount.load() == 0);
+    REQUIRE(cache.getCacheSize() == 0);
+    
+    // Same features as the cached path
+    auto cached = cache.getFeatures(genomes.back());
+    for (int i = 0; i < AudioFeatureCache::AUDIO_FEATURE_COUNT; ++i)
+        REQUIRE(cached[static_cast<size_t>(i)] == features[i]);
+}
+
+TEST_CASE("Fixed-size MLP predicts and trains without heap allocation")
+{
+    AudioMLP mlp;
+    
+    const int numSamples = 8;
+    float inputs[numSamples * AudioMLP::getInputSize()];
+    float targets[numSamples];
+    float weights[numSamples];
+    float outputs[numSamples];
+    
+    for (int i = 0; i < numSamples * AudioMLP::getInputSize(); ++i)
+        inputs[i] = static_cast<float>(i % 13) / 12.0f;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        targets[n] = static_cast<float>(n % 2);
+        weights[n] = 1.0f;
+    }
+    
+    allocationCount.store(0);
+    countAllocations = true;
+    
+    mlp.trainBatch(inputs, numSamples, targets, weights, 0.05f);
+    mlp.predictBatch(inputs, numSamples, outputs);
+    
+    countAllocations = false;
+    
+    REQUIRE(allocationCount.load() == 0);
+}
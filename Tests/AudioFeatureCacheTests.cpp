@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "GA/AudioFeatureCache.h"
+#include "GA/WorkerPool.h"
+#include <cmath>
 
 TEST_CASE("AudioFeatureCache cache hit returns identical features")
 {
@@ -96,3 +98,397 @@ TEST_CASE("AudioFeatureCache LRU eviction works")
     // Cache should be at max size, not 140
     REQUIRE(cache.getCacheSize() <= 128);
 }
+
+TEST_CASE("AudioFeatureCache concurrent misses match serial rendering")
+{
+    AudioFeatureCache serialCache(44100.0);
+    AudioFeatureCache sharedCache(44100.0);
+    WorkerPool pool(4);
+    
+    std::vector<std::vector<float>> genomes;
+    for (int i = 0; i < 8; ++i)
+        genomes.push_back(std::vector<float>(17, 0.1f + 0.1f * i));
+    
+    std::vector<std::vector<float>> parallelFeatures(genomes.size());
+    pool.parallelFor(static_cast<int>(genomes.size()), [&](int i, int)
+    {
+        parallelFeatures[i] = sharedCache.getFeatures(genomes[i]);
+    });
+    
+    REQUIRE(sharedCache.getCacheSize() == genomes.size());
+    
+    for (size_t i = 0; i < genomes.size(); ++i)
+        REQUIRE(parallelFeatures[i] == serialCache.getFeatures(genomes[i]));
+}
+
+TEST_CASE("AudioFeatureCache fixed-rate profile ignores host sample rate")
+{
+    auto profile = AudioFeatureCache::RenderProfile::fitness();
+    AudioFeatureCache cache(44100.0, profile);
+    AudioFeatureCache otherHost(96000.0, profile);
+    
+    std::vector<float> genome(17, 0.5f);
+    auto features = cache.getFeatures(genome);
+    
+    REQUIRE(cache.getRenderSampleRate() == profile.sampleRate);
+    REQUIRE(features == otherHost.getFeatures(genome));
+    
+    // Host rate changes don't invalidate fixed-rate features
+    cache.setSampleRate(48000.0);
+    REQUIRE(cache.hasCached(genome));
+    
+    cache.setRenderProfile(AudioFeatureCache::RenderProfile::fullFidelity());
+    REQUIRE(cache.getCacheSize() == 0);
+    REQUIRE(cache.getRenderSampleRate() == 48000.0);
+}
+
+TEST_CASE("AudioFeatureCache fitness profile drift against full fidelity", "[drift]")
+{
+    AudioFeatureCache full(44100.0, AudioFeatureCache::RenderProfile::fullFidelity());
+    AudioFeatureCache reduced(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    
+    juce::Random random(1234);
+    const int numGenomes = 24;
+    
+    std::vector<double> drift(AudioFeatureCache::AUDIO_FEATURE_COUNT, 0.0);
+    double fullMs = 0.0;
+    double reducedMs = 0.0;
+    
+    for (int g = 0; g < numGenomes; ++g)
+    {
+        std::vector<float> genome(17);
+        for (float& value : genome)
+            value = random.nextFloat();
+        
+        auto start = juce::Time::getMillisecondCounterHiRes();
+        auto reference = full.getFeatures(genome);
+        auto mid = juce::Time::getMillisecondCounterHiRes();
+        auto candidate = reduced.getFeatures(genome);
+        auto end = juce::Time::getMillisecondCounterHiRes();
+        
+        fullMs += mid - start;
+        reducedMs += end - mid;
+        
+        for (size_t i = 0; i < reference.size(); ++i)
+            drift[i] += std::abs(reference[i] - candidate[i]) / numGenomes;
+    }
+    
+    // Mean absolute drift per normalized feature, reported if the bound
+    // fails. MFCC 0 drifts most: the mel bands span the render rate's
+    // Nyquist, not a fixed range.
+    double meanDrift = 0.0;
+    juce::String report;
+    for (size_t i = 0; i < drift.size(); ++i)
+    {
+        report << (int) i << ":" << juce::String(drift[i], 3) << " ";
+        meanDrift += drift[i] / static_cast<double>(drift.size());
+    }
+    
+    UNSCOPED_INFO("Feature drift " << report.toStdString());
+    UNSCOPED_INFO("Mean drift " << meanDrift << ", render " << fullMs / numGenomes
+                  << " ms -> " << reducedMs / numGenomes << " ms per genome");
+    REQUIRE(meanDrift < 0.1);
+}
+
+TEST_CASE("AudioFeatureCache batch features match per-genome features")
+{
+    AudioFeatureCache serialCache(44100.0);
+    AudioFeatureCache batchCache(44100.0);
+    
+    // More genomes than one sweep, with a repeat so the batch sees a hit
+    const int numGenomes = 11;
+    std::vector<float> genomes(static_cast<size_t>(numGenomes) * 17);
+    juce::Random random(5);
+    for (float& value : genomes)
+        value = random.nextFloat();
+    
+    std::vector<float> first(genomes.begin(), genomes.begin() + 17);
+    batchCache.getFeatures(first);
+    
+    std::vector<float> features(static_cast<size_t>(numGenomes) * AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    batchCache.getFeaturesBatch(genomes.data(), numGenomes, 17, features.data());
+    
+    REQUIRE(batchCache.getCacheHits() == 1);
+    REQUIRE(batchCache.getCacheSize() == static_cast<size_t>(numGenomes));
+    
+    for (int g = 0; g < numGenomes; ++g)
+    {
+        std::vector<float> genome(genomes.begin() + g * 17, genomes.begin() + (g + 1) * 17);
+        auto expected = serialCache.getFeatures(genome);
+        
+        for (int i = 0; i < AudioFeatureCache::AUDIO_FEATURE_COUNT; ++i)
+            REQUIRE(features[static_cast<size_t>(g * AudioFeatureCache::AUDIO_FEATURE_COUNT + i)] == expected[static_cast<size_t>(i)]);
+    }
+}
+
+TEST_CASE("AudioFeatureCache prefix features preview the first note without caching")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    
+    std::vector<float> genome(17, 0.5f);
+    std::vector<float> prefix(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    REQUIRE(cache.computePrefixFeaturesBatch(genome.data(), 1, 17, prefix.data()));
+    
+    std::vector<float> full(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    cache.computeFeatures(genome, full.data());
+    
+    bool differs = false;
+    for (int i = 0; i < AudioFeatureCache::AUDIO_FEATURE_COUNT; ++i)
+    {
+        REQUIRE(prefix[static_cast<size_t>(i)] >= 0.0f);
+        REQUIRE(prefix[static_cast<size_t>(i)] <= 1.0f);
+        differs = differs || prefix[static_cast<size_t>(i)] != full[static_cast<size_t>(i)];
+    }
+    REQUIRE(differs);
+    REQUIRE(cache.getCacheSize() == 0);
+    
+    // Malformed rows have no preview
+    REQUIRE_FALSE(cache.computePrefixFeaturesBatch(genome.data(), 1, 16, prefix.data()));
+}
+
+TEST_CASE("AudioFeatureCache analysis pool keeps features within rounding")
+{
+    AudioFeatureCache cache(44100.0);
+    WorkerPool pool(4);
+    
+    std::vector<float> genome(17, 0.4f);
+    std::vector<float> streamed(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    cache.computeFeatures(genome, streamed.data());
+    
+    cache.setAnalysisPool(&pool);
+    std::vector<float> pooled(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    cache.computeFeatures(genome, pooled.data());
+    cache.setAnalysisPool(nullptr);
+    
+    for (int i = 0; i < AudioFeatureCache::AUDIO_FEATURE_COUNT; ++i)
+        REQUIRE_THAT(pooled[static_cast<size_t>(i)], Catch::Matchers::WithinAbs(streamed[static_cast<size_t>(i)], 1e-5));
+}
+
+TEST_CASE("AudioFeatureCache reserved contexts serve concurrent misses and survive rate changes")
+{
+    AudioFeatureCache cache(44100.0);
+    cache.reserveContexts(4);
+    REQUIRE(cache.getNumIdleContexts() == 4);
+    
+    // Four concurrent misses check out the prebuilt contexts and return them
+    WorkerPool pool(4);
+    std::vector<float> features(static_cast<size_t>(4 * AudioFeatureCache::AUDIO_FEATURE_COUNT));
+    pool.parallelFor(4, [&](int task, int)
+    {
+        std::vector<float> genome(17, 0.2f + 0.1f * static_cast<float>(task));
+        cache.computeFeatures(genome, features.data() + task * AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    });
+    REQUIRE(cache.getNumIdleContexts() == 4);
+    
+    // A new render rate rebuilds every context at once
+    cache.setSampleRate(48000.0);
+    REQUIRE(cache.getNumIdleContexts() == 4);
+    
+    std::vector<float> genome(17, 0.5f);
+    std::vector<float> at48k(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    cache.computeFeatures(genome, at48k.data());
+    
+    AudioFeatureCache fresh(48000.0);
+    std::vector<float> expected(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    fresh.computeFeatures(genome, expected.data());
+    REQUIRE(at48k == expected);
+}
+
+TEST_CASE("AudioFeatureCache sharded lookups stay consistent under concurrent use")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    WorkerPool pool(4);
+    
+    std::vector<std::vector<float>> genomes;
+    juce::Random random(11);
+    for (int i = 0; i < 24; ++i)
+    {
+        std::vector<float> genome(17);
+        for (float& value : genome)
+            value = random.nextFloat();
+        genomes.push_back(genome);
+    }
+    
+    // Every task looks up every genome, starting at a different offset
+    const int numTasks = 8;
+    std::vector<std::vector<std::vector<float>>> results(numTasks);
+    pool.parallelFor(numTasks, [&](int task, int)
+    {
+        for (size_t g = 0; g < genomes.size(); ++g)
+            results[task].push_back(cache.getFeatures(genomes[(g + static_cast<size_t>(task) * 3) % genomes.size()]));
+    });
+    
+    REQUIRE(cache.getCacheHits() + cache.getCacheMisses() == static_cast<size_t>(numTasks) * genomes.size());
+    REQUIRE(cache.getCacheMisses() == genomes.size());  // Concurrent misses on one genome share a render
+    REQUIRE(cache.getCacheSize() == genomes.size());
+    
+    AudioFeatureCache serial(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    for (int task = 0; task < numTasks; ++task)
+        for (size_t g = 0; g < genomes.size(); ++g)
+            REQUIRE(results[task][g] == serial.getFeatures(genomes[(g + static_cast<size_t>(task) * 3) % genomes.size()]));
+}
+
+TEST_CASE("AudioFeatureCache renders a genome once however many callers miss on it")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    WorkerPool pool(4);
+    
+    std::vector<float> genome(17, 0.35f);
+    std::vector<float> other(17, 0.65f);
+    
+    // Half the callers go through the batch path, alongside a genome of their own
+    const int numTasks = 8;
+    std::vector<std::vector<float>> results(numTasks);
+    pool.parallelFor(numTasks, [&](int task, int)
+    {
+        if (task % 2 == 0)
+        {
+            results[task] = cache.getFeatures(genome);
+            return;
+        }
+        
+        std::vector<float> batch(genome);
+        batch.insert(batch.end(), other.begin(), other.end());
+        std::vector<float> features(2 * AudioFeatureCache::AUDIO_FEATURE_COUNT);
+        cache.getFeaturesBatch(batch.data(), 2, 17, features.data());
+        results[task].assign(features.begin(), features.begin() + AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    });
+    
+    REQUIRE(cache.getCacheMisses() == 2);
+    REQUIRE(cache.getCacheHits() == static_cast<size_t>(numTasks + numTasks / 2 - 2));
+    REQUIRE(cache.getStats().joins <= cache.getCacheHits());
+    
+    AudioFeatureCache reference(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    const auto expected = reference.getFeatures(genome);
+    for (const auto& features : results)
+        REQUIRE(features == expected);
+}
+
+TEST_CASE("AudioFeatureCache key tolerance shares features between near-duplicate genomes")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    cache.setKeyTolerance(0.01f, 1);
+    
+    std::vector<float> genome(17, 0.5f);
+    std::vector<float> nearby = genome;
+    nearby[3] += 0.004f;
+    nearby[9] -= 0.006f;
+    
+    auto features = cache.getFeatures(genome);
+    REQUIRE(cache.getFeatures(nearby) == features);
+    REQUIRE(cache.hasCached(nearby));
+    REQUIRE(cache.getCacheMisses() == 1);
+    
+    // Batch lookups snap the same way
+    std::vector<float> rows = nearby;
+    rows.insert(rows.end(), genome.begin(), genome.end());
+    std::vector<float> batchFeatures(2 * AudioFeatureCache::AUDIO_FEATURE_COUNT);
+    cache.getFeaturesBatch(rows.data(), 2, 17, batchFeatures.data());
+    REQUIRE(std::equal(features.begin(), features.end(), batchFeatures.begin()));
+    REQUIRE(cache.getCacheMisses() == 1);
+    
+    // Only lookups that moved the genome count, and each was audited
+    auto drift = cache.getDriftStats();
+    REQUIRE(drift.approximateLookups == 2);
+    REQUIRE(drift.audits == 2);
+    REQUIRE(drift.maxAbsError < 0.1f);
+    REQUIRE(drift.meanAbsError <= drift.maxAbsError);
+    
+    // Exact keys again
+    cache.setKeyTolerance(0.0f);
+    cache.getFeatures(nearby);
+    REQUIRE(cache.getCacheMisses() == 2);
+}
+
+TEST_CASE("AudioFeatureCache memory budget sets capacity and stats track use")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    REQUIRE(cache.getCacheCapacity() == 128);
+    
+    // Room for a few entries per shard
+    cache.setMemoryBudget(8 * 1024);
+    const auto stats = cache.getStats();
+    REQUIRE(stats.capacity < 128);
+    REQUIRE(stats.memoryBytes <= 8 * 1024);
+    REQUIRE(stats.capacity == cache.getCacheCapacity());
+    
+    const int numGenomes = static_cast<int>(stats.capacity) + 40;
+    for (int i = 0; i < numGenomes; ++i)
+        cache.getFeatures(std::vector<float>(17, static_cast<float>(i) / numGenomes));
+    cache.getFeatures(std::vector<float>(17, static_cast<float>(numGenomes - 1) / numGenomes));
+    
+    const auto used = cache.getStats();
+    REQUIRE(used.entries <= used.capacity);
+    REQUIRE(used.misses == static_cast<size_t>(numGenomes));
+    REQUIRE(used.hits == 1);
+    REQUIRE(used.evictions >= static_cast<size_t>(numGenomes) - used.capacity);
+    REQUIRE(used.getHitRate() > 0.0f);
+    REQUIRE(used.getAverageMissMs() > 0.0);
+    
+    size_t histogramTotal = 0;
+    for (size_t count : used.renderHistogram)
+        histogramTotal += count;
+    REQUIRE(histogramTotal == used.misses);
+    
+    cache.setMemoryBudget(0);
+    REQUIRE(cache.getCacheCapacity() == 128);
+}
+
+TEST_CASE("AudioFeatureCache prefetch renders genomes in the background")
+{
+    AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    
+    const int numGenomes = 12;
+    std::vector<float> genomes(static_cast<size_t>(numGenomes) * 17);
+    juce::Random random(3);
+    for (float& value : genomes)
+        value = random.nextFloat();
+    
+    cache.prefetch(genomes.data(), numGenomes, 17);
+    cache.prefetch(genomes.data(), 2, 17);  // Already queued or cached: no extra work
+    REQUIRE(cache.waitForPrefetches(10000));
+    
+    REQUIRE(cache.getPrefetchedCount() == static_cast<size_t>(numGenomes));
+    
+    // Every lookup is now a hit, with the same features a direct render gives
+    AudioFeatureCache reference(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    const size_t missesBefore = cache.getCacheMisses();
+    for (int g = 0; g < numGenomes; ++g)
+    {
+        std::vector<float> genome(genomes.begin() + g * 17, genomes.begin() + (g + 1) * 17);
+        REQUIRE(cache.hasCached(genome));
+        REQUIRE(cache.getFeatures(genome) == reference.getFeatures(genome));
+    }
+    REQUIRE(cache.getCacheMisses() == missesBefore);
+}
+
+TEST_CASE("AudioFeatureCache applies requested sample rates in the background")
+{
+    AudioFeatureCache cache(44100.0);
+    cache.reserveContexts(2);
+    
+    std::vector<float> genome(17, 0.5f);
+    auto at44k = cache.getFeatures(genome);
+    
+    // Several requests in a row; lookups carry on meanwhile and only the last one sticks
+    cache.requestSampleRate(96000.0);
+    cache.requestSampleRate(88200.0);
+    REQUIRE(cache.getFeatures(genome).size() == at44k.size());
+    cache.requestSampleRate(48000.0);
+    
+    REQUIRE(cache.waitForReconfiguration(10000));
+    REQUIRE(cache.getRenderSampleRate() == 48000.0);
+    REQUIRE(cache.getNumIdleContexts() == 2);
+    REQUIRE_FALSE(cache.hasCached(genome));
+    
+    AudioFeatureCache fresh(48000.0);
+    REQUIRE(cache.getFeatures(genome) == fresh.getFeatures(genome));
+    
+    // A fixed-rate profile keeps its features through a requested change
+    AudioFeatureCache fixedRate(44100.0, AudioFeatureCache::RenderProfile::fitness());
+    fixedRate.getFeatures(genome);
+    fixedRate.requestSampleRate(96000.0);
+    REQUIRE(fixedRate.waitForReconfiguration(10000));
+    REQUIRE(fixedRate.hasCached(genome));
+    REQUIRE(fixedRate.getRenderSampleRate() == AudioFeatureCache::RenderProfile::fitness().sampleRate);
+}
@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "GA/CpuBudget.h"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("CpuBudget pauses work down to its average core count")
+{
+    CpuBudget budget;
+
+    // Unlimited and no audio pressure: never pauses, never caps
+    REQUIRE(budget.getPauseSeconds(0.1, 4) == 0.0);
+    REQUIRE(budget.capThreads(8) == 8);
+
+    // Half a core: one thread busy 10 ms idles another 10 ms
+    budget.setCores(0.5f);
+    REQUIRE(budget.capThreads(8) == 1);
+    REQUIRE_THAT(budget.getPauseSeconds(0.01, 1), WithinAbs(0.01, 1e-9));
+
+    // Two cores over four threads: busy 10 ms, idle 10 ms
+    budget.setCores(2.0f);
+    REQUIRE(budget.capThreads(8) == 2);
+    REQUIRE_THAT(budget.getPauseSeconds(0.01, 4), WithinAbs(0.01, 1e-9));
+    REQUIRE(budget.getPauseSeconds(0.01, 2) == 0.0);
+
+    // Pauses are bounded, and a negative budget means unlimited
+    REQUIRE(budget.getPauseSeconds(100.0, 4) == CpuBudget::maxPauseSeconds);
+    budget.setCores(-1.0f);
+    REQUIRE(budget.getCores() == 0.0f);
+}
+
+TEST_CASE("CpuBudget backs off as the audio thread nears its deadline")
+{
+    CpuBudget budget;
+
+    budget.setAudioLoad(CpuBudget::backoffLoad);
+    REQUIRE(budget.getBackoffFactor() == 1.0f);
+    REQUIRE(budget.getPauseSeconds(0.01, 2) == 0.0);
+
+    // Halfway to the deadline from the backoff point
+    budget.setAudioLoad((CpuBudget::backoffLoad + 1.0f) * 0.5f);
+    const float halfway = 1.0f - 0.5f * (1.0f - CpuBudget::minimumShare);
+    REQUIRE_THAT(budget.getBackoffFactor(), WithinAbs(halfway, 1e-6));
+
+    // Even without a budget, work now idles in proportion
+    REQUIRE(budget.getPauseSeconds(0.01, 1) > 0.0);
+
+    budget.setAudioLoad(3.0f);
+    REQUIRE(budget.getBackoffFactor() == CpuBudget::minimumShare);
+}
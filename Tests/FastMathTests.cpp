@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include <juce_core/juce_core.h>
+#include "JX11/FastMath.h"
+#include "JX11/Filter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    float relativeError(float approx, float exact)
+    {
+        return std::abs(approx - exact) / std::max(std::abs(exact), 1e-30f);
+    }
+}
+
+TEST_CASE("FastMath::exp stays within 1e-6 relative error", "[fastmath]")
+{
+    // Covers the cutoff modulation range with wide margin
+    float worst = 0.0f;
+    for (int i = 0; i <= 40000; ++i)
+    {
+        float x = -20.0f + 40.0f * i / 40000.0f;
+        worst = std::max(worst, relativeError(FastMath::exp(x), std::exp(x)));
+    }
+    
+    REQUIRE(worst < 1e-6f);
+    REQUIRE(FastMath::exp(0.0f) == 1.0f);
+}
+
+TEST_CASE("FastMath::exp saturates instead of overflowing", "[fastmath]")
+{
+    REQUIRE(std::isfinite(FastMath::exp(200.0f)));
+    REQUIRE(FastMath::exp(-200.0f) >= 0.0f);
+    REQUIRE(FastMath::exp(-200.0f) < 1e-37f);
+}
+
+TEST_CASE("FastMath::tan stays within 1e-6 relative error over the prewarp range", "[fastmath]")
+{
+    float worst = 0.0f;
+    for (int i = 1; i <= 10000; ++i)
+    {
+        float x = Filter::MAX_PREWARP * i / 10000.0f;
+        worst = std::max(worst, relativeError(FastMath::tan(x), std::tan(x)));
+    }
+    
+    REQUIRE(worst < 1e-6f);
+}
+
+TEST_CASE("Fast filter coefficients match the exact ones", "[fastmath]")
+{
+    Filter exact, fast;
+    exact.sampleRate = fast.sampleRate = 44100.0f;
+    
+    for (float cutoff = 30.0f; cutoff <= 20000.0f; cutoff *= 1.05f)
+    {
+        exact.reset();
+        fast.reset();
+        exact.updateCoefficients(cutoff, 2.0f);
+        fast.updateCoefficientsFast(cutoff, 2.0f);
+        
+        // Same impulse through both; a coefficient drift shows up in the response
+        float maxDiff = 0.0f;
+        for (int n = 0; n < 64; ++n)
+        {
+            float in = n == 0 ? 1.0f : 0.0f;
+            maxDiff = std::max(maxDiff, std::abs(exact.render(in) - fast.render(in)));
+        }
+        REQUIRE(maxDiff < 1e-5f);
+    }
+}
+
+TEST_CASE("Prewarp clamp keeps coefficients stable below 44.1 kHz", "[fastmath]")
+{
+    // 20 kHz is past Nyquist at the 22.05 kHz fitness render rate
+    Filter filter;
+    filter.sampleRate = 22050.0f;
+    filter.reset();
+    filter.updateCoefficients(20000.0f, 1.0f);
+    
+    float peak = 0.0f;
+    for (int n = 0; n < 4096; ++n)
+        peak = std::max(peak, std::abs(filter.render(n == 0 ? 1.0f : 0.0f)));
+    
+    REQUIRE(std::isfinite(peak));
+    REQUIRE(peak < 2.0f);
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/FeatureExtractor.h"
+#include "GA/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    std::vector<float> makeSine(float frequency, double sampleRate, int numSamples)
+    {
+        std::vector<float> audio(static_cast<size_t>(numSamples));
+        const float step = 2.0f * juce::MathConstants<float>::pi * frequency / static_cast<float>(sampleRate);
+        for (int i = 0; i < numSamples; ++i)
+            audio[static_cast<size_t>(i)] = 0.5f * std::sin(step * i);
+        return audio;
+    }
+}
+
+TEST_CASE("FeatureExtractor centroid tracks a pure tone")
+{
+    FeatureExtractor extractor(22050.0, 1024, 256);
+    
+    for (float frequency : { 440.0f, 2000.0f, 6000.0f })
+    {
+        auto audio = makeSine(frequency, 22050.0, 22050);
+        FeatureVector features = extractor.extractFeatures(audio.data(), static_cast<int>(audio.size()));
+        
+        REQUIRE(std::abs(features.spectralCentroidMean - frequency) < frequency * 0.05f);
+        REQUIRE(features.spectralCentroidStd < frequency * 0.01f);
+    }
+}
+
+TEST_CASE("FeatureExtractor gives finite features for silence and short buffers")
+{
+    FeatureExtractor extractor(44100.0, 2048);
+    
+    std::vector<float> silence(44100, 0.0f);
+    std::vector<float> shortTone = makeSine(1000.0f, 44100.0, 1000);  // Shorter than one frame
+    
+    for (const auto* audio : { &silence, &shortTone })
+    {
+        FeatureVector features = extractor.extractFeatures(audio->data(), static_cast<int>(audio->size()));
+        
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE(std::isfinite(features.mfccMean[static_cast<size_t>(i)]));
+            REQUIRE(std::isfinite(features.mfccStd[static_cast<size_t>(i)]));
+        }
+        REQUIRE(std::isfinite(features.spectralCentroidMean));
+        REQUIRE(std::isfinite(features.rmsEnergy));
+    }
+}
+
+TEST_CASE("FeatureExtractor streaming matches whole-buffer extraction")
+{
+    FeatureExtractor extractor(22050.0, 1024, 256);
+    
+    // Rising then decaying tone, so attack, RMS and the frame statistics all move
+    auto audio = makeSine(880.0f, 22050.0, 9000);
+    for (size_t i = 0; i < audio.size(); ++i)
+        audio[i] *= std::min(1.0f, static_cast<float>(i) / 2000.0f) * std::exp(-static_cast<float>(i) / 6000.0f);
+    
+    for (int numSamples : { 700, 9000 })  // Shorter than one frame, and several frames
+    {
+        FeatureVector whole = extractor.extractFeatures(audio.data(), numSamples);
+        
+        for (int blockSize : { 1, 100, 256, 1000 })
+        {
+            extractor.beginStream();
+            for (int start = 0; start < numSamples; start += blockSize)
+                extractor.pushSamples(audio.data() + start, std::min(blockSize, numSamples - start));
+            FeatureVector streamed = extractor.finishStream();
+            
+            REQUIRE(streamed.mfccMean == whole.mfccMean);
+            REQUIRE(streamed.mfccStd == whole.mfccStd);
+            REQUIRE(streamed.spectralCentroidMean == whole.spectralCentroidMean);
+            REQUIRE(streamed.spectralCentroidStd == whole.spectralCentroidStd);
+            REQUIRE(streamed.attackTime == whole.attackTime);
+            REQUIRE(streamed.rmsEnergy == whole.rmsEnergy);
+        }
+    }
+}
+
+TEST_CASE("FeatureExtractor frame-parallel analysis matches the sequential one")
+{
+    FeatureExtractor extractor(22050.0, 1024, 256);
+    WorkerPool pool(4);
+    
+    auto audio = makeSine(660.0f, 22050.0, 44100);
+    for (size_t i = 0; i < audio.size(); ++i)
+        audio[i] *= std::exp(-static_cast<float>(i) / 15000.0f) * (1.0f + 0.5f * std::sin(0.0005f * static_cast<float>(i)));
+    
+    const int numSamples = static_cast<int>(audio.size());
+    FeatureVector sequential = extractor.extractFeatures(audio.data(), numSamples);
+    
+    auto near = [](float a, float b) { return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::abs(b)); };
+    
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        FeatureVector pooled = extractor.extractFeatures(audio.data(), numSamples, pool);
+        
+        for (size_t i = 0; i < 10; ++i)
+        {
+            REQUIRE(near(pooled.mfccMean[i], sequential.mfccMean[i]));
+            REQUIRE(near(pooled.mfccStd[i], sequential.mfccStd[i]));
+        }
+        REQUIRE(near(pooled.spectralCentroidMean, sequential.spectralCentroidMean));
+        REQUIRE(near(pooled.spectralCentroidStd, sequential.spectralCentroidStd));
+        REQUIRE(pooled.attackTime == sequential.attackTime);
+        REQUIRE(pooled.rmsEnergy == sequential.rmsEnergy);
+    }
+    
+    // Too short to split: same as the sequential path
+    FeatureVector shortPooled = extractor.extractFeatures(audio.data(), 700, pool);
+    FeatureVector shortSequential = extractor.extractFeatures(audio.data(), 700);
+    REQUIRE(shortPooled.mfccMean == shortSequential.mfccMean);
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/FeatureStore.h"
+#include "GA/AudioFeatureCache.h"
+#include <array>
+
+namespace
+{
+    juce::File getStoreFile(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("FeatureStoreTests");
+        dir.createDirectory();
+        auto file = dir.getChildFile(name);
+        file.deleteFile();
+        return file;
+    }
+    
+    size_t hashKey(const float* key, int keySize)
+    {
+        // Deliberately weak so lookups must compare keys
+        return static_cast<size_t>(keySize) + static_cast<size_t>(key[0] > 0.5f);
+    }
+    
+    FeatureStore::Tag makeTag()
+    {
+        FeatureStore::Tag tag;
+        tag.renderVersion = 1;
+        tag.keySize = 3;
+        tag.valueSize = 2;
+        tag.sampleRate = 22050.0;
+        return tag;
+    }
+}
+
+TEST_CASE("FeatureStore records survive reopening")
+{
+    auto file = getStoreFile("reopen.bin");
+    
+    {
+        FeatureStore store(file, makeTag(), &hashKey, 1000);
+        REQUIRE(store.isOpen());
+        
+        for (int i = 0; i < 100; ++i)
+        {
+            std::array<float, 3> key { i * 0.01f, 1.0f, 2.0f };
+            std::array<float, 2> value { static_cast<float>(i), -1.0f };
+            store.append(key.data(), hashKey(key.data(), 3), value.data());
+        }
+        REQUIRE(store.size() == 100);
+    }
+    
+    FeatureStore reopened(file, makeTag(), &hashKey, 1000);
+    REQUIRE(reopened.size() == 100);
+    
+    for (int i = 0; i < 100; ++i)
+    {
+        std::array<float, 3> key { i * 0.01f, 1.0f, 2.0f };
+        const float* value = reopened.find(key.data(), hashKey(key.data(), 3));
+        REQUIRE(value != nullptr);
+        REQUIRE(value[0] == static_cast<float>(i));
+    }
+    
+    // Appends after a reopen are findable beside the mapped records
+    std::array<float, 3> key { 9.0f, 9.0f, 9.0f };
+    std::array<float, 2> value { 7.0f, 7.0f };
+    reopened.append(key.data(), hashKey(key.data(), 3), value.data());
+    REQUIRE(reopened.find(key.data(), hashKey(key.data(), 3))[0] == 7.0f);
+    REQUIRE(reopened.size() == 101);
+}
+
+TEST_CASE("FeatureStore discards files from another configuration")
+{
+    auto file = getStoreFile("tag.bin");
+    std::array<float, 3> key { 0.1f, 0.2f, 0.3f };
+    std::array<float, 2> value { 1.0f, 2.0f };
+    
+    {
+        FeatureStore store(file, makeTag(), &hashKey, 10);
+        store.append(key.data(), hashKey(key.data(), 3), value.data());
+    }
+    
+    auto newer = makeTag();
+    newer.renderVersion = 2;
+    FeatureStore store(file, newer, &hashKey, 10);
+    
+    REQUIRE(store.isOpen());
+    REQUIRE(store.size() == 0);
+    REQUIRE(store.find(key.data(), hashKey(key.data(), 3)) == nullptr);
+}
+
+TEST_CASE("FeatureStore ignores a torn trailing record and respects its cap")
+{
+    auto file = getStoreFile("torn.bin");
+    
+    {
+        FeatureStore store(file, makeTag(), &hashKey, 3);
+        for (int i = 0; i < 5; ++i)
+        {
+            std::array<float, 3> key { static_cast<float>(i), 0.0f, 0.0f };
+            std::array<float, 2> value { static_cast<float>(i), 0.0f };
+            store.append(key.data(), hashKey(key.data(), 3), value.data());
+        }
+        REQUIRE(store.size() == 3);
+    }
+    
+    // Half a record, as if the process died mid-append
+    float partial[2] = { 42.0f, 42.0f };
+    file.appendData(partial, sizeof(partial));
+    
+    {
+        FeatureStore store(file, makeTag(), &hashKey, 10);
+        REQUIRE(store.size() == 3);
+        
+        std::array<float, 3> key { 5.0f, 0.0f, 0.0f };
+        std::array<float, 2> value { 5.0f, 0.0f };
+        store.append(key.data(), hashKey(key.data(), 3), value.data());
+    }
+    
+    FeatureStore store(file, makeTag(), &hashKey, 10);
+    REQUIRE(store.size() == 4);
+    std::array<float, 3> key { 5.0f, 0.0f, 0.0f };
+    REQUIRE(store.find(key.data(), hashKey(key.data(), 3))[0] == 5.0f);
+}
+
+TEST_CASE("AudioFeatureCache serves persisted features in a new session without rendering")
+{
+    auto dir = getStoreFile("session").getParentDirectory().getChildFile("session");
+    dir.deleteRecursively();
+    dir.createDirectory();
+    
+    std::vector<float> genome(HeadlessParam::COUNT, 0.4f);
+    std::vector<float> features;
+    
+    {
+        AudioFeatureCache cache(44100.0, AudioFeatureCache::RenderProfile::fitness());
+        cache.setPersistentDirectory(dir);
+        
+        // Only persistent lookups (rated genomes) are stored, cache hits included
+        std::vector<float> unrated(HeadlessParam::COUNT, 0.6f);
+        cache.getFeatures(unrated);
+        features = cache.getFeatures(genome);
+        REQUIRE(cache.getStoredCount() == 0);
+        
+        REQUIRE(cache.getFeatures(genome, true) == features);
+        REQUIRE(cache.getStoredCount() == 1);
+        
+        std::vector<float> batchFeatures(AudioFeatureCache::AUDIO_FEATURE_COUNT);
+        cache.getFeaturesBatch(unrated.data(), 1, HeadlessParam::COUNT, batchFeatures.data(), true);
+        REQUIRE(cache.getStoredCount() == 2);
+    }
+    
+    AudioFeatureCache cache(48000.0, AudioFeatureCache::RenderProfile::fitness());
+    cache.setPersistentDirectory(dir);
+    
+    REQUIRE(cache.hasCached(genome));
+    REQUIRE(cache.getFeatures(genome) == features);
+    REQUIRE(cache.getCacheMisses() == 0);
+    
+    // A different analysis is a different file
+    cache.setRenderProfile(AudioFeatureCache::RenderProfile::fullFidelity());
+    REQUIRE_FALSE(cache.hasCached(genome));
+    REQUIRE(cache.getStoredCount() == 0);
+}
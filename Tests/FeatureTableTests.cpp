@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/FeatureTable.h"
+#include <array>
+
+namespace
+{
+    using Table = FeatureTable<4, 2>;
+    
+    std::array<float, 4> key(float x) { return { x, x + 1.0f, x + 2.0f, x + 3.0f }; }
+    std::array<float, 2> value(float x) { return { x, -x }; }
+}
+
+TEST_CASE("FeatureTable keeps colliding keys apart")
+{
+    Table table(8);
+    
+    // Same hash for both: only the stored key tells them apart
+    auto a = key(1.0f), b = key(2.0f);
+    auto va = value(10.0f), vb = value(20.0f);
+    table.insert(a.data(), 42, va.data());
+    table.insert(b.data(), 42, vb.data());
+    
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.find(a.data(), 42)[0] == 10.0f);
+    REQUIRE(table.find(b.data(), 42)[0] == 20.0f);
+    
+    auto c = key(3.0f);
+    REQUIRE(table.find(c.data(), 42) == nullptr);
+    REQUIRE_FALSE(table.contains(c.data(), 42));
+}
+
+TEST_CASE("FeatureTable evicts unreferenced entries first and stays consistent")
+{
+    Table table(4);
+    
+    for (int i = 0; i < 4; ++i)
+    {
+        auto k = key(static_cast<float>(i));
+        auto v = value(static_cast<float>(i));
+        table.insert(k.data(), static_cast<size_t>(i % 2), v.data());  // Two probe chains
+    }
+    REQUIRE(table.size() == 4);
+    
+    // First pass clears every CLOCK bit and evicts entry 0; then touch 1 so 2 goes next
+    auto k4 = key(4.0f);
+    auto v4 = value(4.0f);
+    table.insert(k4.data(), 0, v4.data());
+    
+    auto k1 = key(1.0f);
+    REQUIRE(table.find(k1.data(), 1) != nullptr);
+    
+    auto k5 = key(5.0f);
+    auto v5 = value(5.0f);
+    table.insert(k5.data(), 1, v5.data());
+    
+    REQUIRE(table.size() == 4);
+    auto k0 = key(0.0f), k2 = key(2.0f), k3 = key(3.0f);
+    REQUIRE(table.find(k0.data(), 0) == nullptr);
+    REQUIRE(table.find(k2.data(), 0) == nullptr);
+    REQUIRE(table.find(k1.data(), 1)[0] == 1.0f);
+    REQUIRE(table.find(k3.data(), 1)[0] == 3.0f);
+    REQUIRE(table.find(k4.data(), 0)[0] == 4.0f);
+    REQUIRE(table.find(k5.data(), 1)[0] == 5.0f);
+}
+
+TEST_CASE("FeatureTable survives heavy churn and clear")
+{
+    Table table(16);
+    
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto k = key(static_cast<float>(i));
+        auto v = value(static_cast<float>(i));
+        table.insert(k.data(), static_cast<size_t>(i * 7 % 5), v.data());
+        
+        // The newest entry is always findable and the table never overfills
+        REQUIRE(table.find(k.data(), static_cast<size_t>(i * 7 % 5))[1] == -static_cast<float>(i));
+        REQUIRE(table.size() <= 16);
+    }
+    
+    table.clear();
+    REQUIRE(table.size() == 0);
+    auto k = key(999.0f);
+    REQUIRE(table.find(k.data(), 999 * 7 % 5) == nullptr);
+}
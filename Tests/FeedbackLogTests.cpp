@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/FeedbackLog.h"
+#include <filesystem>
+
+namespace
+{
+    juce::File getLogDirectory(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("FeedbackLogTests").getChildFile(name);
+        dir.deleteRecursively();
+        dir.createDirectory();
+        return dir;
+    }
+
+    const std::vector<juce::String> names { "cutoff", "resonance" };
+
+    FeedbackLog::Record makeRecord(uint64_t sampleIndex)
+    {
+        FeedbackLog::Record record;
+        record.timestampMs = 1000;
+        record.sampleIndex = sampleIndex;
+        record.rating = 1.0f;
+        record.playTimeSeconds = 2.5f;
+        record.genomePrediction = 0.25f;
+        record.audioPrediction = 0.75f;
+        record.sampleWeight = 0.5f;
+        record.setConfigFlags("adaptive+novelty");
+        return record;
+    }
+
+    juce::StringArray exportLines(const juce::File& log)
+    {
+        const auto csv = log.getSiblingFile("export.csv");
+        REQUIRE(FeedbackLog::exportCSV(log, csv));
+
+        juce::StringArray all, lines;
+        csv.readLines(all);
+        for (const auto& line : all)
+            if (line.isNotEmpty())
+                lines.add(line);
+        return lines;
+    }
+}
+
+TEST_CASE("FeedbackLog exports the CSV schema compute_metrics reads")
+{
+    const auto log = getLogDirectory("export").getChildFile("feedback_log.bin");
+
+    {
+        FeedbackLog writer(log, names);
+        REQUIRE(writer.isOpen());
+
+        const float genome[] = { 0.125f, 0.5f };
+        for (uint64_t i = 0; i < 3; ++i)
+            writer.append(genome, makeRecord(i));
+
+        REQUIRE(writer.flush());
+    }
+
+    const auto lines = exportLines(log);
+    REQUIRE(lines.size() == 4);
+    REQUIRE(lines[0] == FeedbackLog::getCSVHeader(names));
+    REQUIRE(lines[0].startsWith("cutoff,resonance,rating,playTimeSeconds,sampleIndex"));
+
+    juce::StringArray fields;
+    fields.addTokens(lines[3], ",", "");
+    REQUIRE(fields.size() == 10);
+    REQUIRE(fields[0].getFloatValue() == 0.125f);
+    REQUIRE(fields[2].getFloatValue() == 1.0f);
+    REQUIRE(fields[4] == "2");
+    REQUIRE(fields[7] == "adaptive+novelty");
+    REQUIRE(fields[9].getFloatValue() == 0.5f);
+}
+
+TEST_CASE("FeedbackLog imports the CSV it exports")
+{
+    const auto dir = getLogDirectory("import");
+    const auto log = dir.getChildFile("feedback_log.bin");
+
+    {
+        FeedbackLog writer(log, names);
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            const float genome[] = { 0.125f * static_cast<float>(i), 0.5f };
+            writer.append(genome, makeRecord(i));
+        }
+    }
+
+    const auto csv = dir.getChildFile("dataset.csv");
+    REQUIRE(FeedbackLog::exportCSV(log, csv));
+
+    const auto imported = dir.getChildFile("imported.bin");
+    {
+        FeedbackLog writer(imported, names);
+        REQUIRE(writer.importCSV(csv) == 3);
+
+        // Other columns aren't this log's
+        FeedbackLog other(dir.getChildFile("other.bin"), { "a", "b", "c" });
+        REQUIRE(other.importCSV(csv) == -1);
+    }
+
+    REQUIRE(exportLines(imported).joinIntoString("\n") == exportLines(log).joinIntoString("\n"));
+}
+
+TEST_CASE("FeedbackLog appends across sessions and drops torn records")
+{
+    const auto log = getLogDirectory("reopen").getChildFile("feedback_log.bin");
+    const float genome[] = { 0.0f, 1.0f };
+
+    {
+        FeedbackLog writer(log, names);
+        writer.append(genome, makeRecord(0));
+    }
+
+    // As if a crash cut the last record short
+    {
+        juce::FileOutputStream stream(log);
+        stream.write("torn", 4);
+    }
+
+    {
+        FeedbackLog writer(log, names);
+        writer.append(genome, makeRecord(1));
+    }
+
+    const auto lines = exportLines(log);
+    REQUIRE(lines.size() == 3);
+    REQUIRE(lines[1].contains(",0,"));
+    REQUIRE(lines[2].contains(",1,"));
+}
+
+TEST_CASE("FeedbackLog rotates a log written with other parameters")
+{
+    const auto dir = getLogDirectory("rotate");
+    const auto log = dir.getChildFile("feedback_log.bin");
+    const float genome[] = { 0.5f, 0.5f, 0.5f };
+
+    {
+        FeedbackLog writer(log, { "a", "b", "c" });
+        writer.append(genome, makeRecord(0));
+    }
+
+    {
+        FeedbackLog writer(log, names);
+        writer.append(genome, makeRecord(1));
+    }
+
+    const auto lines = exportLines(log);
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines[0].startsWith("cutoff,resonance,"));
+
+    int backups = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir.getFullPathName().toStdString()))
+        backups += entry.path().filename().string().rfind("feedback_log_backup_", 0) == 0 ? 1 : 0;
+    REQUIRE(backups == 1);
+}
+
+TEST_CASE("FeedbackLog streams its records back in order")
+{
+    const auto log = getLogDirectory("read").getChildFile("feedback_log.bin");
+
+    {
+        FeedbackLog writer(log, names);
+        for (uint64_t i = 0; i < 5; ++i)
+        {
+            const float genome[] = { static_cast<float>(i), 0.5f };
+            writer.append(genome, makeRecord(i));
+        }
+    }
+
+    uint64_t next = 0;
+    REQUIRE(FeedbackLog::readRecords(log, 2, [&](const FeedbackLog::Record& record, const float* genome)
+    {
+        REQUIRE(record.sampleIndex == next);
+        REQUIRE(genome[0] == static_cast<float>(next));
+        REQUIRE(record.rating == 1.0f);
+        ++next;
+    }));
+    REQUIRE(next == 5);
+
+    // Other genome sizes are refused rather than misread
+    REQUIRE_FALSE(FeedbackLog::readRecords(log, 3, [](const FeedbackLog::Record&, const float*) {}));
+}
@@ -5,6 +5,9 @@
 #include "GA/SelectionOperators.h"
 #include "GA/Population.h"
 #include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 TEST_CASE("Mutation keeps parameters in valid range")
 {
@@ -14,7 +17,7 @@ TEST_CASE("Mutation keeps parameters in valid range")
         individual.setParameter(i, 0.5f);
     }
     
-    juce::Random rng(42);
+    RandomStream rng(42);
     UniformMutation mutation;
     mutation.mutationRate = 1.0f;  // Mutate all parameters
     mutation.mutationStrength = 1.0f;  // Maximum perturbation
@@ -40,7 +43,7 @@ TEST_CASE("Crossover produces valid offspring")
         parent2.setParameter(i, 1.0f);
     }
     
-    juce::Random rng(42);
+    RandomStream rng(42);
     UniformCrossover crossover;
     
     Individual offspring = crossover(parent1, parent2, rng);
@@ -62,12 +65,11 @@ TEST_CASE("Tournament selection returns valid index")
     // Set different fitness values
     for (int i = 0; i < 10; ++i)
     {
-        Individual& ind = const_cast<Individual&>(pop[i]);
-        ind.setFitness(static_cast<float>(i) / 10.0f);
+        pop.setFitness(i, static_cast<float>(i) / 10.0f);
     }
     pop.markDirty();
     
-    juce::Random rng(42);
+    RandomStream rng(42);
     TournamentSelection selector;
     selector.tournamentSize = 3;
     
@@ -85,12 +87,11 @@ TEST_CASE("Tournament selection statistically favors higher fitness")
     // Set distinct fitness values: indices 0-4 have low fitness, 5-9 have high
     for (int i = 0; i < 10; ++i)
     {
-        Individual& ind = const_cast<Individual&>(pop[i]);
-        ind.setFitness(static_cast<float>(i) / 10.0f);
+        pop.setFitness(i, static_cast<float>(i) / 10.0f);
     }
     pop.markDirty();
     
-    juce::Random rng(123);
+    RandomStream rng(123);
     TournamentSelection selector;
     selector.tournamentSize = 3;
     
@@ -108,3 +109,148 @@ TEST_CASE("Tournament selection statistically favors higher fitness")
     float ratio = static_cast<float>(highFitnessCount) / trials;
     REQUIRE(ratio > 0.6f);  // Expect significant bias toward higher fitness
 }
+
+namespace
+{
+    // Fitness i / size, shuffled so rank and index differ
+    Population makeRankedPopulation(int size)
+    {
+        Population pop(size, 17);
+        pop.initializeRandom();
+        
+        for (int i = 0; i < size; ++i)
+            pop.setFitness(i, static_cast<float>((i * 7) % size) / static_cast<float>(size));
+        
+        return pop;
+    }
+}
+
+TEST_CASE("Batched tournament selection draws the same winners as single tournaments")
+{
+    Population pop = makeRankedPopulation(30);
+    TournamentSelection selector;
+    
+    RandomStream single(9), batched(9);
+    std::vector<int> winners(64);
+    selector(pop, batched, winners.data(), static_cast<int>(winners.size()));
+    
+    for (int winner : winners)
+        REQUIRE(winner == selector(pop, single));
+}
+
+TEST_CASE("Rank selection follows the linear ranking distribution")
+{
+    const int size = 20;
+    Population pop = makeRankedPopulation(size);
+    
+    RankSelection selector;
+    selector.selectionPressure = 1.8f;
+    selector.prepare(pop);
+    
+    RandomStream rng(5);
+    const int draws = 200000;
+    std::vector<int> indices(static_cast<size_t>(draws));
+    selector(rng, indices.data(), draws);
+    
+    std::vector<int> counts(static_cast<size_t>(size), 0);
+    for (int index : indices)
+        ++counts[static_cast<size_t>(index)];
+    
+    // Member i has rank (i * 7) % size
+    for (int i = 0; i < size; ++i)
+    {
+        const int rank = (i * 7) % size;
+        const double expected = (2.0 - 1.8 + 2.0 * 0.8 * rank / (size - 1)) / size;
+        REQUIRE(std::abs(counts[static_cast<size_t>(i)] / double(draws) - expected) < 0.004);
+    }
+    
+    // Re-ranking follows the population's fitness
+    pop.setFitness(0, 2.0f);
+    selector.prepare(pop);
+    selector(rng, indices.data(), 1000);
+    REQUIRE(std::count(indices.begin(), indices.begin() + 1000, 0) > 1000 * 1.5 / size);
+}
+
+TEST_CASE("Stochastic universal sampling draws each member within one of its share")
+{
+    const int size = 16;
+    Population pop = makeRankedPopulation(size);
+    
+    const float* fitness = pop.getFitnessArray();
+    const float worst = *std::min_element(fitness, fitness + size);
+    const float best = *std::max_element(fitness, fitness + size);
+    const double floorShare = 0.01 * (best - worst);
+    double total = 0.0;
+    for (int i = 0; i < size; ++i)
+        total += fitness[i] - worst + floorShare;
+    
+    RandomStream rng(11);
+    const int count = 40;
+    
+    for (int trial = 0; trial < 50; ++trial)
+    {
+        int indices[count];
+        StochasticUniversalSampling()(pop, rng, indices, count);
+        
+        for (int i = 0; i < size; ++i)
+        {
+            const double expected = count * (fitness[i] - worst + floorShare) / total;
+            const auto drawn = std::count(indices, indices + count, i);
+            REQUIRE(drawn >= static_cast<long>(std::floor(expected)));
+            REQUIRE(drawn <= static_cast<long>(std::ceil(expected)));
+        }
+    }
+}
+
+TEST_CASE("Worst replacement plans keep the best of population and offspring")
+{
+    Population pop = makeRankedPopulation(10);  // Fitness 0.0 ... 0.9
+    const float offspring[] = { 0.05f, 0.95f, 0.15f, 0.25f };
+    int members[4], children[4];
+    
+    // Unconditional: offspring in order over the worst members
+    WorstReplacement worst;
+    REQUIRE(worst(pop, offspring, 4, members, children) == 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(pop.getFitness(members[i]) == static_cast<float>(i) / 10.0f);
+        REQUIRE(children[i] == i);
+    }
+    
+    // Elitist: 0.95 over 0.0, 0.25 over 0.1, 0.15 over 0.2 fails
+    worst.onlyIfBetter = true;
+    REQUIRE(worst(pop, offspring, 4, members, children) == 2);
+    REQUIRE(children[0] == 1);
+    REQUIRE(children[1] == 3);
+}
+
+TEST_CASE("Crowding replacement takes the nearest fitter slot, each slot once")
+{
+    const int size = 12;
+    Population pop(size, 17);
+    
+    // Member i sits at i / size in every parameter with fitness 0.5
+    for (int i = 0; i < size; ++i)
+    {
+        std::vector<float> genome(17, static_cast<float>(i) / size);
+        pop.replace(i, genome.data(), 0.5f);
+    }
+    
+    // Offspring right on top of member 3: fitter, worse, then fitter again
+    std::vector<float> offspring(3 * 17, 3.0f / size);
+    const float fitness[] = { 0.9f, 0.1f, 0.8f };
+    
+    CrowdingReplacement crowding;
+    crowding.crowdingSize = size * 4;  // Sees nearly everyone
+    
+    RandomStream rng(3);
+    int members[3], children[3];
+    const int count = crowding(pop, offspring.data(), fitness, 3, rng, members, children);
+    
+    REQUIRE(count == 2);
+    REQUIRE(members[0] == 3);
+    REQUIRE(children[0] == 0);
+    REQUIRE(members[1] != 3);  // Taken already, so a neighbour
+    REQUIRE(std::abs(members[1] - 3) == 1);
+    REQUIRE(children[1] == 2);
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "GA/GenerationBudget.h"
+#include "GA/GeneticAlgorithm.h"
+#include "GA/IFitnessModel.h"
+#include "GA/ParameterBridge.h"
+
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    // Sleeps per genome, so a generation's time is about its offspring count in milliseconds
+    class SleepingFitnessModel : public IFitnessModel
+    {
+    public:
+        float evaluate(const std::vector<float>& genome) override
+        {
+            juce::Thread::sleep(1);
+            return genome[0];
+        }
+
+        void sendFeedback(const std::vector<float>&, const Feedback&) override {}
+    };
+}
+
+TEST_CASE("GenerationBudget keeps the fixed size without a target")
+{
+    GenerationBudget budget;
+    REQUIRE(budget.getOffspringCount(10, 40, 4) == 10);
+
+    // A latency target only applies once a generation has been measured
+    budget.setTarget(GenerationBudget::Mode::Latency, 50.0f, 250.0f);
+    REQUIRE(budget.getOffspringCount(10, 40, 4) == 10);
+    REQUIRE(budget.getPauseSeconds(0.1, 4) == 0.0);
+
+    budget.recordGeneration(10, 0.01);
+    budget.setTarget(GenerationBudget::Mode::Fixed, 50.0f, 250.0f);
+    REQUIRE(budget.getOffspringCount(10, 40, 4) == 10);
+    REQUIRE(budget.getStats().targetMs == 0.0f);
+}
+
+TEST_CASE("GenerationBudget settles where a generation takes the target time")
+{
+    GenerationBudget budget;
+    budget.setTarget(GenerationBudget::Mode::Latency, 100.0f, 250.0f);
+
+    // 20 ms of overhead plus 4 ms an offspring: 20 offspring take 100 ms
+    auto generationSeconds = [](int n) { return (20.0 + 4.0 * n) / 1000.0; };
+
+    int offspring = 10;
+    for (int generation = 0; generation < 60; ++generation)
+    {
+        offspring = budget.getOffspringCount(10, 40, 1);
+        budget.recordGeneration(offspring, generationSeconds(offspring));
+    }
+
+    REQUIRE(offspring >= 19);
+    REQUIRE(offspring <= 20);
+    REQUIRE_THAT(budget.getStats().generationMs, WithinAbs(100.0, 5.0));
+    REQUIRE(budget.getStats().offspringPerGeneration == offspring);
+}
+
+TEST_CASE("GenerationBudget grows gradually and stays in range")
+{
+    GenerationBudget budget;
+    budget.setTarget(GenerationBudget::Mode::Latency, 1000.0f, 250.0f);
+
+    // Cheap offspring: the target allows hundreds, but each step at most doubles
+    budget.recordGeneration(2, 0.002);
+    REQUIRE(budget.getOffspringCount(10, 40, 1) == 4);
+    REQUIRE(budget.getOffspringCount(10, 40, 1) == 8);
+    REQUIRE(budget.getOffspringCount(10, 40, 1) == 16);
+    REQUIRE(budget.getOffspringCount(10, 40, 1) == 32);
+    REQUIRE(budget.getOffspringCount(10, 40, 1) == 40);
+
+    // Expensive ones: cut straight down, but never below the minimum
+    GenerationBudget tight;
+    tight.setTarget(GenerationBudget::Mode::Latency, 10.0f, 250.0f);
+    tight.recordGeneration(10, 1.0);
+    REQUIRE(tight.getOffspringCount(10, 40, 1) == GenerationBudget::minOffspring);
+}
+
+TEST_CASE("GenerationBudget spreads a CPU target over the evaluation threads")
+{
+    GenerationBudget budget;
+    budget.setTarget(GenerationBudget::Mode::CpuTime, 1000.0f, 200.0f);
+
+    // 200 ms a second over four threads: 50 ms generations
+    REQUIRE_THAT(budget.getTargetSeconds(4), WithinAbs(0.05, 1e-9));
+
+    // Busy 50 ms on four threads is 200 core-ms, so idle 950 ms to average 200 ms/s
+    REQUIRE_THAT(budget.getPauseSeconds(0.05, 4), WithinAbs(0.95, 1e-9));
+    REQUIRE(budget.getPauseSeconds(1.0, 4) == GenerationBudget::maxPauseSeconds);
+
+    budget.recordCycle(0.05, 4, 1.0);
+    REQUIRE_THAT(budget.getStats().cpuMsPerSecond, WithinAbs(200.0, 1e-3));
+
+    // A target beyond what the threads can use never pauses
+    budget.setTarget(GenerationBudget::Mode::CpuTime, 1000.0f, 5000.0f);
+    REQUIRE(budget.getPauseSeconds(0.05, 1) == 0.0);
+}
+
+TEST_CASE("A latency budget sizes the GA's generations to the target")
+{
+    SleepingFitnessModel model;
+    GeneticAlgorithm ga(model);
+
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.populationSize = 80;
+    config.budgetMode = GAConfig::BudgetMode::Latency;
+    config.targetLatencyMs = 25.0f;
+    ga.setConfig(config);
+    REQUIRE(config.toString() == "latency25");
+
+    ga.stepGeneration();  // Initialises the population
+    for (int generation = 0; generation < 30; ++generation)
+        ga.stepGeneration();
+
+    // About a millisecond an offspring: more than the fixed ten, fewer than the cap
+    const auto stats = ga.getBudgetStats();
+    REQUIRE(stats.offspringPerGeneration > GeneticAlgorithm::getOffspringPerGeneration());
+    REQUIRE(stats.offspringPerGeneration < 40);
+    REQUIRE_THAT(stats.generationMs, WithinAbs(25.0, 10.0));
+
+    // A tighter target cuts the generations down
+    config.targetLatencyMs = 5.0f;
+    ga.setConfig(config);
+    for (int generation = 0; generation < 10; ++generation)
+        ga.stepGeneration();
+
+    REQUIRE(ga.getBudgetStats().offspringPerGeneration < GeneticAlgorithm::getOffspringPerGeneration());
+}
+
+TEST_CASE("The GA measures how soon a fetched preset is replaced")
+{
+    SleepingFitnessModel model;
+    GeneticAlgorithm ga(model);
+
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.budgetMode = GAConfig::BudgetMode::Latency;
+    config.targetLatencyMs = 20.0f;
+    ga.setConfig(config);
+
+    ga.startGA();
+    juce::Thread::sleep(300);
+
+    std::vector<float> params;
+    float fitness;
+    REQUIRE(ga.getParameterBridge()->pop(params, fitness));
+    juce::Thread::sleep(300);
+    ga.stopGA();
+
+    // A generation or so, not the time the queue sat full
+    const auto stats = ga.getBudgetStats();
+    REQUIRE(stats.fetchLatencyMs > 0.0f);
+    REQUIRE(stats.fetchLatencyMs < 200.0f);
+}
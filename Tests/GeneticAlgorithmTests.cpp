@@ -2,6 +2,7 @@
 #include "GA/GeneticAlgorithm.h"
 #include "GA/ParameterBridge.h"
 #include "GA/IFitnessModel.h"
+#include "GA/GenomeConstraints.h"
 #include <juce_core/juce_core.h>
 
 // Simple mock fitness model that returns constant fitness
@@ -18,6 +19,144 @@ public:
     }
 };
 
+// Fitness is the mean parameter; the estimate is either exact or deliberately inverted
+class EstimatingFitnessModel : public IFitnessModel
+{
+public:
+    explicit EstimatingFitnessModel(bool invertEstimate_) : invertEstimate(invertEstimate_) {}
+    
+    float evaluate(const std::vector<float>& genome) override
+    {
+        float sum = 0.0f;
+        for (float value : genome)
+            sum += value;
+        return sum / static_cast<float>(genome.size());
+    }
+    
+    bool estimateBatch(const float* genomes, int numGenomes, int genomeSize, float* estimatesOut) override
+    {
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            const float* row = genomes + static_cast<size_t>(i) * genomeSize;
+            float fitness = evaluate(std::vector<float>(row, row + genomeSize));
+            estimatesOut[i] = invertEstimate ? 1.0f - fitness : fitness;
+        }
+        return true;
+    }
+    
+    void sendFeedback(const std::vector<float>& /*genome*/, const Feedback& /*feedback*/) override
+    {
+    }
+    
+private:
+    bool invertEstimate;
+};
+
+// Flat fitness; the model is least sure about genomes with a high first parameter
+class UncertainFitnessModel : public IFitnessModel
+{
+public:
+    float evaluate(const std::vector<float>& /*genome*/) override
+    {
+        return 0.5f;
+    }
+    
+    bool evaluateUncertainty(const float* genomes, int numGenomes, int genomeSize,
+                             float* meanOut, float* varianceOut) override
+    {
+        float highest = -1.0f;
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            const float* row = genomes + static_cast<size_t>(i) * genomeSize;
+            meanOut[i] = 0.5f;
+            varianceOut[i] = row[0];
+            
+            if (row[0] > highest)
+            {
+                highest = row[0];
+                mostUncertain.assign(row, row + genomeSize);
+            }
+        }
+        ++calls;
+        return true;
+    }
+    
+    void sendFeedback(const std::vector<float>& /*genome*/, const Feedback& /*feedback*/) override
+    {
+    }
+    
+    std::vector<float> mostUncertain;
+    int calls = 0;
+};
+
+// Rewards a high or a low mean parameter; flipping is a model update
+class VersionedFitnessModel : public IFitnessModel
+{
+public:
+    float evaluate(const std::vector<float>& genome) override
+    {
+        float sum = 0.0f;
+        for (float value : genome)
+            sum += value;
+        const float mean = sum / static_cast<float>(genome.size());
+        return preferLow.load() ? 1.0f - mean : mean;
+    }
+    
+    uint64_t getModelVersion() const override { return version.load(); }
+    
+    void flip()
+    {
+        preferLow = !preferLow.load();
+        ++version;
+    }
+    
+    void sendFeedback(const std::vector<float>& /*genome*/, const Feedback& /*feedback*/) override
+    {
+    }
+    
+private:
+    std::atomic<bool> preferLow { false };
+    std::atomic<uint64_t> version { 1 };
+};
+
+// Fitness is the mean parameter; the surrogate ranks either alike or in reverse
+class SurrogateFitnessModel : public IFitnessModel
+{
+public:
+    explicit SurrogateFitnessModel(bool invertSurrogate_) : invertSurrogate(invertSurrogate_) {}
+    
+    float evaluate(const std::vector<float>& genome) override
+    {
+        ++evaluations;
+        float sum = 0.0f;
+        for (float value : genome)
+            sum += value;
+        return sum / static_cast<float>(genome.size());
+    }
+    
+    bool surrogateBatch(const float* genomes, int numGenomes, int genomeSize, float* scoresOut) override
+    {
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            const float* row = genomes + static_cast<size_t>(i) * genomeSize;
+            float sum = 0.0f;
+            for (int j = 0; j < genomeSize; ++j)
+                sum += row[j];
+            scoresOut[i] = invertSurrogate ? -sum : sum;  // A different scale, same (or reversed) order
+        }
+        return true;
+    }
+    
+    void sendFeedback(const std::vector<float>& /*genome*/, const Feedback& /*feedback*/) override
+    {
+    }
+    
+    int evaluations = 0;
+    
+private:
+    bool invertSurrogate;
+};
+
 TEST_CASE("GeneticAlgorithm starts and stops cleanly")
 {
     MockFitnessModel model;
@@ -81,6 +220,99 @@ TEST_CASE("GeneticAlgorithm produces parameter updates")
     ga.stopGA();
 }
 
+TEST_CASE("GeneticAlgorithm produces updates with parallel evaluation")
+{
+    MockFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 4;
+    ga.setConfig(config);
+    
+    ga.startGA();
+    juce::Thread::sleep(200);
+    
+    auto* bridge = ga.getParameterBridge();
+    REQUIRE(bridge->hasData() == true);
+    
+    std::vector<float> params;
+    float fitness;
+    REQUIRE(bridge->pop(params, fitness) == true);
+    REQUIRE(params.size() == 17);
+    
+    ga.stopGA();
+}
+
+TEST_CASE("GeneticAlgorithm refills the bridge as soon as a preset is taken")
+{
+    MockFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    ga.setConfig(config);
+    
+    ga.startGA();
+    juce::Thread::sleep(200);
+    
+    auto* bridge = ga.getParameterBridge();
+    REQUIRE(bridge->hasData() == true);
+    
+    std::vector<float> params;
+    float fitness;
+    
+    for (int i = 0; i < 5; ++i)
+    {
+        REQUIRE(bridge->pop(params, fitness) == true);
+        
+        // Previously the GA polled the mailbox every 100 ms
+        auto start = juce::Time::getMillisecondCounterHiRes();
+        while (!bridge->hasData() && juce::Time::getMillisecondCounterHiRes() - start < 2000.0)
+            juce::Thread::yield();
+        
+        REQUIRE(bridge->hasData() == true);
+    }
+    
+    ga.stopGA();
+    REQUIRE(ga.isGARunning() == false);
+}
+
+TEST_CASE("GeneticAlgorithm island mode evolves and feeds the bridge")
+{
+    MockFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 4;
+    config.numIslands = 4;
+    config.migrationInterval = 3;
+    ga.setConfig(config);
+    
+    auto* bridge = ga.getParameterBridge();
+    
+    for (bool randomMigration : { false, true })
+    {
+        config.randomMigration = randomMigration;
+        ga.setConfig(config);
+        
+        for (int i = 0; i < 12; ++i)
+            ga.stepGeneration();
+        
+        // Four islands each offer a candidate per generation
+        REQUIRE(bridge->isFull());
+        
+        std::vector<float> params;
+        float fitness;
+        while (bridge->pop(params, fitness))
+            REQUIRE(params.size() == 17);
+    }
+    
+    ga.startGA();
+    juce::Thread::sleep(100);
+    REQUIRE(bridge->hasData() == true);
+    ga.stopGA();
+}
+
 TEST_CASE("GeneticAlgorithm double start is safe")
 {
     MockFitnessModel model;
@@ -120,6 +352,8 @@ TEST_CASE("GAConfig defaults are sensible")
     REQUIRE(config.epsilonDecay < 1.0f);
     REQUIRE(config.noveltyWeight >= 0.0f);
     REQUIRE(config.noveltyWeight <= 1.0f);
+    REQUIRE(config.numIslands == 1);
+    REQUIRE(config.migrationInterval > 0);
 }
 
 TEST_CASE("setConfig enables adaptive exploration")
@@ -169,3 +403,499 @@ TEST_CASE("setConfig enables multi-objective")
     REQUIRE(ga.getConfig().noveltyWeight == 0.4f);
 }
 
+TEST_CASE("Progressive evaluation rejects hopeless offspring and audits the rejections")
+{
+    EstimatingFitnessModel model(false);
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.progressiveEvaluation = true;
+    config.earlyRejectMargin = 0.0f;
+    config.rejectionAuditRate = 0.5f;
+    ga.setConfig(config);
+    
+    ga.stepGeneration();  // Initialises the population
+    
+    for (int generation = 0; generation < 30; ++generation)
+        ga.stepGeneration();
+    
+    auto stats = ga.getProgressiveStats();
+    REQUIRE(stats.estimated == 31 * 10);
+    REQUIRE(stats.rejected > 0);
+    REQUIRE(stats.fullyEvaluated < stats.estimated);
+    REQUIRE(stats.fullyEvaluated == stats.estimated - stats.rejected + stats.audited);
+    
+    // An exact estimate never rejects a survivor
+    REQUIRE(stats.audited > 0);
+    REQUIRE(stats.wrongRejections == 0);
+}
+
+TEST_CASE("Progressive evaluation measures wrong rejections")
+{
+    EstimatingFitnessModel model(true);
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.progressiveEvaluation = true;
+    config.rejectionAuditRate = 1.0f;
+    ga.setConfig(config);
+    
+    for (int generation = 0; generation < 20; ++generation)
+        ga.stepGeneration();
+    
+    // Inverted estimates reject the best offspring, and every rejection is audited
+    auto stats = ga.getProgressiveStats();
+    REQUIRE(stats.audited == stats.rejected);
+    REQUIRE(stats.wrongRejections > 0);
+    REQUIRE(stats.getWrongRejectionRate() > 0.0f);
+}
+
+TEST_CASE("Progressive evaluation falls back when the model has no estimate")
+{
+    MockFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.progressiveEvaluation = true;
+    ga.setConfig(config);
+    
+    for (int generation = 0; generation < 3; ++generation)
+        ga.stepGeneration();
+    
+    REQUIRE(ga.getProgressiveStats().estimated == 0);
+}
+
+TEST_CASE("Surrogate filtering fully evaluates only the top offspring")
+{
+    SurrogateFitnessModel model(false);
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.surrogateFiltering = true;
+    config.surrogateKeepFraction = 0.3f;
+    config.rejectionAuditRate = 0.0f;
+    ga.setConfig(config);
+    REQUIRE(config.toString() == "surrogate");
+    
+    ga.stepGeneration();  // Initialises the population, then one generation
+    const int initialEvaluations = model.evaluations - 3;
+    
+    for (int generation = 0; generation < 20; ++generation)
+        ga.stepGeneration();
+    
+    const auto stats = ga.getSurrogateStats();
+    REQUIRE(stats.screened == 21 * 10);
+    REQUIRE(stats.cut == 21 * 7);
+    REQUIRE(stats.fullyEvaluated == 21 * 3);
+    REQUIRE(model.evaluations - initialEvaluations == 21 * 3);
+    
+    // Kept offspring ranked alike by both stages
+    REQUIRE(stats.concordantPairs > 0);
+    REQUIRE(stats.getRankAgreement() == 1.0f);
+    REQUIRE(ga.getPopulationStats().bestFitness > 0.5f);
+}
+
+TEST_CASE("Surrogate filtering measures rank agreement on audited cuts")
+{
+    SurrogateFitnessModel model(true);
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.surrogateFiltering = true;
+    config.rejectionAuditRate = 1.0f;
+    ga.setConfig(config);
+    
+    for (int generation = 0; generation < 10; ++generation)
+        ga.stepGeneration();
+    
+    // A reversed surrogate cuts the best offspring, and every cut is audited
+    const auto stats = ga.getSurrogateStats();
+    REQUIRE(stats.audited == stats.cut);
+    REQUIRE(stats.fullyEvaluated == stats.screened);
+    REQUIRE(stats.wrongCuts > 0);
+    REQUIRE(stats.getWrongCutRate() > 0.0f);
+    REQUIRE(stats.getRankAgreement() == -1.0f);
+}
+
+TEST_CASE("Surrogate filtering falls back when the model has no surrogate")
+{
+    EstimatingFitnessModel model(false);
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.surrogateFiltering = true;
+    config.progressiveEvaluation = true;
+    ga.setConfig(config);
+    
+    for (int generation = 0; generation < 3; ++generation)
+        ga.stepGeneration();
+    
+    REQUIRE(ga.getSurrogateStats().screened == 0);
+    REQUIRE(ga.getProgressiveStats().estimated == 30);
+}
+
+TEST_CASE("Oversampled proposals keep the surrogate's best offspring")
+{
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.populationSize = 20;
+    
+    // Same seed and generations, with and without a proposal batch
+    auto run = [&config](int proposalBatchSize, int& evaluationsOut)
+    {
+        SurrogateFitnessModel model(false);
+        GeneticAlgorithm ga(model);
+        config.proposalBatchSize = proposalBatchSize;
+        ga.setConfig(config);
+        ga.setSeed(3);
+        
+        for (int generation = 0; generation < 20; ++generation)
+            ga.stepGeneration();
+        
+        evaluationsOut = model.evaluations;
+        return ga.getPopulationStats();
+    };
+    
+    int plainEvaluations = 0, oversampledEvaluations = 0;
+    const auto plain = run(0, plainEvaluations);
+    const auto oversampled = run(200, oversampledEvaluations);
+    
+    // Only the kept offspring are fully evaluated
+    REQUIRE(plainEvaluations == 20 + 20 * 10);
+    REQUIRE(oversampledEvaluations == plainEvaluations);
+    REQUIRE(oversampled.averageFitness > plain.averageFitness);
+    REQUIRE(oversampled.bestFitness > plain.bestFitness);
+}
+
+TEST_CASE("Oversampled proposals fall back to plain breeding without a surrogate")
+{
+    EstimatingFitnessModel model(false);
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.proposalBatchSize = 64;
+    ga.setConfig(config);
+    REQUIRE(config.toString() == "proposals64");
+    
+    // At or below a generation's offspring count nothing is oversampled
+    GAConfig unused;
+    unused.proposalBatchSize = GAConfig::offspringPerGeneration;
+    REQUIRE(unused.toString() == "baseline");
+    
+    for (int generation = 0; generation < 5; ++generation)
+        ga.stepGeneration();
+    
+    REQUIRE(ga.getPopulationStats().generation == 5);
+    REQUIRE(ga.getParameterBridge()->hasData());
+}
+
+TEST_CASE("Silence rejection breeds again instead of evaluating inaudible offspring")
+{
+    // Rewards ever slower attacks, which drives the GA towards silence
+    struct SlowAttackModel : public IFitnessModel
+    {
+        std::atomic<int> inaudibleEvaluations { 0 };
+        
+        float evaluate(const std::vector<float>& genome) override
+        {
+            if (!GenomeConstraints::isAudible(genome.data(), static_cast<int>(genome.size())))
+                ++inaudibleEvaluations;
+            return genome[GenomeConstraints::EnvAttack];
+        }
+        
+        void sendFeedback(const std::vector<float>&, const Feedback&) override {}
+    };
+    
+    auto run = [](bool rejectSilence, GeneticAlgorithm::SilenceStats& stats)
+    {
+        SlowAttackModel model;
+        
+        GAConfig config;
+        config.numEvaluationThreads = 1;
+        config.populationSize = 20;
+        config.silenceRejection = rejectSilence;
+        
+        GeneticAlgorithm ga(model);
+        ga.setConfig(config);
+        ga.setSeed(11);
+        
+        for (int i = 0; i < 60; ++i)
+            ga.stepGeneration();
+        
+        stats = ga.getSilenceStats();
+        return model.inaudibleEvaluations.load();
+    };
+    
+    GeneticAlgorithm::SilenceStats off, on;
+    const int inaudibleWithout = run(false, off);
+    const int inaudibleWith = run(true, on);
+    
+    REQUIRE(off.screened == 0);
+    REQUIRE(inaudibleWithout > 30);
+    
+    // Every offspring is screened; only those still inaudible after every
+    // retry (and the initial random population) are evaluated
+    REQUIRE(on.screened >= 60u * GeneticAlgorithm::getOffspringPerGeneration());
+    REQUIRE(on.rejected > 0);
+    REQUIRE(inaudibleWith < inaudibleWithout / 2);
+    REQUIRE(static_cast<uint64_t>(inaudibleWith) <= on.kept + 20);
+}
+
+TEST_CASE("A model update re-scores the whole population within one generation")
+{
+    VersionedFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 2;
+    ga.setConfig(config);
+    
+    for (int generation = 0; generation < 20; ++generation)
+        ga.stepGeneration();
+    
+    const auto before = ga.getPopulationStats();
+    REQUIRE(before.rescores == 0);
+    REQUIRE(before.averageFitness > 0.55f);
+    
+    // The population evolved towards high means, which now score low; stale
+    // scores would keep the average where it was
+    model.flip();
+    ga.stepGeneration();
+    
+    const auto after = ga.getPopulationStats();
+    REQUIRE(after.rescores == 1);
+    REQUIRE(after.averageFitness < 0.45f);
+    
+    ga.stepGeneration();
+    REQUIRE(ga.getPopulationStats().rescores == 1);
+}
+
+TEST_CASE("Uncertainty exploration offers the offspring the model is least sure about")
+{
+    UncertainFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.uncertaintyExploration = true;
+    ga.setConfig(config);
+    REQUIRE(config.toString() == "ucb");
+    
+    for (int generation = 0; generation < 3; ++generation)
+    {
+        ga.stepGeneration();
+        
+        std::vector<float> params;
+        float fitness;
+        REQUIRE(ga.getParameterBridge()->pop(params, fitness));
+        REQUIRE(params == model.mostUncertain);
+    }
+    
+    REQUIRE(model.calls == 3);
+}
+
+TEST_CASE("Uncertainty exploration falls back to epsilon-greedy without an estimate")
+{
+    MockFitnessModel model;
+    GeneticAlgorithm ga(model);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.uncertaintyExploration = true;
+    ga.setConfig(config);
+    
+    ga.stepGeneration();
+    REQUIRE(ga.getParameterBridge()->hasData());
+}
+
+TEST_CASE("Seeded runs with a configured population size are reproducible")
+{
+    EstimatingFitnessModel model(false);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.populationSize = 20;
+    
+    auto run = [&](juce::int64 seed)
+    {
+        GeneticAlgorithm ga(model);
+        ga.setConfig(config);
+        ga.setSeed(seed);
+        
+        for (int i = 0; i < 30; ++i)
+            ga.stepGeneration();
+        
+        return ga.getPopulationStats();
+    };
+    
+    const auto first = run(42);
+    const auto second = run(42);
+    
+    REQUIRE(first.generation == 30);
+    REQUIRE(first.bestFitness == second.bestFitness);
+    REQUIRE(first.averageFitness == second.averageFitness);
+    REQUIRE(first.worstFitness <= first.averageFitness);
+    REQUIRE(first.averageFitness <= first.bestFitness);
+}
+
+TEST_CASE("Every selection and replacement strategy evolves towards fitter presets")
+{
+    EstimatingFitnessModel model(false);
+    
+    const GAConfig::SelectionMode selections[] = { GAConfig::SelectionMode::Tournament, GAConfig::SelectionMode::Rank,
+                                                   GAConfig::SelectionMode::StochasticUniversal };
+    const GAConfig::ReplacementMode replacements[] = { GAConfig::ReplacementMode::WorstN, GAConfig::ReplacementMode::Crowding,
+                                                       GAConfig::ReplacementMode::ElitistSteadyState };
+    
+    for (auto selection : selections)
+    {
+        for (auto replacement : replacements)
+        {
+            GAConfig config;
+            config.numEvaluationThreads = 1;
+            config.populationSize = 40;
+            config.selectionMode = selection;
+            config.replacementMode = replacement;
+            
+            GeneticAlgorithm ga(model);
+            ga.setConfig(config);
+            ga.setSeed(17);
+            ga.stepGeneration();
+            
+            const auto initial = ga.getPopulationStats();
+            float best = initial.bestFitness;
+            
+            for (int i = 0; i < 40; ++i)
+            {
+                ga.stepGeneration();
+                
+                // Only worst-N may give up a better member for a worse offspring
+                if (replacement != GAConfig::ReplacementMode::WorstN)
+                    REQUIRE(ga.getPopulationStats().bestFitness >= best);
+                best = ga.getPopulationStats().bestFitness;
+            }
+            
+            INFO(config.toString());
+            REQUIRE(ga.getPopulationStats().averageFitness > initial.averageFitness);
+        }
+    }
+    
+    GAConfig config;
+    config.selectionMode = GAConfig::SelectionMode::Rank;
+    config.replacementMode = GAConfig::ReplacementMode::Crowding;
+    REQUIRE(config.toString() == "rank+crowding");
+}
+
+TEST_CASE("Seeded island runs do not depend on the number of evaluation threads")
+{
+    EstimatingFitnessModel model(false);
+    
+    GAConfig config;
+    config.numIslands = 3;
+    config.migrationInterval = 5;
+    config.populationSize = 20;
+    config.adaptiveExploration = true;
+    
+    auto run = [&](int numThreads)
+    {
+        config.numEvaluationThreads = numThreads;
+        GeneticAlgorithm ga(model);
+        ga.setConfig(config);
+        ga.setSeed(99);
+        
+        for (int i = 0; i < 25; ++i)
+            ga.stepGeneration();
+        
+        juce::MemoryBlock snapshot;
+        REQUIRE(ga.getPopulationSnapshot(snapshot));
+        const auto* bytes = static_cast<const char*>(snapshot.getData());
+        return std::vector<char>(bytes, bytes + snapshot.getSize());
+    };
+    
+    // Same genomes, fitness and generators, whichever worker bred each island
+    const auto serial = run(1);
+    REQUIRE(run(4) == serial);
+    REQUIRE(run(3) == serial);
+}
+
+TEST_CASE("A population snapshot resumes the GA where it stopped")
+{
+    EstimatingFitnessModel model(false);
+    
+    GAConfig config;
+    config.numEvaluationThreads = 1;
+    config.populationSize = 20;
+    
+    GeneticAlgorithm original(model);
+    original.setConfig(config);
+    original.setSeed(7);
+    
+    juce::MemoryBlock snapshot;
+    REQUIRE_FALSE(original.getPopulationSnapshot(snapshot));  // No population yet
+    
+    for (int i = 0; i < 10; ++i)
+        original.stepGeneration();
+    
+    REQUIRE(original.getPopulationSnapshot(snapshot));
+    
+    GeneticAlgorithm resumed(model);
+    resumed.setConfig(config);
+    REQUIRE(resumed.setPopulationSnapshot(snapshot.getData(), snapshot.getSize()));
+    
+    SECTION("the first candidate is queued before any evaluation")
+    {
+        resumed.startGA();
+        REQUIRE(resumed.getParameterBridge()->hasData());
+        resumed.stopGA();
+    }
+    
+    SECTION("evolution continues exactly as if it never stopped")
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            original.stepGeneration();
+            resumed.stepGeneration();
+        }
+        
+        const auto expected = original.getPopulationStats();
+        const auto actual = resumed.getPopulationStats();
+        
+        REQUIRE(actual.generation == 15);
+        REQUIRE(actual.bestFitness == expected.bestFitness);
+        REQUIRE(actual.averageFitness == expected.averageFitness);
+        REQUIRE(actual.worstFitness == expected.worstFitness);
+    }
+    
+    SECTION("a snapshot of another population size is ignored")
+    {
+        config.populationSize = 30;
+        resumed.setConfig(config);
+        resumed.stepGeneration();
+        
+        REQUIRE(resumed.getPopulationStats().generation == 1);
+    }
+}
+
+TEST_CASE("Damaged population snapshots are rejected")
+{
+    MockFitnessModel model;
+    GeneticAlgorithm ga(model);
+    ga.stepGeneration();
+    
+    juce::MemoryBlock snapshot;
+    REQUIRE(ga.getPopulationSnapshot(snapshot));
+    REQUIRE(ga.setPopulationSnapshot(snapshot.getData(), snapshot.getSize()));
+    
+    auto* bytes = static_cast<char*>(snapshot.getData());
+    bytes[snapshot.getSize() - 1] ^= 0x5a;
+    REQUIRE_FALSE(ga.setPopulationSnapshot(snapshot.getData(), snapshot.getSize()));
+    REQUIRE_FALSE(ga.setPopulationSnapshot(snapshot.getData(), 16));
+    REQUIRE_FALSE(ga.setPopulationSnapshot(nullptr, 0));
+}
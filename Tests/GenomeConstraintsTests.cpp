@@ -1,5 +1,39 @@
 #include <catch2/catch_test_macros.hpp>
 #include "GA/GenomeConstraints.h"
+#include "GA/HeadlessSynth.h"
+#include "GA/RandomStream.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Level of the feature phrase (as AudioFeatureCache plays it at 22050 Hz) in dBFS
+    float renderPhraseDb(const std::vector<float>& genome)
+    {
+        constexpr double sampleRate = 22050.0;
+        constexpr int totalSamples = 22050;
+        constexpr int noteDuration = totalSamples / 4;
+        const std::vector<MidiEvent> phrase = {
+            { 0, 0x90, 60, 110 },
+            { noteDuration - 100, 0x80, 60, 0 },
+            { noteDuration, 0x90, 64, 80 },
+            { noteDuration * 2 - 100, 0x80, 64, 0 },
+            { noteDuration * 2, 0x90, 67, 50 },
+            { noteDuration * 3 - 100, 0x80, 67, 0 },
+            { noteDuration * 3, 0x90, 72, 100 },
+            { totalSamples - 200, 0x80, 72, 0 }
+        };
+        
+        HeadlessSynth synth(sampleRate);
+        synth.setParameters(genome);
+        const auto audio = synth.renderSequence(phrase, totalSamples);
+        
+        double energy = 0.0;
+        for (int i = 0; i < totalSamples; ++i)
+            energy += static_cast<double>(audio.getSample(0, i)) * audio.getSample(0, i);
+        return static_cast<float>(10.0 * std::log10(energy / totalSamples + 1e-20));
+    }
+}
 
 TEST_CASE("GenomeConstraints repairs low filterFreq with low filterEnv")
 {
@@ -42,3 +76,106 @@ TEST_CASE("GenomeConstraints handles edge case of very low filterFreq")
     // Env should be boosted significantly
     REQUIRE(genome[GenomeConstraints::FilterEnv] >= 0.5f);
 }
+
+TEST_CASE("GenomeConstraints repairBatch leaves every row as repair does")
+{
+    constexpr int numGenomes = 64;
+    RandomStream random(17);
+    
+    std::vector<float> batch(static_cast<size_t>(numGenomes) * 17);
+    for (auto& value : batch)
+        value = random.nextFloat();
+    
+    // Include the edges: fully closed, and exactly at the audibility limit
+    batch[GenomeConstraints::FilterFreq] = 0.0f;
+    batch[GenomeConstraints::FilterEnv] = 0.0f;
+    batch[17 + GenomeConstraints::FilterFreq] = 0.35f;
+    batch[17 + GenomeConstraints::FilterEnv] = 0.2f;
+    
+    auto single = batch;
+    GenomeConstraints::repairBatch(batch.data(), numGenomes, 17);
+    
+    for (int row = 0; row < numGenomes; ++row)
+    {
+        float* genome = single.data() + row * 17;
+        GenomeConstraints::repair(genome, 17);
+        
+        for (int i = 0; i < 17; ++i)
+            REQUIRE(batch[static_cast<size_t>(row * 17 + i)] == genome[i]);
+    }
+    
+    REQUIRE(batch[GenomeConstraints::FilterEnv] > 0.5f);
+    REQUIRE(batch[17 + GenomeConstraints::FilterEnv] == 0.2f);  // Open enough already
+}
+
+TEST_CASE("GenomeConstraints predicts inaudible envelopes and filters")
+{
+    std::vector<float> genome(17, 0.5f);
+    genome[GenomeConstraints::EnvAttack] = 0.0f;
+    genome[GenomeConstraints::FilterFreq] = 0.8f;
+    
+    const float open = GenomeConstraints::estimateLevelDb(genome.data(), 17);
+    REQUIRE(open > -10.0f);
+    REQUIRE(GenomeConstraints::isAudible(genome.data(), 17));
+    
+    // A pluck: fastest decay to no sustain still sounds at every note-on
+    auto pluck = genome;
+    pluck[GenomeConstraints::EnvDecay] = 0.0f;
+    pluck[GenomeConstraints::EnvSustain] = 0.0f;
+    REQUIRE(GenomeConstraints::estimateLevelDb(pluck.data(), 17) < open);
+    REQUIRE(GenomeConstraints::isAudible(pluck.data(), 17));
+    
+    // A filter a negative envelope holds shut still lets the saw's low end
+    // through, so it is quieter but audible
+    auto closing = genome;
+    closing[GenomeConstraints::FilterFreq] = 0.4f;
+    closing[GenomeConstraints::FilterEnv] = 0.0f;
+    closing[GenomeConstraints::FilterAttack] = 0.0f;
+    closing[GenomeConstraints::FilterSustain] = 1.0f;
+    REQUIRE(GenomeConstraints::estimateLevelDb(closing.data(), 17) < open - 6.0f);
+    REQUIRE(GenomeConstraints::isAudible(closing.data(), 17));
+    
+    // The slowest attack barely gets going within a quarter-second note,
+    // and behind that filter it is lost
+    auto slowAttack = closing;
+    slowAttack[GenomeConstraints::EnvAttack] = 1.0f;
+    REQUIRE_FALSE(GenomeConstraints::isAudible(slowAttack.data(), 17));
+    
+    // Too short to say: assumed audible
+    REQUIRE(GenomeConstraints::estimateLevelDb(genome.data(), 5) == 0.0f);
+}
+
+TEST_CASE("Genomes predicted inaudible render far below typical genomes")
+{
+    RandomStream random(5);
+    std::vector<float> typicalLevels, rejectedLevels;
+    
+    for (int n = 0; n < 400; ++n)
+    {
+        std::vector<float> genome(17);
+        for (auto& value : genome)
+            value = random.nextFloat();
+        GenomeConstraints::repair(genome);
+        
+        // Every other genome gets a slow attack, so plenty are predicted inaudible
+        const bool typical = n % 2 == 1;
+        if (!typical)
+            genome[GenomeConstraints::EnvAttack] = 0.9f + 0.1f * random.nextFloat();
+        
+        const float level = renderPhraseDb(genome);
+        if (typical)
+            typicalLevels.push_back(level);
+        if (!GenomeConstraints::isAudible(genome.data(), 17))
+            rejectedLevels.push_back(level);
+    }
+    
+    std::sort(typicalLevels.begin(), typicalLevels.end());
+    const float median = typicalLevels[typicalLevels.size() / 2];
+    
+    REQUIRE(rejectedLevels.size() >= 8);
+    for (float level : rejectedLevels)
+        REQUIRE(level < median - 10.0f);
+    
+    std::sort(rejectedLevels.begin(), rejectedLevels.end());
+    REQUIRE(rejectedLevels[rejectedLevels.size() / 2] < median - 20.0f);
+}
@@ -0,0 +1,381 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/HeadlessSynth.h"
+#include "GA/HeadlessSynthBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::vector<float> makeGenome(float envRelease)
+    {
+        std::vector<float> genome(HeadlessParam::COUNT, 0.5f);
+        genome[HeadlessParam::envAttack] = 0.0f;
+        genome[HeadlessParam::envRelease] = envRelease;
+        return genome;
+    }
+    
+    // A patch inside the GA's fixed settings: no glide, polyphonic, 0 dB
+    void configurePatch(Synth& synth, double sampleRate)
+    {
+        synth.allocateResources(sampleRate, 512);
+        synth.reset();
+        
+        const float inverseSampleRate = 1.0f / static_cast<float>(sampleRate);
+        synth.envAttack = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * 10.0f));
+        synth.envDecay = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * 50.0f));
+        synth.envSustain = 0.6f;
+        synth.envRelease = std::exp(-inverseSampleRate * std::exp(5.5f - 0.075f * 40.0f));
+        synth.noiseMix = 0.01f;
+        synth.oscMix = 0.7f;
+        synth.detune = std::pow(1.059463094359f, -0.1f);
+        synth.tune = static_cast<float>(sampleRate) * std::exp(0.05776226505f * -36.3763f);
+        synth.numVoices = Synth::MAX_VOICES;
+        synth.volumeTrim = 0.0008f * 2.5f;
+        synth.outputLevelSmoother.setCurrentAndTargetValue(1.0f);
+        synth.velocitySensitivity = 0.025f;
+        synth.ignoreVelocity = false;
+        synth.lfoInc = 0.2f * inverseSampleRate * synth.LFO_MAX * 6.2831853f;
+        synth.vibrato = 0.01f;
+        synth.pwmDepth = 0.01f;
+        synth.glideMode = 0;
+        synth.glideRate = 1.0f;
+        synth.glideBend = 0.0f;
+        synth.filterKeyTracking = 2.0f;
+        synth.filterQ = 2.0f;
+        synth.filterLFODepth = 0.4f;
+        synth.filterAttack = 0.9f;
+        synth.filterDecay = 0.99f;
+        synth.filterSustain = 0.3f;
+        synth.filterRelease = 0.95f;
+        synth.filterEnvDepth = 1.5f;
+    }
+}
+
+TEST_CASE("HeadlessSynth leaves the tail silent once a short release has decayed")
+{
+    HeadlessSynth synth(44100.0, 512);
+    synth.setParameters(makeGenome(0.0f));
+    
+    const int totalSamples = 88200;
+    std::vector<MidiEvent> events = {
+        { 0, 0x90, 60, 100 },
+        { 22050, 0x80, 60, 0 }
+    };
+    
+    auto buffer = synth.renderSequence(events, totalSamples);
+    const float* data = buffer.getReadPointer(0);
+    
+    bool soundedWhileHeld = false;
+    for (int i = 0; i < 22050; ++i)
+        soundedWhileHeld = soundedWhileHeld || data[i] != 0.0f;
+    REQUIRE(soundedWhileHeld);
+    
+    // Rendering stopped soon after the release instead of running out the buffer
+    REQUIRE(synth.getRenderedSamples() > 22050);
+    REQUIRE(synth.getRenderedSamples() < totalSamples / 2);
+    
+    const bool tailSilent = std::all_of(data + totalSamples / 2, data + totalSamples, [](float x) { return x == 0.0f; });
+    REQUIRE(tailSilent);
+}
+
+TEST_CASE("HeadlessSynth renders repeatably with a long release")
+{
+    HeadlessSynth synth(44100.0, 512);
+    synth.setParameters(makeGenome(1.0f));
+    
+    std::vector<MidiEvent> events = {
+        { 0, 0x90, 60, 100 },
+        { 4410, 0x80, 60, 0 }
+    };
+    
+    auto first = synth.renderSequence(events, 44100);
+    auto second = synth.renderSequence(events, 44100);
+    
+    // The release is still sounding at the end of the buffer, so all of it rendered
+    REQUIRE(first.getReadPointer(0)[44099] != 0.0f);
+    REQUIRE(synth.getRenderedSamples() == 44100);
+    
+    const bool identical = std::equal(first.getReadPointer(0), first.getReadPointer(0) + 44100, second.getReadPointer(0));
+    REQUIRE(identical);
+}
+
+TEST_CASE("HeadlessSynthBatch lanes match individual renders")
+{
+    juce::Random random(99);
+    
+    std::vector<std::vector<float>> genomes;
+    for (int g = 0; g < 6; ++g)
+    {
+        std::vector<float> genome(HeadlessParam::COUNT);
+        for (float& value : genome)
+            value = random.nextFloat();
+        genomes.push_back(genome);
+    }
+    genomes[1][HeadlessParam::envRelease] = 0.0f;  // One lane falls silent early
+    
+    const int totalSamples = 44100;
+    std::vector<MidiEvent> events = {
+        { 0, 0x90, 60, 110 },
+        { 11000, 0x80, 60, 0 },
+        { 11025, 0x90, 64, 80 },
+        { 22050, 0x90, 67, 50 },
+        { 30000, 0x80, 64, 0 },
+        { 33000, 0x80, 67, 0 }
+    };
+    
+    HeadlessSynthBatch batch(44100.0, 512);
+    juce::AudioBuffer<float> output(HeadlessSynthBatch::MAX_WIDTH, totalSamples);
+    
+    const int width = static_cast<int>(genomes.size());
+    for (int l = 0; l < width; ++l)
+        batch.setParameters(l, genomes[static_cast<size_t>(l)].data());
+    
+    batch.renderSequence(events, output, width);
+    
+    HeadlessSynth single(44100.0, 512);
+    for (int l = 0; l < width; ++l)
+    {
+        single.setParameters(genomes[static_cast<size_t>(l)]);
+        auto expected = single.renderSequence(events, totalSamples);
+        
+        for (int i = 0; i < totalSamples; ++i)
+            REQUIRE(output.getReadPointer(l)[i] == expected.getReadPointer(0)[i]);
+    }
+}
+
+TEST_CASE("Synth tracks voices through stealing, decay and retrigger")
+{
+    Synth synth;
+    configurePatch(synth, 44100.0);
+    synth.envRelease = 0.75f;  // Fast release so voices die within a block
+    
+    std::vector<float> out(512);
+    float* outPtr = out.data();
+    
+    // More notes than voices: the quietest voices get stolen
+    for (int note = 40; note < 40 + Synth::MAX_VOICES + 2; ++note)
+        synth.midiMessage(0x90, static_cast<uint8_t>(note), 100);
+    synth.render<1>(&outPtr, 512);
+    REQUIRE_FALSE(synth.isSilent());
+    
+    for (int note = 40; note < 40 + Synth::MAX_VOICES + 2; ++note)
+        synth.midiMessage(0x80, static_cast<uint8_t>(note), 0);
+    for (int block = 0; block < 4; ++block)
+        synth.render<1>(&outPtr, 512);
+    REQUIRE(synth.isSilent());
+    
+    // A new note after every voice died must sound again
+    synth.midiMessage(0x90, 64, 100);
+    synth.render<1>(&outPtr, 512);
+    REQUIRE_FALSE(synth.isSilent());
+    
+    bool sounded = false;
+    for (float x : out)
+        sounded = sounded || x != 0.0f;
+    REQUIRE(sounded);
+}
+
+TEST_CASE("NoiseGenerator block fill continues the per-sample sequence bit for bit")
+{
+    NoiseGenerator block, reference;
+    block.reset();
+    reference.reset();
+    
+    // Short and odd lengths exercise the scalar tail and the state left between blocks
+    for (int count : { 32, 1, 3, 4, 7, 17, 32, 5, 64 })
+    {
+        std::vector<float> filled(static_cast<size_t>(count));
+        block.fill(filled.data(), count, 0.37f);
+        
+        for (int i = 0; i < count; ++i)
+            REQUIRE(filled[static_cast<size_t>(i)] == reference.nextValue() * 0.37f);
+    }
+    
+    REQUIRE(block.nextValue() == reference.nextValue());
+}
+
+TEST_CASE("HeadlessSynth output guard modes agree on clean renders")
+{
+    std::vector<MidiEvent> events = {
+        { 0, 0x90, 60, 100 },
+        { 22050, 0x80, 60, 0 }
+    };
+    
+    auto genome = makeGenome(0.3f);
+    genome[HeadlessParam::noise] = 0.0f;
+    
+    HeadlessSynth perBlock(44100.0, 512);
+    perBlock.setParameters(genome);
+    auto reference = perBlock.renderSequence(events, 44100);
+    
+    for (auto guard : { HeadlessSynth::OutputGuard::deferred, HeadlessSynth::OutputGuard::off })
+    {
+        HeadlessSynth synth(44100.0, 512);
+        synth.setOutputGuard(guard);
+        synth.setParameters(genome);
+        auto buffer = synth.renderSequence(events, 44100);
+        
+        // Nothing near full scale, so no guard has anything to change
+        for (int i = 0; i < 44100; ++i)
+            REQUIRE(buffer.getSample(0, i) == reference.getSample(0, i));
+    }
+}
+
+TEST_CASE("HeadlessSynth streams a sequence bit for bit like renderSequence")
+{
+    std::vector<MidiEvent> events = {
+        { 0, 0x90, 60, 110 },
+        { 5000, 0x80, 60, 0 },
+        { 5000, 0x90, 64, 80 },
+        { 10337, 0x90, 67, 50 },
+        { 15000, 0x80, 64, 0 },
+        { 18000, 0x80, 67, 0 }
+    };
+    const int totalSamples = 30000;
+    
+    HeadlessSynth synth(44100.0, 512);
+    synth.setParameters(makeGenome(0.2f));
+    auto reference = synth.renderSequence(events, totalSamples);
+    
+    // Block sizes that do and don't line up with events or the synth's block size
+    for (int blockSize : { 1, 256, 333, 512, 4096 })
+    {
+        std::vector<float> scratch(static_cast<size_t>(blockSize));
+        std::vector<float> streamed;
+        
+        synth.streamSequence(events, totalSamples, scratch.data(), blockSize,
+                             [&streamed](const float* block, int numSamples)
+                             {
+                                 streamed.insert(streamed.end(), block, block + numSamples);
+                             });
+        
+        REQUIRE(streamed.size() == static_cast<size_t>(totalSamples));
+        for (int i = 0; i < totalSamples; ++i)
+            REQUIRE(streamed[static_cast<size_t>(i)] == reference.getSample(0, i));
+    }
+}
+
+TEST_CASE("HeadlessSynth parameter changes render like a freshly configured synth")
+{
+    std::vector<MidiEvent> events = {
+        { 0, 0x90, 60, 100 },
+        { 8000, 0x80, 60, 0 }
+    };
+    
+    juce::Random random(45);
+    HeadlessSynth reused(44100.0, 512);
+    
+    for (int trial = 0; trial < 8; ++trial)
+    {
+        // Change a few genes at a time, so most coefficients are left as they were
+        auto genome = makeGenome(0.3f);
+        for (int gene = 0; gene < 3; ++gene)
+            genome[static_cast<size_t>(random.nextInt(HeadlessParam::COUNT))] = random.nextFloat();
+        
+        reused.setParameters(genome);
+        auto incremental = reused.renderSequence(events, 12000);
+        
+        HeadlessSynth fresh(44100.0, 512);
+        fresh.setParameters(genome);
+        auto reference = fresh.renderSequence(events, 12000);
+        
+        for (int i = 0; i < 12000; ++i)
+            REQUIRE(incremental.getSample(0, i) == reference.getSample(0, i));
+    }
+}
+
+TEST_CASE("SynthParameters updates only what depends on dirty parameters")
+{
+    Synth synth;
+    synth.allocateResources(44100.0, 512);
+    
+    SynthParameters::Values values {};
+    values[SynthParameters::oscMix] = 40.0f;
+    values[SynthParameters::filterReso] = 30.0f;
+    values[SynthParameters::filterVelocity] = -100.0f;
+    values[SynthParameters::glideRate] = 35.0f;
+    values[SynthParameters::polyMode] = 0.0f;
+    SynthParameters::apply(synth, values, SynthParameters::allDirty, 44100.0f);
+    
+    REQUIRE(synth.numVoices == 1);
+    REQUIRE(synth.ignoreVelocity);
+    REQUIRE(synth.glideRate < 1.0f);
+    
+    const float filterQ = synth.filterQ;
+    const float volumeTrim = synth.volumeTrim;
+    const float envAttack = synth.envAttack;
+    
+    // Unmarked changes are ignored until their bit is set
+    values[SynthParameters::filterReso] = 80.0f;
+    values[SynthParameters::envAttack] = 60.0f;
+    SynthParameters::apply(synth, values, SynthParameters::bit(SynthParameters::filterReso), 44100.0f);
+    
+    REQUIRE(synth.filterQ != filterQ);
+    REQUIRE(synth.volumeTrim != volumeTrim);
+    REQUIRE(synth.envAttack == envAttack);
+    REQUIRE(SynthParameters::diff(values, values) == 0);
+    
+    // A full pass lands on the same coefficients
+    Synth reference;
+    reference.allocateResources(44100.0, 512);
+    SynthParameters::apply(synth, values, SynthParameters::bit(SynthParameters::envAttack), 44100.0f);
+    SynthParameters::apply(reference, values, SynthParameters::allDirty, 44100.0f);
+    
+    REQUIRE(synth.filterQ == reference.filterQ);
+    REQUIRE(synth.volumeTrim == reference.volumeTrim);
+    REQUIRE(synth.envAttack == reference.envAttack);
+    REQUIRE(synth.glideRate == reference.glideRate);
+}
+
+TEST_CASE("Precomputed timbre coefficients switch a synth like a full update")
+{
+    juce::Random random(52);
+    auto randomValues = [&random]()
+    {
+        SynthParameters::Values values {};
+        for (auto& value : values)
+            value = random.nextFloat() * 100.0f;
+        values[SynthParameters::lfoRate] = random.nextFloat();
+        values[SynthParameters::vibrato] = random.nextFloat() * 200.0f - 100.0f;
+        values[SynthParameters::polyMode] = 1.0f;
+        return values;
+    };
+    
+    const auto before = randomValues();
+    const auto after = randomValues();
+    
+    // Prepared away from any synth, then copied in; apply() is left the rest
+    SynthParameters::TimbreCoefficients coefficients;
+    SynthParameters::applyTimbre(coefficients, after, SynthParameters::timbreMask, 48000.0f);
+    
+    Synth switched;
+    switched.allocateResources(48000.0, 512);
+    SynthParameters::apply(switched, before, SynthParameters::allDirty, 48000.0f);
+    coefficients.copyTo(switched);
+    SynthParameters::apply(switched, after, SynthParameters::diff(after, before) & ~SynthParameters::timbreMask, 48000.0f);
+    
+    Synth reference;
+    reference.allocateResources(48000.0, 512);
+    SynthParameters::apply(reference, after, SynthParameters::allDirty, 48000.0f);
+    
+    REQUIRE(switched.envAttack == reference.envAttack);
+    REQUIRE(switched.envDecay == reference.envDecay);
+    REQUIRE(switched.envSustain == reference.envSustain);
+    REQUIRE(switched.envRelease == reference.envRelease);
+    REQUIRE(switched.noiseMix == reference.noiseMix);
+    REQUIRE(switched.oscMix == reference.oscMix);
+    REQUIRE(switched.volumeTrim == reference.volumeTrim);
+    REQUIRE(switched.detune == reference.detune);
+    REQUIRE(switched.filterLFODepth == reference.filterLFODepth);
+    REQUIRE(switched.filterQ == reference.filterQ);
+    REQUIRE(switched.filterKeyTracking == reference.filterKeyTracking);
+    REQUIRE(switched.filterEnvDepth == reference.filterEnvDepth);
+    REQUIRE(switched.filterAttack == reference.filterAttack);
+    REQUIRE(switched.filterDecay == reference.filterDecay);
+    REQUIRE(switched.filterSustain == reference.filterSustain);
+    REQUIRE(switched.filterRelease == reference.filterRelease);
+    REQUIRE(switched.lfoInc == reference.lfoInc);
+    REQUIRE(switched.vibrato == reference.vibrato);
+    REQUIRE(switched.pwmDepth == reference.pwmDepth);
+    REQUIRE(switched.glideRate == reference.glideRate);
+}
@@ -46,6 +46,7 @@ TEST_CASE("MLP training changes population fitness distribution", "[integration]
     auto testDir = getTestDir();
     auto names = getParamNames();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
 
     // Target genome we'll train the MLP to "like"
     std::vector<float> targetGenome(17, 0.8f);
@@ -113,6 +114,7 @@ TEST_CASE("GA evolves toward MLP-preferred region", "[integration]")
     auto testDir = getTestDir();
     auto names = getParamNames();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
 
     // Pre-train MLP to strongly prefer high values
     std::vector<float> preferred(17, 0.9f);
@@ -178,6 +180,7 @@ TEST_CASE("GA exploration produces diverse presets", "[integration]")
     auto testDir = getTestDir();
     auto names = getParamNames();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
 
     // Pre-train MLP to strongly prefer one corner of parameter space
     std::vector<float> preferred(17, 0.9f);
@@ -247,6 +250,7 @@ TEST_CASE("Novelty bonus increases population diversity", "[integration]")
     auto testDir = getTestDir();
     auto names = getParamNames();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
 
     std::vector<float> preferred(17, 0.9f);
     std::vector<float> notPreferred(17, 0.1f);
@@ -310,6 +314,7 @@ TEST_CASE("Adaptive exploration config applies correctly", "[integration]")
     auto testDir = getTestDir();
     auto names = getParamNames();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
 
     GeneticAlgorithm ga(model);
     GAConfig config;
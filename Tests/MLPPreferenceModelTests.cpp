@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "GA/MLPPreferenceModel.h"
+#include <atomic>
+#include <filesystem>
+#include <thread>
 
 namespace
 {
@@ -24,6 +27,7 @@ TEST_CASE("MLPPreferenceModel evaluate returns value in valid range")
                                         "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
     auto testDir = getTestDir();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
     
     std::vector<float> genome(17, 0.5f);
     
@@ -39,10 +43,13 @@ TEST_CASE("MLPPreferenceModel sendFeedback updates predictions")
                                         "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
     auto testDir = getTestDir();
     MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
     
     std::vector<float> genome(17, 0.5f);
     
     float before = model.evaluate(genome);
+    const auto versionBefore = model.getModelVersion();
+    REQUIRE(versionBefore > 0);
     
     // Send multiple "like" feedbacks
     IFitnessModel::Feedback feedback{1.0f, 5.0f};
@@ -52,12 +59,15 @@ TEST_CASE("MLPPreferenceModel sendFeedback updates predictions")
     }
     
     // Wait for async training to complete
-    waitForTraining();
+    REQUIRE(model.waitUntilTrained(30000));
     
     float after = model.evaluate(genome);
     
     // Prediction should increase toward 1.0 after training toward "like"
     REQUIRE(after > before);
+    
+    // Published weights tell the GA to re-score
+    REQUIRE(model.getModelVersion() > versionBefore);
 }
 
 TEST_CASE("MLPPreferenceModel handles dislike feedback")
@@ -72,6 +82,8 @@ TEST_CASE("MLPPreferenceModel handles dislike feedback")
     
     MLPPreferenceModel model(names, testDir);
     
+    REQUIRE(model.waitUntilReady());
+    
     std::vector<float> genome(17, 0.5f);
     
     // Get initial prediction (should be ~0.5 for fresh MLP)
@@ -92,3 +104,283 @@ TEST_CASE("MLPPreferenceModel handles dislike feedback")
     
     testDir.deleteRecursively();
 }
+
+TEST_CASE("MLPPreferenceModel evaluateBatch matches evaluate")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = getTestDir();
+    MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
+    
+    const int numGenomes = 4;
+    std::vector<float> genomes(numGenomes * 17);
+    for (size_t i = 0; i < genomes.size(); ++i)
+        genomes[i] = static_cast<float>((i * 13) % 17) / 16.0f;
+    
+    for (auto mode : { MLPPreferenceModel::InputMode::Genome, MLPPreferenceModel::InputMode::Audio })
+    {
+        model.setInputMode(mode);
+        
+        std::vector<float> batchFitness(numGenomes);
+        model.evaluateBatch(genomes.data(), numGenomes, 17, batchFitness.data());
+        
+        for (int i = 0; i < numGenomes; ++i)
+        {
+            std::vector<float> genome(genomes.begin() + i * 17, genomes.begin() + (i + 1) * 17);
+            REQUIRE(batchFitness[i] == model.evaluate(genome));
+        }
+    }
+}
+
+TEST_CASE("MLPPreferenceModel offers the genome MLP as its surrogate")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = getTestDir();
+    MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
+    
+    const int numGenomes = 4;
+    std::vector<float> genomes(numGenomes * 17);
+    for (size_t i = 0; i < genomes.size(); ++i)
+        genomes[i] = static_cast<float>((i * 7) % 17) / 16.0f;
+    
+    // In genome mode it is the full score
+    std::vector<float> scores(numGenomes);
+    std::vector<float> genomeFitness(numGenomes);
+    REQUIRE(model.surrogateBatch(genomes.data(), numGenomes, 17, scores.data()));
+    model.evaluateBatch(genomes.data(), numGenomes, 17, genomeFitness.data());
+    REQUIRE(scores == genomeFitness);
+    
+    model.setInputMode(MLPPreferenceModel::InputMode::Audio);
+    REQUIRE(model.surrogateBatch(genomes.data(), numGenomes, 17, scores.data()));
+    REQUIRE(scores == genomeFitness);
+}
+
+TEST_CASE("MLPPreferenceModel evaluate runs concurrently with training")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = getTestDir();
+    MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
+    
+    std::vector<float> genome(17, 0.5f);
+    float before = model.evaluate(genome);
+    
+    std::atomic<bool> done{false};
+    std::atomic<bool> allValid{true};
+    
+    std::thread evaluator([&]
+    {
+        while (!done.load())
+        {
+            float score = model.evaluate(genome);
+            if (!(score >= 0.0f && score <= 1.0f))
+                allValid.store(false);
+        }
+    });
+    
+    IFitnessModel::Feedback feedback{1.0f, 5.0f};
+    for (int i = 0; i < 20; ++i)
+        model.sendFeedback(genome, feedback);
+    
+    waitForTraining();
+    done.store(true);
+    evaluator.join();
+    
+    REQUIRE(allValid.load());
+    REQUIRE(model.evaluate(genome) > before);
+}
+
+TEST_CASE("MLPPreferenceModel loads its checkpoint on the training thread")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("MLPPreferenceModelTests_reload_" + juce::Uuid().toString());
+    testDir.createDirectory();
+    
+    // Trained weights, as fresh ones score exactly 0.5 and prove nothing
+    std::vector<float> genome(17, 0.25f);
+    GenomeMLP trained;
+    for (int i = 0; i < 50; ++i)
+        trained.train(genome, 1.0f, 0.01f);
+    
+    const AudioMLP audio;
+    const GenomeEnsemble genomeEnsemble;
+    const AudioEnsemble audioEnsemble;
+    REQUIRE(ModelCheckpoint::write(testDir.getChildFile("mlp_checkpoint.bin"), {
+        { MLPPreferenceModel::genomeMLPSection, trained.getWeights() },
+        { MLPPreferenceModel::audioMLPSection, audio.getWeights() },
+        { MLPPreferenceModel::genomeEnsembleSection, genomeEnsemble.getWeights() },
+        { MLPPreferenceModel::audioEnsembleSection, audioEnsemble.getWeights() },
+        { MLPPreferenceModel::audioFeatureTagSection, MLPPreferenceModel::getAudioFeatureTag() }
+    }));
+    
+    float expected;
+    QuantizedGenomeMLP(trained).predictBatch(genome.data(), 1, &expected);
+    REQUIRE(expected > 0.6f);
+    
+    MLPPreferenceModel model(names, testDir);
+    
+    // Neutral until the weights are back, then exactly what was saved
+    float score = model.evaluate(genome);
+    REQUIRE((score == 0.5f || score == expected));
+    
+    REQUIRE(model.waitUntilReady());
+    REQUIRE_FALSE(model.isRetraining());
+    REQUIRE(model.evaluate(genome) == expected);
+    
+    testDir.deleteRecursively();
+}
+
+TEST_CASE("MLPPreferenceModel retrains from the feedback log without a checkpoint")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("MLPPreferenceModelTests_retrain_" + juce::Uuid().toString());
+    testDir.createDirectory();
+    
+    std::vector<float> liked(17, 0.8f);
+    std::vector<float> disliked(17, 0.2f);
+    
+    // History only: a log of ratings and no weights at all
+    {
+        FeedbackLog log(testDir.getChildFile("feedback_log.bin"), names);
+        for (int i = 0; i < 200; ++i)
+        {
+            FeedbackLog::Record record;
+            record.sampleIndex = static_cast<uint64_t>(i);
+            record.rating = (i % 2 == 0) ? 1.0f : 0.0f;
+            log.append((i % 2 == 0) ? liked.data() : disliked.data(), record);
+        }
+    }
+    
+    MLPPreferenceModel model(names, testDir);
+    REQUIRE(model.waitUntilReady());
+    
+    for (int waited = 0; model.isRetraining() && waited < 30000; waited += 50)
+        juce::Thread::sleep(50);
+    
+    REQUIRE_FALSE(model.isRetraining());
+    REQUIRE(model.getRetrainProgress() == 1.0f);
+    REQUIRE(model.evaluate(liked) > model.evaluate(disliked));
+    
+    testDir.deleteRecursively();
+}
+
+TEST_CASE("MLPPreferenceModel imports a dataset that predates the feedback log")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("MLPPreferenceModelTests_legacy_" + juce::Uuid().toString());
+    testDir.createDirectory();
+    
+    // The CSV dataset written before the log existed
+    {
+        juce::FileOutputStream csv(testDir.getChildFile("feedback_dataset.csv"));
+        csv << FeedbackLog::getCSVHeader(names) << "\n";
+        for (int i = 0; i < 200; ++i)
+        {
+            juce::String line;
+            for (int p = 0; p < 17; ++p)
+                line += juce::String((i % 2 == 0) ? 0.8f : 0.2f, 6) + ",";
+            line += juce::String((i % 2 == 0) ? "1.0" : "0.0") + ",2.00," + juce::String(i)
+                  + ",0.500000,0.500000,baseline,2026-01-20T12:00:00.000Z,1.00";
+            csv << line << "\n";
+        }
+    }
+    
+    std::vector<float> liked(17, 0.8f);
+    std::vector<float> disliked(17, 0.2f);
+    
+    for (int session = 0; session < 2; ++session)
+    {
+        MLPPreferenceModel model(names, testDir);
+        REQUIRE(model.waitUntilReady());
+        
+        for (int waited = 0; (model.isRetraining() || model.isRestoringMetrics()) && waited < 30000; waited += 50)
+            juce::Thread::sleep(50);
+        
+        // Imported once: the second session finds the log, not the dataset
+        REQUIRE(model.getOnlineMetrics().ratings == 200);
+        REQUIRE(model.evaluate(liked) > model.evaluate(disliked));
+        REQUIRE_FALSE(testDir.getChildFile("feedback_dataset.csv").exists());
+        
+        int backups = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(testDir.getFullPathName().toStdString()))
+            backups += entry.path().filename().string().rfind("feedback_dataset_backup_", 0) == 0 ? 1 : 0;
+        REQUIRE(backups == 1);
+    }
+    
+    testDir.deleteRecursively();
+}
+
+TEST_CASE("MLPPreferenceModel retrains audio weights saved for other audio features")
+{
+    std::vector<juce::String> names = {"p0", "p1", "p2", "p3", "p4", "p5", "p6", "p7",
+                                        "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15", "p16"};
+    auto testDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("MLPPreferenceModelTests_featureTag_" + juce::Uuid().toString());
+    testDir.createDirectory();
+    
+    std::vector<float> liked(17, 0.8f);
+    std::vector<float> disliked(17, 0.2f);
+    
+    {
+        FeedbackLog log(testDir.getChildFile("feedback_log.bin"), names);
+        for (int i = 0; i < 40; ++i)
+        {
+            FeedbackLog::Record record;
+            record.sampleIndex = static_cast<uint64_t>(i);
+            record.rating = (i % 2 == 0) ? 1.0f : 0.0f;
+            log.append((i % 2 == 0) ? liked.data() : disliked.data(), record);
+        }
+    }
+    
+    // A complete checkpoint whose audio models saw full-fidelity features
+    auto staleTag = MLPPreferenceModel::getAudioFeatureTag();
+    staleTag[2] = 0.0f;  // Host-rate render
+    
+    const GenomeMLP genomeMLP;
+    const AudioMLP audioMLP;
+    const GenomeEnsemble genomeEnsemble;
+    const AudioEnsemble audioEnsemble;
+    REQUIRE(ModelCheckpoint::write(testDir.getChildFile("mlp_checkpoint.bin"), {
+        { MLPPreferenceModel::genomeMLPSection, genomeMLP.getWeights() },
+        { MLPPreferenceModel::audioMLPSection, audioMLP.getWeights() },
+        { MLPPreferenceModel::genomeEnsembleSection, genomeEnsemble.getWeights() },
+        { MLPPreferenceModel::audioEnsembleSection, audioEnsemble.getWeights() },
+        { MLPPreferenceModel::audioFeatureTagSection, staleTag }
+    }));
+    
+    {
+        MLPPreferenceModel model(names, testDir);
+        REQUIRE(model.waitUntilReady());
+        
+        for (int waited = 0; model.isRetraining() && waited < 30000; waited += 50)
+            juce::Thread::sleep(50);
+        
+        REQUIRE_FALSE(model.isRetraining());
+        REQUIRE(model.getRetrainProgress() == 1.0f);
+    }
+    
+    // The retrained checkpoint is tagged with the current features
+    ModelCheckpoint::Sections sections;
+    REQUIRE(ModelCheckpoint::read(testDir.getChildFile("mlp_checkpoint.bin"), sections));
+    const auto* tag = ModelCheckpoint::find(sections, MLPPreferenceModel::audioFeatureTagSection);
+    REQUIRE(tag != nullptr);
+    REQUIRE(*tag == MLPPreferenceModel::getAudioFeatureTag());
+    
+    // Only the audio models were retrained; the genome ones kept their weights
+    REQUIRE(*ModelCheckpoint::find(sections, MLPPreferenceModel::genomeMLPSection) == genomeMLP.getWeights());
+    REQUIRE(*ModelCheckpoint::find(sections, MLPPreferenceModel::genomeEnsembleSection) == genomeEnsemble.getWeights());
+    REQUIRE(*ModelCheckpoint::find(sections, MLPPreferenceModel::audioMLPSection) != audioMLP.getWeights());
+    REQUIRE(*ModelCheckpoint::find(sections, MLPPreferenceModel::audioEnsembleSection) != audioEnsemble.getWeights());
+    
+    testDir.deleteRecursively();
+}
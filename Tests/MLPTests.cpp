@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "GA/MLP.h"
+#include "GA/FixedMLP.h"
+#include "GA/QuantizedMLP.h"
+#include "GA/EnsembleMLP.h"
+#include "GA/WorkerPool.h"
 
 static constexpr int GENOME_INPUT_SIZE = 17;
 
@@ -169,3 +173,210 @@ TEST_CASE("Audio MLP learns with realistic feature distribution")
     REQUIRE(afterDislike < afterLike);
 }
 
+
+TEST_CASE("MLP predictBatch matches per-sample predict")
+{
+    MLP mlp;
+    std::vector<float> input(GENOME_INPUT_SIZE, 0.4f);
+    
+    for (int i = 0; i < 10; ++i)
+        mlp.train(input, 1.0f, 0.1f);
+    
+    const int numSamples = 50;
+    std::vector<float> batch(numSamples * GENOME_INPUT_SIZE);
+    for (size_t i = 0; i < batch.size(); ++i)
+        batch[i] = static_cast<float>((i * 37) % 101) / 100.0f;
+    
+    std::vector<float> outputs(numSamples);
+    mlp.predictBatch(batch.data(), numSamples, outputs.data());
+    
+    for (int n = 0; n < numSamples; ++n)
+    {
+        std::vector<float> row(batch.begin() + n * GENOME_INPUT_SIZE,
+                               batch.begin() + (n + 1) * GENOME_INPUT_SIZE);
+        REQUIRE(outputs[n] == mlp.predict(row));
+    }
+}
+
+TEST_CASE("MLP predict is safe to call concurrently")
+{
+    MLP mlp;
+    std::vector<float> liked(GENOME_INPUT_SIZE, 0.7f);
+    for (int i = 0; i < 10; ++i)
+        mlp.train(liked, 1.0f, 0.1f);
+    
+    const MLP& model = mlp;
+    const int numInputs = 64;
+    std::vector<std::vector<float>> inputs(numInputs, std::vector<float>(GENOME_INPUT_SIZE));
+    for (int n = 0; n < numInputs; ++n)
+        for (int i = 0; i < GENOME_INPUT_SIZE; ++i)
+            inputs[n][i] = static_cast<float>((n * 31 + i * 7) % 97) / 96.0f;
+    
+    std::vector<float> parallel(numInputs);
+    WorkerPool pool(4);
+    pool.parallelFor(numInputs, [&](int n, int) { parallel[n] = model.predict(inputs[n]); });
+    
+    for (int n = 0; n < numInputs; ++n)
+        REQUIRE(parallel[n] == model.predict(inputs[n]));
+}
+
+TEST_CASE("MLP trainBatch takes one step on the mean gradient")
+{
+    MLP single;
+    MLP batched;
+    batched.setWeights(single.getWeights());
+    
+    std::vector<float> input(GENOME_INPUT_SIZE, 0.3f);
+    input[2] = 0.9f;
+    
+    // A batch of two identical samples has the same mean gradient as one
+    std::vector<float> batch(input);
+    batch.insert(batch.end(), input.begin(), input.end());
+    const float targets[] = { 1.0f, 1.0f };
+    const float weights[] = { 0.7f, 0.7f };
+    
+    for (int step = 0; step < 5; ++step)
+    {
+        single.train(input, 1.0f, 0.1f, 0.7f);
+        batched.trainBatch(batch.data(), 2, targets, weights, 0.1f);
+    }
+    
+    REQUIRE(batched.getWeights() == single.getWeights());
+}
+
+TEST_CASE("MLP trainBatch separates liked and disliked samples")
+{
+    MLP mlp;
+    std::vector<float> liked(GENOME_INPUT_SIZE, 0.8f);
+    std::vector<float> disliked(GENOME_INPUT_SIZE, 0.2f);
+    
+    std::vector<float> batch(liked);
+    batch.insert(batch.end(), disliked.begin(), disliked.end());
+    const float targets[] = { 1.0f, 0.0f };
+    const float weights[] = { 1.0f, 1.0f };
+    
+    for (int step = 0; step < 50; ++step)
+        mlp.trainBatch(batch.data(), 2, targets, weights, 0.05f);
+    
+    REQUIRE(mlp.predict(liked) > 0.5f);
+    REQUIRE(mlp.predict(disliked) < 0.5f);
+}
+
+TEST_CASE("FixedMLP loads MLP weights and matches its predictions and training")
+{
+    MLP runtime(GENOME_INPUT_SIZE, 32);
+    GenomeMLP fixed;
+    
+    REQUIRE(GenomeMLP::getWeightCount() == runtime.getWeightCount());
+    REQUIRE(fixed.setWeights(runtime.getWeights()));
+    REQUIRE_FALSE(fixed.setWeights(std::vector<float>(10)));
+    
+    const int numSamples = 6;
+    std::vector<float> batch(numSamples * GENOME_INPUT_SIZE);
+    for (size_t i = 0; i < batch.size(); ++i)
+        batch[i] = static_cast<float>((i * 29) % 53) / 52.0f;
+    const float targets[] = { 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.5f };
+    const float weights[] = { 1.0f, 0.5f, 2.0f, 1.0f, 1.0f, 0.8f };
+    
+    for (int step = 0; step < 20; ++step)
+    {
+        runtime.trainBatch(batch.data(), numSamples, targets, weights, 0.05f);
+        fixed.trainBatch(batch.data(), numSamples, targets, weights, 0.05f);
+    }
+    
+    std::vector<float> runtimeOut(numSamples), fixedOut(numSamples);
+    runtime.predictBatch(batch.data(), numSamples, runtimeOut.data());
+    fixed.predictBatch(batch.data(), numSamples, fixedOut.data());
+    
+    for (int n = 0; n < numSamples; ++n)
+    {
+        std::vector<float> row(batch.begin() + n * GENOME_INPUT_SIZE, batch.begin() + (n + 1) * GENOME_INPUT_SIZE);
+        REQUIRE(fixedOut[n] == fixed.predict(row));
+        REQUIRE_THAT(fixedOut[n], Catch::Matchers::WithinAbs(runtimeOut[n], 1e-5f));
+    }
+    
+    // Weights saved by either load into the other
+    REQUIRE(runtime.setWeights(fixed.getWeights()));
+    REQUIRE(runtime.getWeights() == fixed.getWeights());
+}
+
+TEST_CASE("QuantizedMLP predictions stay within tolerance of float")
+{
+    AudioMLP model;
+    
+    // Enough training that the output layer is far from its neutral start
+    const int numSamples = 32;
+    std::vector<float> batch(numSamples * AudioMLP::getInputSize());
+    for (size_t i = 0; i < batch.size(); ++i)
+        batch[i] = static_cast<float>((i * 41) % 89) / 88.0f;
+    std::vector<float> targets(numSamples), weights(numSamples, 1.0f);
+    for (int n = 0; n < numSamples; ++n)
+        targets[n] = batch[static_cast<size_t>(n) * AudioMLP::getInputSize()] > 0.5f ? 1.0f : 0.0f;
+    
+    for (int step = 0; step < 200; ++step)
+        model.trainBatch(batch.data(), numSamples, targets.data(), weights.data(), 0.01f);
+    
+    QuantizedAudioMLP quantized(model);
+    
+    std::vector<float> exact(numSamples), approx(numSamples);
+    model.predictBatch(batch.data(), numSamples, exact.data());
+    quantized.predictBatch(batch.data(), numSamples, approx.data());
+    
+    float spread = 0.0f;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        std::vector<float> row(batch.begin() + n * AudioMLP::getInputSize(), batch.begin() + (n + 1) * AudioMLP::getInputSize());
+        REQUIRE(approx[n] == quantized.predict(row));
+        REQUIRE_THAT(approx[n], Catch::Matchers::WithinAbs(exact[n], 0.01f));
+        spread = std::max(spread, std::abs(exact[n] - 0.5f));
+    }
+    REQUIRE(spread > 0.1f);
+}
+
+TEST_CASE("EnsembleMLP starts neutral and its heads diverge under bootstrap training")
+{
+    GenomeEnsemble ensemble;
+    
+    const int numSamples = 16;
+    std::vector<float> batch(numSamples * GENOME_INPUT_SIZE);
+    for (size_t i = 0; i < batch.size(); ++i)
+        batch[i] = static_cast<float>((i * 23) % 61) / 60.0f;
+    std::vector<float> targets(numSamples), weights(numSamples, 1.0f);
+    for (int n = 0; n < numSamples; ++n)
+        targets[n] = static_cast<float>(n % 2);
+    
+    std::vector<float> mean(numSamples), variance(numSamples);
+    ensemble.predictBatch(batch.data(), numSamples, mean.data(), variance.data());
+    for (int n = 0; n < numSamples; ++n)
+    {
+        REQUIRE_THAT(mean[n], Catch::Matchers::WithinAbs(0.5f, 1e-6f));
+        REQUIRE(variance[n] == 0.0f);
+    }
+    
+    for (int step = 0; step < 50; ++step)
+        ensemble.trainBatch(batch.data(), numSamples, targets.data(), weights.data(), 0.01f);
+    
+    ensemble.predictBatch(batch.data(), numSamples, mean.data(), variance.data());
+    float totalVariance = 0.0f;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        REQUIRE(mean[n] >= 0.0f);
+        REQUIRE(mean[n] <= 1.0f);
+        REQUIRE(variance[n] >= 0.0f);
+        REQUIRE(variance[n] <= 0.25f);
+        totalVariance += variance[n];
+    }
+    REQUIRE(totalVariance > 0.0f);
+    
+    // One row through the batch path scores the same as alone
+    float single = 0.0f, singleVariance = 0.0f;
+    ensemble.predictBatch(batch.data() + 3 * GENOME_INPUT_SIZE, 1, &single, &singleVariance);
+    REQUIRE(single == mean[3]);
+    REQUIRE(singleVariance == variance[3]);
+    
+    // Round-trips through its weights
+    GenomeEnsemble restored;
+    REQUIRE(restored.setWeights(ensemble.getWeights()));
+    REQUIRE(restored.getWeights() == ensemble.getWeights());
+    REQUIRE_FALSE(restored.setWeights(std::vector<float>(5)));
+}
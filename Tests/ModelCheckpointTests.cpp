@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/ModelCheckpoint.h"
+
+namespace
+{
+    juce::File getCheckpointFile(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("ModelCheckpointTests");
+        dir.createDirectory();
+        auto file = dir.getChildFile(name);
+        file.deleteFile();
+        ModelCheckpoint::getTemporaryFile(file).deleteFile();
+        return file;
+    }
+
+    ModelCheckpoint::Sections makeSections(float offset)
+    {
+        return {
+            { 1, { offset, offset + 1.0f, offset + 2.0f } },
+            { 3, { -offset } },
+            { 7, {} }
+        };
+    }
+
+    void requireSectionsEqual(const ModelCheckpoint::Sections& a, const ModelCheckpoint::Sections& b)
+    {
+        REQUIRE(a.size() == b.size());
+        for (size_t s = 0; s < a.size(); ++s)
+        {
+            REQUIRE(a[s].id == b[s].id);
+            REQUIRE(a[s].values == b[s].values);
+        }
+    }
+}
+
+TEST_CASE("ModelCheckpoint sections round-trip through the file")
+{
+    auto file = getCheckpointFile("roundtrip.bin");
+    const auto written = makeSections(0.5f);
+
+    REQUIRE(ModelCheckpoint::write(file, written));
+    REQUIRE(file.existsAsFile());
+    REQUIRE_FALSE(ModelCheckpoint::getTemporaryFile(file).exists());
+
+    ModelCheckpoint::Sections loaded;
+    REQUIRE(ModelCheckpoint::read(file, loaded));
+    requireSectionsEqual(written, loaded);
+
+    REQUIRE(ModelCheckpoint::find(loaded, 3) != nullptr);
+    REQUIRE(ModelCheckpoint::find(loaded, 3)->front() == -0.5f);
+    REQUIRE(ModelCheckpoint::find(loaded, 2) == nullptr);
+
+    // Rewriting replaces the previous checkpoint
+    REQUIRE(ModelCheckpoint::write(file, makeSections(4.0f)));
+    REQUIRE(ModelCheckpoint::read(file, loaded));
+    requireSectionsEqual(makeSections(4.0f), loaded);
+}
+
+TEST_CASE("ModelCheckpoint rejects damaged files")
+{
+    auto file = getCheckpointFile("damaged.bin");
+    REQUIRE(ModelCheckpoint::write(file, makeSections(1.0f)));
+
+    juce::MemoryBlock bytes;
+    REQUIRE(file.loadFileAsData(bytes));
+    ModelCheckpoint::Sections loaded;
+
+    SECTION("flipped payload byte")
+    {
+        static_cast<char*>(bytes.getData())[bytes.getSize() - 1] ^= 0x40;
+        REQUIRE(file.replaceWithData(bytes.getData(), bytes.getSize()));
+        REQUIRE_FALSE(ModelCheckpoint::read(file, loaded));
+    }
+
+    SECTION("truncated")
+    {
+        REQUIRE(file.replaceWithData(bytes.getData(), bytes.getSize() - 4));
+        REQUIRE_FALSE(ModelCheckpoint::read(file, loaded));
+    }
+
+    SECTION("missing")
+    {
+        file.deleteFile();
+        REQUIRE_FALSE(ModelCheckpoint::read(file, loaded));
+    }
+}
+
+TEST_CASE("ModelCheckpoint recovers a checkpoint left before its rename")
+{
+    auto file = getCheckpointFile("recover.bin");
+    REQUIRE(ModelCheckpoint::write(file, makeSections(2.0f)));
+
+    // As if a crash hit after the temporary was written but before the rename
+    REQUIRE(file.moveFileTo(ModelCheckpoint::getTemporaryFile(file)));
+    REQUIRE_FALSE(file.exists());
+
+    ModelCheckpoint::Sections loaded;
+    REQUIRE(ModelCheckpoint::read(file, loaded));
+    requireSectionsEqual(makeSections(2.0f), loaded);
+}
+
+TEST_CASE("CheckpointWriter writes the latest submission")
+{
+    auto file = getCheckpointFile("writer.bin");
+
+    {
+        CheckpointWriter writer(file);
+
+        for (int i = 0; i < 20; ++i)
+            writer.submit(makeSections(static_cast<float>(i)));
+
+        REQUIRE(writer.waitUntilWritten(5000));
+        REQUIRE(writer.getWriteCount() >= 1);
+        REQUIRE(writer.getWriteCount() <= 20);
+
+        ModelCheckpoint::Sections loaded;
+        REQUIRE(ModelCheckpoint::read(file, loaded));
+        requireSectionsEqual(makeSections(19.0f), loaded);
+
+        // Destroying the writer still writes anything pending
+        writer.submit(makeSections(100.0f));
+    }
+
+    ModelCheckpoint::Sections loaded;
+    REQUIRE(ModelCheckpoint::read(file, loaded));
+    requireSectionsEqual(makeSections(100.0f), loaded);
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "GA/NoveltyIndex.h"
+#include "GA/Population.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Reference implementation: full scan and sort
+    float bruteForceNovelty(const Population& pop, const float* genome, int selfIndex, int k)
+    {
+        std::vector<float> distances;
+        for (int i = 0; i < pop.size(); ++i)
+        {
+            if (i == selfIndex)
+                continue;
+            
+            float sumSq = 0.0f;
+            for (int j = 0; j < pop.getParameterCount(); ++j)
+            {
+                float diff = genome[j] - pop.getGenome(i)[j];
+                sumSq += diff * diff;
+            }
+            distances.push_back(std::sqrt(sumSq));
+        }
+        
+        std::sort(distances.begin(), distances.end());
+        k = std::min(k, static_cast<int>(distances.size()));
+        
+        float sum = 0.0f;
+        for (int i = 0; i < k; ++i)
+            sum += distances[i];
+        
+        return std::min(sum / k / std::sqrt(static_cast<float>(pop.getParameterCount())), 1.0f);
+    }
+}
+
+TEST_CASE("NoveltyIndex member novelty matches full scan")
+{
+    Population pop(30, 17);
+    pop.initializeRandom();
+    
+    NoveltyIndex index(17);
+    index.rebuild(pop);
+    
+    for (int i = 0; i < pop.size(); ++i)
+    {
+        REQUIRE_THAT(index.memberNovelty(pop, i, 5),
+                     Catch::Matchers::WithinAbs(bruteForceNovelty(pop, pop.getGenome(i), i, 5), 1e-5));
+    }
+}
+
+TEST_CASE("NoveltyIndex incremental update matches rebuild")
+{
+    Population pop(20, 17);
+    pop.initializeRandom();
+    
+    NoveltyIndex index(17);
+    index.rebuild(pop);
+    
+    std::vector<float> genome(17, 0.9f);
+    pop.setGenome(7, genome.data());
+    index.update(pop, 7);
+    
+    NoveltyIndex rebuilt(17);
+    rebuilt.rebuild(pop);
+    
+    for (int i = 0; i < pop.size(); ++i)
+        REQUIRE_THAT(index.memberNovelty(pop, i, 3),
+                     Catch::Matchers::WithinAbs(rebuilt.memberNovelty(pop, i, 3), 1e-6));
+}
+
+TEST_CASE("NoveltyIndex candidate novelty and elite archive")
+{
+    Population pop(10, 17);
+    pop.initializeRandom();
+    
+    NoveltyIndex index(17, 4);
+    index.rebuild(pop);
+    
+    std::vector<float> candidate(17, 0.5f);
+    float withoutArchive = index.candidateNovelty(pop, candidate.data(), 3);
+    REQUIRE_THAT(withoutArchive,
+                 Catch::Matchers::WithinAbs(bruteForceNovelty(pop, candidate.data(), -1, 3), 1e-5));
+    
+    // An identical archived elite makes the candidate less novel
+    index.addToArchive(candidate.data());
+    REQUIRE(index.getArchiveSize() == 1);
+    REQUIRE(index.candidateNovelty(pop, candidate.data(), 3) < withoutArchive);
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "GA/OnlineMetrics.h"
+#include "GA/MLPPreferenceModel.h"
+#include <cmath>
+#include <random>
+
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    struct Rated
+    {
+        float rating, genomePrediction, audioPrediction;
+    };
+
+    // compute_metrics.py's definitions, over the whole product of likes and dislikes
+    float bruteForceAgreement(const std::vector<Rated>& rated, bool audio)
+    {
+        uint64_t correct = 0, total = 0;
+        for (const auto& like : rated)
+        {
+            if (like.rating != 1.0f)
+                continue;
+
+            for (const auto& dislike : rated)
+            {
+                if (dislike.rating != 0.0f)
+                    continue;
+
+                ++total;
+                const float likePrediction = audio ? like.audioPrediction : like.genomePrediction;
+                const float dislikePrediction = audio ? dislike.audioPrediction : dislike.genomePrediction;
+                correct += likePrediction > dislikePrediction ? 1 : 0;
+            }
+        }
+        return total > 0 ? float(double(correct) / double(total)) : 0.0f;
+    }
+
+    float bruteForceRollingError(const std::vector<Rated>& rated)
+    {
+        const size_t first = rated.size() > OnlineMetrics::rollingWindow ? rated.size() - OnlineMetrics::rollingWindow : 0;
+        double sum = 0.0;
+        for (size_t i = first; i < rated.size(); ++i)
+            sum += std::abs(rated[i].genomePrediction - rated[i].rating);
+        return float(sum / double(rated.size() - first));
+    }
+
+    juce::File getTestDirectory()
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("OnlineMetricsTests_" + juce::Uuid().toString());
+        dir.createDirectory();
+        return dir;
+    }
+}
+
+TEST_CASE("OnlineMetrics matches the offline metrics at every step")
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    OnlineMetrics metrics;
+    std::vector<Rated> rated;
+
+    for (int i = 0; i < 400; ++i)
+    {
+        // Likes predicted somewhat higher; the odd neutral rating; coarse audio predictions make ties
+        const float rating = i % 17 == 5 ? 0.5f : (unit(rng) < 0.4f ? 1.0f : 0.0f);
+        const float genome = juce::jlimit(0.0f, 1.0f, 0.3f * rating + 0.7f * unit(rng));
+        const float audio = std::round(unit(rng) * 8.0f) / 8.0f;
+
+        metrics.add(rating, genome, audio, static_cast<uint64_t>(i + 1));
+        rated.push_back({ rating, genome, audio });
+
+        if (i % 37 != 0 && i != 399)
+            continue;
+
+        const auto stats = metrics.getStats();
+        REQUIRE(stats.ratings == rated.size());
+        // Genome predictions may share a bucket now and then; the audio ones sit on bucket edges
+        REQUIRE_THAT(stats.genome.getPairwiseAgreement(), WithinAbs(bruteForceAgreement(rated, false), 1e-3));
+        REQUIRE_THAT(stats.audio.getPairwiseAgreement(), WithinAbs(bruteForceAgreement(rated, true), 1e-5));
+        REQUIRE_THAT(stats.genome.rollingError, WithinAbs(bruteForceRollingError(rated), 1e-5));
+    }
+
+    const auto stats = metrics.getStats();
+    REQUIRE(stats.likes + stats.dislikes < stats.ratings);
+    REQUIRE(stats.genome.pairs == stats.likes * stats.dislikes);
+    REQUIRE(stats.genome.getPairwiseAgreement() > 0.6f);
+    REQUIRE(stats.firstLikeIndex > 0);
+}
+
+TEST_CASE("OnlineMetrics starts empty and resets")
+{
+    OnlineMetrics metrics;
+    REQUIRE(metrics.getStats().ratings == 0);
+    REQUIRE(metrics.getStats().getLikeRate() == 0.0f);
+    REQUIRE(metrics.getStats().firstLikeIndex == -1);
+
+    metrics.add(0.0f, 0.2f, 0.2f, 1);
+    metrics.add(1.0f, 0.9f, 0.1f, 2);
+    auto stats = metrics.getStats();
+    REQUIRE(stats.getLikeRate() == 0.5f);
+    REQUIRE(stats.firstLikeIndex == 2);
+    REQUIRE(stats.genome.getPairwiseAgreement() == 1.0f);
+    REQUIRE(stats.audio.getPairwiseAgreement() == 0.0f);
+    REQUIRE_THAT(stats.genome.meanError, WithinAbs(0.15, 1e-6));
+
+    metrics.reset();
+    stats = metrics.getStats();
+    REQUIRE(stats.ratings == 0);
+    REQUIRE(stats.genome.pairs == 0);
+    REQUIRE(stats.genome.rollingError == 0.0f);
+}
+
+TEST_CASE("MLPPreferenceModel keeps its metrics across sessions")
+{
+    std::vector<juce::String> names;
+    for (int i = 0; i < 17; ++i)
+        names.push_back("p" + juce::String(i));
+
+    const auto dir = getTestDirectory();
+    OnlineMetrics::Stats first;
+
+    {
+        MLPPreferenceModel model(names, dir);
+        REQUIRE(model.waitUntilReady());
+
+        for (int i = 0; i < 6; ++i)
+            model.sendFeedback(std::vector<float>(17, i % 2 == 0 ? 0.8f : 0.2f), { i % 2 == 0 ? 1.0f : 0.0f, 3.0f });
+
+        for (int wait = 0; wait < 100 && model.getOnlineMetrics().ratings < 6; ++wait)
+            juce::Thread::sleep(20);
+
+        first = model.getOnlineMetrics();
+        REQUIRE(first.ratings == 6);
+        REQUIRE(first.likes == 3);
+        REQUIRE(first.genome.pairs == 9);
+    }
+
+    // Rebuilt from the feedback log once the next session is ready
+    {
+        MLPPreferenceModel model(names, dir);
+        REQUIRE(model.waitUntilReady());
+
+        for (int wait = 0; wait < 100 && model.isRestoringMetrics(); ++wait)
+            juce::Thread::sleep(20);
+
+        REQUIRE_FALSE(model.isRestoringMetrics());
+        const auto restored = model.getOnlineMetrics();
+        REQUIRE(restored.ratings == first.ratings);
+        REQUIRE(restored.genome.agreeingPairs == first.genome.agreeingPairs);
+        REQUIRE(restored.audio.agreeingPairs == first.audio.agreeingPairs);
+        REQUIRE(restored.genome.rollingError == first.genome.rollingError);
+    }
+
+    dir.deleteRecursively();
+}
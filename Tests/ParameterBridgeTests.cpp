@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "GA/ParameterBridge.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <thread>
 
 TEST_CASE("ParameterBridge starts with no data")
 {
@@ -65,21 +68,87 @@ TEST_CASE("ParameterBridge pop returns false when empty")
     REQUIRE(result == false);
 }
 
-TEST_CASE("ParameterBridge second push overwrites first")
+TEST_CASE("ParameterBridge pops candidates in FIFO order")
 {
     ParameterBridge bridge;
     
     bridge.push({0.1f}, 0.5f);
     bridge.push({0.9f}, 0.95f);
+    REQUIRE(bridge.getNumAvailable() == 2);
     
     std::vector<float> output;
     float fitness;
+    
     bridge.pop(output, fitness);
+    REQUIRE(output[0] == 0.1f);
+    REQUIRE(fitness == 0.5f);
     
+    bridge.pop(output, fitness);
     REQUIRE(output[0] == 0.9f);
     REQUIRE(fitness == 0.95f);
 }
 
+TEST_CASE("ParameterBridge rejects pushes when full")
+{
+    ParameterBridge bridge(2, 4);
+    
+    REQUIRE(bridge.push({0.1f}, 0.1f) == true);
+    REQUIRE(bridge.push({0.2f}, 0.2f) == true);
+    REQUIRE(bridge.isFull());
+    REQUIRE(bridge.push({0.3f}, 0.3f) == false);
+    
+    std::vector<float> output;
+    float fitness;
+    bridge.pop(output, fitness);
+    REQUIRE(output[0] == 0.1f);
+    
+    REQUIRE(bridge.push({0.3f}, 0.3f) == true);
+    bridge.pop(output, fitness);
+    bridge.pop(output, fitness);
+    REQUIRE(output[0] == 0.3f);
+    REQUIRE(bridge.hasData() == false);
+}
+
+TEST_CASE("ParameterBridge delivers every candidate across threads in order")
+{
+    ParameterBridge bridge(3, 17);
+    constexpr int total = 2000;
+    
+    std::thread producer([&bridge]
+    {
+        std::vector<float> params(17);
+        for (int i = 0; i < total; ++i)
+        {
+            std::fill(params.begin(), params.end(), static_cast<float>(i));
+            while (!bridge.push(params, static_cast<float>(i)))
+                bridge.waitForSpace(10);
+        }
+    });
+    
+    std::vector<float> output;
+    float fitness;
+    int expected = 0;
+    bool inOrder = true;
+    
+    while (expected < total)
+    {
+        if (!bridge.pop(output, fitness))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        
+        inOrder = inOrder && output.size() == 17 && fitness == static_cast<float>(expected)
+                  && output.front() == fitness && output.back() == fitness;
+        ++expected;
+    }
+    
+    producer.join();
+    
+    REQUIRE(inOrder);
+    REQUIRE(bridge.hasData() == false);
+}
+
 TEST_CASE("ParameterBridge clear removes pending data")
 {
     ParameterBridge bridge;
@@ -90,3 +159,29 @@ TEST_CASE("ParameterBridge clear removes pending data")
     REQUIRE(bridge.hasData() == false);
 }
 
+
+TEST_CASE("ParameterBridge waitForSpace wakes when the consumer pops")
+{
+    ParameterBridge bridge(1, 4);
+    REQUIRE(bridge.waitForSpace(0) == true);
+    
+    bridge.push({0.5f}, 0.5f);
+    REQUIRE(bridge.waitForSpace(0) == false);
+    
+    std::thread consumer([&bridge]
+    {
+        juce::Thread::sleep(20);
+        std::vector<float> params;
+        float fitness;
+        bridge.pop(params, fitness);
+    });
+    
+    auto start = juce::Time::getMillisecondCounterHiRes();
+    bool empty = bridge.waitForSpace(5000);
+    auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+    
+    consumer.join();
+    
+    REQUIRE(empty == true);
+    REQUIRE(elapsed < 2000.0);
+}
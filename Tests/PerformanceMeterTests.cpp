@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/PerformanceMeter.h"
+#include <thread>
+
+TEST_CASE("AudioLoadMeter bins blocks by their share of the deadline")
+{
+    AudioLoadMeter meter;
+    meter.prepare(48000.0);
+
+    // 480 samples play for 10 ms
+    meter.addBlock(0.0005, 480);  // 5%
+    meter.addBlock(0.0045, 480);  // 45%
+    meter.addBlock(0.0046, 480);  // 46%
+    meter.addBlock(0.0150, 480);  // 150%, an overrun
+
+    auto snapshot = meter.getSnapshot(true);
+    REQUIRE(snapshot.blocks == 4);
+    REQUIRE(snapshot.histogram[0] == 1);
+    REQUIRE(snapshot.histogram[4] == 2);
+    REQUIRE(snapshot.getOverruns() == 1);
+    REQUIRE(snapshot.lastLoad > 1.49f);
+    REQUIRE(snapshot.lastLoad < 1.51f);
+    REQUIRE(snapshot.peakLoad == snapshot.lastLoad);
+    REQUIRE(snapshot.averageLoad > 0.0f);
+    REQUIRE(snapshot.averageLoad < snapshot.peakLoad);
+
+    // Taking the peak starts a new window; the histogram keeps counting
+    meter.addBlock(0.0020, 480);
+    snapshot = meter.getSnapshot(true);
+    REQUIRE(snapshot.peakLoad > 0.19f);
+    REQUIRE(snapshot.peakLoad < 0.21f);
+    REQUIRE(snapshot.blocks == 5);
+
+    REQUIRE(meter.getSnapshot(false).peakLoad == 0.0f);
+
+    meter.prepare(48000.0);
+    REQUIRE(meter.getSnapshot(false).blocks == 0);
+}
+
+TEST_CASE("ThreadCpuMeter reports busy and idle threads")
+{
+    ThreadCpuMeter busy, idle;
+
+    // Spins until the meter itself has seen 50 ms of CPU time, however long
+    // a loaded machine takes to give it that; the wall-clock limit only
+    // stops a broken meter from hanging the test
+    constexpr int64_t busyTargetNanos = 50000000;
+
+    std::thread busyThread([&busy]
+    {
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        volatile double sink = 0.0;
+
+        while (busy.getCpuNanos() < busyTargetNanos
+               && juce::Time::getMillisecondCounterHiRes() - start < 10000.0)
+        {
+            for (int i = 0; i < 10000; ++i)
+                sink = sink + 1.0;
+            busy.sample();
+        }
+    });
+
+    std::thread idleThread([&idle]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        idle.sample();
+    });
+
+    ThreadCpuMeter::Reading busyReading, idleReading;
+    REQUIRE(busy.getUsage(busyReading) == 0.0f);  // First reading only sets the baseline
+    REQUIRE(idle.getUsage(idleReading) == 0.0f);
+
+    busyThread.join();
+    idleThread.join();
+
+    REQUIRE(busy.getCpuNanos() >= busyTargetNanos);
+    REQUIRE(idle.getCpuNanos() < busy.getCpuNanos() / 2);
+    REQUIRE(busy.getUsage(busyReading) > 0.0f);
+}
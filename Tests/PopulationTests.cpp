@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "GA/Population.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cstdint>
 
 TEST_CASE("Population getBest returns highest fitness individual")
 {
@@ -10,8 +13,7 @@ TEST_CASE("Population getBest returns highest fitness individual")
     // Set known fitness values
     for (int i = 0; i < 5; ++i)
     {
-        Individual& ind = const_cast<Individual&>(pop[i]);
-        ind.setFitness(static_cast<float>(i) * 0.2f);
+        pop.setFitness(i, static_cast<float>(i) * 0.2f);
     }
     pop.markDirty();
     
@@ -28,8 +30,7 @@ TEST_CASE("Population statistics update after replacement")
     
     for (int i = 0; i < 5; ++i)
     {
-        Individual& ind = const_cast<Individual&>(pop[i]);
-        ind.setFitness(0.5f);
+        pop.setFitness(i, 0.5f);
     }
     pop.markDirty();
     
@@ -41,3 +42,111 @@ TEST_CASE("Population statistics update after replacement")
     REQUIRE(pop.getBestIndex() == 0);
     REQUIRE_THAT(pop.getBestFitness(), Catch::Matchers::WithinAbs(1.0f, 0.001f));
 }
+
+TEST_CASE("Population stores genomes in one aligned contiguous matrix")
+{
+    Population pop(8, 17);
+    pop.initializeRandom();
+    
+    const float* matrix = pop.getGenomeMatrix();
+    REQUIRE(reinterpret_cast<std::uintptr_t>(matrix) % 64 == 0);
+    
+    for (int i = 0; i < pop.size(); ++i)
+    {
+        REQUIRE(pop.getGenome(i) == matrix + i * 17);
+        
+        auto view = pop[i];
+        REQUIRE(view.data() == pop.getGenome(i));
+        REQUIRE(view.getParameterCount() == 17);
+        REQUIRE(view.getParameters().size() == 17);
+    }
+}
+
+TEST_CASE("Population setGenome invalidates fitness")
+{
+    Population pop(3, 17);
+    pop.initializeRandom();
+    pop.setFitness(1, 0.9f);
+    REQUIRE(pop.isEvaluated(1));
+    
+    std::vector<float> genome(17, 0.25f);
+    pop.setGenome(1, genome.data());
+    
+    REQUIRE_FALSE(pop.isEvaluated(1));
+    REQUIRE(pop[1].getParameters() == genome);
+}
+
+TEST_CASE("Population worstK matches a full sort after incremental updates")
+{
+    Population pop(64, 17);
+    pop.initializeRandom();
+    
+    juce::Random random(42);
+    for (int i = 0; i < pop.size(); ++i)
+        pop.setFitness(i, random.nextFloat());
+    
+    for (int step = 0; step < 200; ++step)
+    {
+        int index = random.nextInt(pop.size());
+        
+        if (step % 5 == 0)
+        {
+            Individual child(17);
+            child.setFitness(random.nextFloat());
+            pop.replace(index, child);
+        }
+        else if (step % 7 == 0)
+        {
+            std::vector<float> genome(17, 0.5f);
+            pop.setGenome(index, genome.data());
+        }
+        else
+        {
+            pop.setFitness(index, random.nextFloat());
+        }
+        
+        // Reference: sort evaluated indices by (fitness, index)
+        std::vector<int> expected;
+        double sum = 0.0;
+        for (int i = 0; i < pop.size(); ++i)
+        {
+            if (pop.isEvaluated(i))
+            {
+                expected.push_back(i);
+                sum += pop.getFitness(i);
+            }
+        }
+        std::sort(expected.begin(), expected.end(), [&pop](int a, int b)
+        {
+            if (pop.getFitness(a) != pop.getFitness(b))
+                return pop.getFitness(a) < pop.getFitness(b);
+            return a < b;
+        });
+        
+        int worst[10];
+        int count = pop.worstK(10, worst);
+        
+        REQUIRE(count == std::min(10, static_cast<int>(expected.size())));
+        for (int i = 0; i < count; ++i)
+            REQUIRE(worst[i] == expected[i]);
+        
+        REQUIRE(pop.getEvaluatedCount() == static_cast<int>(expected.size()));
+        REQUIRE(pop.getWorstFitness() == pop.getFitness(expected.front()));
+        REQUIRE_THAT(pop.getAverageFitness(),
+                     Catch::Matchers::WithinAbs(sum / expected.size(), 1e-5));
+        
+        float bestFitness = pop.getFitness(expected.back());
+        REQUIRE(pop.getBestFitness() == bestFitness);
+    }
+}
+
+TEST_CASE("Population worstK with no evaluated individuals returns nothing")
+{
+    Population pop(4, 17);
+    pop.initializeRandom();
+    
+    int worst[4];
+    REQUIRE(pop.worstK(4, worst) == 0);
+    REQUIRE_FALSE(pop.hasBest());
+    REQUIRE(pop.getBestIndex() == -1);
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include "JX11/Utils.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // Gentle sine with a length that leaves a scalar tail after the 8-wide lanes
+    std::vector<float> makeBuffer(int size = 517)
+    {
+        std::vector<float> buffer(static_cast<size_t>(size));
+        for (int i = 0; i < size; ++i)
+            buffer[static_cast<size_t>(i)] = 0.9f * std::sin(0.01f * i);
+        return buffer;
+    }
+    
+    bool isAllZero(const std::vector<float>& buffer)
+    {
+        for (float x : buffer)
+            if (x != 0.0f)
+                return false;
+        return true;
+    }
+}
+
+TEST_CASE("protectYourEars leaves clean audio untouched")
+{
+    auto buffer = makeBuffer();
+    buffer[100] = 1.0f;
+    buffer[200] = -1.0f;
+    const auto original = buffer;
+    
+    REQUIRE(isWithinUnitRange(buffer.data(), static_cast<int>(buffer.size())));
+    protectYourEars(buffer.data(), static_cast<int>(buffer.size()));
+    REQUIRE(buffer == original);
+}
+
+TEST_CASE("protectYourEars clamps mild overs")
+{
+    auto buffer = makeBuffer();
+    buffer[10] = 1.5f;
+    buffer[515] = -1.2f;  // In the scalar tail
+    
+    REQUIRE_FALSE(isWithinUnitRange(buffer.data(), static_cast<int>(buffer.size())));
+    protectYourEars(buffer.data(), static_cast<int>(buffer.size()));
+    REQUIRE(buffer[10] == 1.0f);
+    REQUIRE(buffer[515] == -1.0f);
+    REQUIRE(buffer[11] == makeBuffer()[11]);
+}
+
+TEST_CASE("protectYourEars silences NaN, Inf and extreme values anywhere")
+{
+    const float bad[] = {
+        std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        3.0f
+    };
+    const int positions[] = { 0, 7, 300, 516 };
+    
+    for (float value : bad)
+    {
+        for (int position : positions)
+        {
+            auto buffer = makeBuffer();
+            buffer[static_cast<size_t>(position)] = value;
+            
+            REQUIRE_FALSE(isWithinUnitRange(buffer.data(), static_cast<int>(buffer.size())));
+            protectYourEars(buffer.data(), static_cast<int>(buffer.size()));
+            REQUIRE(isAllZero(buffer));
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/RandomStream.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+TEST_CASE("RandomStream gives the same numbers for the same seed and stream")
+{
+    RandomStream a(42), b(42), other(43), sibling(42, 1);
+
+    bool differsFromOther = false, differsFromSibling = false;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto value = a.next64();
+        REQUIRE(value == b.next64());
+        differsFromOther |= value != other.next64();
+        differsFromSibling |= value != sibling.next64();
+    }
+
+    REQUIRE(differsFromOther);
+    REQUIRE(differsFromSibling);
+    REQUIRE(a.getPosition() == 100);
+}
+
+TEST_CASE("RandomStream splits into independent children")
+{
+    const RandomStream parent(7);
+    auto first = parent.split(0);
+    auto again = parent.split(0);
+    auto second = parent.split(1);
+
+    // Drawing from one child never moves another
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 50; ++i)
+        values.push_back(first.next64());
+    for (int i = 0; i < 50; ++i)
+        REQUIRE(again.next64() == values[static_cast<size_t>(i)]);
+
+    std::set<uint64_t> seen(values.begin(), values.end());
+    for (int i = 0; i < 50; ++i)
+        REQUIRE(seen.insert(second.next64()).second);
+
+    REQUIRE(RandomStream::deriveSeed(7, 3) == RandomStream::deriveSeed(7, 3));
+    REQUIRE(RandomStream::deriveSeed(7, 3) != RandomStream::deriveSeed(7, 4));
+}
+
+TEST_CASE("RandomStream replays from any position and restores its state")
+{
+    RandomStream stream(11);
+    for (int i = 0; i < 10; ++i)
+        stream.next64();
+
+    const auto state = stream.getState();
+    const auto tenth = stream.next64();
+    const auto eleventh = stream.next64();
+
+    stream.setPosition(10);
+    REQUIRE(stream.next64() == tenth);
+
+    RandomStream restored;
+    restored.setState(state);
+    REQUIRE(restored.next64() == tenth);
+    REQUIRE(restored.next64() == eleventh);
+}
+
+TEST_CASE("RandomStream bounded values stay in range")
+{
+    RandomStream stream(3);
+    std::vector<int> counts(10, 0);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int value = stream.nextInt(10);
+        REQUIRE(value >= 0);
+        REQUIRE(value < 10);
+        ++counts[static_cast<size_t>(value)];
+
+        const float unit = stream.nextFloat();
+        REQUIRE(unit >= 0.0f);
+        REQUIRE(unit < 1.0f);
+
+        const double fine = stream.nextDouble();
+        REQUIRE(fine >= 0.0);
+        REQUIRE(fine < 1.0);
+    }
+
+    // Roughly uniform: each bucket within 20% of its expected 1000
+    for (int count : counts)
+    {
+        REQUIRE(count > 800);
+        REQUIRE(count < 1200);
+    }
+}
+
+TEST_CASE("RandomStream drives the standard distributions and shuffles")
+{
+    RandomStream a(5), b(5);
+
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (int i = 0; i < 20; ++i)
+    {
+        const float value = distribution(a);
+        REQUIRE(value >= -1.0f);
+        REQUIRE(value < 1.0f);
+        REQUIRE(value == distribution(b));
+    }
+
+    std::vector<int> first(32), second(32);
+    std::iota(first.begin(), first.end(), 0);
+    std::iota(second.begin(), second.end(), 0);
+    std::shuffle(first.begin(), first.end(), a);
+    std::shuffle(second.begin(), second.end(), b);
+    REQUIRE(first == second);
+}
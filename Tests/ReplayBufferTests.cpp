@@ -0,0 +1,101 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/ReplayBuffer.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+    std::array<float, 3> genome(float x) { return { x, x + 0.1f, x + 0.2f }; }
+    std::array<float, 2> features(float x) { return { -x, 2.0f * x }; }
+}
+
+TEST_CASE("ReplayBuffer stores columns and overwrites the oldest sample when full")
+{
+    ReplayBuffer buffer(3, 3, 2, 1);
+    
+    for (int i = 0; i < 4; ++i)
+    {
+        auto g = genome(static_cast<float>(i));
+        auto f = features(static_cast<float>(i));
+        buffer.add(g.data(), f.data(), static_cast<float>(i % 2), 0.5f + i);
+    }
+    
+    REQUIRE(buffer.size() == 3);
+    REQUIRE(buffer.capacity() == 3);
+    
+    // Sample 3 went into the slot sample 0 was in
+    REQUIRE(buffer.genome(0)[0] == 3.0f);
+    REQUIRE(buffer.features(0)[1] == 6.0f);
+    REQUIRE(buffer.rating(0) == 1.0f);
+    REQUIRE(buffer.sampleWeight(0) == 3.5f);
+    REQUIRE(buffer.genome(1)[2] == genome(1.0f)[2]);
+    
+    buffer.clear();
+    REQUIRE(buffer.size() == 0);
+}
+
+TEST_CASE("ReplayBuffer samples high-error samples more often")
+{
+    ReplayBuffer buffer(16, 3, 2, 7);
+    
+    for (int i = 0; i < 16; ++i)
+    {
+        auto g = genome(static_cast<float>(i));
+        auto f = features(static_cast<float>(i));
+        buffer.add(g.data(), f.data(), 1.0f, 1.0f);
+    }
+    
+    // One sample the model still gets badly wrong; the rest are learnt
+    for (int i = 0; i < 16; ++i)
+        buffer.updatePriority(i, i == 5 ? 0.9f : 0.0f);
+    
+    std::vector<int> draws(16, 0);
+    int indices[8];
+    float importance[8];
+    
+    for (int round = 0; round < 200; ++round)
+    {
+        buffer.sample(8, indices, importance);
+        
+        float largest = 0.0f;
+        for (int k = 0; k < 8; ++k)
+        {
+            REQUIRE(indices[k] >= 0);
+            REQUIRE(indices[k] < 16);
+            REQUIRE(importance[k] > 0.0f);
+            REQUIRE(importance[k] <= 1.0f);
+            largest = std::max(largest, importance[k]);
+            ++draws[static_cast<size_t>(indices[k])];
+        }
+        REQUIRE(largest == 1.0f);
+    }
+    
+    // Priority 0.91^0.6 against 0.01^0.6 for the rest: most draws
+    for (int i = 0; i < 16; ++i)
+        if (i != 5)
+            REQUIRE(draws[5] > 10 * draws[static_cast<size_t>(i)]);
+}
+
+TEST_CASE("ReplayBuffer draws uniformly before any priorities are learnt")
+{
+    ReplayBuffer buffer(4, 3, 2, 3);
+    
+    for (int i = 0; i < 4; ++i)
+    {
+        auto g = genome(static_cast<float>(i));
+        auto f = features(static_cast<float>(i));
+        buffer.add(g.data(), f.data(), 0.0f, 1.0f);
+    }
+    
+    // Stratified over equal priorities: each slice is one sample
+    int indices[4];
+    float importance[4];
+    buffer.sample(4, indices, importance);
+    
+    for (int k = 0; k < 4; ++k)
+    {
+        REQUIRE(indices[k] == k);
+        REQUIRE(importance[k] == 1.0f);
+    }
+}
@@ -0,0 +1,193 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/SharedEngine.h"
+#include "GA/GeneticAlgorithm.h"
+#include "GA/ParameterBridge.h"
+#include "GA/FeedbackLog.h"
+
+namespace
+{
+    std::vector<juce::String> getParameterNames()
+    {
+        std::vector<juce::String> names;
+        for (int i = 0; i < 17; ++i)
+            names.push_back("p" + juce::String(i));
+        return names;
+    }
+
+    juce::File getTestDirectory(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("SharedEngineTests_" + name + "_" + juce::Uuid().toString());
+        dir.createDirectory();
+        return dir;
+    }
+
+    class SumFitnessModel : public IFitnessModel
+    {
+    public:
+        float evaluate(const std::vector<float>& genome) override
+        {
+            float sum = 0.0f;
+            for (float value : genome)
+                sum += value;
+            return sum / static_cast<float>(genome.size());
+        }
+
+        void sendFeedback(const std::vector<float>&, const Feedback&) override {}
+    };
+}
+
+TEST_CASE("SharedEngine gives every instance of a profile the same model")
+{
+    const auto names = getParameterNames();
+    const auto first = getTestDirectory("first");
+    const auto second = getTestDirectory("second");
+    const int profilesBefore = SharedEngine::getNumProfiles();
+
+    {
+        auto a = SharedEngine::acquireModel(names, first);
+        auto b = SharedEngine::acquireModel(names, first);
+        auto c = SharedEngine::acquireModel(names, second);
+
+        REQUIRE(&a->getModel() == &b->getModel());
+        REQUIRE(&a->getModel() != &c->getModel());
+        REQUIRE(a->getNumSharing() == 2);
+        REQUIRE(c->getNumSharing() == 1);
+        REQUIRE(a->getModel().getBaseDirectory() == first);
+        REQUIRE(SharedEngine::getNumProfiles() == profilesBefore + 2);
+
+        b.reset();
+        REQUIRE(a->getNumSharing() == 1);
+        REQUIRE(SharedEngine::getNumProfiles() == profilesBefore + 2);
+    }
+
+    REQUIRE(SharedEngine::getNumProfiles() == profilesBefore);
+
+    first.deleteRecursively();
+    second.deleteRecursively();
+}
+
+TEST_CASE("SharedEngine writes one feedback log for every instance of a profile")
+{
+    const auto names = getParameterNames();
+    const auto dir = getTestDirectory("log");
+
+    {
+        auto a = SharedEngine::acquireModel(names, dir);
+        auto b = SharedEngine::acquireModel(names, dir);
+        REQUIRE(a->getModel().waitUntilReady());
+
+        a->getModel().sendFeedback(std::vector<float>(17, 0.2f), { 1.0f, 3.0f });
+        b->getModel().sendFeedback(std::vector<float>(17, 0.8f), { 0.0f, 3.0f });
+        juce::Thread::sleep(1000);  // Both taken off the queue by the one training thread
+    }
+
+    // The last release saved and closed the log before returning
+    int numRecords = 0;
+    REQUIRE(FeedbackLog::readRecords(dir.getChildFile("feedback_log.bin"), 17,
+                                     [&numRecords](const FeedbackLog::Record&, const float*) { ++numRecords; }));
+    REQUIRE(numRecords == 2);
+
+    dir.deleteRecursively();
+}
+
+TEST_CASE("SharedEngine keeps each instance's input mode and config flags")
+{
+    using InputMode = SharedEngine::ModelHandle::InputMode;
+    const auto names = getParameterNames();
+    const auto dir = getTestDirectory("mode");
+
+    {
+        auto genome = SharedEngine::acquireModel(names, dir);
+        auto audio = SharedEngine::acquireModel(names, dir);
+        auto& model = genome->getModel();
+        REQUIRE(model.waitUntilReady());
+
+        const auto genomeVersion = genome->getModelVersion();
+        audio->setInputMode(InputMode::Audio);
+        audio->setConfigFlags("audio");
+        REQUIRE(genome->getInputMode() == InputMode::Genome);
+        REQUIRE(genome->getModelVersion() == genomeVersion);
+        REQUIRE(audio->getModelVersion() > genomeVersion);
+
+        const std::vector<float> candidate(17, 0.3f);
+        REQUIRE(genome->evaluate(candidate) == model.evaluate(candidate, InputMode::Genome));
+        REQUIRE(audio->evaluate(candidate) == model.evaluate(candidate, InputMode::Audio));
+
+        float scores[2];
+        genome->evaluateBatch(candidate.data(), 1, 17, scores);
+        audio->evaluateBatch(candidate.data(), 1, 17, scores + 1);
+        REQUIRE(scores[0] == model.evaluate(candidate, InputMode::Genome));
+        REQUIRE(scores[1] == model.evaluate(candidate, InputMode::Audio));
+
+        // Each rating is logged with the flags of the instance that sent it
+        genome->sendFeedback(candidate, { 1.0f, 3.0f });
+        audio->sendFeedback(candidate, { 0.0f, 3.0f });
+        REQUIRE(model.waitUntilTrained(30000));
+    }
+
+    juce::StringArray flags;
+    REQUIRE(FeedbackLog::readRecords(dir.getChildFile("feedback_log.bin"), 17,
+                                     [&flags](const FeedbackLog::Record& record, const float*) { flags.add(record.configFlags); }));
+    REQUIRE(flags.joinIntoString(",") == "baseline,audio");
+
+    dir.deleteRecursively();
+}
+
+TEST_CASE("SharedEngine training yields to the busiest instance's audio")
+{
+    const auto names = getParameterNames();
+    const auto dir = getTestDirectory("load");
+
+    auto quiet = SharedEngine::acquireModel(names, dir);
+    auto busy = SharedEngine::acquireModel(names, dir);
+    auto& model = quiet->getModel();
+
+    quiet->setAudioLoad(0.2f);
+    busy->setAudioLoad(0.7f);
+    REQUIRE(model.getAudioLoad() == 0.7f);
+
+    quiet->setAudioLoad(0.3f);
+    REQUIRE(model.getAudioLoad() == 0.7f);
+
+    busy.reset();
+    REQUIRE(model.getAudioLoad() == 0.3f);
+
+    quiet.reset();
+    dir.deleteRecursively();
+}
+
+TEST_CASE("SharedEngine's worker pool serves several GAs at once")
+{
+    std::weak_ptr<WorkerPool> released;
+
+    {
+        auto pool = SharedEngine::getWorkerPool();
+        REQUIRE(pool == SharedEngine::getWorkerPool());
+        REQUIRE(pool->getNumSlots() == juce::SystemStats::getNumCpus());
+        released = pool;
+
+        SumFitnessModel model;
+        GeneticAlgorithm first(model), second(model);
+        first.setEvaluationPool(pool);
+        second.setEvaluationPool(pool);
+        pool.reset();
+
+        // Whichever GA doesn't get the workers evaluates on its own thread
+        first.startGA();
+        second.startGA();
+        juce::Thread::sleep(200);
+
+        std::vector<float> params;
+        float fitness;
+        REQUIRE(first.getParameterBridge()->pop(params, fitness));
+        REQUIRE(second.getParameterBridge()->pop(params, fitness));
+        REQUIRE(released.lock() != nullptr);
+
+        first.stopGA();
+        second.stopGA();
+    }
+
+    // Gone with its last user
+    REQUIRE(released.expired());
+}
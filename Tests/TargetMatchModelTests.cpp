@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/TargetMatchModel.h"
+#include "GA/HeadlessSynth.h"
+#include <cmath>
+
+namespace
+{
+    juce::File getTestDirectory(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("TargetMatchModelTests").getChildFile(name);
+        dir.deleteRecursively();
+        dir.createDirectory();
+        return dir;
+    }
+
+    std::vector<float> makeGenome(int seed)
+    {
+        juce::Random random(seed);
+        std::vector<float> genome(HeadlessParam::COUNT);
+        for (auto& value : genome)
+            value = random.nextFloat();
+        return genome;
+    }
+
+    // The feature cache's C4-E4-G4-C5 phrase, rendered at sampleRate
+    juce::AudioBuffer<float> renderPhrase(const std::vector<float>& genome, double sampleRate, int durationMs)
+    {
+        const int totalSamples = static_cast<int>(sampleRate * durationMs / 1000.0);
+        const int noteDuration = totalSamples / 4;
+        const std::vector<MidiEvent> phrase = {
+            { 0, 0x90, 60, 110 },
+            { noteDuration - 100, 0x80, 60, 0 },
+            { noteDuration, 0x90, 64, 80 },
+            { noteDuration * 2 - 100, 0x80, 64, 0 },
+            { noteDuration * 2, 0x90, 67, 50 },
+            { noteDuration * 3 - 100, 0x80, 67, 0 },
+            { noteDuration * 3, 0x90, 72, 100 },
+            { totalSamples - 200, 0x80, 72, 0 }
+        };
+
+        HeadlessSynth synth(sampleRate);
+        synth.setParameters(genome);
+        return synth.renderSequence(phrase, totalSamples);
+    }
+
+    // 32-bit float WAV, the mono signal copied to every channel
+    void writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate, int numChannels)
+    {
+        const int numSamples = audio.getNumSamples();
+        const uint32_t dataBytes = static_cast<uint32_t>(numSamples * numChannels * 4);
+        const uint32_t rate = static_cast<uint32_t>(sampleRate);
+        const uint16_t channels = static_cast<uint16_t>(numChannels);
+
+        juce::FileOutputStream stream(file);
+        REQUIRE(stream.openedOk());
+
+        auto write32 = [&stream](uint32_t value) { stream.write(&value, 4); };
+        auto write16 = [&stream](uint16_t value) { stream.write(&value, 2); };
+
+        stream.write("RIFF", 4);
+        write32(36 + dataBytes);
+        stream.write("WAVEfmt ", 8);
+        write32(16);
+        write16(3);  // IEEE float
+        write16(channels);
+        write32(rate);
+        write32(rate * channels * 4);
+        write16(static_cast<uint16_t>(channels * 4));
+        write16(32);
+        stream.write("data", 4);
+        write32(dataBytes);
+
+        for (int i = 0; i < numSamples; ++i)
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float sample = audio.getSample(0, i);
+                stream.write(&sample, 4);
+            }
+    }
+}
+
+TEST_CASE("TargetMatchModel scores a render of its own target as a perfect match")
+{
+    const auto profile = AudioFeatureCache::RenderProfile::fitness();
+    const auto genome = makeGenome(1);
+    const auto wav = getTestDirectory("exact").getChildFile("target.wav");
+    writeWav(wav, renderPhrase(genome, profile.sampleRate, profile.durationMs), profile.sampleRate, 1);
+
+    TargetMatchModel model(44100.0, profile);
+    REQUIRE(model.evaluate(genome) == 0.0f);  // No target yet
+
+    const auto result = model.loadTarget(wav);
+    REQUIRE(result.success);
+    REQUIRE(model.hasTarget());
+
+    // Same render rate, phrase and analysis as the candidate, so no distance at all
+    REQUIRE(model.evaluate(genome) == 1.0f);
+    REQUIRE(model.evaluate(makeGenome(2)) < 1.0f);
+}
+
+TEST_CASE("TargetMatchModel resamples and mixes down a target as it reads it")
+{
+    const auto profile = AudioFeatureCache::RenderProfile::fitness();
+    const auto dir = getTestDirectory("resample");
+
+    // A decaying 440 Hz tone: the same sound at either rate
+    auto makeTone = [](double sampleRate, double seconds)
+    {
+        juce::AudioBuffer<float> tone(1, static_cast<int>(sampleRate * seconds));
+        for (int i = 0; i < tone.getNumSamples(); ++i)
+        {
+            const double t = i / sampleRate;
+            tone.setSample(0, i, static_cast<float>(0.2 * std::exp(-2.0 * t) * std::sin(2.0 * juce::MathConstants<double>::pi * 440.0 * t)));
+        }
+        return tone;
+    };
+
+    // Stereo at twice the render rate, and longer than the phrase that is analysed
+    const auto native = dir.getChildFile("native.wav");
+    const auto resampled = dir.getChildFile("resampled.wav");
+    writeWav(native, makeTone(profile.sampleRate, 1.0), profile.sampleRate, 1);
+    writeWav(resampled, makeTone(profile.sampleRate * 2.0, 3.0), profile.sampleRate * 2.0, 2);
+
+    TargetMatchModel nativeModel(44100.0, profile), resampledModel(44100.0, profile);
+    REQUIRE(nativeModel.loadTarget(native).success);
+    REQUIRE(resampledModel.loadTarget(resampled).success);
+
+    const auto expected = nativeModel.getTargetFeatures();
+    const auto actual = resampledModel.getTargetFeatures();
+
+    REQUIRE(std::abs(actual.rmsEnergy - expected.rmsEnergy) < 0.02f * expected.rmsEnergy);
+    REQUIRE(std::abs(actual.spectralCentroidMean - expected.spectralCentroidMean) < 0.02f * expected.spectralCentroidMean);
+    for (int i = 0; i < 10; ++i)
+        REQUIRE(std::abs(actual.mfccMean[static_cast<size_t>(i)] - expected.mfccMean[static_cast<size_t>(i)]) < 0.5f);
+}
+
+TEST_CASE("TargetMatchModel batch scores match single evaluations")
+{
+    TargetMatchModel model;
+
+    FeatureVector target;
+    target.mfccMean.fill(5.0f);
+    target.spectralCentroidMean = 1500.0f;
+    target.rmsEnergy = 0.1f;
+    REQUIRE(model.getModelVersion() == 0);
+    model.setTargetFeatures(target);
+    REQUIRE(model.getTargetFeatures().spectralCentroidMean == 1500.0f);
+    REQUIRE(model.getModelVersion() == 1);
+
+    // One full lane block and a partial one
+    const int numGenomes = TargetMatchModel::MAX_LANES + 3;
+    std::vector<float> genomes;
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        const auto genome = makeGenome(100 + i);
+        genomes.insert(genomes.end(), genome.begin(), genome.end());
+    }
+
+    std::vector<float> batch(static_cast<size_t>(numGenomes));
+    model.evaluateBatch(genomes.data(), numGenomes, HeadlessParam::COUNT, batch.data());
+
+    for (int i = 0; i < numGenomes; ++i)
+    {
+        const auto first = genomes.begin() + i * HeadlessParam::COUNT;
+        REQUIRE(batch[static_cast<size_t>(i)] == model.evaluate(std::vector<float>(first, first + HeadlessParam::COUNT)));
+        REQUIRE(batch[static_cast<size_t>(i)] > 0.0f);
+        REQUIRE(batch[static_cast<size_t>(i)] < 1.0f);
+    }
+}
+
+TEST_CASE("TargetMatchModel reports targets it cannot read")
+{
+    TargetMatchModel model;
+    const auto dir = getTestDirectory("errors");
+
+    auto result = model.loadTarget(dir.getChildFile("missing.wav"));
+    REQUIRE_FALSE(result.success);
+    REQUIRE(result.errorMessage.isNotEmpty());
+
+    const auto notAudio = dir.getChildFile("notes.txt");
+    REQUIRE(notAudio.replaceWithText("not audio"));
+    REQUIRE_FALSE(model.loadTarget(notAudio).success);
+    REQUIRE_FALSE(model.hasTarget());
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/Trace.h"
+#include <thread>
+
+namespace
+{
+    juce::File getTraceFile(const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("TraceTests");
+        dir.createDirectory();
+        auto file = dir.getChildFile(name);
+        file.deleteFile();
+        return file;
+    }
+
+    int countOccurrences(const juce::String& text, const juce::String& pattern)
+    {
+        int count = 0;
+        for (int index = text.indexOf(pattern); index >= 0; index = text.indexOf(index + 1, pattern))
+            ++count;
+        return count;
+    }
+}
+
+TEST_CASE("Trace records zones and counters from several threads")
+{
+    Trace::start();
+    REQUIRE(Trace::isRecording());
+
+    auto work = [](const char* threadName)
+    {
+        Trace::setThreadName(threadName);
+        for (int i = 0; i < 10; ++i)
+        {
+            PPG_TRACE_ZONE("test zone");
+            PPG_TRACE_COUNTER("test counter", i);
+        }
+    };
+
+    std::thread first(work, "first worker");
+    std::thread second(work, "second worker");
+    first.join();
+    second.join();
+
+    Trace::stop();
+
+    // Nothing lands once stopped
+    {
+        PPG_TRACE_ZONE("after stop");
+    }
+
+    const auto file = getTraceFile("threads.json");
+    REQUIRE(Trace::exportChromeTrace(file));
+
+    const auto json = file.loadFileAsString();
+    REQUIRE(json.startsWith("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    REQUIRE(json.trimEnd().endsWith("]}"));
+    REQUIRE(countOccurrences(json, "\"name\":\"test zone\"") == 20);
+    REQUIRE(countOccurrences(json, "\"ph\":\"C\",\"name\":\"test counter\"") == 20);
+    REQUIRE(json.contains("\"args\":{\"name\":\"first worker\"}"));
+    REQUIRE(json.contains("\"args\":{\"name\":\"second worker\"}"));
+    REQUIRE_FALSE(json.contains("after stop"));
+}
+
+TEST_CASE("Trace keeps each thread's newest events and restarts empty")
+{
+    Trace::start();
+
+    std::thread writer([]
+    {
+        for (int i = 0; i < Trace::eventsPerThread + 100; ++i)
+            PPG_TRACE_COUNTER("overflow", i);
+    });
+    writer.join();
+
+    Trace::stop();
+
+    const auto file = getTraceFile("overflow.json");
+    REQUIRE(Trace::exportChromeTrace(file));
+
+    auto json = file.loadFileAsString();
+    REQUIRE(countOccurrences(json, "\"overflow\"") == Trace::eventsPerThread);
+    REQUIRE(json.contains("\"value\":" + juce::String(static_cast<double>(Trace::eventsPerThread + 99), 6)));
+    REQUIRE_FALSE(json.contains("\"value\":" + juce::String(static_cast<double>(99), 6) + "}"));
+
+    // A new recording drops the previous one
+    Trace::start();
+    Trace::stop();
+    REQUIRE(Trace::exportChromeTrace(file));
+    json = file.loadFileAsString();
+    REQUIRE_FALSE(json.contains("overflow"));
+}
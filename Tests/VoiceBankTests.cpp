@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <juce_core/juce_core.h>
+#include "JX11/VoiceBank.h"
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    using Voices = std::array<Voice, 8>;
+    
+    // Mixed voices: different pitches, envelope shapes, and some silent lanes
+    Voices makeVoices()
+    {
+        Voices voices;
+        
+        for (int v = 0; v < 8; ++v)
+        {
+            Voice& voice = voices[static_cast<size_t>(v)];
+            voice.reset();
+            voice.filter.sampleRate = 44100.0f;
+            
+            if (v == 2 || v == 5)
+                continue;  // Left silent
+            
+            voice.note = 48 + v * 5;
+            voice.updatePanning();
+            voice.osc1.period = 40.0f + 23.0f * v;
+            voice.osc1.amplitude = 0.5f;
+            voice.osc2.period = voice.osc1.period * 1.01f;
+            voice.osc2.amplitude = 0.25f;
+            voice.filter.updateCoefficients(800.0f + 300.0f * v, 1.5f);
+            
+            voice.env.attackMultiplier = 0.99f;
+            voice.env.decayMultiplier = 0.995f;
+            voice.env.sustainLevel = v == 7 ? 0.0f : 0.6f;
+            voice.env.releaseMultiplier = 0.95f;
+            voice.env.attack();
+        }
+        
+        return voices;
+    }
+    
+    void renderScalar(Voices& voices, float noise, float& left, float& right)
+    {
+        for (auto& voice : voices)
+        {
+            if (voice.env.isActive())
+            {
+                float output = voice.render(noise);
+                left += output * voice.panLeft;
+                right += output * voice.panRight;
+            }
+        }
+    }
+}
+
+TEST_CASE("VoiceBank renders identically to per-voice scalar rendering")
+{
+    Voices scalarVoices = makeVoices();
+    Voices bankVoices = makeVoices();
+    VoiceBank<8> bank;
+    
+    juce::Random random(7);
+    
+    for (int run = 0; run < 400; ++run)
+    {
+        // Release a couple of voices part-way so lanes go silent mid-run
+        if (run == 150)
+        {
+            scalarVoices[1].release();
+            bankVoices[1].release();
+            scalarVoices[6].release();
+            bankVoices[6].release();
+        }
+        
+        bank.load(bankVoices);
+        
+        for (int i = 0; i < 32; ++i)
+        {
+            float noise = (random.nextFloat() * 2.0f - 1.0f) * 0.1f;
+            
+            float scalarLeft = 0.0f, scalarRight = 0.0f;
+            renderScalar(scalarVoices, noise, scalarLeft, scalarRight);
+            
+            float bankLeft = 0.0f, bankRight = 0.0f;
+            bank.renderSample(noise, bankLeft, bankRight);
+            
+            REQUIRE(bankLeft == scalarLeft);
+            REQUIRE(bankRight == scalarRight);
+        }
+        
+        bank.store();
+        
+        for (int v = 0; v < 8; ++v)
+        {
+            REQUIRE(bankVoices[static_cast<size_t>(v)].env.level == scalarVoices[static_cast<size_t>(v)].env.level);
+            REQUIRE(bankVoices[static_cast<size_t>(v)].saw == scalarVoices[static_cast<size_t>(v)].saw);
+        }
+    }
+    
+    // Released voices must have decayed to silence and stayed frozen
+    REQUIRE_FALSE(bankVoices[1].env.isActive());
+    REQUIRE_FALSE(bankVoices[6].env.isActive());
+}
+
+TEST_CASE("VoiceBank mono render matches the right channel of the stereo render")
+{
+    Voices stereoVoices = makeVoices();
+    Voices monoVoices = makeVoices();
+    VoiceBank<8> stereoBank, monoBank;
+    
+    juce::Random random(11);
+    
+    for (int run = 0; run < 100; ++run)
+    {
+        stereoBank.load(stereoVoices);
+        monoBank.load(monoVoices);
+        
+        for (int i = 0; i < 32; ++i)
+        {
+            float noise = (random.nextFloat() * 2.0f - 1.0f) * 0.1f;
+            
+            float left = 0.0f, right = 0.0f;
+            stereoBank.renderSample(noise, left, right);
+            
+            float mono = 0.0f;
+            monoBank.renderSample(noise, mono);
+            
+            REQUIRE(mono == right);
+        }
+        
+        stereoBank.store();
+        monoBank.store();
+    }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GA/WorkerPool.h"
+#include <atomic>
+#include <vector>
+
+TEST_CASE("WorkerPool runs every task exactly once")
+{
+    WorkerPool pool(4);
+    REQUIRE(pool.getNumSlots() == 4);
+    
+    std::vector<std::atomic<int>> counts(100);
+    for (auto& c : counts)
+        c.store(0);
+    
+    // Catch2 assertions aren't thread-safe, so workers only record
+    std::vector<int> slots(100, -1);
+    
+    pool.parallelFor(100, [&](int index, int slot)
+    {
+        slots[static_cast<size_t>(index)] = slot;
+        ++counts[index];
+    });
+    
+    for (auto& c : counts)
+        REQUIRE(c.load() == 1);
+    
+    for (int slot : slots)
+    {
+        REQUIRE(slot >= 0);
+        REQUIRE(slot < 4);
+    }
+}
+
+TEST_CASE("WorkerPool can be reused for many jobs")
+{
+    WorkerPool pool(3);
+    std::atomic<int> total{0};
+    
+    for (int job = 0; job < 50; ++job)
+        pool.parallelFor(8, [&](int, int) { ++total; });
+    
+    REQUIRE(total.load() == 400);
+}
+
+TEST_CASE("WorkerPool single slot runs inline")
+{
+    WorkerPool pool(1);
+    REQUIRE(pool.getNumSlots() == 1);
+    
+    std::vector<int> order;
+    pool.parallelFor(5, [&](int index, int slot)
+    {
+        REQUIRE(slot == 0);
+        order.push_back(index);
+    });
+    
+    REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("WorkerPool nested parallelFor runs inline")
+{
+    WorkerPool pool(4);
+    std::atomic<int> total{0};
+    
+    pool.parallelFor(4, [&](int, int)
+    {
+        pool.parallelFor(4, [&](int, int) { ++total; });
+    });
+    
+    REQUIRE(total.load() == 16);
+}
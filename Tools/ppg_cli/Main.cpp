@@ -0,0 +1,562 @@
+/*
+  ==============================================================================
+    Main.cpp
+    Created: 14 Oct 2026
+    Author:  Daniel Lister
+  ==============================================================================
+*/
+
+#include "GA/GeneticAlgorithm.h"
+#include "GA/GenomeConstraints.h"
+#include "GA/HeadlessSynth.h"
+#include "GA/IFitnessModel.h"
+#include "GA/MLPPreferenceModel.h"
+#include "GA/ParameterBridge.h"
+#include "GA/TargetMatchModel.h"
+#include "GA/Trace.h"
+#include "GA/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* const usage =
+        "Usage: ppg_cli [options]\n"
+        "\n"
+        "Runs the GA headlessly against a scripted preference oracle or a target\n"
+        "sound, printing throughput and convergence as CSV on stdout and a\n"
+        "summary on stderr.\n"
+        "\n"
+        "Session:\n"
+        "  --generations N      Generations per session (default 500)\n"
+        "  --sessions N         Simulated sessions (default 1)\n"
+        "  --first-session N    Index of the first session, for sharding across jobs (default 0)\n"
+        "  --jobs N             Sessions run concurrently (default 1, 0 = one per core)\n"
+        "  --seed N             Base seed; session i uses seed + i (default 1)\n"
+        "  --report-every N     Generations between CSV rows (default: one row per session)\n"
+        "\n"
+        "Fitness:\n"
+        "  --model DIR          Start from the model saved in DIR (copied, never modified)\n"
+        "  --direct             Score genomes with the oracle itself, without a model\n"
+        "  --target FILE        Match the sound of an audio file instead (no ratings)\n"
+        "  --rate-every N       Generations between simulated ratings (default 5, 0 = never)\n"
+        "  --like-threshold X   Oracle similarity above which a preset is liked (default 0.75)\n"
+        "  --noise X            Probability the oracle flips a rating (default 0.05)\n"
+        "\n"
+        "GA (see GAConfig):\n"
+        "  --population N       Individuals per island (default 50)\n"
+        "  --threads N          Evaluation threads per session (default 0 = one per core)\n"
+        "  --islands N          Island count (default 1)\n"
+        "  --migration N        Generations between migrations (default 10)\n"
+        "  --proposals N        Candidates bred per generation and screened by the surrogate (default 0 = off)\n"
+        "  --surrogate X        Fully evaluate only the top X of offspring by the genome MLP (audio mode)\n"
+        "  --latency-ms X       Size generations to take X ms each (default: fixed size)\n"
+        "  --cpu-ms X           Size generations for X ms of CPU a second over the threads (no pauses here)\n"
+        "  --selection S        Parent selection: tournament, rank or sus (default tournament)\n"
+        "  --replacement R      Replacement: worst, crowding or elitist (default worst)\n"
+        "  --adaptive --novelty --multi-objective --progressive --ucb --audio --reject-silent\n"
+        "\n"
+        "PPG_TRACE=<file> records a Chrome trace of the run to file.\n";
+
+    // GenomeConstraints::ParamIndex order, as JX11AudioProcessor::getGAParameterIDs names them
+    const std::vector<juce::String> parameterNames
+    {
+        "oscMix", "oscFine",
+        "filterFreq", "filterReso", "filterEnv", "filterLFO",
+        "filterAttack", "filterDecay", "filterSustain", "filterRelease",
+        "envAttack", "envDecay", "envSustain", "envRelease",
+        "lfoRate", "vibrato", "noise"
+    };
+
+    // Model files worth copying out of a saved model directory
+    const char* const modelFiles[] =
+    {
+        "mlp_checkpoint.bin", "mlp_weights_genome.bin", "mlp_weights_audio.bin", "feedback_log.bin"
+    };
+
+    struct Options
+    {
+        int generations = 500;
+        int sessions = 1;
+        int firstSession = 0;
+        int jobs = 1;
+        juce::int64 seed = 1;
+        int reportEvery = 0;
+
+        juce::File modelDirectory;
+        bool direct = false;
+        juce::File targetFile;
+        FeatureVector targetFeatures;  // Decoded once by main(), shared by every session
+        int rateEvery = 5;
+        float likeThreshold = 0.75f;
+        float noise = 0.05f;
+
+        GAConfig config;
+    };
+
+    /**
+        Simulated user: likes presets near a hidden target genome. Similarity
+        is one minus the RMS distance to the target, so it lies in [0, 1] and a
+        uniformly random preset scores about 0.6.
+    */
+    class PreferenceOracle
+    {
+    public:
+        PreferenceOracle(juce::Random& random, float likeThreshold, float noise)
+            : target(static_cast<size_t>(HeadlessParam::COUNT)), threshold(likeThreshold), flipProbability(noise)
+        {
+            for (auto& value : target)
+                value = random.nextFloat();
+
+            GenomeConstraints::repair(target.data(), static_cast<int>(target.size()));
+        }
+
+        float getSimilarity(const float* genome) const
+        {
+            float squared = 0.0f;
+            for (size_t i = 0; i < target.size(); ++i)
+                squared += (genome[i] - target[i]) * (genome[i] - target[i]);
+
+            return 1.0f - std::sqrt(squared / static_cast<float>(target.size()));
+        }
+
+        bool rate(const float* genome, juce::Random& random) const
+        {
+            const bool liked = getSimilarity(genome) > threshold;
+            return random.nextFloat() < flipProbability ? !liked : liked;
+        }
+
+    private:
+        std::vector<float> target;
+        const float threshold;
+        const float flipProbability;
+    };
+
+    // --direct: the GA climbs the oracle's similarity with no model in between
+    class OracleFitnessModel : public IFitnessModel
+    {
+    public:
+        explicit OracleFitnessModel(const PreferenceOracle& preferenceOracle) : oracle(preferenceOracle) {}
+
+        float evaluate(const std::vector<float>& genome) override { return oracle.getSimilarity(genome.data()); }
+
+        void evaluateBatch(const float* genomes, int numGenomes, int genomeSize, float* fitnessOut) override
+        {
+            for (int i = 0; i < numGenomes; ++i)
+                fitnessOut[i] = oracle.getSimilarity(genomes + static_cast<size_t>(i) * static_cast<size_t>(genomeSize));
+        }
+
+        void sendFeedback(const std::vector<float>&, const Feedback&) override {}
+
+    private:
+        const PreferenceOracle& oracle;
+    };
+
+    bool parseInt(const juce::String& text, int minimum, int& valueOut)
+    {
+        if (!text.containsOnly("-0123456789") || text.isEmpty())
+            return false;
+
+        valueOut = text.getIntValue();
+        return valueOut >= minimum;
+    }
+
+    bool parseFloat(const juce::String& text, float minimum, float maximum, float& valueOut)
+    {
+        if (!text.containsOnly("-0123456789.eE") || text.isEmpty())
+            return false;
+
+        valueOut = text.getFloatValue();
+        return valueOut >= minimum && valueOut <= maximum;
+    }
+
+    // False (after printing why) on an unknown option or a bad value
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const juce::String option(argv[i]);
+            const juce::String value = i + 1 < argc ? juce::String(argv[i + 1]) : juce::String();
+            bool valid = true;
+            bool takesValue = true;
+
+            if (option == "--generations")          valid = parseInt(value, 1, options.generations);
+            else if (option == "--sessions")        valid = parseInt(value, 1, options.sessions);
+            else if (option == "--first-session")   valid = parseInt(value, 0, options.firstSession);
+            else if (option == "--jobs")            valid = parseInt(value, 0, options.jobs);
+            else if (option == "--report-every")    valid = parseInt(value, 0, options.reportEvery);
+            else if (option == "--rate-every")      valid = parseInt(value, 0, options.rateEvery);
+            else if (option == "--population")      valid = parseInt(value, GeneticAlgorithm::getOffspringPerGeneration(), options.config.populationSize);
+            else if (option == "--threads")         valid = parseInt(value, 0, options.config.numEvaluationThreads);
+            else if (option == "--islands")         valid = parseInt(value, 1, options.config.numIslands);
+            else if (option == "--migration")       valid = parseInt(value, 0, options.config.migrationInterval);
+            else if (option == "--proposals")       valid = parseInt(value, 0, options.config.proposalBatchSize);
+            else if (option == "--like-threshold")  valid = parseFloat(value, 0.0f, 1.0f, options.likeThreshold);
+            else if (option == "--noise")           valid = parseFloat(value, 0.0f, 1.0f, options.noise);
+            else if (option == "--latency-ms")
+            {
+                options.config.budgetMode = GAConfig::BudgetMode::Latency;
+                valid = parseFloat(value, 1.0f, 60000.0f, options.config.targetLatencyMs);
+            }
+            else if (option == "--cpu-ms")
+            {
+                options.config.budgetMode = GAConfig::BudgetMode::CpuTime;
+                valid = parseFloat(value, 1.0f, 1000.0f, options.config.targetCpuMsPerSecond);
+            }
+            else if (option == "--selection")
+            {
+                if (value == "tournament")  options.config.selectionMode = GAConfig::SelectionMode::Tournament;
+                else if (value == "rank")   options.config.selectionMode = GAConfig::SelectionMode::Rank;
+                else if (value == "sus")    options.config.selectionMode = GAConfig::SelectionMode::StochasticUniversal;
+                else                        valid = false;
+            }
+            else if (option == "--replacement")
+            {
+                if (value == "worst")           options.config.replacementMode = GAConfig::ReplacementMode::WorstN;
+                else if (value == "crowding")   options.config.replacementMode = GAConfig::ReplacementMode::Crowding;
+                else if (value == "elitist")    options.config.replacementMode = GAConfig::ReplacementMode::ElitistSteadyState;
+                else                            valid = false;
+            }
+            else if (option == "--surrogate")
+            {
+                options.config.surrogateFiltering = true;
+                valid = parseFloat(value, 0.0f, 1.0f, options.config.surrogateKeepFraction)
+                     && options.config.surrogateKeepFraction > 0.0f;
+            }
+            else if (option == "--seed")
+            {
+                valid = value.isNotEmpty() && value.containsOnly("-0123456789");
+                options.seed = value.getLargeIntValue();
+            }
+            else if (option == "--target")
+            {
+                options.targetFile = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+                valid = value.isNotEmpty() && options.targetFile.existsAsFile();
+            }
+            else if (option == "--model")
+            {
+                options.modelDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+                valid = value.isNotEmpty() && options.modelDirectory.isDirectory();
+            }
+            else
+            {
+                takesValue = false;
+
+                if (option == "--direct")               options.direct = true;
+                else if (option == "--adaptive")        options.config.adaptiveExploration = true;
+                else if (option == "--novelty")         options.config.noveltyBonus = true;
+                else if (option == "--multi-objective") options.config.multiObjective = true;
+                else if (option == "--progressive")     options.config.progressiveEvaluation = true;
+                else if (option == "--ucb")             options.config.uncertaintyExploration = true;
+                else if (option == "--audio")           options.config.mlpInputMode = GAConfig::MLPInputMode::Audio;
+                else if (option == "--reject-silent")   options.config.silenceRejection = true;
+                else
+                {
+                    std::cerr << "Unknown option " << option << "\n\n" << usage;
+                    return false;
+                }
+            }
+
+            if (!valid)
+            {
+                std::cerr << "Bad value for " << option << ": '" << value << "'\n";
+                return false;
+            }
+
+            if (takesValue)
+                ++i;
+        }
+
+        const int fitnessSources = (options.direct ? 1 : 0) + (options.modelDirectory != juce::File() ? 1 : 0)
+                                 + (options.targetFile != juce::File() ? 1 : 0);
+        if (fitnessSources > 1)
+        {
+            std::cerr << "--direct, --model and --target are exclusive\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    // Fresh scratch directory for one session's model, seeded from the saved model if any
+    juce::File createModelDirectory(const Options& options, int session)
+    {
+        // Random suffix: other ppg_cli processes on the machine may run the same session index
+        auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                             .getChildFile("ppg_cli")
+                             .getChildFile("session" + juce::String(session) + "_"
+                                           + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64()));
+        directory.createDirectory();
+
+        if (options.modelDirectory != juce::File())
+            for (const char* name : modelFiles)
+                if (options.modelDirectory.getChildFile(name).existsAsFile())
+                    options.modelDirectory.getChildFile(name).copyFileTo(directory.getChildFile(name));
+
+        return directory;
+    }
+
+    // Ratings and their oracle similarity within one report interval
+    struct RatingWindow
+    {
+        int ratings = 0;
+        int likes = 0;
+        double similaritySum = 0.0;
+
+        float getLikeRate() const { return ratings > 0 ? float(likes) / float(ratings) : 0.0f; }
+        float getSimilarity() const { return ratings > 0 ? float(similaritySum / ratings) : 0.0f; }
+    };
+
+    struct SessionResult
+    {
+        std::string rows;
+        int generations = 0;
+        double seconds = 0.0;
+        juce::int64 offspring = 0;
+        float finalLikeRate = 0.0f;
+        float finalBestFitness = 0.0f;
+        GeneticAlgorithm::SurrogateStats surrogate;
+        GeneticAlgorithm::SilenceStats silence;
+        GenerationBudget::Stats budget;
+        OnlineMetrics::Stats metrics;  // Counts no ratings without a preference model
+    };
+
+    SessionResult runSession(const Options& options, int session)
+    {
+        const juce::int64 seed = options.seed + session;
+        juce::Random random(seed);
+
+        const PreferenceOracle oracle(random, options.likeThreshold, options.noise);
+
+        juce::File modelDirectory;
+        std::unique_ptr<IFitnessModel> model;
+
+        const bool matchingTarget = options.targetFile != juce::File();
+
+        if (options.direct)
+        {
+            model = std::make_unique<OracleFitnessModel>(oracle);
+        }
+        else if (matchingTarget)
+        {
+            auto matcher = std::make_unique<TargetMatchModel>();
+            matcher->setTargetFeatures(options.targetFeatures);
+            model = std::move(matcher);
+        }
+        else
+        {
+            modelDirectory = createModelDirectory(options, session);
+            auto mlp = std::make_unique<MLPPreferenceModel>(parameterNames, modelDirectory, 44100.0,
+                                                            MLPPreferenceModel::defaultReplayCapacity,
+                                                            static_cast<uint64_t>(seed));
+            mlp->setInputMode(options.config.mlpInputMode);
+            mlp->setConfigFlags(options.config.toString());
+            mlp->waitUntilReady(60000);
+            model = std::move(mlp);
+        }
+
+        SessionResult result;
+
+        {
+            GeneticAlgorithm ga(*model);
+            ga.setConfig(options.config);
+            ga.setSeed(random.nextInt64());
+
+            auto& bridge = *ga.getParameterBridge();
+            std::vector<float> candidate;
+            float candidateFitness = 0.0f;
+
+            const int numIslands = std::max(1, options.config.numIslands);
+            const int reportEvery = options.reportEvery > 0 ? options.reportEvery : options.generations;
+            RatingWindow window, lastWindow;
+            std::ostringstream rows;
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            juce::int64 offspring = 0;
+
+            for (int generation = 1; generation <= options.generations; ++generation)
+            {
+                ga.stepGeneration();
+                offspring += static_cast<juce::int64>(ga.getBudgetStats().offspringPerGeneration) * numIslands;
+
+                if (!matchingTarget && options.rateEvery > 0 && generation % options.rateEvery == 0
+                    && bridge.pop(candidate, candidateFitness))
+                {
+                    const bool liked = oracle.rate(candidate.data(), random);
+                    model->sendFeedback(candidate, { liked ? 1.0f : 0.0f, 5.0f });
+
+                    // Trained on before the next generation, so a seed always gives the same run
+                    if (auto* mlp = dynamic_cast<MLPPreferenceModel*>(model.get()))
+                        mlp->waitUntilTrained(60000);
+
+                    ++window.ratings;
+                    window.likes += liked ? 1 : 0;
+                    window.similaritySum += oracle.getSimilarity(candidate.data());
+                }
+
+                // Keep a queue slot free so the newest candidate is the one rated
+                while (bridge.isFull())
+                    bridge.pop(candidate, candidateFitness);
+
+                if (generation % reportEvery == 0 || generation == options.generations)
+                {
+                    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+                    const auto stats = ga.getPopulationStats();
+
+                    rows << session << "," << seed << "," << stats.generation << "," << seconds << ","
+                         << (seconds > 0.0 ? stats.generation / seconds : 0.0) << ","
+                         << (seconds > 0.0 ? static_cast<double>(offspring) / seconds : 0.0) << ","
+                         << stats.bestFitness << "," << stats.averageFitness << "," << stats.worstFitness << ","
+                         << window.ratings << "," << window.getLikeRate() << "," << window.getSimilarity() << "\n";
+
+                    result.generations = stats.generation;
+                    result.seconds = seconds;
+                    result.offspring = offspring;
+                    result.finalBestFitness = stats.bestFitness;
+
+                    if (window.ratings > 0)
+                        lastWindow = window;
+                    window = {};
+                }
+            }
+
+            result.rows = rows.str();
+            result.finalLikeRate = lastWindow.getLikeRate();
+            result.surrogate = ga.getSurrogateStats();
+            result.silence = ga.getSilenceStats();
+            result.budget = ga.getBudgetStats();
+        }
+
+        // Ratings still queued at the end aren't counted
+        if (auto* mlp = dynamic_cast<MLPPreferenceModel*>(model.get()))
+            result.metrics = mlp->getOnlineMetrics();
+
+        model.reset();
+        if (modelDirectory != juce::File())
+            modelDirectory.deleteRecursively();
+
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (juce::String(argv[i]) == "--help" || juce::String(argv[i]) == "-h")
+        {
+            std::cout << usage;
+            return 0;
+        }
+    }
+
+    if (!parseOptions(argc, argv, options))
+        return 1;
+
+    if (options.targetFile != juce::File())
+    {
+        TargetMatchModel loader;
+        const auto loaded = loader.loadTarget(options.targetFile);
+        if (!loaded.success)
+        {
+            std::cerr << "Can't load " << options.targetFile.getFullPathName() << ": " << loaded.errorMessage << "\n";
+            return 1;
+        }
+
+        options.targetFeatures = loader.getTargetFeatures();
+    }
+
+    std::cout << "session,seed,generation,seconds,generationsPerSecond,offspringPerSecond,"
+                 "bestFitness,averageFitness,worstFitness,ratings,likeRate,oracleSimilarity\n";
+
+    std::mutex outputMutex;
+    int generations = 0;
+    juce::int64 offspring = 0;
+    double sessionSeconds = 0.0;
+    double likeRateSum = 0.0, bestFitnessSum = 0.0;
+    GeneticAlgorithm::SurrogateStats surrogate;
+    GeneticAlgorithm::SilenceStats silence;
+    double offspringPerGenerationSum = 0.0, generationMsSum = 0.0;
+    double agreementSum = 0.0, rollingErrorSum = 0.0;
+    int sessionsWithMetrics = 0;
+
+    Trace::startFromEnvironment();
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    // With several jobs each session evaluates on its own job thread (the pool runs nested work inline)
+    WorkerPool sessionPool(std::min(options.jobs > 0 ? options.jobs : juce::SystemStats::getNumCpus(), options.sessions));
+    sessionPool.parallelFor(options.sessions, [&](int index, int)
+    {
+        const auto result = runSession(options, options.firstSession + index);
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << result.rows << std::flush;
+        generations += result.generations;
+        offspring += result.offspring;
+        sessionSeconds += result.seconds;
+        likeRateSum += result.finalLikeRate;
+        bestFitnessSum += result.finalBestFitness;
+        surrogate.screened += result.surrogate.screened;
+        surrogate.cut += result.surrogate.cut;
+        surrogate.audited += result.surrogate.audited;
+        surrogate.wrongCuts += result.surrogate.wrongCuts;
+        surrogate.concordantPairs += result.surrogate.concordantPairs;
+        surrogate.discordantPairs += result.surrogate.discordantPairs;
+        silence.screened += result.silence.screened;
+        silence.rejected += result.silence.rejected;
+        silence.kept += result.silence.kept;
+        offspringPerGenerationSum += result.budget.offspringPerGeneration;
+        generationMsSum += result.budget.generationMs;
+
+        if (result.metrics.ratings > 0)
+        {
+            const bool audio = options.config.mlpInputMode == GAConfig::MLPInputMode::Audio;
+            const auto& predictor = audio ? result.metrics.audio : result.metrics.genome;
+            agreementSum += predictor.getPairwiseAgreement();
+            rollingErrorSum += predictor.rollingError;
+            ++sessionsWithMetrics;
+        }
+    });
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    std::cerr << options.sessions << " sessions (" << options.config.toString() << (options.direct ? ", direct" : "")
+              << (options.targetFile != juce::File() ? ", target " + options.targetFile.getFileName() : juce::String())
+              << ") in " << seconds << " s: "
+              << (seconds > 0.0 ? generations / seconds : 0.0) << " generations/s, "
+              << (seconds > 0.0 ? static_cast<double>(offspring) / seconds : 0.0) << " offspring/s overall, "
+              << (sessionSeconds > 0.0 ? generations / sessionSeconds : 0.0) << " generations/s per session; "
+              << "mean final like rate " << likeRateSum / options.sessions
+              << ", mean final best fitness " << bestFitnessSum / options.sessions << "\n";
+
+    if (options.config.surrogateFiltering)
+        std::cerr << "Surrogate: " << surrogate.cut << " of " << surrogate.screened << " offspring cut, rank agreement "
+                  << surrogate.getRankAgreement() << ", wrong cut rate " << surrogate.getWrongCutRate() << "\n";
+
+    if (options.config.silenceRejection)
+        std::cerr << "Silence: " << silence.rejected << " of " << silence.screened << " candidates predicted inaudible and bred again, "
+                  << silence.kept << " kept when every retry was inaudible too\n";
+
+    if (sessionsWithMetrics > 0)
+        std::cerr << "Model: mean pairwise agreement " << agreementSum / sessionsWithMetrics
+                  << ", mean rolling prediction error " << rollingErrorSum / sessionsWithMetrics << "\n";
+
+    if (options.config.budgetMode != GAConfig::BudgetMode::Fixed)
+        std::cerr << "Budget: " << offspringPerGenerationSum / options.sessions << " offspring per generation and island, "
+                  << generationMsSum / options.sessions << " ms per generation (mean of final values)\n";
+
+    if (Trace::isRecording())
+        std::cerr << "Trace written to " << Trace::stopAndExport().getFullPathName() << "\n";
+
+    return 0;
+}